@@ -0,0 +1,111 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+
+/* Keyple Card Calypso */
+#include "CalypsoCardClass.h"
+#include "CmdCardReadRecords.h"
+
+/* Mock */
+#include "ApduResponseAdapterMock.h"
+
+using namespace keyple::card::calypso;
+
+/*
+ * Shape of the status tables before they became constant arrays: one heap allocated entry per
+ * status word, copied from the parent table when the program starts.
+ */
+struct LegacyStatusProperties {
+    LegacyStatusProperties(const std::string& information) : mInformation(information) {}
+
+    const std::string mInformation;
+};
+
+static std::map<const int, const std::shared_ptr<LegacyStatusProperties>> buildLegacyTable()
+{
+    std::map<const int, const std::shared_ptr<LegacyStatusProperties>> m;
+
+    /* Same status words as the Read Records command */
+    const int statusWords[] = {0x6981, 0x6982, 0x6985, 0x6986, 0x6A82, 0x6A83, 0x6B00, 0x9000};
+    for (const int sw : statusWords) {
+        m.insert({sw, std::make_shared<LegacyStatusProperties>("Status information")});
+    }
+
+    return m;
+}
+
+/* Program start: each command class used to build its table this way */
+static void BM_LegacyStatusTableInitialization(benchmark::State& state)
+{
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(buildLegacyTable());
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_LegacyStatusTableInitialization);
+
+/* Success, referenced error and unknown status words */
+static const std::vector<std::shared_ptr<ApduResponseApi>> createResponses()
+{
+    return {std::make_shared<ApduResponseAdapterMock>(
+                std::vector<uint8_t>({0x01, 0x02, 0x03, 0x04, 0x90, 0x00})),
+            std::make_shared<ApduResponseAdapterMock>(std::vector<uint8_t>({0x6A, 0x83})),
+            std::make_shared<ApduResponseAdapterMock>(std::vector<uint8_t>({0x6F, 0x00}))};
+}
+
+static void BM_LegacyStatusWordLookup(benchmark::State& state)
+{
+    const std::map<const int, const std::shared_ptr<LegacyStatusProperties>> legacyTable =
+        buildLegacyTable();
+    const std::vector<std::shared_ptr<ApduResponseApi>> responses = createResponses();
+    size_t i = 0;
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        const auto it = legacyTable.find(responses[i++ % 3]->getStatusWord());
+        benchmark::DoNotOptimize(it != legacyTable.end());
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_LegacyStatusWordLookup);
+
+static void BM_IsSuccessful(benchmark::State& state)
+{
+    auto command = std::make_shared<CmdCardReadRecords>(CalypsoCardClass::ISO,
+                                                        1,
+                                                        1,
+                                                        CmdCardReadRecords::ReadMode::ONE_RECORD,
+                                                        4);
+    const std::vector<std::shared_ptr<ApduResponseApi>> responses = createResponses();
+    size_t i = 0;
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        command->AbstractApduCommand::setApduResponse(responses[i++ % 3]);
+        benchmark::DoNotOptimize(command->isSuccessful());
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_IsSuccessful);
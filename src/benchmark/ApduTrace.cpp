@@ -0,0 +1,167 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "ApduTrace.h"
+
+#include <algorithm>
+#include <chrono>
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+using namespace keyple::core::util::cpp::exception;
+
+static const char MAGIC[4] = {'K', 'A', 'P', 'T'};
+static const uint8_t VERSION = 1;
+
+static void writeInt(std::ostream& output, const uint64_t value, const int length)
+{
+    for (int i = 0; i < length; i++) {
+        output.put(static_cast<char>(value >> (8 * i)));
+    }
+}
+
+static void writeBytes(std::ostream& output, const std::vector<uint8_t>& bytes)
+{
+    writeInt(output, bytes.size(), 2);
+    output.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+static void writeApdus(std::ostream& output, const std::vector<std::vector<uint8_t>>& apdus)
+{
+    writeInt(output, apdus.size(), 2);
+    for (const auto& apdu : apdus) {
+        writeBytes(output, apdu);
+    }
+}
+
+static uint64_t readInt(std::istream& input, const int length)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < length; i++) {
+        const int c = input.get();
+        if (c == std::char_traits<char>::eof()) {
+            throw IllegalArgumentException("Truncated APDU trace.");
+        }
+
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(c)) << (8 * i);
+    }
+
+    return value;
+}
+
+static const std::vector<uint8_t> readBytes(std::istream& input)
+{
+    std::vector<uint8_t> bytes(static_cast<size_t>(readInt(input, 2)));
+
+    input.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+    if (static_cast<size_t>(input.gcount()) != bytes.size()) {
+        throw IllegalArgumentException("Truncated APDU trace.");
+    }
+
+    return bytes;
+}
+
+static const std::vector<std::vector<uint8_t>> readApdus(std::istream& input)
+{
+    std::vector<std::vector<uint8_t>> apdus(static_cast<size_t>(readInt(input, 2)));
+    for (auto& apdu : apdus) {
+        apdu = readBytes(input);
+    }
+
+    return apdus;
+}
+
+void ApduTrace::writeHeader(std::ostream& output,
+                            const std::string& readerName,
+                            const bool isContactless)
+{
+    output.write(MAGIC, sizeof(MAGIC));
+    writeInt(output, VERSION, 1);
+    writeInt(output, isContactless ? 1 : 0, 1);
+    writeBytes(output, std::vector<uint8_t>(readerName.begin(), readerName.end()));
+}
+
+void ApduTrace::writeEvent(std::ostream& output, const Event& event)
+{
+    writeInt(output, static_cast<uint8_t>(event.type), 1);
+    writeInt(output, event.startTime, 8);
+    writeInt(output, event.endTime, 8);
+
+    if (event.type == EventType::EXCHANGE) {
+        writeInt(output, event.isCloseAfter ? 1 : 0, 1);
+        writeInt(output, event.stopOnUnsuccessfulStatusWord ? 1 : 0, 1);
+        writeInt(output, static_cast<uint8_t>(event.outcome), 1);
+        writeInt(output, event.isLogicalChannelOpen ? 1 : 0, 1);
+        writeApdus(output, event.requests);
+        writeApdus(output, event.responses);
+    }
+}
+
+void ApduTrace::readHeader(std::istream& input, std::string& readerName, bool& isContactless)
+{
+    char magic[sizeof(MAGIC)];
+    input.read(magic, sizeof(magic));
+
+    if (input.gcount() != sizeof(magic) ||
+        !std::equal(magic, magic + sizeof(magic), MAGIC) ||
+        readInt(input, 1) != VERSION) {
+        throw IllegalArgumentException("Not an APDU trace or unsupported version.");
+    }
+
+    isContactless = readInt(input, 1) != 0;
+
+    const std::vector<uint8_t> name = readBytes(input);
+    readerName.assign(name.begin(), name.end());
+}
+
+bool ApduTrace::readEvent(std::istream& input, Event& event)
+{
+    const int type = input.get();
+    if (type == std::char_traits<char>::eof()) {
+        return false;
+    }
+
+    if (type != static_cast<uint8_t>(EventType::EXCHANGE) &&
+        type != static_cast<uint8_t>(EventType::RELEASE_CHANNEL)) {
+        throw IllegalArgumentException("Bad APDU trace event type: " + std::to_string(type));
+    }
+
+    event.type = static_cast<EventType>(type);
+    event.startTime = readInt(input, 8);
+    event.endTime = readInt(input, 8);
+    event.requests.clear();
+    event.responses.clear();
+
+    if (event.type == EventType::EXCHANGE) {
+        event.isCloseAfter = readInt(input, 1) != 0;
+        event.stopOnUnsuccessfulStatusWord = readInt(input, 1) != 0;
+        const uint64_t outcome = readInt(input, 1);
+        if (outcome > static_cast<uint8_t>(Outcome::READER_BROKEN_COMMUNICATION)) {
+            throw IllegalArgumentException("Bad APDU trace exchange outcome: " +
+                                           std::to_string(outcome));
+        }
+
+        event.outcome = static_cast<Outcome>(outcome);
+        event.isLogicalChannelOpen = readInt(input, 1) != 0;
+        event.requests = readApdus(input);
+        event.responses = readApdus(input);
+    }
+
+    return true;
+}
+
+uint64_t ApduTrace::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
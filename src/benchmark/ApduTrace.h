@@ -0,0 +1,120 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Binary format of the APDU traces of a reader channel.
+ *
+ * <p>A trace is made of a header followed by events, all integers being little-endian:
+ *
+ * <pre>
+ * header:   "KAPT" | version (u8) | contactless (u8) | name length (u16) | name
+ * event:    type (u8) | start (u64) | end (u64)
+ * exchange: event | channel control (u8) | stop on unsuccessful SW (u8) | outcome (u8) |
+ *           logical channel open (u8) | request count (u16) | requests | response count (u16) |
+ *           responses, each APDU being stored as length (u16) | bytes
+ * release:  event
+ * </pre>
+ *
+ * <p>The timestamps are those of a monotonic clock (std::chrono::steady_clock), in nanoseconds:
+ * they can be compared between the traces of the card and SAM channels of a same run.
+ */
+class ApduTrace final {
+public:
+    /**
+     *
+     */
+    enum class EventType : uint8_t {
+        EXCHANGE = 0x01,
+        RELEASE_CHANNEL = 0x02
+    };
+
+    /**
+     * Result of an exchange.
+     */
+    enum class Outcome : uint8_t {
+        SUCCESS = 0x00,
+        /* UnexpectedStatusWordException, the responses received so far being recorded */
+        UNEXPECTED_STATUS_WORD = 0x01,
+        /* CardBrokenCommunicationException, the responses received so far being recorded */
+        CARD_BROKEN_COMMUNICATION = 0x02,
+        /* ReaderBrokenCommunicationException, the responses received so far being recorded */
+        READER_BROKEN_COMMUNICATION = 0x03
+    };
+
+    /**
+     * Event of a channel: card request/response exchange or channel release.
+     */
+    struct Event {
+        EventType type;
+        uint64_t startTime;
+        uint64_t endTime;
+        bool isCloseAfter;
+        bool stopOnUnsuccessfulStatusWord;
+        Outcome outcome;
+        bool isLogicalChannelOpen;
+        std::vector<std::vector<uint8_t>> requests;
+        std::vector<std::vector<uint8_t>> responses;
+    };
+
+    /**
+     * Writes a trace header.
+     *
+     * @param output The stream (opened in binary mode).
+     * @param readerName The name of the reader.
+     * @param isContactless True if the reader is contactless.
+     */
+    static void writeHeader(std::ostream& output,
+                            const std::string& readerName,
+                            const bool isContactless);
+
+    /**
+     * Writes an event.
+     *
+     * @param output The stream (opened in binary mode).
+     * @param event The event.
+     */
+    static void writeEvent(std::ostream& output, const Event& event);
+
+    /**
+     * Reads a trace header.
+     *
+     * @param input The stream (opened in binary mode).
+     * @param readerName The name of the reader (output).
+     * @param isContactless True if the reader is contactless (output).
+     * @throw IllegalArgumentException If the stream does not start with a valid header.
+     */
+    static void readHeader(std::istream& input, std::string& readerName, bool& isContactless);
+
+    /**
+     * Reads the next event.
+     *
+     * @param input The stream (opened in binary mode).
+     * @param event The event (output).
+     * @return False if the end of the trace is reached.
+     * @throw IllegalArgumentException If the trace is truncated or invalid.
+     */
+    static bool readEvent(std::istream& input, Event& event);
+
+    /**
+     *
+     * @return The current time of the monotonic clock, in nanoseconds.
+     */
+    static uint64_t now();
+};
@@ -0,0 +1,69 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+/* Google Benchmark */
+#include "benchmark/benchmark.h"
+
+/*
+ * The benchmarks register themselves with the BENCHMARK macro in their translation unit. Besides
+ * the time, they report per iteration the heap allocations of the library (those of the simulated
+ * card and SAM excluded) and, for the transactions, the APDUs exchanged with the card and the SAM.
+ */
+
+/**
+ * Number of heap allocations (calls to operator new) since the start of the program, except those
+ * made within an AllocationCountPause.
+ *
+ * <p>Counted by the replacement of the global operator new in MainBenchmark.cpp.
+ */
+long getAllocationCount();
+
+/**
+ * Scope in which the heap allocations of the calling thread are not counted, e.g. those of the
+ * simulated card and SAM, which are not part of the cost of the library (see UncountedReader).
+ *
+ * <p>The scopes may be nested.
+ */
+class AllocationCountPause final {
+public:
+    /**
+     * Pauses the count for the calling thread.
+     */
+    AllocationCountPause();
+
+    /**
+     * Resumes the count, unless an enclosing scope still pauses it.
+     */
+    ~AllocationCountPause();
+
+    AllocationCountPause(const AllocationCountPause&) = delete;
+    AllocationCountPause& operator=(const AllocationCountPause&) = delete;
+};
+
+/**
+ * Reports the heap allocations per iteration of a benchmark.
+ *
+ * @param state the state of the benchmark, after its loop.
+ * @param startAllocationCount the allocation count taken just before the loop.
+ */
+void reportAllocations(benchmark::State& state, const long startAllocationCount);
+
+/**
+ * Reports the APDUs exchanged per iteration of a benchmark.
+ *
+ * @param state the state of the benchmark, after its loop.
+ * @param name the name of the counter (e.g. "card_apdus").
+ * @param apduCount the number of APDUs exchanged during the loop.
+ */
+void reportApdus(benchmark::State& state, const char* name, const long apduCount);
@@ -0,0 +1,102 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "VirtualCardReader.h"
+
+/* Calypsonet Terminal Card */
+#include "CardSelectionResponseApi.h"
+
+/* Keyple Card Calypso */
+#include "CalypsoCardSelectionAdapter.h"
+
+/* Mock */
+#include "ApduResponseAdapterMock.h"
+#include "CardResponseAdapterMock.h"
+
+using namespace calypsonet::terminal::card;
+using namespace keyple::card::calypso;
+
+/* Response to the selection of a card: FCI and responses to the prepared commands */
+class VirtualCardSelectionResponse final : public CardSelectionResponseApi {
+public:
+    VirtualCardSelectionResponse(const std::shared_ptr<ApduResponseApi> selectApplicationResponse,
+                                 const std::shared_ptr<CardResponseApi> cardResponse)
+    : mSelectApplicationResponse(selectApplicationResponse), mCardResponse(cardResponse) {}
+
+    const std::string& getPowerOnData() const override
+    {
+        return mPowerOnData;
+    }
+
+    const std::shared_ptr<ApduResponseApi> getSelectApplicationResponse() const override
+    {
+        return mSelectApplicationResponse;
+    }
+
+    bool hasMatched() const override
+    {
+        return true;
+    }
+
+    const std::shared_ptr<CardResponseApi> getCardResponse() const override
+    {
+        return mCardResponse;
+    }
+
+private:
+    const std::string mPowerOnData;
+    const std::shared_ptr<ApduResponseApi> mSelectApplicationResponse;
+    const std::shared_ptr<CardResponseApi> mCardResponse;
+};
+
+/* Selection with the reading of the environment and of the last event of a validation */
+static void BM_CalypsoCardSelectionParse(benchmark::State& state)
+{
+    const VirtualCardReader reader(
+        "VIRTUAL_CARD_READER",
+        std::vector<uint8_t>({0x31, 0x54, 0x49, 0x43, 0x2E, 0x49, 0x43, 0x41, 0x31}),
+        std::vector<uint8_t>({0x00, 0x00, 0x00, 0x00, 0x11, 0x22, 0x33, 0x44}),
+        std::vector<uint8_t>({0x0A, 0x3C, 0x23, 0x12, 0x14, 0x10, 0x01}));
+
+    CalypsoCardSelectionAdapter cardSelection;
+    cardSelection.filterByDfName(
+                     std::vector<uint8_t>({0x31, 0x54, 0x49, 0x43, 0x2E, 0x49, 0x43, 0x41, 0x31}))
+                 .prepareReadRecord(0x07, 1)
+                 .prepareReadRecord(0x08, 1);
+
+    std::vector<uint8_t> record(29, 0x5A);
+    record.push_back(0x90);
+    record.push_back(0x00);
+
+    const auto cardSelectionResponse =
+        std::make_shared<VirtualCardSelectionResponse>(
+            reader.getSelectApplicationResponse(),
+            std::make_shared<CardResponseAdapterMock>(
+                std::vector<std::shared_ptr<ApduResponseApi>>(
+                    {std::make_shared<ApduResponseAdapterMock>(record),
+                     std::make_shared<ApduResponseAdapterMock>(record)}),
+                true));
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cardSelection.parse(cardSelectionResponse));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_CalypsoCardSelectionParse);
@@ -0,0 +1,257 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+
+/* Keyple Card Calypso */
+#include "CalypsoCardAdapter.h"
+#include "CalypsoCardClass.h"
+#include "CalypsoCardCommand.h"
+#include "CalypsoCardUtilAdapter.h"
+#include "CmdCardChangeKey.h"
+#include "CmdCardGetChallenge.h"
+#include "CmdCardReadRecords.h"
+
+/* Mock */
+#include "ApduResponseAdapterMock.h"
+
+using namespace keyple::card::calypso;
+
+/*
+ * Frozen copy of the former command reference, compared by name and instruction byte, so that the
+ * reference measurement does not depend on the current CalypsoCardCommand::operator==.
+ */
+struct LegacyCommandRef {
+    std::string name;
+    uint8_t instructionByte;
+
+    bool operator==(const LegacyCommandRef& o) const
+    {
+        return name == o.name && instructionByte == o.instructionByte;
+    }
+};
+
+/* Commands of the former if/else chain of CalypsoCardUtilAdapter::updateCalypsoCard, in order */
+static const std::vector<CalypsoCardCommand>& getLegacyCommands()
+{
+    static const std::vector<CalypsoCardCommand> commands = {
+        CalypsoCardCommand::READ_RECORDS, CalypsoCardCommand::GET_DATA,
+        CalypsoCardCommand::SEARCH_RECORD_MULTIPLE, CalypsoCardCommand::READ_RECORD_MULTIPLE,
+        CalypsoCardCommand::SELECT_FILE, CalypsoCardCommand::UPDATE_RECORD,
+        CalypsoCardCommand::WRITE_RECORD, CalypsoCardCommand::APPEND_RECORD,
+        CalypsoCardCommand::INCREASE, CalypsoCardCommand::DECREASE,
+        CalypsoCardCommand::INCREASE_MULTIPLE, CalypsoCardCommand::DECREASE_MULTIPLE,
+        CalypsoCardCommand::OPEN_SESSION, CalypsoCardCommand::CLOSE_SESSION,
+        CalypsoCardCommand::READ_BINARY, CalypsoCardCommand::UPDATE_BINARY,
+        CalypsoCardCommand::WRITE_BINARY, CalypsoCardCommand::GET_CHALLENGE,
+        CalypsoCardCommand::VERIFY_PIN, CalypsoCardCommand::SV_GET,
+        CalypsoCardCommand::SV_RELOAD, CalypsoCardCommand::SV_DEBIT,
+        CalypsoCardCommand::SV_UNDEBIT, CalypsoCardCommand::INVALIDATE,
+        CalypsoCardCommand::REHABILITATE, CalypsoCardCommand::CHANGE_PIN,
+        CalypsoCardCommand::CHANGE_KEY};
+
+    return commands;
+}
+
+/* Former references of the chain, in the same order */
+static const std::vector<LegacyCommandRef>& getLegacyChain()
+{
+    static const std::vector<LegacyCommandRef> chain = [] {
+        std::vector<LegacyCommandRef> refs;
+        for (const auto& command : getLegacyCommands()) {
+            refs.push_back({command.getName(), command.getInstructionByte()});
+        }
+
+        return refs;
+    }();
+
+    return chain;
+}
+
+/* Former reference held by a command, returned by reference as getCommandRef() did */
+static const LegacyCommandRef& getLegacyCommandRef(
+    const std::shared_ptr<AbstractCardCommand> command)
+{
+    static const std::vector<const LegacyCommandRef*> refsById = [] {
+        std::vector<const LegacyCommandRef*> refs(CalypsoCardCommand::ID_COUNT, nullptr);
+        for (std::size_t i = 0; i < getLegacyCommands().size(); i++) {
+            refs[static_cast<std::size_t>(getLegacyCommands()[i].getId())] = &getLegacyChain()[i];
+        }
+
+        return refs;
+    }();
+
+    return *refsById[static_cast<std::size_t>(command->getCommandRef().getId())];
+}
+
+/*
+ * Resolution of the command reference as done by the former if/else chain of
+ * CalypsoCardUtilAdapter::updateCalypsoCard, kept here as the reference measurement: string and
+ * INS compares down to the matching branch, then the dynamic_pointer_cast of that branch.
+ */
+static int legacyResolve(const std::shared_ptr<AbstractCardCommand> command)
+{
+    const std::vector<LegacyCommandRef>& chain = getLegacyChain();
+    const LegacyCommandRef& commandRef = getLegacyCommandRef(command);
+
+    for (int i = 0; i < static_cast<int>(chain.size()); i++) {
+        if (commandRef == chain[i]) {
+            switch (i) {
+            case 0:
+                return std::dynamic_pointer_cast<CmdCardReadRecords>(command) ? i : -1;
+            case 17:
+                return std::dynamic_pointer_cast<CmdCardGetChallenge>(command) ? i : -1;
+            case 26:
+                return std::dynamic_pointer_cast<CmdCardChangeKey>(command) ? i : -1;
+            default:
+                return i;
+            }
+        }
+    }
+
+    return -1;
+}
+
+/*
+ * Resolution of the command reference as done by the handler array, indexed by identifier.
+ */
+static int tableResolve(const std::shared_ptr<AbstractCardCommand> command)
+{
+    struct Table {
+        Table()
+        {
+            for (std::size_t i = 0; i < CalypsoCardCommand::ID_COUNT; i++) {
+                entries[i] = static_cast<int>(i);
+            }
+        }
+
+        int entries[CalypsoCardCommand::ID_COUNT];
+    };
+
+    static const Table table;
+
+    return table.entries[static_cast<std::size_t>(command->getCommandRef().getId())];
+}
+
+/* First, middle and last entries of the former chain */
+static const std::vector<std::shared_ptr<AbstractCardCommand>> createCommands()
+{
+    return {std::make_shared<CmdCardReadRecords>(CalypsoCardClass::ISO,
+                                                 1,
+                                                 1,
+                                                 CmdCardReadRecords::ReadMode::ONE_RECORD,
+                                                 4),
+            std::make_shared<CmdCardGetChallenge>(CalypsoCardClass::ISO),
+            std::make_shared<CmdCardChangeKey>(CalypsoCardClass::ISO,
+                                               1,
+                                               std::vector<uint8_t>(32, 0x00))};
+}
+
+static const std::vector<std::shared_ptr<ApduResponseApi>> createResponses()
+{
+    return {std::make_shared<ApduResponseAdapterMock>(
+                std::vector<uint8_t>({0x01, 0x02, 0x03, 0x04, 0x90, 0x00})),
+            std::make_shared<ApduResponseAdapterMock>(
+                std::vector<uint8_t>({0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x90, 0x00})),
+            std::make_shared<ApduResponseAdapterMock>(std::vector<uint8_t>({0x90, 0x00}))};
+}
+
+static void BM_LegacyCommandResolution(benchmark::State& state)
+{
+    const std::vector<std::shared_ptr<AbstractCardCommand>> commands = createCommands();
+    size_t i = 0;
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(legacyResolve(commands[i++ % 3]));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_LegacyCommandResolution);
+
+static void BM_TableCommandResolution(benchmark::State& state)
+{
+    const std::vector<std::shared_ptr<AbstractCardCommand>> commands = createCommands();
+    size_t i = 0;
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tableResolve(commands[i++ % 3]));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_TableCommandResolution);
+
+static void BM_UpdateCalypsoCard(benchmark::State& state)
+{
+    auto calypsoCard = std::make_shared<CalypsoCardAdapter>();
+    const std::vector<std::shared_ptr<AbstractCardCommand>> commands = createCommands();
+    const std::vector<std::shared_ptr<ApduResponseApi>> responses = createResponses();
+    size_t i = 0;
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        CalypsoCardUtilAdapter::updateCalypsoCard(calypsoCard,
+                                                  commands[i % 3],
+                                                  responses[i % 3],
+                                                  false);
+        i++;
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_UpdateCalypsoCard);
+
+/* Responses of a whole card request: a contract read and an event log read */
+static void BM_UpdateCalypsoCardMultipleResponses(benchmark::State& state)
+{
+    auto calypsoCard = std::make_shared<CalypsoCardAdapter>();
+
+    const std::vector<std::shared_ptr<AbstractCardCommand>> commands = {
+        std::make_shared<CmdCardReadRecords>(CalypsoCardClass::ISO,
+                                             0x09,
+                                             1,
+                                             CmdCardReadRecords::ReadMode::ONE_RECORD,
+                                             29),
+        std::make_shared<CmdCardReadRecords>(CalypsoCardClass::ISO,
+                                             0x08,
+                                             1,
+                                             CmdCardReadRecords::ReadMode::ONE_RECORD,
+                                             29)};
+
+    std::vector<uint8_t> record(29, 0x5A);
+    record.push_back(0x90);
+    record.push_back(0x00);
+
+    const std::vector<std::shared_ptr<ApduResponseApi>> responses = {
+        std::make_shared<ApduResponseAdapterMock>(record),
+        std::make_shared<ApduResponseAdapterMock>(record)};
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        CalypsoCardUtilAdapter::updateCalypsoCard(calypsoCard, commands, responses, false);
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_UpdateCalypsoCardMultipleResponses);
@@ -0,0 +1,159 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include "Benchmark.h"
+#include "VirtualCardReader.h"
+
+/* Keyple Core Util */
+#include "ApduUtil.h"
+
+/* Keyple Card Calypso */
+#include "CalypsoCardAdapter.h"
+#include "CalypsoCardClass.h"
+#include "CmdCardAppendRecord.h"
+#include "CmdCardIncreaseOrDecrease.h"
+#include "CmdCardOpenSession.h"
+#include "CmdCardReadRecords.h"
+#include "CmdCardUpdateRecord.h"
+
+using namespace keyple::card::calypso;
+using namespace keyple::core::util;
+
+static void BM_ApduUtilBuildCase2(benchmark::State& state)
+{
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            ApduUtil::build(0x00, 0xB2, 0x01, 0x4C, static_cast<uint8_t>(0x1D)));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_ApduUtilBuildCase2);
+
+static void BM_ApduUtilBuildCase3(benchmark::State& state)
+{
+    const std::vector<uint8_t> data(29, 0x5A);
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ApduUtil::build(0x00, 0xE2, 0x00, 0x40, data));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_ApduUtilBuildCase3);
+
+static void BM_ApduUtilBuildCase4(benchmark::State& state)
+{
+    const std::vector<uint8_t> data({0x12, 0x34, 0x56, 0x78});
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            ApduUtil::build(0x00, 0x8A, 0x0B, 0x3A, data, static_cast<uint8_t>(0x00)));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_ApduUtilBuildCase4);
+
+static void BM_CmdCardReadRecords(benchmark::State& state)
+{
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::make_shared<CmdCardReadRecords>(CalypsoCardClass::ISO,
+                                                 0x09,
+                                                 1,
+                                                 CmdCardReadRecords::ReadMode::MULTIPLE_RECORD,
+                                                 0));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_CmdCardReadRecords);
+
+static void BM_CmdCardUpdateRecord(benchmark::State& state)
+{
+    const std::vector<uint8_t> record(29, 0x5A);
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::make_shared<CmdCardUpdateRecord>(CalypsoCardClass::ISO, 0x09, 1, record));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_CmdCardUpdateRecord);
+
+static void BM_CmdCardAppendRecord(benchmark::State& state)
+{
+    const std::vector<uint8_t> record(29, 0x5A);
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::make_shared<CmdCardAppendRecord>(CalypsoCardClass::ISO, 0x08, record));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_CmdCardAppendRecord);
+
+static void BM_CmdCardDecrease(benchmark::State& state)
+{
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::make_shared<CmdCardIncreaseOrDecrease>(true, CalypsoCardClass::ISO, 0x19, 1, 1));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_CmdCardDecrease);
+
+static void BM_CmdCardOpenSession(benchmark::State& state)
+{
+    /* Revision 3.1 card, as returned by the virtual card */
+    const VirtualCardReader reader(
+        "VIRTUAL_CARD_READER",
+        std::vector<uint8_t>({0x31, 0x54, 0x49, 0x43, 0x2E, 0x49, 0x43, 0x41, 0x31}),
+        std::vector<uint8_t>({0x00, 0x00, 0x00, 0x00, 0x11, 0x22, 0x33, 0x44}),
+        std::vector<uint8_t>({0x0A, 0x3C, 0x23, 0x12, 0x14, 0x10, 0x01}));
+
+    auto calypsoCard = std::make_shared<CalypsoCardAdapter>();
+    calypsoCard->initializeWithFci(reader.getSelectApplicationResponse());
+
+    const std::vector<uint8_t> samChallenge({0x12, 0x34, 0x56, 0x78});
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::make_shared<CmdCardOpenSession>(calypsoCard, 0x03, samChallenge, 0x09, 1));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_CmdCardOpenSession);
@@ -0,0 +1,155 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include "Benchmark.h"
+
+/* Keyple Card Calypso */
+#include "FileDataAdapter.h"
+
+using namespace keyple::card::calypso;
+
+/*
+ * Contract file of 4 records of 29 bytes. The benchmarks using it take the storage as argument: 0
+ * for the map of records, 1 for the flat storage.
+ */
+static const std::shared_ptr<FileDataAdapter> createContracts(const bool isFlatStorage)
+{
+    auto fileData = std::make_shared<FileDataAdapter>();
+    if (isFlatStorage) {
+        fileData->useFlatStorage(4, 29);
+    }
+
+    for (int i = 1; i <= 4; i++) {
+        fileData->setContent(i, std::vector<uint8_t>(29, static_cast<uint8_t>(i)));
+    }
+
+    return fileData;
+}
+
+static void BM_FileDataSetContent(benchmark::State& state)
+{
+    const auto fileData = createContracts(state.range(0) != 0);
+    const std::vector<uint8_t> record(29, 0x5A);
+    int i = 0;
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        fileData->setContent(1 + (i++ & 3), record);
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_FileDataSetContent)->Arg(0)->Arg(1);
+
+static void BM_FileDataGetContent(benchmark::State& state)
+{
+    const auto fileData = createContracts(state.range(0) != 0);
+    int i = 0;
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fileData->getContent(1 + (i++ & 3)));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_FileDataGetContent)->Arg(0)->Arg(1);
+
+/* Partial update of a record, as done by Update Binary and Write Binary */
+static void BM_FileDataFillContent(benchmark::State& state)
+{
+    const auto fileData = createContracts(state.range(0) != 0);
+    const std::vector<uint8_t> data(8, 0x0F);
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        fileData->fillContent(1, data, 4);
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_FileDataFillContent)->Arg(0)->Arg(1);
+
+/* Event log of 3 records, as updated by Append Record */
+static void BM_FileDataAddCyclicContent(benchmark::State& state)
+{
+    FileDataAdapter fileData;
+    if (state.range(0) != 0) {
+        fileData.useFlatStorage(3, 29);
+    }
+
+    const std::vector<uint8_t> event(29, 0x5A);
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        fileData.addCyclicContent(event);
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_FileDataAddCyclicContent)->Arg(0)->Arg(1);
+
+/* Counter file of 9 counters, as updated by Increase and Decrease */
+static void BM_FileDataSetCounter(benchmark::State& state)
+{
+    FileDataAdapter fileData;
+    fileData.setContent(1, std::vector<uint8_t>(27, 0x00));
+
+    const std::vector<uint8_t> value({0x00, 0x01, 0x00});
+    int i = 0;
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        fileData.setCounter(1 + i++ % 9, value);
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_FileDataSetCounter);
+
+static void BM_FileDataGetAllCountersValue(benchmark::State& state)
+{
+    FileDataAdapter fileData;
+    fileData.setContent(1, std::vector<uint8_t>(27, 0x01));
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fileData.getAllCountersValueAsArray());
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_FileDataGetAllCountersValue);
+
+/* Copy made to back up the file before its first update in a session */
+static void BM_FileDataCopy(benchmark::State& state)
+{
+    const auto fileData = createContracts(state.range(0) != 0);
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::make_shared<FileDataAdapter>(fileData));
+    }
+
+    reportAllocations(state, allocationCount);
+}
+BENCHMARK(BM_FileDataCopy)->Arg(0)->Arg(1);
@@ -0,0 +1,124 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "LatencyClock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+using namespace keyple::core::util::cpp::exception;
+
+/* Identifier of the next timelines, 0 designating none */
+static std::atomic<uint64_t> nextTimelineId(1);
+
+/* End of the last exchange of the calling thread on the timelines designated by timelineId */
+struct ThreadTimeline {
+    uint64_t timelineId;
+    long long end;
+};
+
+static thread_local ThreadTimeline threadTimeline = {0, 0};
+
+LatencyClock::LatencyClock(const Mode mode)
+: mMode(mode), mTimelineId(nextTimelineId++), mCriticalPath(0), mTotalLatency(0) {}
+
+int LatencyClock::createChannel()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mChannelEnds.push_back(0);
+
+    return static_cast<int>(mChannelEnds.size()) - 1;
+}
+
+std::chrono::microseconds LatencyClock::beginExchange(const int channel)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    checkChannel(channel);
+
+    /* A thread unknown to the timelines waits for the exchanges completed so far */
+    const long long threadEnd =
+        threadTimeline.timelineId == mTimelineId ? threadTimeline.end : mCriticalPath;
+    const long long start = std::max(mChannelEnds[channel], threadEnd);
+
+    threadTimeline = {mTimelineId, start};
+
+    return std::chrono::microseconds(start);
+}
+
+void LatencyClock::endExchange(const int channel,
+                               const std::chrono::microseconds start,
+                               const std::chrono::microseconds latency)
+{
+    if (mMode == Mode::REAL) {
+        std::this_thread::sleep_for(latency);
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    checkChannel(channel);
+
+    const long long end = start.count() + latency.count();
+
+    mChannelEnds[channel] = std::max(mChannelEnds[channel], end);
+    mCriticalPath = std::max(mCriticalPath, end);
+    mTotalLatency += latency.count();
+
+    threadTimeline = {mTimelineId, end};
+}
+
+void LatencyClock::spend(const int channel, const std::chrono::microseconds latency)
+{
+    endExchange(channel, beginExchange(channel), latency);
+}
+
+std::chrono::microseconds LatencyClock::getSpentLatency() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    return std::chrono::microseconds(mCriticalPath);
+}
+
+std::chrono::microseconds LatencyClock::getTotalLatency() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    return std::chrono::microseconds(mTotalLatency);
+}
+
+void LatencyClock::reset()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    /* The timelines of the threads refer to the previous identifier and become obsolete */
+    mTimelineId = nextTimelineId++;
+    std::fill(mChannelEnds.begin(), mChannelEnds.end(), 0);
+    mCriticalPath = 0;
+    mTotalLatency = 0;
+}
+
+LatencyClock::Mode LatencyClock::getMode() const
+{
+    return mMode;
+}
+
+void LatencyClock::checkChannel(const int channel) const
+{
+    if (channel < 0 || channel >= static_cast<int>(mChannelEnds.size())) {
+        throw IllegalArgumentException("Unknown channel: " + std::to_string(channel));
+    }
+}
@@ -0,0 +1,151 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * Clock on which the latency readers spend their latency, possibly shared by the card and SAM
+ * readers of a transaction.
+ *
+ * <p>Each reader spends its latency on its own channel. The clock keeps a virtual timeline per
+ * channel and per thread: an exchange starts once the previous exchange of its channel and the
+ * previous exchange of its thread are over, so that the exchanges of concurrent threads on
+ * distinct channels (e.g. SAM digest pipelining) overlap. The first exchange of a thread starts
+ * after the exchanges already completed on the clock. The spent latency is the critical path of
+ * the exchanges, i.e. the end of the latest one.
+ *
+ * <p>In REAL mode, the calling thread also sleeps for the duration of each latency. In VIRTUAL
+ * mode, nothing sleeps, so that simulated runs are fast.
+ *
+ * <p>Thread safe.
+ */
+class LatencyClock final {
+public:
+    /**
+     *
+     */
+    enum class Mode {
+        REAL,
+        VIRTUAL
+    };
+
+    /**
+     *
+     * @param mode The mode.
+     */
+    explicit LatencyClock(const Mode mode);
+
+    /**
+     * Creates a new channel, with its own timeline.
+     *
+     * @return The channel identifier.
+     */
+    int createChannel();
+
+    /**
+     * Begins an exchange on a channel, before it is transmitted.
+     *
+     * @param channel The channel identifier.
+     * @return The virtual start time of the exchange.
+     * @throw IllegalArgumentException If the channel is unknown.
+     */
+    std::chrono::microseconds beginExchange(const int channel);
+
+    /**
+     * Ends an exchange on a channel: sleeps in REAL mode, and moves the timelines of the channel
+     * and of the calling thread to the end of the exchange.
+     *
+     * @param channel The channel identifier.
+     * @param start The virtual start time returned by beginExchange.
+     * @param latency The latency of the exchange.
+     * @throw IllegalArgumentException If the channel is unknown.
+     */
+    void endExchange(const int channel,
+                     const std::chrono::microseconds start,
+                     const std::chrono::microseconds latency);
+
+    /**
+     * Spends a latency on a channel, as an exchange beginning now.
+     *
+     * @param channel The channel identifier.
+     * @param latency The latency.
+     * @throw IllegalArgumentException If the channel is unknown.
+     */
+    void spend(const int channel, const std::chrono::microseconds latency);
+
+    /**
+     *
+     * @return The critical path of the exchanges since the creation of the clock or the last
+     *         reset, the overlapping exchanges being counted once.
+     */
+    std::chrono::microseconds getSpentLatency() const;
+
+    /**
+     *
+     * @return The sum of the latencies spent since the creation of the clock or the last reset,
+     *         as if all the exchanges were made one after the other.
+     */
+    std::chrono::microseconds getTotalLatency() const;
+
+    /**
+     * Resets the timelines (the channels are kept).
+     */
+    void reset();
+
+    /**
+     *
+     * @return The mode.
+     */
+    Mode getMode() const;
+
+private:
+    /**
+     *
+     */
+    const Mode mMode;
+
+    /**
+     * Protects the timelines.
+     */
+    mutable std::mutex mMutex;
+
+    /**
+     * Identifier of the current timelines, unique across clocks and resets, to which the
+     * timelines of the threads refer.
+     */
+    uint64_t mTimelineId;
+
+    /**
+     * End of the last exchange of each channel, in microseconds.
+     */
+    std::vector<long long> mChannelEnds;
+
+    /**
+     * End of the latest exchange, in microseconds.
+     */
+    long long mCriticalPath;
+
+    /**
+     * Sum of the latencies, in microseconds.
+     */
+    long long mTotalLatency;
+
+    /**
+     * Checks that a channel exists (mMutex held).
+     */
+    void checkChannel(const int channel) const;
+};
@@ -0,0 +1,114 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "LatencyModel.h"
+
+#include <fstream>
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+using namespace keyple::core::util::cpp::exception;
+
+/**
+ * Removes the leading and trailing blanks of a text.
+ */
+static std::string trim(const std::string& text)
+{
+    const std::string blanks = " \t\r";
+    const size_t first = text.find_first_not_of(blanks);
+    if (first == std::string::npos) {
+        return std::string();
+    }
+
+    return text.substr(first, text.find_last_not_of(blanks) - first + 1);
+}
+
+/**
+ * Parses a positive number of microseconds, -1 if the text is not one.
+ */
+static long parseMicroseconds(const std::string& text)
+{
+    if (text.empty() ||
+        text.size() > 9 ||
+        text.find_first_not_of("0123456789") != std::string::npos) {
+        return -1;
+    }
+
+    return std::stol(text);
+}
+
+LatencyModel LatencyModel::contactlessCard()
+{
+    return {std::chrono::microseconds(0),
+            std::chrono::microseconds(1000),
+            std::chrono::microseconds(40),
+            std::chrono::microseconds(300)};
+}
+
+LatencyModel LatencyModel::contactSam()
+{
+    return {std::chrono::microseconds(0),
+            std::chrono::microseconds(300),
+            std::chrono::microseconds(10),
+            std::chrono::microseconds(50)};
+}
+
+LatencyModel LatencyModel::fromFile(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file) {
+        throw IllegalArgumentException("Unable to read the latency model file: " + path);
+    }
+
+    LatencyModel model = {std::chrono::microseconds(0),
+                          std::chrono::microseconds(0),
+                          std::chrono::microseconds(0),
+                          std::chrono::microseconds(0)};
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+
+        /* "key = value", the blanks around the key and the value being optional */
+        const std::string content = trim(line);
+        if (content.empty() || content[0] == '#') {
+            continue;
+        }
+
+        const size_t separator = content.find('=');
+        const std::string key = trim(content.substr(0, separator));
+        const long value = separator == std::string::npos ?
+                           -1 : parseMicroseconds(trim(content.substr(separator + 1)));
+
+        if (key.empty() || value < 0) {
+            throw IllegalArgumentException("Bad latency model line " +
+                                           std::to_string(lineNumber) + ": " + line);
+        }
+
+        if (key == "exchange") {
+            model.exchangeTime = std::chrono::microseconds(value);
+        } else if (key == "apdu") {
+            model.apduTime = std::chrono::microseconds(value);
+        } else if (key == "byte") {
+            model.byteTime = std::chrono::microseconds(value);
+        } else if (key == "jitter") {
+            model.jitter = std::chrono::microseconds(value);
+        } else {
+            throw IllegalArgumentException("Unknown latency model key line " +
+                                           std::to_string(lineNumber) + ": " + key);
+        }
+    }
+
+    return model;
+}
@@ -0,0 +1,81 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+/**
+ * Timing cost of the exchanges with a reader.
+ *
+ * <p>The latency of a card request is: exchangeTime + for each APDU (apduTime + byteTime x (command
+ * length + response length)), plus a jitter drawn uniformly in [-jitter, +jitter]. The result is
+ * never negative.
+ *
+ * <p>A model can be loaded from a text file made of "key = value" lines, values in microseconds:
+ *
+ * <pre>
+ * # Contactless card, field measures of 2023-03
+ * exchange = 0
+ * apdu = 1000
+ * byte = 40
+ * jitter = 300
+ * </pre>
+ *
+ * The blanks around the key and the value are optional ("apdu=1000" is valid). Missing keys are
+ * set to zero, blank lines and lines starting with '#' are ignored.
+ */
+struct LatencyModel final {
+    /**
+     * Fixed cost of a card request (reader command, channel management).
+     */
+    std::chrono::microseconds exchangeTime;
+
+    /**
+     * Fixed cost of each APDU (protocol overhead, card processing).
+     */
+    std::chrono::microseconds apduTime;
+
+    /**
+     * Transmission cost of each byte, command and response.
+     */
+    std::chrono::microseconds byteTime;
+
+    /**
+     * Maximum deviation added to or subtracted from the latency of a card request.
+     */
+    std::chrono::microseconds jitter;
+
+    /**
+     * Model of a contactless card (ISO 14443 at 106 kbit/s, about 1 to 3 ms per APDU).
+     *
+     * @return A model.
+     */
+    static LatencyModel contactlessCard();
+
+    /**
+     * Model of a contact SAM (ISO 7816 at high speed).
+     *
+     * @return A model.
+     */
+    static LatencyModel contactSam();
+
+    /**
+     * Loads a model from a file.
+     *
+     * @param path The path of the file.
+     * @return A model.
+     * @throw IllegalArgumentException If the file cannot be read or contains an invalid line.
+     */
+    static LatencyModel fromFile(const std::string& path);
+};
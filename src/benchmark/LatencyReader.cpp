@@ -0,0 +1,105 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "LatencyReader.h"
+
+#include <algorithm>
+
+/* Calypsonet Terminal Card */
+#include "UnexpectedStatusWordException.h"
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+using namespace keyple::core::util::cpp::exception;
+
+LatencyReader::LatencyReader(const std::shared_ptr<CardReader> reader,
+                             const LatencyModel& model,
+                             const std::shared_ptr<LatencyClock> clock,
+                             const uint32_t seed)
+: mReader(reader),
+  mProxyReader(std::dynamic_pointer_cast<ProxyReaderApi>(reader)),
+  mModel(model),
+  mClock(clock),
+  mChannel(clock->createChannel()),
+  mRandom(seed)
+{
+    if (mProxyReader == nullptr) {
+        throw IllegalArgumentException("The reader must implement ProxyReaderApi.");
+    }
+}
+
+const std::string& LatencyReader::getName() const
+{
+    return mReader->getName();
+}
+
+bool LatencyReader::isContactless()
+{
+    return mReader->isContactless();
+}
+
+bool LatencyReader::isCardPresent()
+{
+    return mReader->isCardPresent();
+}
+
+const std::shared_ptr<CardResponseApi> LatencyReader::transmitCardRequest(
+    const std::shared_ptr<CardRequestSpi> cardRequest,
+    const ChannelControl channelControl)
+{
+    const std::chrono::microseconds start = mClock->beginExchange(mChannel);
+    std::shared_ptr<CardResponseApi> cardResponse;
+
+    try {
+        cardResponse = mProxyReader->transmitCardRequest(cardRequest, channelControl);
+    } catch (const UnexpectedStatusWordException& e) {
+        spendLatency(cardRequest, e.getCardResponse(), start);
+        throw;
+    }
+
+    spendLatency(cardRequest, cardResponse, start);
+
+    return cardResponse;
+}
+
+void LatencyReader::releaseChannel()
+{
+    mProxyReader->releaseChannel();
+}
+
+void LatencyReader::spendLatency(const std::shared_ptr<CardRequestSpi> cardRequest,
+                                 const std::shared_ptr<CardResponseApi> cardResponse,
+                                 const std::chrono::microseconds start)
+{
+    const auto& apduRequests = cardRequest->getApduRequests();
+    const size_t apduCount = cardResponse != nullptr ? cardResponse->getApduResponses().size() : 0;
+
+    long long bytes = 0;
+    for (size_t i = 0; i < apduCount && i < apduRequests.size(); i++) {
+        bytes += apduRequests[i]->getApdu().size() +
+                 cardResponse->getApduResponses()[i]->getApdu().size();
+    }
+
+    long long latency = mModel.exchangeTime.count() +
+                        static_cast<long long>(apduCount) * mModel.apduTime.count() +
+                        bytes * mModel.byteTime.count();
+
+    if (mModel.jitter.count() > 0) {
+        std::uniform_int_distribution<long long> jitter(-mModel.jitter.count(),
+                                                        mModel.jitter.count());
+        std::lock_guard<std::mutex> lock(mMutex);
+        latency += jitter(mRandom);
+    }
+
+    mClock->endExchange(mChannel, start, std::chrono::microseconds(std::max(latency, 0LL)));
+}
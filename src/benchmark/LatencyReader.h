@@ -0,0 +1,138 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+
+/* Calypsonet Terminal Card */
+#include "CardRequestSpi.h"
+#include "CardResponseApi.h"
+#include "ChannelControl.h"
+#include "ProxyReaderApi.h"
+
+/* Calypsonet Terminal Reader */
+#include "CardReader.h"
+
+/* Benchmark */
+#include "LatencyClock.h"
+#include "LatencyModel.h"
+
+using namespace calypsonet::terminal::card;
+using namespace calypsonet::terminal::card::spi;
+using namespace calypsonet::terminal::reader;
+
+/**
+ * Reader decorator adding the latency of a LatencyModel to each card request transmitted to the
+ * decorated reader.
+ *
+ * <p>The latency is spent on a channel of a LatencyClock once the request is processed, also when
+ * it fails with an unexpected status word (the APDUs exchanged until the failure are counted).
+ * The exchange begins on the clock before the request is transmitted, so that it overlaps the
+ * exchanges transmitted meanwhile by other threads on other readers. The jitter
+ * is drawn from a seeded generator: runs are reproducible.
+ *
+ * <p>Thread safe if the decorated reader is.
+ */
+class LatencyReader final : public CardReader, public ProxyReaderApi {
+public:
+    /**
+     *
+     * @param reader The decorated reader, implementing ProxyReaderApi.
+     * @param model The latency model.
+     * @param clock The clock on which the latency is spent, on a channel of its own.
+     * @param seed The seed of the jitter generator.
+     * @throw IllegalArgumentException If the reader does not implement ProxyReaderApi.
+     */
+    LatencyReader(const std::shared_ptr<CardReader> reader,
+                  const LatencyModel& model,
+                  const std::shared_ptr<LatencyClock> clock,
+                  const uint32_t seed = 1);
+
+    /**
+     * {@inheritDoc}
+     */
+    const std::string& getName() const override;
+
+    /**
+     * {@inheritDoc}
+     */
+    bool isContactless() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    bool isCardPresent() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    const std::shared_ptr<CardResponseApi> transmitCardRequest(
+        const std::shared_ptr<CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override;
+
+    /**
+     * {@inheritDoc}
+     */
+    void releaseChannel() override;
+
+private:
+    /**
+     *
+     */
+    const std::shared_ptr<CardReader> mReader;
+
+    /**
+     *
+     */
+    const std::shared_ptr<ProxyReaderApi> mProxyReader;
+
+    /**
+     *
+     */
+    const LatencyModel mModel;
+
+    /**
+     *
+     */
+    const std::shared_ptr<LatencyClock> mClock;
+
+    /**
+     * Channel of the reader on the clock.
+     */
+    const int mChannel;
+
+    /**
+     * Jitter generator, protected by mMutex.
+     */
+    std::minstd_rand mRandom;
+
+    /**
+     *
+     */
+    std::mutex mMutex;
+
+    /**
+     * Computes and spends the latency of a card request.
+     *
+     * @param cardRequest The request.
+     * @param cardResponse The responses received, possibly fewer than the requested APDUs.
+     * @param start The virtual start time of the exchange.
+     */
+    void spendLatency(const std::shared_ptr<CardRequestSpi> cardRequest,
+                      const std::shared_ptr<CardResponseApi> cardResponse,
+                      const std::chrono::microseconds start);
+};
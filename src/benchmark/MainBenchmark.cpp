@@ -0,0 +1,82 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "Benchmark.h"
+
+static std::atomic<long> allocationCount(0);
+
+/* Depth of the AllocationCountPause scopes of the calling thread */
+static thread_local int allocationCountPauseDepth = 0;
+
+/*
+ * Replacement of the global allocation functions counting the heap allocations of the whole
+ * program, paused scopes excepted. The array and nothrow forms call this one by default.
+ */
+void* operator new(std::size_t size)
+{
+    if (allocationCountPauseDepth == 0) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+#endif
+
+long getAllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+AllocationCountPause::AllocationCountPause()
+{
+    allocationCountPauseDepth++;
+}
+
+AllocationCountPause::~AllocationCountPause()
+{
+    allocationCountPauseDepth--;
+}
+
+void reportAllocations(benchmark::State& state, const long startAllocationCount)
+{
+    state.counters["allocs"] =
+        benchmark::Counter(static_cast<double>(getAllocationCount() - startAllocationCount),
+                           benchmark::Counter::kAvgIterations);
+}
+
+void reportApdus(benchmark::State& state, const char* name, const long apduCount)
+{
+    state.counters[name] =
+        benchmark::Counter(static_cast<double>(apduCount), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_MAIN();
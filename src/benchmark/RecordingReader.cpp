@@ -0,0 +1,132 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "RecordingReader.h"
+
+/* Calypsonet Terminal Card */
+#include "CardBrokenCommunicationException.h"
+#include "ReaderBrokenCommunicationException.h"
+#include "UnexpectedStatusWordException.h"
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+using namespace keyple::core::util::cpp::exception;
+
+RecordingReader::RecordingReader(const std::shared_ptr<CardReader> reader,
+                                 const std::shared_ptr<std::ostream> output)
+: mReader(reader),
+  mProxyReader(std::dynamic_pointer_cast<ProxyReaderApi>(reader)),
+  mOutput(output)
+{
+    if (mProxyReader == nullptr) {
+        throw IllegalArgumentException("The reader must implement ProxyReaderApi.");
+    }
+
+    ApduTrace::writeHeader(*mOutput, mReader->getName(), mReader->isContactless());
+}
+
+const std::string& RecordingReader::getName() const
+{
+    return mReader->getName();
+}
+
+bool RecordingReader::isContactless()
+{
+    return mReader->isContactless();
+}
+
+bool RecordingReader::isCardPresent()
+{
+    return mReader->isCardPresent();
+}
+
+const std::shared_ptr<CardResponseApi> RecordingReader::transmitCardRequest(
+    const std::shared_ptr<CardRequestSpi> cardRequest,
+    const ChannelControl channelControl)
+{
+    const uint64_t startTime = ApduTrace::now();
+    std::shared_ptr<CardResponseApi> cardResponse;
+
+    try {
+        cardResponse = mProxyReader->transmitCardRequest(cardRequest, channelControl);
+    } catch (const UnexpectedStatusWordException& e) {
+        record(cardRequest,
+               channelControl,
+               e.getCardResponse(),
+               ApduTrace::Outcome::UNEXPECTED_STATUS_WORD,
+               startTime);
+        throw;
+    } catch (const CardBrokenCommunicationException& e) {
+        record(cardRequest,
+               channelControl,
+               e.getCardResponse(),
+               ApduTrace::Outcome::CARD_BROKEN_COMMUNICATION,
+               startTime);
+        throw;
+    } catch (const ReaderBrokenCommunicationException& e) {
+        record(cardRequest,
+               channelControl,
+               e.getCardResponse(),
+               ApduTrace::Outcome::READER_BROKEN_COMMUNICATION,
+               startTime);
+        throw;
+    }
+
+    record(cardRequest, channelControl, cardResponse, ApduTrace::Outcome::SUCCESS, startTime);
+
+    return cardResponse;
+}
+
+void RecordingReader::releaseChannel()
+{
+    const uint64_t startTime = ApduTrace::now();
+
+    mProxyReader->releaseChannel();
+
+    ApduTrace::Event event;
+    event.type = ApduTrace::EventType::RELEASE_CHANNEL;
+    event.startTime = startTime;
+    event.endTime = ApduTrace::now();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    ApduTrace::writeEvent(*mOutput, event);
+}
+
+void RecordingReader::record(const std::shared_ptr<CardRequestSpi> cardRequest,
+                             const ChannelControl channelControl,
+                             const std::shared_ptr<CardResponseApi> cardResponse,
+                             const ApduTrace::Outcome outcome,
+                             const uint64_t startTime)
+{
+    ApduTrace::Event event;
+    event.type = ApduTrace::EventType::EXCHANGE;
+    event.startTime = startTime;
+    event.endTime = ApduTrace::now();
+    event.isCloseAfter = channelControl == ChannelControl::CLOSE_AFTER;
+    event.stopOnUnsuccessfulStatusWord = cardRequest->stopOnUnsuccessfulStatusWord();
+    event.outcome = outcome;
+    event.isLogicalChannelOpen = cardResponse != nullptr && cardResponse->isLogicalChannelOpen();
+
+    for (const auto& apduRequest : cardRequest->getApduRequests()) {
+        event.requests.push_back(apduRequest->getApdu());
+    }
+
+    if (cardResponse != nullptr) {
+        for (const auto& apduResponse : cardResponse->getApduResponses()) {
+            event.responses.push_back(apduResponse->getApdu());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    ApduTrace::writeEvent(*mOutput, event);
+}
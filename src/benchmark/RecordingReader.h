@@ -0,0 +1,115 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+/* Calypsonet Terminal Card */
+#include "CardRequestSpi.h"
+#include "CardResponseApi.h"
+#include "ChannelControl.h"
+#include "ProxyReaderApi.h"
+
+/* Calypsonet Terminal Reader */
+#include "CardReader.h"
+
+/* Benchmark */
+#include "ApduTrace.h"
+
+using namespace calypsonet::terminal::card;
+using namespace calypsonet::terminal::card::spi;
+using namespace calypsonet::terminal::reader;
+
+/**
+ * Reader decorator recording the exchanges with the decorated reader in an APDU trace (see
+ * ApduTrace).
+ *
+ * <p>Each card request is recorded with the responses received and the monotonic times of its
+ * transmission, also when it fails with an unexpected status word or a broken communication with
+ * the card or the reader. The channel releases are recorded too. Record the card and SAM channels
+ * in two traces to replay them with two ReplayReader.
+ *
+ * <p>Thread safe if the decorated reader is.
+ */
+class RecordingReader final : public CardReader, public ProxyReaderApi {
+public:
+    /**
+     * Creates the decorator and writes the trace header.
+     *
+     * @param reader The decorated reader, implementing ProxyReaderApi.
+     * @param output The stream receiving the trace (opened in binary mode).
+     * @throw IllegalArgumentException If the reader does not implement ProxyReaderApi.
+     */
+    RecordingReader(const std::shared_ptr<CardReader> reader,
+                    const std::shared_ptr<std::ostream> output);
+
+    /**
+     * {@inheritDoc}
+     */
+    const std::string& getName() const override;
+
+    /**
+     * {@inheritDoc}
+     */
+    bool isContactless() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    bool isCardPresent() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    const std::shared_ptr<CardResponseApi> transmitCardRequest(
+        const std::shared_ptr<CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override;
+
+    /**
+     * {@inheritDoc}
+     */
+    void releaseChannel() override;
+
+private:
+    /**
+     *
+     */
+    const std::shared_ptr<CardReader> mReader;
+
+    /**
+     *
+     */
+    const std::shared_ptr<ProxyReaderApi> mProxyReader;
+
+    /**
+     *
+     */
+    const std::shared_ptr<std::ostream> mOutput;
+
+    /**
+     * Protects mOutput.
+     */
+    std::mutex mMutex;
+
+    /**
+     * Records an exchange.
+     */
+    void record(const std::shared_ptr<CardRequestSpi> cardRequest,
+                const ChannelControl channelControl,
+                const std::shared_ptr<CardResponseApi> cardResponse,
+                const ApduTrace::Outcome outcome,
+                const uint64_t startTime);
+};
@@ -0,0 +1,141 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "ReplayReader.h"
+
+/* Calypsonet Terminal Card */
+#include "CardBrokenCommunicationException.h"
+#include "ReaderBrokenCommunicationException.h"
+#include "UnexpectedStatusWordException.h"
+
+/* Keyple Core Util */
+#include "ByteArrayUtil.h"
+#include "IllegalStateException.h"
+
+/* Mock */
+#include "ApduResponseAdapterMock.h"
+#include "CardResponseAdapterMock.h"
+
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+
+ReplayReader::ReplayReader(std::istream& input, const std::shared_ptr<LatencyClock> clock)
+: mIsContactless(false),
+  mNextEvent(0),
+  mClock(clock),
+  mChannel(clock != nullptr ? clock->createChannel() : -1)
+{
+    ApduTrace::readHeader(input, mName, mIsContactless);
+
+    ApduTrace::Event event;
+    while (ApduTrace::readEvent(input, event)) {
+        mEvents.push_back(event);
+    }
+}
+
+void ReplayReader::rewind()
+{
+    mNextEvent = 0;
+}
+
+size_t ReplayReader::getRemainingEventCount() const
+{
+    return mEvents.size() - mNextEvent;
+}
+
+const std::string& ReplayReader::getName() const
+{
+    return mName;
+}
+
+bool ReplayReader::isContactless()
+{
+    return mIsContactless;
+}
+
+bool ReplayReader::isCardPresent()
+{
+    return true;
+}
+
+const std::shared_ptr<CardResponseApi> ReplayReader::transmitCardRequest(
+    const std::shared_ptr<CardRequestSpi> cardRequest,
+    const ChannelControl channelControl)
+{
+    const size_t eventIndex = mNextEvent;
+    const ApduTrace::Event& event = nextEvent(ApduTrace::EventType::EXCHANGE);
+    const auto& apduRequests = cardRequest->getApduRequests();
+
+    if (event.isCloseAfter != (channelControl == ChannelControl::CLOSE_AFTER) ||
+        event.stopOnUnsuccessfulStatusWord != cardRequest->stopOnUnsuccessfulStatusWord() ||
+        event.requests.size() != apduRequests.size()) {
+        throw IllegalStateException("Replay divergence at event #" + std::to_string(eventIndex) +
+                                    ": the card request differs from the recorded one.");
+    }
+
+    for (size_t i = 0; i < apduRequests.size(); i++) {
+        if (apduRequests[i]->getApdu() != event.requests[i]) {
+            throw IllegalStateException("Replay divergence at event #" +
+                                        std::to_string(eventIndex) + ", APDU #" +
+                                        std::to_string(i) + ": expected " +
+                                        ByteArrayUtil::toHex(event.requests[i]) + ", got " +
+                                        ByteArrayUtil::toHex(apduRequests[i]->getApdu()));
+        }
+    }
+
+    std::vector<std::shared_ptr<ApduResponseApi>> apduResponses;
+    apduResponses.reserve(event.responses.size());
+    for (const auto& response : event.responses) {
+        apduResponses.push_back(std::make_shared<ApduResponseAdapterMock>(response));
+    }
+
+    const auto cardResponse =
+        std::make_shared<CardResponseAdapterMock>(apduResponses, event.isLogicalChannelOpen);
+
+    switch (event.outcome) {
+    case ApduTrace::Outcome::UNEXPECTED_STATUS_WORD:
+        throw UnexpectedStatusWordException("Unexpected status word.", cardResponse);
+    case ApduTrace::Outcome::CARD_BROKEN_COMMUNICATION:
+        throw CardBrokenCommunicationException("Card communication lost.", cardResponse);
+    case ApduTrace::Outcome::READER_BROKEN_COMMUNICATION:
+        throw ReaderBrokenCommunicationException("Reader communication lost.", cardResponse);
+    default:
+        break;
+    }
+
+    return cardResponse;
+}
+
+void ReplayReader::releaseChannel()
+{
+    nextEvent(ApduTrace::EventType::RELEASE_CHANNEL);
+}
+
+const ApduTrace::Event& ReplayReader::nextEvent(const ApduTrace::EventType type)
+{
+    if (mNextEvent >= mEvents.size() || mEvents[mNextEvent].type != type) {
+        throw IllegalStateException("Replay divergence at event #" + std::to_string(mNextEvent) +
+                                    ": " +
+                                    (type == ApduTrace::EventType::EXCHANGE ?
+                                         "unexpected card request." :
+                                         "unexpected channel release."));
+    }
+
+    const ApduTrace::Event& event = mEvents[mNextEvent++];
+
+    if (mClock != nullptr) {
+        mClock->spend(mChannel,
+                      std::chrono::microseconds((event.endTime - event.startTime) / 1000));
+    }
+
+    return event;
+}
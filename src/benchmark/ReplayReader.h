@@ -0,0 +1,147 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Calypsonet Terminal Card */
+#include "CardRequestSpi.h"
+#include "CardResponseApi.h"
+#include "ChannelControl.h"
+#include "ProxyReaderApi.h"
+
+/* Calypsonet Terminal Reader */
+#include "CardReader.h"
+
+/* Benchmark */
+#include "ApduTrace.h"
+#include "LatencyClock.h"
+
+using namespace calypsonet::terminal::card;
+using namespace calypsonet::terminal::card::spi;
+using namespace calypsonet::terminal::reader;
+
+/**
+ * Reader serving the responses of an APDU trace recorded by a RecordingReader.
+ *
+ * <p>The replay is deterministic: the card requests and channel releases must come in the
+ * recorded order, and each request must be identical to the recorded one (APDUs, channel control,
+ * stop on unsuccessful status word). Otherwise, the replay fails with an IllegalStateException
+ * designating the first difference, which lets two versions of the library be compared APDU by
+ * APDU. When the library script depends on the content of the responses only, replaying both the
+ * card and SAM channels of a transaction reproduces it exactly.
+ *
+ * <p>If a clock is provided, the recorded duration of each event is spent on a channel of its own,
+ * which reproduces the field timings (latency spikes included).
+ *
+ * <p>Not thread safe: a reader serves a single transaction at a time.
+ */
+class ReplayReader final : public CardReader, public ProxyReaderApi {
+public:
+    /**
+     * Loads a trace.
+     *
+     * @param input The stream providing the trace (opened in binary mode).
+     * @param clock The clock on which the recorded durations are spent (optional).
+     * @throw IllegalArgumentException If the trace is invalid.
+     */
+    explicit ReplayReader(std::istream& input,
+                          const std::shared_ptr<LatencyClock> clock = nullptr);
+
+    /**
+     * Restarts the replay from the first event of the trace.
+     */
+    void rewind();
+
+    /**
+     *
+     * @return The number of events not replayed yet.
+     */
+    size_t getRemainingEventCount() const;
+
+    /**
+     * {@inheritDoc}
+     */
+    const std::string& getName() const override;
+
+    /**
+     * {@inheritDoc}
+     */
+    bool isContactless() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    bool isCardPresent() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @throw IllegalStateException If the request differs from the recorded one.
+     * @throw UnexpectedStatusWordException If the recorded exchange failed this way.
+     * @throw CardBrokenCommunicationException If the recorded exchange failed this way.
+     * @throw ReaderBrokenCommunicationException If the recorded exchange failed this way.
+     */
+    const std::shared_ptr<CardResponseApi> transmitCardRequest(
+        const std::shared_ptr<CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @throw IllegalStateException If no channel release is expected.
+     */
+    void releaseChannel() override;
+
+private:
+    /**
+     *
+     */
+    std::string mName;
+
+    /**
+     *
+     */
+    bool mIsContactless;
+
+    /**
+     *
+     */
+    std::vector<ApduTrace::Event> mEvents;
+
+    /**
+     * Index of the next event to replay.
+     */
+    size_t mNextEvent;
+
+    /**
+     *
+     */
+    const std::shared_ptr<LatencyClock> mClock;
+
+    /**
+     * Channel of the reader on the clock, if any.
+     */
+    const int mChannel;
+
+    /**
+     * Gets the next event, checking its type, and spends its duration.
+     *
+     * @throw IllegalStateException If the trace is over or the next event has another type.
+     */
+    const ApduTrace::Event& nextEvent(const ApduTrace::EventType type);
+};
@@ -0,0 +1,478 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "SoftwareSamReader.h"
+
+#include <algorithm>
+
+/* Calypsonet Terminal Card */
+#include "UnexpectedStatusWordException.h"
+
+/* Keyple Core Util */
+#include "ByteArrayUtil.h"
+#include "IllegalArgumentException.h"
+
+/* Mock */
+#include "ApduResponseAdapterMock.h"
+#include "CardResponseAdapterMock.h"
+
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+
+/* Instruction bytes */
+static const uint8_t INS_CARD_CIPHER_PIN = 0x12;
+static const uint8_t INS_SELECT_DIVERSIFIER = 0x14;
+static const uint8_t INS_SV_PREPARE_DEBIT = 0x54;
+static const uint8_t INS_SV_PREPARE_LOAD = 0x56;
+static const uint8_t INS_SV_CHECK = 0x58;
+static const uint8_t INS_SV_PREPARE_UNDEBIT = 0x5C;
+static const uint8_t INS_DIGEST_AUTHENTICATE = 0x82;
+static const uint8_t INS_GET_CHALLENGE = 0x84;
+static const uint8_t INS_GIVE_RANDOM = 0x86;
+static const uint8_t INS_DIGEST_INIT = 0x8A;
+static const uint8_t INS_DIGEST_UPDATE = 0x8C;
+static const uint8_t INS_DIGEST_CLOSE = 0x8E;
+
+/* Status words */
+static const int SW_SUCCESS = 0x9000;
+static const int SW_WRONG_LENGTH = 0x6700;
+static const int SW_CONDITIONS_NOT_SATISFIED = 0x6985;
+static const int SW_INCORRECT_SIGNATURE = 0x6988;
+static const int SW_INCORRECT_P1_P2 = 0x6A00;
+static const int SW_INCORRECT_DATA = 0x6A80;
+static const int SW_INS_NOT_SUPPORTED = 0x6D00;
+
+static const uint8_t DIGEST_UPDATE_MULTIPLE_P1 = 0x80;
+static const uint8_t CARD_CIPHER_PIN_VERIFY_P1 = 0x80;
+static const int SV_LOAD_BUILD_DATA_LENGTH = 15;
+static const int SV_DEBIT_BUILD_DATA_LENGTH = 12;
+static const int SV_GET_HEADER_LENGTH = 4;
+static const int CARD_CHALLENGE_LENGTH = 8;
+
+/**
+ * Selection response of a SAM, reduced to its ATR.
+ */
+class SoftwareSamSelectionResponse final : public CardSelectionResponseApi {
+public:
+    explicit SoftwareSamSelectionResponse(const std::string& powerOnData)
+    : mPowerOnData(powerOnData) {}
+
+    const std::string& getPowerOnData() const override
+    {
+        return mPowerOnData;
+    }
+
+    const std::shared_ptr<ApduResponseApi> getSelectApplicationResponse() const override
+    {
+        return nullptr;
+    }
+
+    bool hasMatched() const override
+    {
+        return true;
+    }
+
+    const std::shared_ptr<CardResponseApi> getCardResponse() const override
+    {
+        return nullptr;
+    }
+
+private:
+    const std::string mPowerOnData;
+};
+
+static std::vector<uint8_t> statusWord(const int sw)
+{
+    return std::vector<uint8_t>({static_cast<uint8_t>(sw >> 8), static_cast<uint8_t>(sw)});
+}
+
+static std::vector<uint8_t>& appendStatusWord(std::vector<uint8_t>& response, const int sw)
+{
+    response.push_back(static_cast<uint8_t>(sw >> 8));
+    response.push_back(static_cast<uint8_t>(sw));
+
+    return response;
+}
+
+static const std::vector<uint8_t> getDataIn(const std::vector<uint8_t>& apdu)
+{
+    if (apdu.size() <= 5) {
+        return std::vector<uint8_t>();
+    }
+
+    const size_t lc = std::min(static_cast<size_t>(apdu[4]), apdu.size() - 5);
+
+    return std::vector<uint8_t>(apdu.begin() + 5, apdu.begin() + 5 + lc);
+}
+
+SoftwareSamReader::SoftwareSamReader(const std::string& name,
+                                     const std::vector<uint8_t>& serialNumber)
+: mName(name),
+  mSerialNumber(serialNumber),
+  mTransactionNumber(0),
+  mIsLogicalChannelOpen(false),
+  mRandom(0x9E3779B9),
+  mApduCount(0)
+{
+    if (serialNumber.size() != 4) {
+        throw IllegalArgumentException("Bad SAM serial number length.");
+    }
+
+    /* SAM C1: platform 00h, application type 80h, subtype C1h, issuer 20h, version 00h, 00h */
+    mPowerOnData = "3B3F9600805A0080C1200000" + ByteArrayUtil::toHex(serialNumber) + "829000";
+}
+
+const std::shared_ptr<CardSelectionResponseApi> SoftwareSamReader::getCardSelectionResponse() const
+{
+    return std::make_shared<SoftwareSamSelectionResponse>(mPowerOnData);
+}
+
+long SoftwareSamReader::getApduCount() const
+{
+    return mApduCount;
+}
+
+const std::string& SoftwareSamReader::getName() const
+{
+    return mName;
+}
+
+bool SoftwareSamReader::isContactless()
+{
+    return false;
+}
+
+bool SoftwareSamReader::isCardPresent()
+{
+    return true;
+}
+
+const std::shared_ptr<CardResponseApi> SoftwareSamReader::transmitCardRequest(
+    const std::shared_ptr<CardRequestSpi> cardRequest,
+    const ChannelControl channelControl)
+{
+    mIsLogicalChannelOpen = true;
+
+    std::vector<std::shared_ptr<ApduResponseApi>> apduResponses;
+    apduResponses.reserve(cardRequest->getApduRequests().size());
+
+    for (const auto& apduRequest : cardRequest->getApduRequests()) {
+        const auto apduResponse =
+            std::make_shared<ApduResponseAdapterMock>(processApdu(apduRequest->getApdu()));
+        apduResponses.push_back(apduResponse);
+
+        const std::vector<int>& successfulStatusWords = apduRequest->getSuccessfulStatusWords();
+        if (cardRequest->stopOnUnsuccessfulStatusWord() &&
+            std::find(successfulStatusWords.begin(),
+                      successfulStatusWords.end(),
+                      apduResponse->getStatusWord()) == successfulStatusWords.end()) {
+            throw UnexpectedStatusWordException(
+                      "Unexpected status word.",
+                      std::make_shared<CardResponseAdapterMock>(apduResponses,
+                                                                mIsLogicalChannelOpen));
+        }
+    }
+
+    if (channelControl == ChannelControl::CLOSE_AFTER) {
+        releaseChannel();
+    }
+
+    return std::make_shared<CardResponseAdapterMock>(apduResponses, mIsLogicalChannelOpen);
+}
+
+void SoftwareSamReader::releaseChannel()
+{
+    mIsLogicalChannelOpen = false;
+}
+
+const std::vector<uint8_t> SoftwareSamReader::processApdu(const std::vector<uint8_t>& apdu)
+{
+    mApduCount++;
+
+    if (apdu.size() < 4) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    switch (apdu[1]) {
+    case INS_SELECT_DIVERSIFIER:
+        return processSelectDiversifier(apdu);
+    case INS_GET_CHALLENGE:
+        return processGetChallenge(apdu);
+    case INS_DIGEST_INIT:
+        return processDigestInit(apdu);
+    case INS_DIGEST_UPDATE:
+        return processDigestUpdate(apdu);
+    case INS_DIGEST_CLOSE:
+        return processDigestClose(apdu);
+    case INS_DIGEST_AUTHENTICATE:
+        return processDigestAuthenticate(apdu);
+    case INS_GIVE_RANDOM:
+        return processGiveRandom(apdu);
+    case INS_CARD_CIPHER_PIN:
+        return processCardCipherPin(apdu);
+    case INS_SV_PREPARE_LOAD:
+    case INS_SV_PREPARE_DEBIT:
+    case INS_SV_PREPARE_UNDEBIT:
+        return processSvPrepare(apdu);
+    case INS_SV_CHECK:
+        return processSvCheck(apdu);
+    default:
+        return statusWord(SW_INS_NOT_SUPPORTED);
+    }
+}
+
+const std::vector<uint8_t> SoftwareSamReader::processSelectDiversifier(
+    const std::vector<uint8_t>& apdu)
+{
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+
+    if (dataIn.size() != 4 && dataIn.size() != 8) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    mDiversifier = dataIn;
+
+    return statusWord(SW_SUCCESS);
+}
+
+const std::vector<uint8_t> SoftwareSamReader::processGetChallenge(const std::vector<uint8_t>& apdu)
+{
+    if (apdu.size() != 5 || (apdu[4] != 4 && apdu[4] != 8)) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    std::vector<uint8_t> response(apdu[4]);
+    for (auto& b : response) {
+        b = nextRandom();
+    }
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> SoftwareSamReader::processDigestInit(const std::vector<uint8_t>& apdu)
+{
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+
+    /* KIF and KVC in incoming data, followed by the Open Secure Session response */
+    if (apdu[3] != 0xFF) {
+        return statusWord(SW_INCORRECT_P1_P2);
+    }
+
+    if (dataIn.size() < 3) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    if (mDiversifier.empty()) {
+        return statusWord(SW_CONDITIONS_NOT_SATISFIED);
+    }
+
+    mDigest.reset(new VirtualSignature(mDiversifier, dataIn[0], dataIn[1]));
+    mDigest->update(std::vector<uint8_t>(dataIn.begin() + 2, dataIn.end()));
+    mTerminalSignature.clear();
+
+    return statusWord(SW_SUCCESS);
+}
+
+const std::vector<uint8_t> SoftwareSamReader::processDigestUpdate(const std::vector<uint8_t>& apdu)
+{
+    if (mDigest == nullptr || !mTerminalSignature.empty()) {
+        return statusWord(SW_CONDITIONS_NOT_SATISFIED);
+    }
+
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+
+    if (dataIn.empty()) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    if (apdu[2] != DIGEST_UPDATE_MULTIPLE_P1) {
+        mDigest->update(dataIn);
+        return statusWord(SW_SUCCESS);
+    }
+
+    /* Sequence of length-prefixed blocks */
+    size_t offset = 0;
+    while (offset < dataIn.size()) {
+        const size_t length = dataIn[offset++];
+        if (length == 0 || offset + length > dataIn.size()) {
+            return statusWord(SW_INCORRECT_DATA);
+        }
+
+        mDigest->update(std::vector<uint8_t>(dataIn.begin() + offset,
+                                             dataIn.begin() + offset + length));
+        offset += length;
+    }
+
+    return statusWord(SW_SUCCESS);
+}
+
+const std::vector<uint8_t> SoftwareSamReader::processDigestClose(const std::vector<uint8_t>& apdu)
+{
+    if (apdu.size() != 5 || (apdu[4] != 4 && apdu[4] != 8)) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    if (mDigest == nullptr) {
+        return statusWord(SW_CONDITIONS_NOT_SATISFIED);
+    }
+
+    mTerminalSignature = mDigest->getTerminalSignature(apdu[4]);
+
+    std::vector<uint8_t> response = mTerminalSignature;
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> SoftwareSamReader::processDigestAuthenticate(
+    const std::vector<uint8_t>& apdu)
+{
+    if (mDigest == nullptr || mTerminalSignature.empty()) {
+        return statusWord(SW_CONDITIONS_NOT_SATISFIED);
+    }
+
+    const std::vector<uint8_t> cardSignature = getDataIn(apdu);
+    const bool isAuthentic = cardSignature == mDigest->getCardSignature(mTerminalSignature);
+
+    /* The session is over, whatever the result */
+    mDigest.reset();
+    mTerminalSignature.clear();
+
+    return statusWord(isAuthentic ? SW_SUCCESS : SW_INCORRECT_SIGNATURE);
+}
+
+const std::vector<uint8_t> SoftwareSamReader::processGiveRandom(const std::vector<uint8_t>& apdu)
+{
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+
+    if (dataIn.size() != CARD_CHALLENGE_LENGTH) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    mCardChallenge = dataIn;
+
+    return statusWord(SW_SUCCESS);
+}
+
+const std::vector<uint8_t> SoftwareSamReader::processCardCipherPin(const std::vector<uint8_t>& apdu)
+{
+    /* PIN verification only, with KIF and KVC in incoming data */
+    if (apdu[2] != CARD_CIPHER_PIN_VERIFY_P1 || apdu[3] != 0xFF) {
+        return statusWord(SW_INCORRECT_P1_P2);
+    }
+
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+
+    if (dataIn.size() != 6) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    if (mDiversifier.empty() || mCardChallenge.empty()) {
+        return statusWord(SW_CONDITIONS_NOT_SATISFIED);
+    }
+
+    std::vector<uint8_t> response =
+        VirtualSignature::computeCipheredPin(mDiversifier,
+                                             dataIn[0],
+                                             dataIn[1],
+                                             mCardChallenge,
+                                             std::vector<uint8_t>(dataIn.begin() + 2,
+                                                                  dataIn.end()));
+
+    /* The card challenge can be used only once */
+    mCardChallenge.clear();
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> SoftwareSamReader::processSvPrepare(const std::vector<uint8_t>& apdu)
+{
+    if (apdu[2] != 0x01 || apdu[3] != 0xFF) {
+        return statusWord(SW_INCORRECT_P1_P2);
+    }
+
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+    const size_t buildDataLength = apdu[1] == INS_SV_PREPARE_LOAD ?
+                                       SV_LOAD_BUILD_DATA_LENGTH :
+                                       SV_DEBIT_BUILD_DATA_LENGTH;
+
+    /* SV Get header, SV Get response (KVC first, status word included), SV command build data */
+    if (dataIn.size() < SV_GET_HEADER_LENGTH + 3 + buildDataLength) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    if (mDiversifier.empty()) {
+        return statusWord(SW_CONDITIONS_NOT_SATISFIED);
+    }
+
+    const auto svGetDataBegin = dataIn.begin() + SV_GET_HEADER_LENGTH;
+    const auto buildDataBegin = dataIn.end() - buildDataLength;
+
+    const std::vector<uint8_t> svGetHeader(dataIn.begin(), svGetDataBegin);
+    const std::vector<uint8_t> svGetData(svGetDataBegin, buildDataBegin);
+    const uint8_t kvc = svGetData[0];
+
+    /* INS, Lc and the fixed part of the command data in, its first byte excluded */
+    std::vector<uint8_t> svCommandData = {buildDataBegin[0], buildDataBegin[3]};
+    svCommandData.insert(svCommandData.end(), buildDataBegin + 5, dataIn.end());
+
+    mTransactionNumber = (mTransactionNumber + 1) & 0xFFFFFF;
+    const std::vector<uint8_t> samTNum = {static_cast<uint8_t>(mTransactionNumber >> 16),
+                                          static_cast<uint8_t>(mTransactionNumber >> 8),
+                                          static_cast<uint8_t>(mTransactionNumber)};
+
+    const std::vector<uint8_t> signatureHi =
+        VirtualSignature::computeSvSignatureHi(mDiversifier,
+                                               kvc,
+                                               svGetHeader,
+                                               svGetData,
+                                               svCommandData,
+                                               mSerialNumber,
+                                               samTNum);
+
+    mSvSignatureLo = VirtualSignature::computeSvSignatureLo(mDiversifier, kvc, signatureHi);
+
+    /* P1, P2 and first byte of the card command data in, SAM TNum, signatureHi */
+    std::vector<uint8_t> response = {nextRandom(), nextRandom(), nextRandom()};
+    response.insert(response.end(), samTNum.begin(), samTNum.end());
+    response.insert(response.end(), signatureHi.begin(), signatureHi.end());
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> SoftwareSamReader::processSvCheck(const std::vector<uint8_t>& apdu)
+{
+    if (mSvSignatureLo.empty()) {
+        return statusWord(SW_CONDITIONS_NOT_SATISFIED);
+    }
+
+    const std::vector<uint8_t> signatureLo = getDataIn(apdu);
+    const std::vector<uint8_t> expectedSignatureLo = mSvSignatureLo;
+
+    mSvSignatureLo.clear();
+
+    /* No data: the SV operation is cancelled */
+    if (signatureLo.empty()) {
+        return statusWord(SW_SUCCESS);
+    }
+
+    return statusWord(signatureLo == expectedSignatureLo ? SW_SUCCESS : SW_INCORRECT_SIGNATURE);
+}
+
+uint8_t SoftwareSamReader::nextRandom()
+{
+    /* xorshift32 */
+    mRandom ^= mRandom << 13;
+    mRandom ^= mRandom >> 17;
+    mRandom ^= mRandom << 5;
+
+    return static_cast<uint8_t>(mRandom);
+}
@@ -0,0 +1,221 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Calypsonet Terminal Card */
+#include "CardRequestSpi.h"
+#include "CardResponseApi.h"
+#include "CardSelectionResponseApi.h"
+#include "ChannelControl.h"
+#include "ProxyReaderApi.h"
+
+/* Calypsonet Terminal Reader */
+#include "CardReader.h"
+
+/* Benchmark */
+#include "VirtualSignature.h"
+
+using namespace calypsonet::terminal::card;
+using namespace calypsonet::terminal::card::spi;
+using namespace calypsonet::terminal::reader;
+
+/**
+ * Reader holding a software SAM C1 holding the test keys of VirtualSignature.
+ *
+ * <p>The SAM answers the commands used by SamCommandProcessor in a secure session: Select
+ * Diversifier, Get Challenge, Digest Init/Update/Update Multiple/Close, Digest Authenticate, SV
+ * Prepare Load/Debit/Undebit, SV Check, Give Random and Card Cipher PIN. Any other instruction is
+ * answered with 6D00h.
+ *
+ * <p>Together with a VirtualCardReader, it lets a whole secure session (opening, modifications,
+ * SV operation, closing and mutual authentication) run locally, without any hardware.
+ *
+ * <p>Not thread safe: a reader serves a single transaction at a time.
+ */
+class SoftwareSamReader final : public CardReader, public ProxyReaderApi {
+public:
+    /**
+     * Creates a reader holding a SAM C1.
+     *
+     * @param name The reader name.
+     * @param serialNumber The SAM serial number (4 bytes).
+     * @throw IllegalArgumentException If the serial number is invalid.
+     */
+    SoftwareSamReader(const std::string& name, const std::vector<uint8_t>& serialNumber);
+
+    /**
+     * Gets the selection response of the SAM (its ATR), to be used to create a CalypsoSamAdapter.
+     *
+     * @return A not null reference.
+     */
+    const std::shared_ptr<CardSelectionResponseApi> getCardSelectionResponse() const;
+
+    /**
+     *
+     * @return The number of APDUs processed by the SAM since the creation of the reader.
+     */
+    long getApduCount() const;
+
+    /**
+     * {@inheritDoc}
+     */
+    const std::string& getName() const override;
+
+    /**
+     * {@inheritDoc}
+     */
+    bool isContactless() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    bool isCardPresent() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    const std::shared_ptr<CardResponseApi> transmitCardRequest(
+        const std::shared_ptr<CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override;
+
+    /**
+     * {@inheritDoc}
+     */
+    void releaseChannel() override;
+
+private:
+    /**
+     *
+     */
+    const std::string mName;
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> mSerialNumber;
+
+    /**
+     * ATR, as a hex string.
+     */
+    std::string mPowerOnData;
+
+    /**
+     * Card serial number provided by Select Diversifier, empty if none.
+     */
+    std::vector<uint8_t> mDiversifier;
+
+    /**
+     * Digest of the ongoing session, null if no session is open.
+     */
+    std::unique_ptr<VirtualSignature> mDigest;
+
+    /**
+     * Signature returned by Digest Close, empty if not computed yet.
+     */
+    std::vector<uint8_t> mTerminalSignature;
+
+    /**
+     * Challenge provided by Give Random, empty once used.
+     */
+    std::vector<uint8_t> mCardChallenge;
+
+    /**
+     * SV signature expected from the card by SV Check, empty if no SV operation is pending.
+     */
+    std::vector<uint8_t> mSvSignatureLo;
+
+    /**
+     * Transaction number, incremented at each SV Prepare.
+     */
+    int mTransactionNumber;
+
+    /**
+     *
+     */
+    bool mIsLogicalChannelOpen;
+
+    /**
+     * State of the pseudo-random generator of the challenges (deterministic runs).
+     */
+    uint32_t mRandom;
+
+    /**
+     *
+     */
+    long mApduCount;
+
+    /**
+     * Processes an APDU and returns the response APDU (status word included).
+     */
+    const std::vector<uint8_t> processApdu(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processSelectDiversifier(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processGetChallenge(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processDigestInit(const std::vector<uint8_t>& apdu);
+
+    /**
+     * Digest Update (one block) and Digest Update Multiple (length-prefixed blocks).
+     */
+    const std::vector<uint8_t> processDigestUpdate(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processDigestClose(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processDigestAuthenticate(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processGiveRandom(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processCardCipherPin(const std::vector<uint8_t>& apdu);
+
+    /**
+     * SV Prepare Load, Debit and Undebit.
+     */
+    const std::vector<uint8_t> processSvPrepare(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processSvCheck(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    uint8_t nextRandom();
+};
@@ -0,0 +1,60 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "UncountedReader.h"
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+/* Benchmark */
+#include "Benchmark.h"
+
+using namespace keyple::core::util::cpp::exception;
+
+UncountedReader::UncountedReader(const std::shared_ptr<CardReader> reader)
+: mReader(reader), mProxyReader(std::dynamic_pointer_cast<ProxyReaderApi>(reader))
+{
+    if (mProxyReader == nullptr) {
+        throw IllegalArgumentException("The reader must implement ProxyReaderApi.");
+    }
+}
+
+const std::string& UncountedReader::getName() const
+{
+    return mReader->getName();
+}
+
+bool UncountedReader::isContactless()
+{
+    return mReader->isContactless();
+}
+
+bool UncountedReader::isCardPresent()
+{
+    return mReader->isCardPresent();
+}
+
+const std::shared_ptr<CardResponseApi> UncountedReader::transmitCardRequest(
+    const std::shared_ptr<CardRequestSpi> cardRequest,
+    const ChannelControl channelControl)
+{
+    const AllocationCountPause pause;
+
+    return mProxyReader->transmitCardRequest(cardRequest, channelControl);
+}
+
+void UncountedReader::releaseChannel()
+{
+    const AllocationCountPause pause;
+
+    mProxyReader->releaseChannel();
+}
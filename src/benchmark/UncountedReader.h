@@ -0,0 +1,86 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+/* Calypsonet Terminal Card */
+#include "CardRequestSpi.h"
+#include "CardResponseApi.h"
+#include "ChannelControl.h"
+#include "ProxyReaderApi.h"
+
+/* Calypsonet Terminal Reader */
+#include "CardReader.h"
+
+using namespace calypsonet::terminal::card;
+using namespace calypsonet::terminal::card::spi;
+using namespace calypsonet::terminal::reader;
+
+/**
+ * Reader decorator excluding the heap allocations of the decorated reader from the allocation
+ * count of the benchmarks (see AllocationCountPause).
+ *
+ * <p>Decorate the simulated card and SAM readers, and their latency, recording or replay
+ * decorators, with it so that the "allocs" counter reports the allocations of the library only.
+ *
+ * <p>Thread safe if the decorated reader is.
+ */
+class UncountedReader final : public CardReader, public ProxyReaderApi {
+public:
+    /**
+     *
+     * @param reader The decorated reader, implementing ProxyReaderApi.
+     * @throw IllegalArgumentException If the reader does not implement ProxyReaderApi.
+     */
+    explicit UncountedReader(const std::shared_ptr<CardReader> reader);
+
+    /**
+     * {@inheritDoc}
+     */
+    const std::string& getName() const override;
+
+    /**
+     * {@inheritDoc}
+     */
+    bool isContactless() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    bool isCardPresent() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    const std::shared_ptr<CardResponseApi> transmitCardRequest(
+        const std::shared_ptr<CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override;
+
+    /**
+     * {@inheritDoc}
+     */
+    void releaseChannel() override;
+
+private:
+    /**
+     *
+     */
+    const std::shared_ptr<CardReader> mReader;
+
+    /**
+     *
+     */
+    const std::shared_ptr<ProxyReaderApi> mProxyReader;
+};
@@ -0,0 +1,1222 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "VirtualCardReader.h"
+
+#include <algorithm>
+
+/* Calypsonet Terminal Card */
+#include "UnexpectedStatusWordException.h"
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+/* Keyple Card Calypso */
+#include "CalypsoCardAdapter.h"
+#include "CalypsoCardConstant.h"
+
+/* Mock */
+#include "ApduResponseAdapterMock.h"
+#include "CardResponseAdapterMock.h"
+
+using namespace keyple::card::calypso;
+using namespace keyple::core::util::cpp::exception;
+
+/* Instruction bytes */
+static const uint8_t INS_VERIFY_PIN = 0x20;
+static const uint8_t INS_DECREASE = 0x30;
+static const uint8_t INS_INCREASE = 0x32;
+static const uint8_t INS_DECREASE_MULTIPLE = 0x38;
+static const uint8_t INS_INCREASE_MULTIPLE = 0x3A;
+static const uint8_t INS_SV_GET = 0x7C;
+static const uint8_t INS_GET_CHALLENGE = 0x84;
+static const uint8_t INS_OPEN_SESSION = 0x8A;
+static const uint8_t INS_CLOSE_SESSION = 0x8E;
+static const uint8_t INS_SEARCH_RECORD_MULTIPLE = 0xA2;
+static const uint8_t INS_SELECT_FILE = 0xA4;
+static const uint8_t INS_READ_RECORDS = 0xB2;
+static const uint8_t INS_SV_RELOAD = 0xB8;
+static const uint8_t INS_SV_DEBIT = 0xBA;
+static const uint8_t INS_SV_UNDEBIT = 0xBC;
+static const uint8_t INS_GET_DATA = 0xCA;
+static const uint8_t INS_WRITE_RECORD = 0xD2;
+static const uint8_t INS_UPDATE_RECORD = 0xDC;
+static const uint8_t INS_APPEND_RECORD = 0xE2;
+
+/* Status words */
+static const int SW_SUCCESS = 0x9000;
+static const int SW_INCORRECT_PIN = 0x63C0;
+static const int SW_SESSION_BUFFER_OVERFLOW = 0x6400;
+static const int SW_WRONG_LENGTH = 0x6700;
+static const int SW_COUNTER_EXHAUSTED = 0x6900;
+static const int SW_INCOMPATIBLE_FILE = 0x6981;
+static const int SW_CHALLENGE_UNAVAILABLE = 0x6982;
+static const int SW_PIN_BLOCKED = 0x6983;
+static const int SW_CONDITIONS_NOT_SATISFIED = 0x6985;
+static const int SW_INCORRECT_SIGNATURE = 0x6988;
+static const int SW_INCORRECT_DATA = 0x6A80;
+static const int SW_INCORRECT_P1_P2 = 0x6A81;
+static const int SW_FILE_NOT_FOUND = 0x6A82;
+static const int SW_RECORD_NOT_FOUND = 0x6A83;
+static const int SW_DATA_NOT_FOUND = 0x6A88;
+static const int SW_WRONG_P1_P2 = 0x6B00;
+static const int SW_INS_NOT_SUPPORTED = 0x6D00;
+
+static const uint16_t DF_LID = 0x3F00;
+static const int SV_GET_RELOAD = 0x07;
+static const int SV_GET_DEBIT = 0x09;
+static const int SV_LOAD_LOG_LENGTH = 22;
+static const int SV_DEBIT_LOG_LENGTH = 19;
+static const int SV_SIGNATURE_HI_LENGTH = 5;
+static const int SESSION_SIGNATURE_LENGTH = 4;
+static const int SESSION_BUFFER_CMD_ADDITIONAL_COST = 6;
+static const int PIN_LENGTH = 4;
+static const int PIN_CIPHERED_LENGTH = 8;
+static const int PIN_MAX_ATTEMPTS = 3;
+static const int CHALLENGE_LENGTH = 8;
+
+static std::vector<uint8_t> statusWord(const int sw)
+{
+    return std::vector<uint8_t>({static_cast<uint8_t>(sw >> 8), static_cast<uint8_t>(sw)});
+}
+
+static std::vector<uint8_t>& appendStatusWord(std::vector<uint8_t>& response, const int sw)
+{
+    response.push_back(static_cast<uint8_t>(sw >> 8));
+    response.push_back(static_cast<uint8_t>(sw));
+
+    return response;
+}
+
+static const std::vector<uint8_t> getDataIn(const std::vector<uint8_t>& apdu)
+{
+    if (apdu.size() <= 5) {
+        return std::vector<uint8_t>();
+    }
+
+    const size_t lc = std::min(static_cast<size_t>(apdu[4]), apdu.size() - 5);
+
+    return std::vector<uint8_t>(apdu.begin() + 5, apdu.begin() + 5 + lc);
+}
+
+static bool isCase4(const std::vector<uint8_t>& apdu)
+{
+    return apdu.size() > 5 && apdu[4] == apdu.size() - 6;
+}
+
+static int getUnsigned(const std::vector<uint8_t>& bytes, const int offset, const int length)
+{
+    int value = 0;
+    for (int i = 0; i < length; i++) {
+        value = (value << 8) | bytes[offset + i];
+    }
+
+    return value;
+}
+
+static int getSigned(const std::vector<uint8_t>& bytes, const int offset, const int length)
+{
+    const int value = getUnsigned(bytes, offset, length);
+    const int sign = 1 << (8 * length - 1);
+
+    return (value ^ sign) - sign;
+}
+
+static void setUnsigned(std::vector<uint8_t>& bytes,
+                        const int offset,
+                        const int length,
+                        const int value)
+{
+    for (int i = 0; i < length; i++) {
+        bytes[offset + i] = static_cast<uint8_t>(value >> (8 * (length - 1 - i)));
+    }
+}
+
+VirtualCardReader::VirtualCardReader(const std::string& name,
+                                     const std::vector<uint8_t>& dfName,
+                                     const std::vector<uint8_t>& serialNumber,
+                                     const std::vector<uint8_t>& startupInfo)
+: mName(name),
+  mSerialNumber(serialNumber),
+  mIsSvFeatureAvailable(false),
+  mIsPinFeatureAvailable(false),
+  mIsModificationsCounterInBytes(true),
+  mModificationsCounterMax(0),
+  mKifs{0x21, 0x27, 0x30},
+  mKvcs{0x79, 0x79, 0x79},
+  mCurrentSfi(0),
+  mSv({0x79,
+       0,
+       0,
+       std::vector<uint8_t>(3),
+       std::vector<uint8_t>(SV_LOAD_LOG_LENGTH),
+       std::vector<uint8_t>(SV_DEBIT_LOG_LENGTH)}),
+  mPin(PIN_LENGTH, 0x30),
+  mPinKif(0x30),
+  mPinKvc(0x79),
+  mPinAttemptCounter(PIN_MAX_ATTEMPTS),
+  mTransactionCounter(0xFFFFFF),
+  mIsLogicalChannelOpen(false),
+  mIsRatificationPending(false),
+  mModificationsCounter(0),
+  mRandom(0x2545F491),
+  mApduCount(0)
+{
+    if (dfName.size() < 5 || dfName.size() > 16 ||
+        serialNumber.size() != 8 ||
+        startupInfo.size() != 7) {
+        throw IllegalArgumentException("Bad DF name, serial number or startup info length.");
+    }
+
+    /* 6F L 84 L <DF name> A5 L BF0C L C7 08 <serial number> 53 07 <startup info> */
+    const uint8_t issuerDataLength = static_cast<uint8_t>(2 + serialNumber.size() +
+                                                          2 + startupInfo.size());
+    mFci = {0x6F,
+            static_cast<uint8_t>(2 + dfName.size() + 2 + 3 + issuerDataLength),
+            0x84,
+            static_cast<uint8_t>(dfName.size())};
+    mFci.insert(mFci.end(), dfName.begin(), dfName.end());
+    mFci.insert(mFci.end(), {0xA5, static_cast<uint8_t>(3 + issuerDataLength),
+                             0xBF, 0x0C, issuerDataLength,
+                             0xC7, static_cast<uint8_t>(serialNumber.size())});
+    mFci.insert(mFci.end(), serialNumber.begin(), serialNumber.end());
+    mFci.insert(mFci.end(), {0x53, static_cast<uint8_t>(startupInfo.size())});
+    mFci.insert(mFci.end(), startupInfo.begin(), startupInfo.end());
+    appendStatusWord(mFci, SW_SUCCESS);
+
+    /* The card features are those seen by the library */
+    auto calypsoCard = std::make_shared<CalypsoCardAdapter>();
+    calypsoCard->initializeWithFci(getSelectApplicationResponse());
+
+    if (calypsoCard->getProductType() != CalypsoCard::ProductType::PRIME_REVISION_3 ||
+        calypsoCard->isExtendedModeSupported()) {
+        throw IllegalArgumentException("Only Prime revision 3 cards in compatibility mode are " \
+                                       "supported.");
+    }
+
+    mIsSvFeatureAvailable = calypsoCard->isSvFeatureAvailable();
+    mIsPinFeatureAvailable = calypsoCard->isPinFeatureAvailable();
+    mIsModificationsCounterInBytes = calypsoCard->isModificationsCounterInBytes();
+    mModificationsCounterMax = calypsoCard->getModificationsCounter();
+}
+
+const std::shared_ptr<ApduResponseApi> VirtualCardReader::getSelectApplicationResponse() const
+{
+    return std::make_shared<ApduResponseAdapterMock>(mFci);
+}
+
+void VirtualCardReader::setSessionKey(const uint8_t keyIndex, const uint8_t kif, const uint8_t kvc)
+{
+    if (keyIndex < 1 || keyIndex > 3) {
+        throw IllegalArgumentException("Bad key index: " + std::to_string(keyIndex));
+    }
+
+    mKifs[keyIndex - 1] = kif;
+    mKvcs[keyIndex - 1] = kvc;
+}
+
+void VirtualCardReader::createFile(const uint8_t sfi,
+                                   const uint16_t lid,
+                                   const ElementaryFile::Type type,
+                                   const int recordsNumber,
+                                   const int recordSize)
+{
+    if (sfi < 1 || sfi > 30 || type == ElementaryFile::Type::BINARY ||
+        recordsNumber < 1 || recordsNumber > 255 || recordSize < 1 || recordSize > 255) {
+        throw IllegalArgumentException("Bad file definition, SFI: " + std::to_string(sfi));
+    }
+
+    const bool isCounters = type == ElementaryFile::Type::COUNTERS ||
+                            type == ElementaryFile::Type::SIMULATED_COUNTERS;
+
+    VirtualFile& file = mFiles[sfi];
+    file.lid = lid;
+    file.type = type;
+    file.recordSize = recordSize;
+    file.records.assign(isCounters ? 1 : recordsNumber, std::vector<uint8_t>(recordSize));
+}
+
+void VirtualCardReader::setRecord(const uint8_t sfi,
+                                  const int recordNumber,
+                                  const std::vector<uint8_t>& content)
+{
+    VirtualFile& file = mFiles.at(sfi);
+
+    if (recordNumber < 1 || recordNumber > static_cast<int>(file.records.size()) ||
+        static_cast<int>(content.size()) > file.recordSize) {
+        throw IllegalArgumentException("Bad record, SFI: " + std::to_string(sfi));
+    }
+
+    std::vector<uint8_t>& record = file.records[recordNumber - 1];
+    std::fill(std::copy(content.begin(), content.end(), record.begin()), record.end(), 0);
+}
+
+const std::vector<uint8_t>& VirtualCardReader::getRecord(const uint8_t sfi,
+                                                         const int recordNumber) const
+{
+    return mFiles.at(sfi).records.at(recordNumber - 1);
+}
+
+void VirtualCardReader::setSv(const int balance, const uint8_t kvc)
+{
+    mSv.balance = balance;
+    mSv.kvc = kvc;
+}
+
+int VirtualCardReader::getSvBalance() const
+{
+    return mSv.balance;
+}
+
+void VirtualCardReader::setPin(const std::vector<uint8_t>& pin,
+                               const uint8_t kif,
+                               const uint8_t kvc)
+{
+    if (pin.size() != PIN_LENGTH) {
+        throw IllegalArgumentException("Bad PIN length.");
+    }
+
+    mPin = pin;
+    mPinKif = kif;
+    mPinKvc = kvc;
+    mPinAttemptCounter = PIN_MAX_ATTEMPTS;
+}
+
+int VirtualCardReader::getPinAttemptCounter() const
+{
+    return mPinAttemptCounter;
+}
+
+void VirtualCardReader::setTransactionCounter(const int transactionCounter)
+{
+    mTransactionCounter = transactionCounter;
+}
+
+int VirtualCardReader::getTransactionCounter() const
+{
+    return mTransactionCounter;
+}
+
+long VirtualCardReader::getApduCount() const
+{
+    return mApduCount;
+}
+
+const std::string& VirtualCardReader::getName() const
+{
+    return mName;
+}
+
+bool VirtualCardReader::isContactless()
+{
+    return true;
+}
+
+bool VirtualCardReader::isCardPresent()
+{
+    return true;
+}
+
+const std::shared_ptr<CardResponseApi> VirtualCardReader::transmitCardRequest(
+    const std::shared_ptr<CardRequestSpi> cardRequest,
+    const ChannelControl channelControl)
+{
+    if (!mIsLogicalChannelOpen) {
+        /* Implicit selection of the application */
+        mIsLogicalChannelOpen = true;
+        mCurrentSfi = 0;
+    }
+
+    std::vector<std::shared_ptr<ApduResponseApi>> apduResponses;
+    apduResponses.reserve(cardRequest->getApduRequests().size());
+
+    for (const auto& apduRequest : cardRequest->getApduRequests()) {
+        const auto apduResponse =
+            std::make_shared<ApduResponseAdapterMock>(processApdu(apduRequest->getApdu()));
+        apduResponses.push_back(apduResponse);
+
+        const std::vector<int>& successfulStatusWords = apduRequest->getSuccessfulStatusWords();
+        if (cardRequest->stopOnUnsuccessfulStatusWord() &&
+            std::find(successfulStatusWords.begin(),
+                      successfulStatusWords.end(),
+                      apduResponse->getStatusWord()) == successfulStatusWords.end()) {
+            throw UnexpectedStatusWordException(
+                      "Unexpected status word.",
+                      std::make_shared<CardResponseAdapterMock>(apduResponses,
+                                                                mIsLogicalChannelOpen));
+        }
+    }
+
+    if (channelControl == ChannelControl::CLOSE_AFTER) {
+        releaseChannel();
+    }
+
+    return std::make_shared<CardResponseAdapterMock>(apduResponses, mIsLogicalChannelOpen);
+}
+
+void VirtualCardReader::releaseChannel()
+{
+    if (mSessionDigest != nullptr) {
+        abortSession();
+    }
+
+    mIsLogicalChannelOpen = false;
+}
+
+const std::vector<uint8_t> VirtualCardReader::processApdu(const std::vector<uint8_t>& apdu)
+{
+    mApduCount++;
+
+    if (apdu.size() < 4) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    const uint8_t ins = apdu[1];
+
+    /* Any command but Open Secure Session ratifies the previous session */
+    if (ins != INS_OPEN_SESSION) {
+        mIsRatificationPending = false;
+    }
+
+    const bool isDigested =
+        mSessionDigest != nullptr && ins != INS_OPEN_SESSION && ins != INS_CLOSE_SESSION;
+
+    std::vector<uint8_t> response;
+
+    switch (ins) {
+    case INS_GET_DATA:
+        response = processGetData(apdu);
+        break;
+    case INS_SELECT_FILE:
+        response = processSelectFile(apdu);
+        break;
+    case INS_OPEN_SESSION:
+        response = processOpenSession(apdu);
+        break;
+    case INS_CLOSE_SESSION:
+        response = processCloseSession(apdu);
+        break;
+    case INS_READ_RECORDS:
+        response = processReadRecords(apdu);
+        break;
+    case INS_UPDATE_RECORD:
+    case INS_WRITE_RECORD:
+        response = processUpdateOrWriteRecord(apdu);
+        break;
+    case INS_APPEND_RECORD:
+        response = processAppendRecord(apdu);
+        break;
+    case INS_INCREASE:
+    case INS_DECREASE:
+        response = processIncreaseOrDecrease(apdu);
+        break;
+    case INS_INCREASE_MULTIPLE:
+    case INS_DECREASE_MULTIPLE:
+        response = processIncreaseOrDecreaseMultiple(apdu);
+        break;
+    case INS_SEARCH_RECORD_MULTIPLE:
+        response = processSearchRecordMultiple(apdu);
+        break;
+    case INS_SV_GET:
+        response = processSvGet(apdu);
+        break;
+    case INS_SV_RELOAD:
+    case INS_SV_DEBIT:
+    case INS_SV_UNDEBIT:
+        response = processSvOperation(apdu);
+        break;
+    case INS_GET_CHALLENGE:
+        response = processGetChallenge(apdu);
+        break;
+    case INS_VERIFY_PIN:
+        response = processVerifyPin(apdu);
+        break;
+    default:
+        response = statusWord(SW_INS_NOT_SUPPORTED);
+    }
+
+    /* Same digest data as the one provided to the SAM, Le excluded (CL-C4-MAC.1) */
+    if (isDigested) {
+        mSessionDigest->update(
+            isCase4(apdu) ? std::vector<uint8_t>(apdu.begin(), apdu.end() - 1) : apdu);
+        mSessionDigest->update(response);
+    }
+
+    return response;
+}
+
+const std::vector<uint8_t> VirtualCardReader::processGetData(const std::vector<uint8_t>& apdu)
+    const
+{
+    const int tag = (apdu[2] << 8) | apdu[3];
+
+    if (tag == 0x006F) {
+        return mFci;
+    }
+
+    if (tag == 0x0062) {
+        std::vector<uint8_t> response = buildFcp(mCurrentSfi);
+        return appendStatusWord(response, SW_SUCCESS);
+    }
+
+    return statusWord(SW_DATA_NOT_FOUND);
+}
+
+const std::vector<uint8_t> VirtualCardReader::processSelectFile(const std::vector<uint8_t>& apdu)
+{
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+    if (dataIn.size() != 2) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    const uint8_t p1 = apdu[2];
+    const uint8_t p2 = apdu[3];
+
+    auto it = mFiles.end();
+
+    if (p1 == 0x02 && p2 == 0x00) {
+        /* First EF */
+        it = mFiles.begin();
+    } else if (p1 == 0x02 && p2 == 0x02) {
+        /* Next EF */
+        it = mFiles.upper_bound(mCurrentSfi);
+    } else {
+        const uint16_t lid = static_cast<uint16_t>((dataIn[0] << 8) | dataIn[1]);
+
+        if (lid == 0x0000 || lid == DF_LID) {
+            mCurrentSfi = 0;
+            std::vector<uint8_t> response = buildFcp(0);
+            return appendStatusWord(response, SW_SUCCESS);
+        }
+
+        for (it = mFiles.begin(); it != mFiles.end() && it->second.lid != lid; ++it) {}
+    }
+
+    if (it == mFiles.end()) {
+        return statusWord(SW_FILE_NOT_FOUND);
+    }
+
+    mCurrentSfi = it->first;
+    std::vector<uint8_t> response = buildFcp(mCurrentSfi);
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> VirtualCardReader::processOpenSession(const std::vector<uint8_t>& apdu)
+{
+    const uint8_t keyIndex = apdu[2] & 0x07;
+    const int recordNumber = apdu[2] >> 3;
+    const uint8_t sfi = apdu[3] >> 3;
+
+    /* Compatibility mode only (P2 b3..b1 = 001b) */
+    if ((apdu[3] & 0x07) != 0x01 || keyIndex < 1 || keyIndex > 3) {
+        return statusWord(SW_WRONG_P1_P2);
+    }
+
+    if (getDataIn(apdu).empty()) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    /* A new session cancels the ongoing one */
+    if (mSessionDigest != nullptr) {
+        abortSession();
+    }
+
+    if (mTransactionCounter == 0) {
+        return statusWord(SW_COUNTER_EXHAUSTED);
+    }
+
+    std::vector<uint8_t> recordData;
+    if (recordNumber != 0) {
+        const VirtualFile* file = selectFile(sfi);
+        if (file == nullptr) {
+            return statusWord(SW_FILE_NOT_FOUND);
+        }
+
+        if (recordNumber > static_cast<int>(file->records.size())) {
+            return statusWord(SW_RECORD_NOT_FOUND);
+        }
+
+        recordData = file->records[recordNumber - 1];
+    }
+
+    const uint8_t kif = mKifs[keyIndex - 1];
+    const uint8_t kvc = mKvcs[keyIndex - 1];
+
+    std::vector<uint8_t> response(8);
+    setUnsigned(response, 0, 3, mTransactionCounter);
+    response[3] = nextRandom();
+    response[4] = mIsRatificationPending ? 0x01 : 0x00;
+    response[5] = kif;
+    response[6] = kvc;
+    response[7] = static_cast<uint8_t>(recordData.size());
+    response.insert(response.end(), recordData.begin(), recordData.end());
+
+    mTransactionCounter--;
+    mIsRatificationPending = false;
+
+    mSessionDigest.reset(new VirtualSignature(mSerialNumber, kif, kvc));
+    mSessionDigest->update(response);
+    mModificationsCounter = mModificationsCounterMax;
+    mPostponedData.clear();
+    mFilesBackup = mFiles;
+    mSvBackup = mSv;
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> VirtualCardReader::processCloseSession(const std::vector<uint8_t>& apdu)
+{
+    if (mSessionDigest == nullptr) {
+        return statusWord(SW_CONDITIONS_NOT_SATISFIED);
+    }
+
+    const std::vector<uint8_t> terminalSignature = getDataIn(apdu);
+
+    if (terminalSignature.empty()) {
+        /* Abort */
+        abortSession();
+        return statusWord(SW_SUCCESS);
+    }
+
+    if (terminalSignature.size() != SESSION_SIGNATURE_LENGTH) {
+        abortSession();
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    if (terminalSignature != mSessionDigest->getTerminalSignature(SESSION_SIGNATURE_LENGTH)) {
+        abortSession();
+        return statusWord(SW_INCORRECT_SIGNATURE);
+    }
+
+    std::vector<uint8_t> response;
+    if (!mPostponedData.empty()) {
+        response.push_back(static_cast<uint8_t>(mPostponedData.size()));
+        response.insert(response.end(), mPostponedData.begin(), mPostponedData.end());
+    }
+
+    const std::vector<uint8_t> cardSignature = mSessionDigest->getCardSignature(terminalSignature);
+    response.insert(response.end(), cardSignature.begin(), cardSignature.end());
+
+    /* P1 = 00h: the session will be ratified by the next command */
+    mIsRatificationPending = (apdu[2] & 0x80) == 0;
+
+    mSessionDigest.reset();
+    mPostponedData.clear();
+    mFilesBackup.clear();
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> VirtualCardReader::processReadRecords(const std::vector<uint8_t>& apdu)
+{
+    const int recordNumber = apdu[2];
+    const uint8_t readMode = apdu[3] & 0x07;
+
+    if (readMode != 0x04 && readMode != 0x05) {
+        return statusWord(SW_WRONG_P1_P2);
+    }
+
+    const VirtualFile* file = selectFile(apdu[3] >> 3);
+    if (file == nullptr) {
+        return statusWord(SW_FILE_NOT_FOUND);
+    }
+
+    const int recordsNumber = static_cast<int>(file->records.size());
+    if (recordNumber == 0 || recordNumber > recordsNumber) {
+        return statusWord(SW_RECORD_NOT_FOUND);
+    }
+
+    std::vector<uint8_t> response;
+
+    if (readMode == 0x04) {
+        response = file->records[recordNumber - 1];
+    } else {
+        const int le = apdu.size() == 5 && apdu[4] != 0 ? apdu[4] : 256;
+
+        for (int i = recordNumber; i <= recordsNumber; i++) {
+            const std::vector<uint8_t>& record = file->records[i - 1];
+            if (i > recordNumber && response.size() + 2 + record.size() > static_cast<size_t>(le)) {
+                break;
+            }
+
+            response.push_back(static_cast<uint8_t>(i));
+            response.push_back(static_cast<uint8_t>(record.size()));
+            response.insert(response.end(), record.begin(), record.end());
+        }
+    }
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> VirtualCardReader::processUpdateOrWriteRecord(
+    const std::vector<uint8_t>& apdu)
+{
+    const int recordNumber = apdu[2];
+
+    if ((apdu[3] & 0x07) != 0x04) {
+        return statusWord(SW_WRONG_P1_P2);
+    }
+
+    VirtualFile* file = selectFile(apdu[3] >> 3);
+    if (file == nullptr) {
+        return statusWord(SW_FILE_NOT_FOUND);
+    }
+
+    if (recordNumber == 0 || recordNumber > static_cast<int>(file->records.size())) {
+        return statusWord(SW_RECORD_NOT_FOUND);
+    }
+
+    if (file->type == ElementaryFile::Type::CYCLIC && recordNumber != 1) {
+        return statusWord(SW_INCOMPATIBLE_FILE);
+    }
+
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+    if (dataIn.empty() || static_cast<int>(dataIn.size()) > file->recordSize) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    if (!consumeSessionBuffer(apdu)) {
+        return statusWord(SW_SESSION_BUFFER_OVERFLOW);
+    }
+
+    std::vector<uint8_t>& record = file->records[recordNumber - 1];
+    if (apdu[1] == INS_UPDATE_RECORD) {
+        std::copy(dataIn.begin(), dataIn.end(), record.begin());
+    } else {
+        for (size_t i = 0; i < dataIn.size(); i++) {
+            record[i] |= dataIn[i];
+        }
+    }
+
+    return statusWord(SW_SUCCESS);
+}
+
+const std::vector<uint8_t> VirtualCardReader::processAppendRecord(const std::vector<uint8_t>& apdu)
+{
+    if (apdu[2] != 0x00 || (apdu[3] & 0x07) != 0x00) {
+        return statusWord(SW_WRONG_P1_P2);
+    }
+
+    VirtualFile* file = selectFile(apdu[3] >> 3);
+    if (file == nullptr) {
+        return statusWord(SW_FILE_NOT_FOUND);
+    }
+
+    if (file->type != ElementaryFile::Type::CYCLIC) {
+        return statusWord(SW_INCOMPATIBLE_FILE);
+    }
+
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+    if (dataIn.empty() || static_cast<int>(dataIn.size()) > file->recordSize) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    if (!consumeSessionBuffer(apdu)) {
+        return statusWord(SW_SESSION_BUFFER_OVERFLOW);
+    }
+
+    /* The oldest record is dropped, its buffer is reused for the new record #1 */
+    std::rotate(file->records.rbegin(), file->records.rbegin() + 1, file->records.rend());
+    std::vector<uint8_t>& record = file->records[0];
+    std::fill(std::copy(dataIn.begin(), dataIn.end(), record.begin()), record.end(), 0);
+
+    return statusWord(SW_SUCCESS);
+}
+
+const std::vector<uint8_t> VirtualCardReader::processIncreaseOrDecrease(
+    const std::vector<uint8_t>& apdu)
+{
+    const int counterNumber = apdu[2];
+
+    if ((apdu[3] & 0x07) != 0x00) {
+        return statusWord(SW_WRONG_P1_P2);
+    }
+
+    VirtualFile* file = selectFile(apdu[3] >> 3);
+    if (file == nullptr) {
+        return statusWord(SW_FILE_NOT_FOUND);
+    }
+
+    if (file->type != ElementaryFile::Type::COUNTERS &&
+        file->type != ElementaryFile::Type::SIMULATED_COUNTERS) {
+        return statusWord(SW_INCOMPATIBLE_FILE);
+    }
+
+    if (counterNumber == 0 || counterNumber > file->recordSize / 3) {
+        return statusWord(SW_WRONG_P1_P2);
+    }
+
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+    if (dataIn.size() != 3) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    std::vector<uint8_t>& record = file->records[0];
+    const int offset = (counterNumber - 1) * 3;
+    const int delta = getUnsigned(dataIn, 0, 3);
+    const int value = getUnsigned(record, offset, 3) + (apdu[1] == INS_INCREASE ? delta : -delta);
+
+    if (value < 0 || value > 0xFFFFFF) {
+        return statusWord(SW_INCORRECT_DATA);
+    }
+
+    if (!consumeSessionBuffer(apdu)) {
+        return statusWord(SW_SESSION_BUFFER_OVERFLOW);
+    }
+
+    setUnsigned(record, offset, 3, value);
+
+    std::vector<uint8_t> response(record.begin() + offset, record.begin() + offset + 3);
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> VirtualCardReader::processIncreaseOrDecreaseMultiple(
+    const std::vector<uint8_t>& apdu)
+{
+    if (apdu[2] != 0x00 || (apdu[3] & 0x07) != 0x00) {
+        return statusWord(SW_WRONG_P1_P2);
+    }
+
+    VirtualFile* file = selectFile(apdu[3] >> 3);
+    if (file == nullptr) {
+        return statusWord(SW_FILE_NOT_FOUND);
+    }
+
+    if (file->type != ElementaryFile::Type::COUNTERS &&
+        file->type != ElementaryFile::Type::SIMULATED_COUNTERS) {
+        return statusWord(SW_INCOMPATIBLE_FILE);
+    }
+
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+    if (dataIn.empty() || dataIn.size() % 4 != 0) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    /* All the counters are checked before any of them is modified */
+    std::vector<uint8_t> record = file->records[0];
+    std::vector<uint8_t> response;
+    response.reserve(dataIn.size() + 2);
+
+    for (size_t i = 0; i < dataIn.size(); i += 4) {
+        const int counterNumber = dataIn[i];
+        if (counterNumber == 0 || counterNumber > file->recordSize / 3) {
+            return statusWord(SW_INCORRECT_DATA);
+        }
+
+        const int offset = (counterNumber - 1) * 3;
+        const int delta = getUnsigned(dataIn, static_cast<int>(i) + 1, 3);
+        const int value = getUnsigned(record, offset, 3) +
+                          (apdu[1] == INS_INCREASE_MULTIPLE ? delta : -delta);
+
+        if (value < 0 || value > 0xFFFFFF) {
+            return statusWord(SW_INCORRECT_DATA);
+        }
+
+        setUnsigned(record, offset, 3, value);
+        response.push_back(static_cast<uint8_t>(counterNumber));
+        response.insert(response.end(), record.begin() + offset, record.begin() + offset + 3);
+    }
+
+    if (!consumeSessionBuffer(apdu)) {
+        return statusWord(SW_SESSION_BUFFER_OVERFLOW);
+    }
+
+    file->records[0].swap(record);
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> VirtualCardReader::processSearchRecordMultiple(
+    const std::vector<uint8_t>& apdu)
+{
+    const int firstRecordNumber = apdu[2];
+
+    if ((apdu[3] & 0x07) != 0x07) {
+        return statusWord(SW_WRONG_P1_P2);
+    }
+
+    const VirtualFile* file = selectFile(apdu[3] >> 3);
+    if (file == nullptr) {
+        return statusWord(SW_FILE_NOT_FOUND);
+    }
+
+    const int recordsNumber = static_cast<int>(file->records.size());
+    if (firstRecordNumber == 0 || firstRecordNumber > recordsNumber) {
+        return statusWord(SW_RECORD_NOT_FOUND);
+    }
+
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+    if (dataIn.size() < 4 || dataIn.size() != 3 + 2 * static_cast<size_t>(dataIn[2])) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    const bool isRepeatedOffset = (dataIn[0] & 0x80) != 0;
+    const bool isFetchFirstMatchingResult = (dataIn[0] & 0x01) != 0;
+    const int offset = dataIn[1];
+    const int length = dataIn[2];
+    const uint8_t* searchData = dataIn.data() + 3;
+    const uint8_t* mask = searchData + length;
+
+    if (offset + length > file->recordSize) {
+        return statusWord(SW_INCORRECT_DATA);
+    }
+
+    const int lastOffset = isRepeatedOffset ? file->recordSize - length : offset;
+
+    std::vector<uint8_t> response(1);
+
+    for (int i = firstRecordNumber; i <= recordsNumber; i++) {
+        const std::vector<uint8_t>& record = file->records[i - 1];
+
+        bool isMatching = false;
+        for (int o = offset; o <= lastOffset && !isMatching; o++) {
+            int j = 0;
+            while (j < length && ((record[o + j] ^ searchData[j]) & mask[j]) == 0) {
+                j++;
+            }
+            isMatching = j == length;
+        }
+
+        if (isMatching) {
+            response.push_back(static_cast<uint8_t>(i));
+        }
+    }
+
+    response[0] = static_cast<uint8_t>(response.size() - 1);
+
+    if (isFetchFirstMatchingResult && response[0] != 0) {
+        const std::vector<uint8_t>& record = file->records[response[1] - 1];
+        response.insert(response.end(), record.begin(), record.end());
+    }
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> VirtualCardReader::processSvGet(const std::vector<uint8_t>& apdu)
+{
+    if (!mIsSvFeatureAvailable) {
+        return statusWord(SW_INS_NOT_SUPPORTED);
+    }
+
+    if (apdu.size() != 5) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    const uint8_t p2 = apdu[3];
+    if (apdu[2] != 0x00 || (p2 != SV_GET_RELOAD && p2 != SV_GET_DEBIT)) {
+        return statusWord(SW_INCORRECT_P1_P2);
+    }
+
+    /* KVC, TNum, previous signatureLo, challenge, balance, then the log of the operation */
+    std::vector<uint8_t> response(11);
+    response[0] = mSv.kvc;
+    setUnsigned(response, 1, 2, mSv.tNum);
+    std::copy(mSv.signatureLo.begin(), mSv.signatureLo.end(), response.begin() + 3);
+    response[6] = nextRandom();
+    response[7] = nextRandom();
+    setUnsigned(response, 8, 3, mSv.balance);
+
+    const std::vector<uint8_t>& log = p2 == SV_GET_RELOAD ? mSv.loadLog : mSv.debitLog;
+    response.insert(response.end(), log.begin(), log.end());
+    appendStatusWord(response, SW_SUCCESS);
+
+    mSvGetHeader.assign(apdu.begin() + 1, apdu.begin() + 5);
+    mSvGetResponse = response;
+
+    return response;
+}
+
+const std::vector<uint8_t> VirtualCardReader::processSvOperation(const std::vector<uint8_t>& apdu)
+{
+    if (!mIsSvFeatureAvailable) {
+        return statusWord(SW_INS_NOT_SUPPORTED);
+    }
+
+    const uint8_t ins = apdu[1];
+    const int expectedSvGetP2 = ins == INS_SV_RELOAD ? SV_GET_RELOAD : SV_GET_DEBIT;
+
+    /* An SV operation must be preceded by the matching SV Get */
+    if (mSvGetHeader.empty() || mSvGetHeader[2] != expectedSvGetP2) {
+        return statusWord(SW_CONDITIONS_NOT_SATISFIED);
+    }
+
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+    const int fixedLength = ins == INS_SV_RELOAD ? 11 : 8;
+
+    if (static_cast<int>(dataIn.size()) != fixedLength + 7 + SV_SIGNATURE_HI_LENGTH) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    std::vector<uint8_t> svCommandData = {ins, apdu[4]};
+    svCommandData.insert(svCommandData.end(), dataIn.begin() + 1, dataIn.begin() + fixedLength);
+    const std::vector<uint8_t> samId(dataIn.begin() + fixedLength,
+                                     dataIn.begin() + fixedLength + 4);
+    const std::vector<uint8_t> samTNum(dataIn.begin() + fixedLength + 4,
+                                       dataIn.begin() + fixedLength + 7);
+    const std::vector<uint8_t> signatureHi(dataIn.begin() + fixedLength + 7, dataIn.end());
+
+    const std::vector<uint8_t> expectedSignatureHi =
+        VirtualSignature::computeSvSignatureHi(mSerialNumber,
+                                               mSv.kvc,
+                                               mSvGetHeader,
+                                               mSvGetResponse,
+                                               svCommandData,
+                                               samId,
+                                               samTNum);
+
+    /* The SV Get context can be used only once */
+    mSvGetHeader.clear();
+    mSvGetResponse.clear();
+
+    if (signatureHi != expectedSignatureHi) {
+        return statusWord(SW_INCORRECT_SIGNATURE);
+    }
+
+    int amount;
+    if (ins == INS_SV_RELOAD) {
+        amount = getSigned(dataIn, 6, 3);
+    } else if (ins == INS_SV_DEBIT) {
+        /* The debit amount is provided as a negative value */
+        amount = getSigned(dataIn, 1, 2);
+    } else {
+        amount = getUnsigned(dataIn, 1, 2);
+    }
+
+    const int balance = mSv.balance + amount;
+    if (balance < -8388608 || balance > 8388607) {
+        return statusWord(SW_INCORRECT_DATA);
+    }
+
+    if (!consumeSessionBuffer(apdu)) {
+        return statusWord(SW_SESSION_BUFFER_OVERFLOW);
+    }
+
+    mSv.balance = balance;
+    mSv.tNum = (mSv.tNum + 1) & 0xFFFF;
+
+    if (ins == INS_SV_RELOAD) {
+        std::vector<uint8_t>& log = mSv.loadLog;
+        log[0] = dataIn[1];
+        log[1] = dataIn[2];
+        log[2] = dataIn[3];
+        log[3] = dataIn[4];
+        log[4] = dataIn[5];
+        setUnsigned(log, 5, 3, balance);
+        std::copy(dataIn.begin() + 6, dataIn.begin() + 9, log.begin() + 8);
+        std::copy(dataIn.begin() + 9, dataIn.begin() + 11, log.begin() + 11);
+        std::copy(samId.begin(), samId.end(), log.begin() + 13);
+        std::copy(samTNum.begin(), samTNum.end(), log.begin() + 17);
+        setUnsigned(log, 20, 2, mSv.tNum);
+    } else {
+        std::vector<uint8_t>& log = mSv.debitLog;
+        std::copy(dataIn.begin() + 1, dataIn.begin() + 8, log.begin());
+        std::copy(samId.begin(), samId.end(), log.begin() + 7);
+        std::copy(samTNum.begin(), samTNum.end(), log.begin() + 11);
+        setUnsigned(log, 14, 3, balance);
+        setUnsigned(log, 17, 2, mSv.tNum);
+    }
+
+    mSv.signatureLo = VirtualSignature::computeSvSignatureLo(mSerialNumber, mSv.kvc, signatureHi);
+
+    /* In session, the signature is returned by Close Secure Session */
+    if (mSessionDigest != nullptr) {
+        mPostponedData = mSv.signatureLo;
+        return statusWord(SW_SUCCESS);
+    }
+
+    std::vector<uint8_t> response = mSv.signatureLo;
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> VirtualCardReader::processGetChallenge(
+    const std::vector<uint8_t>& apdu)
+{
+    if (apdu.size() != 5 || apdu[4] != CHALLENGE_LENGTH) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    mChallenge.resize(CHALLENGE_LENGTH);
+    for (auto& b : mChallenge) {
+        b = nextRandom();
+    }
+
+    std::vector<uint8_t> response = mChallenge;
+
+    return appendStatusWord(response, SW_SUCCESS);
+}
+
+const std::vector<uint8_t> VirtualCardReader::processVerifyPin(const std::vector<uint8_t>& apdu)
+{
+    if (!mIsPinFeatureAvailable) {
+        return statusWord(SW_INS_NOT_SUPPORTED);
+    }
+
+    if (mSessionDigest != nullptr) {
+        return statusWord(SW_CONDITIONS_NOT_SATISFIED);
+    }
+
+    const std::vector<uint8_t> dataIn = getDataIn(apdu);
+
+    if (!dataIn.empty() && dataIn.size() != PIN_LENGTH && dataIn.size() != PIN_CIPHERED_LENGTH) {
+        return statusWord(SW_WRONG_LENGTH);
+    }
+
+    if (mPinAttemptCounter == 0) {
+        return statusWord(SW_PIN_BLOCKED);
+    }
+
+    /* No data: reading of the attempt counter only */
+    if (dataIn.empty()) {
+        return statusWord(mPinAttemptCounter == PIN_MAX_ATTEMPTS ?
+                              SW_SUCCESS :
+                              SW_INCORRECT_PIN + mPinAttemptCounter);
+    }
+
+    bool isPinCorrect;
+    if (dataIn.size() == PIN_CIPHERED_LENGTH) {
+        /* The challenge can be used only once */
+        if (mChallenge.empty()) {
+            return statusWord(SW_CHALLENGE_UNAVAILABLE);
+        }
+
+        isPinCorrect = dataIn == VirtualSignature::computeCipheredPin(mSerialNumber,
+                                                                      mPinKif,
+                                                                      mPinKvc,
+                                                                      mChallenge,
+                                                                      mPin);
+        mChallenge.clear();
+    } else {
+        isPinCorrect = dataIn == mPin;
+    }
+
+    if (isPinCorrect) {
+        mPinAttemptCounter = PIN_MAX_ATTEMPTS;
+        return statusWord(SW_SUCCESS);
+    }
+
+    mPinAttemptCounter--;
+
+    return statusWord(mPinAttemptCounter == 0 ?
+                          SW_PIN_BLOCKED :
+                          SW_INCORRECT_PIN + mPinAttemptCounter);
+}
+
+VirtualCardReader::VirtualFile* VirtualCardReader::selectFile(const uint8_t sfi)
+{
+    const uint8_t effectiveSfi = sfi == 0 ? mCurrentSfi : sfi;
+
+    const auto it = mFiles.find(effectiveSfi);
+    if (it == mFiles.end()) {
+        return nullptr;
+    }
+
+    mCurrentSfi = effectiveSfi;
+
+    return &it->second;
+}
+
+bool VirtualCardReader::consumeSessionBuffer(const std::vector<uint8_t>& apdu)
+{
+    if (mSessionDigest == nullptr) {
+        return true;
+    }
+
+    const int needed = mIsModificationsCounterInBytes ?
+                           static_cast<int>(getDataIn(apdu).size()) +
+                               SESSION_BUFFER_CMD_ADDITIONAL_COST :
+                           1;
+
+    if (mModificationsCounter - needed < 0) {
+        return false;
+    }
+
+    mModificationsCounter -= needed;
+
+    return true;
+}
+
+void VirtualCardReader::abortSession()
+{
+    mFiles.swap(mFilesBackup);
+    mFilesBackup.clear();
+    mSv = mSvBackup;
+    mSvGetHeader.clear();
+    mSvGetResponse.clear();
+    mPostponedData.clear();
+    mSessionDigest.reset();
+}
+
+const std::vector<uint8_t> VirtualCardReader::buildFcp(const uint8_t sfi) const
+{
+    /* 62 19 85 17 <proprietary information> */
+    std::vector<uint8_t> fcp(27);
+    fcp[0] = 0x62;
+    fcp[1] = 0x19;
+    fcp[2] = 0x85;
+    fcp[3] = 0x17;
+
+    std::vector<uint8_t>::iterator info = fcp.begin() + 4;
+
+    const auto it = mFiles.find(sfi);
+    if (it == mFiles.end()) {
+        info[CalypsoCardConstant::SEL_TYPE_OFFSET] = CalypsoCardConstant::FILE_TYPE_DF;
+        std::copy(mKvcs, mKvcs + 3, info + CalypsoCardConstant::SEL_KVCS_OFFSET);
+        std::copy(mKifs, mKifs + 3, info + CalypsoCardConstant::SEL_KIFS_OFFSET);
+        info[CalypsoCardConstant::SEL_LID_OFFSET] = static_cast<uint8_t>(DF_LID >> 8);
+        info[CalypsoCardConstant::SEL_LID_OFFSET + 1] = static_cast<uint8_t>(DF_LID);
+
+        return fcp;
+    }
+
+    const VirtualFile& file = it->second;
+
+    uint8_t efType;
+    switch (file.type) {
+    case ElementaryFile::Type::LINEAR:
+        efType = CalypsoCardConstant::EF_TYPE_LINEAR;
+        break;
+    case ElementaryFile::Type::CYCLIC:
+        efType = CalypsoCardConstant::EF_TYPE_CYCLIC;
+        break;
+    case ElementaryFile::Type::COUNTERS:
+        efType = CalypsoCardConstant::EF_TYPE_COUNTERS;
+        break;
+    case ElementaryFile::Type::SIMULATED_COUNTERS:
+        efType = CalypsoCardConstant::EF_TYPE_SIMULATED_COUNTERS;
+        break;
+    default:
+        efType = CalypsoCardConstant::EF_TYPE_BINARY;
+    }
+
+    info[CalypsoCardConstant::SEL_SFI_OFFSET] = sfi;
+    info[CalypsoCardConstant::SEL_TYPE_OFFSET] = CalypsoCardConstant::FILE_TYPE_EF;
+    info[CalypsoCardConstant::SEL_EF_TYPE_OFFSET] = efType;
+    info[CalypsoCardConstant::SEL_REC_SIZE_OFFSET] = static_cast<uint8_t>(file.recordSize);
+    info[CalypsoCardConstant::SEL_NUM_REC_OFFSET] = static_cast<uint8_t>(file.records.size());
+    info[CalypsoCardConstant::SEL_LID_OFFSET] = static_cast<uint8_t>(file.lid >> 8);
+    info[CalypsoCardConstant::SEL_LID_OFFSET + 1] = static_cast<uint8_t>(file.lid);
+
+    return fcp;
+}
+
+uint8_t VirtualCardReader::nextRandom()
+{
+    /* xorshift32 */
+    mRandom ^= mRandom << 13;
+    mRandom ^= mRandom >> 17;
+    mRandom ^= mRandom << 5;
+
+    return static_cast<uint8_t>(mRandom);
+}
@@ -0,0 +1,482 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Calypsonet Terminal Calypso */
+#include "ElementaryFile.h"
+
+/* Calypsonet Terminal Card */
+#include "ApduResponseApi.h"
+#include "CardRequestSpi.h"
+#include "CardResponseApi.h"
+#include "ChannelControl.h"
+#include "ProxyReaderApi.h"
+
+/* Calypsonet Terminal Reader */
+#include "CardReader.h"
+
+/* Benchmark */
+#include "VirtualSignature.h"
+
+using namespace calypsonet::terminal::calypso::card;
+using namespace calypsonet::terminal::card;
+using namespace calypsonet::terminal::card::spi;
+using namespace calypsonet::terminal::reader;
+
+/**
+ * Reader holding an in-memory Calypso card (Prime revision 3, compatibility mode).
+ *
+ * <p>The card answers the Calypso command set used by CardTransactionManagerAdapter: Get Data
+ * (FCI, FCP), Select File, Open/Close Secure Session, Read/Update/Write/Append Record,
+ * Increase/Decrease (Multiple), Search Record Multiple, SV Get/Reload/Debit/Undebit, Get Challenge
+ * and Verify PIN (plain or ciphered). Any other instruction is answered with 6D00h.
+ *
+ * <p>The FCI (DF name, serial number, startup information) is configurable. The startup
+ * information is parsed as the library does, which gives the product type and the size of the
+ * session modifications buffer enforced by the card (6400h when exceeded).
+ *
+ * <p>The session and SV signatures and the ciphered PIN are computed with the test keys of
+ * VirtualSignature, so that a software SAM using the same keys can authenticate the card and be
+ * authenticated by it.
+ *
+ * <p>Closing the logical channel (CLOSE_AFTER or releaseChannel) aborts the ongoing session, if
+ * any. The next request reopens the channel, the application being implicitly selected.
+ *
+ * <p>Not thread safe: a reader serves a single transaction at a time.
+ */
+class VirtualCardReader final : public CardReader, public ProxyReaderApi {
+public:
+    /**
+     * Creates a reader holding a card without files.
+     *
+     * @param name The reader name.
+     * @param dfName The DF name (AID) of the application (5 to 16 bytes).
+     * @param serialNumber The application serial number (8 bytes).
+     * @param startupInfo The startup information (7 bytes).
+     * @throw IllegalArgumentException If the FCI is invalid or designates a product other than a
+     *        Prime revision 3 card in compatibility mode.
+     */
+    VirtualCardReader(const std::string& name,
+                      const std::vector<uint8_t>& dfName,
+                      const std::vector<uint8_t>& serialNumber,
+                      const std::vector<uint8_t>& startupInfo);
+
+    /**
+     * Gets the response to the Select Application command, to be used to initialize a
+     * CalypsoCardAdapter.
+     *
+     * @return A not null reference.
+     */
+    const std::shared_ptr<ApduResponseApi> getSelectApplicationResponse() const;
+
+    /**
+     * Sets the key designated by a key index of Open Secure Session.
+     *
+     * @param keyIndex The key index (1 = personalization, 2 = load, 3 = debit).
+     * @param kif The KIF of the key.
+     * @param kvc The KVC of the key.
+     */
+    void setSessionKey(const uint8_t keyIndex, const uint8_t kif, const uint8_t kvc);
+
+    /**
+     * Creates an elementary file, its records being filled with zeros.
+     *
+     * <p>A counters file has a single record of recordSize bytes, holding recordSize / 3 counters.
+     *
+     * @param sfi The SFI (in range [1..30]).
+     * @param lid The LID.
+     * @param type The file type (BINARY files are not supported).
+     * @param recordsNumber The number of records.
+     * @param recordSize The size of the records.
+     */
+    void createFile(const uint8_t sfi,
+                    const uint16_t lid,
+                    const ElementaryFile::Type type,
+                    const int recordsNumber,
+                    const int recordSize);
+
+    /**
+     * Sets the content of a record, completed with zeros up to the record size.
+     *
+     * @param sfi The SFI of an existing file.
+     * @param recordNumber The record number (in range [1..number of records]).
+     * @param content The content.
+     */
+    void setRecord(const uint8_t sfi, const int recordNumber, const std::vector<uint8_t>& content);
+
+    /**
+     * Gets the content of a record.
+     *
+     * @param sfi The SFI of an existing file.
+     * @param recordNumber The record number (in range [1..number of records]).
+     * @return A reference to the record.
+     */
+    const std::vector<uint8_t>& getRecord(const uint8_t sfi, const int recordNumber) const;
+
+    /**
+     * Sets the SV balance and the KVC of the SV key. The SV commands are answered only if the
+     * startup information enables the SV feature.
+     *
+     * @param balance The balance.
+     * @param kvc The KVC of the SV key.
+     */
+    void setSv(const int balance, const uint8_t kvc);
+
+    /**
+     *
+     * @return The SV balance.
+     */
+    int getSvBalance() const;
+
+    /**
+     * Sets the PIN and the key used to decipher it. The PIN commands are answered only if the
+     * startup information enables the PIN feature; Verify PIN is refused while a session is open.
+     *
+     * @param pin The PIN (4 bytes).
+     * @param kif The KIF of the PIN ciphering key.
+     * @param kvc The KVC of the PIN ciphering key.
+     */
+    void setPin(const std::vector<uint8_t>& pin, const uint8_t kif, const uint8_t kvc);
+
+    /**
+     *
+     * @return The number of remaining PIN presentation attempts (0 if the PIN is blocked).
+     */
+    int getPinAttemptCounter() const;
+
+    /**
+     * Sets the transaction counter, decremented at each Open Secure Session.
+     *
+     * @param transactionCounter The value (in range [0..FFFFFFh]).
+     */
+    void setTransactionCounter(const int transactionCounter);
+
+    /**
+     *
+     * @return The transaction counter.
+     */
+    int getTransactionCounter() const;
+
+    /**
+     *
+     * @return The number of APDUs processed by the card since the creation of the reader.
+     */
+    long getApduCount() const;
+
+    /**
+     * {@inheritDoc}
+     */
+    const std::string& getName() const override;
+
+    /**
+     * {@inheritDoc}
+     */
+    bool isContactless() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    bool isCardPresent() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    const std::shared_ptr<CardResponseApi> transmitCardRequest(
+        const std::shared_ptr<CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override;
+
+    /**
+     * {@inheritDoc}
+     */
+    void releaseChannel() override;
+
+private:
+    /**
+     * Elementary file of the card.
+     */
+    struct VirtualFile {
+        uint16_t lid;
+        ElementaryFile::Type type;
+        int recordSize;
+        std::vector<std::vector<uint8_t>> records;
+    };
+
+    /**
+     * Stored value of the card.
+     */
+    struct VirtualSv {
+        uint8_t kvc;
+        int balance;
+        int tNum;
+        std::vector<uint8_t> signatureLo;
+        std::vector<uint8_t> loadLog;
+        std::vector<uint8_t> debitLog;
+    };
+
+    /**
+     *
+     */
+    const std::string mName;
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> mSerialNumber;
+
+    /**
+     * Select Application response (FCI followed by the status word).
+     */
+    std::vector<uint8_t> mFci;
+
+    /**
+     *
+     */
+    bool mIsSvFeatureAvailable;
+
+    /**
+     *
+     */
+    bool mIsPinFeatureAvailable;
+
+    /**
+     *
+     */
+    bool mIsModificationsCounterInBytes;
+
+    /**
+     * Size of the session modifications buffer, in bytes or in number of commands.
+     */
+    int mModificationsCounterMax;
+
+    /**
+     *
+     */
+    uint8_t mKifs[3];
+
+    /**
+     *
+     */
+    uint8_t mKvcs[3];
+
+    /**
+     *
+     */
+    std::map<uint8_t, VirtualFile> mFiles;
+
+    /**
+     * SFI of the current EF, 0 if the current file is the DF.
+     */
+    uint8_t mCurrentSfi;
+
+    /**
+     *
+     */
+    VirtualSv mSv;
+
+    /**
+     * Header of the last SV Get command, empty if no SV operation is allowed.
+     */
+    std::vector<uint8_t> mSvGetHeader;
+
+    /**
+     * Response to the last SV Get command.
+     */
+    std::vector<uint8_t> mSvGetResponse;
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mPin;
+
+    /**
+     *
+     */
+    uint8_t mPinKif;
+
+    /**
+     *
+     */
+    uint8_t mPinKvc;
+
+    /**
+     *
+     */
+    int mPinAttemptCounter;
+
+    /**
+     * Challenge returned by the last Get Challenge command, empty once used by Verify PIN.
+     */
+    std::vector<uint8_t> mChallenge;
+
+    /**
+     *
+     */
+    int mTransactionCounter;
+
+    /**
+     *
+     */
+    bool mIsLogicalChannelOpen;
+
+    /**
+     *
+     */
+    bool mIsRatificationPending;
+
+    /**
+     * Digest of the ongoing session, null if no session is open.
+     */
+    std::unique_ptr<VirtualSignature> mSessionDigest;
+
+    /**
+     *
+     */
+    int mModificationsCounter;
+
+    /**
+     * Data of the SV operation done in session, returned by Close Secure Session.
+     */
+    std::vector<uint8_t> mPostponedData;
+
+    /**
+     * Files as they were at the opening of the session.
+     */
+    std::map<uint8_t, VirtualFile> mFilesBackup;
+
+    /**
+     * Stored value as it was at the opening of the session.
+     */
+    VirtualSv mSvBackup;
+
+    /**
+     * State of the pseudo-random generator of the challenges (deterministic runs).
+     */
+    uint32_t mRandom;
+
+    /**
+     *
+     */
+    long mApduCount;
+
+    /**
+     * Processes an APDU and returns the response APDU (status word included).
+     */
+    const std::vector<uint8_t> processApdu(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processGetData(const std::vector<uint8_t>& apdu) const;
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processSelectFile(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processOpenSession(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processCloseSession(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processReadRecords(const std::vector<uint8_t>& apdu);
+
+    /**
+     * Update Record (replaces the first bytes of the record) and Write Record (binary OR).
+     */
+    const std::vector<uint8_t> processUpdateOrWriteRecord(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processAppendRecord(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processIncreaseOrDecrease(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processIncreaseOrDecreaseMultiple(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processSearchRecordMultiple(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processSvGet(const std::vector<uint8_t>& apdu);
+
+    /**
+     * SV Reload, Debit and Undebit.
+     */
+    const std::vector<uint8_t> processSvOperation(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processGetChallenge(const std::vector<uint8_t>& apdu);
+
+    /**
+     *
+     */
+    const std::vector<uint8_t> processVerifyPin(const std::vector<uint8_t>& apdu);
+
+    /**
+     * Gets the file designated by the SFI of a command (0 for the current EF) and makes it the
+     * current EF.
+     *
+     * @return The file or nullptr if not found.
+     */
+    VirtualFile* selectFile(const uint8_t sfi);
+
+    /**
+     * Checks the room left in the session modifications buffer and reserves the room needed by
+     * the provided command.
+     *
+     * @return False if the buffer would overflow.
+     */
+    bool consumeSessionBuffer(const std::vector<uint8_t>& apdu);
+
+    /**
+     * Cancels the modifications made since the opening of the session and closes it.
+     */
+    void abortSession();
+
+    /**
+     * Builds a Select File/Get Data FCP response.
+     */
+    const std::vector<uint8_t> buildFcp(const uint8_t sfi) const;
+
+    /**
+     *
+     */
+    uint8_t nextRandom();
+};
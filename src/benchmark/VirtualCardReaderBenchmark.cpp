@@ -0,0 +1,368 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "Benchmark.h"
+#include "LatencyReader.h"
+#include "RecordingReader.h"
+#include "ReplayReader.h"
+#include "SoftwareSamReader.h"
+#include "UncountedReader.h"
+#include "VirtualCardReader.h"
+
+/* Keyple Card Calypso */
+#include "CalypsoCardAdapter.h"
+#include "CalypsoSamAdapter.h"
+#include "CardSecuritySettingAdapter.h"
+#include "CardTransactionManagerAdapter.h"
+
+using namespace calypsonet::terminal::calypso::transaction;
+using namespace keyple::card::calypso;
+
+static const uint8_t SFI_CONTRACTS = 0x09;
+static const uint8_t SFI_EVENT_LOG = 0x08;
+static const uint8_t SFI_COUNTERS = 0x19;
+
+/* Enough balance and counter values for one debit, increase or decrease per iteration */
+static const int SV_BALANCE = 8000000;
+static const uint8_t COUNTER_VALUE = 0x7F;
+
+static std::shared_ptr<VirtualCardReader> createVirtualCardReader()
+{
+    /* Prime revision 3.1 card with PIN, SV and a 430-byte session buffer */
+    auto reader = std::make_shared<VirtualCardReader>(
+                      "VIRTUAL_CARD_READER",
+                      std::vector<uint8_t>({0x31, 0x54, 0x49, 0x43, 0x2E, 0x49, 0x43, 0x41, 0x31}),
+                      std::vector<uint8_t>({0x00, 0x00, 0x00, 0x00, 0x11, 0x22, 0x33, 0x44}),
+                      std::vector<uint8_t>({0x0A, 0x3C, 0x23, 0x12, 0x14, 0x10, 0x01}));
+
+    reader->createFile(SFI_EVENT_LOG, 0x2010, ElementaryFile::Type::CYCLIC, 3, 29);
+    reader->createFile(SFI_CONTRACTS, 0x2020, ElementaryFile::Type::LINEAR, 4, 29);
+    reader->createFile(SFI_COUNTERS, 0x2069, ElementaryFile::Type::COUNTERS, 1, 27);
+    reader->setRecord(SFI_COUNTERS, 1, std::vector<uint8_t>(27, COUNTER_VALUE));
+    reader->setSv(SV_BALANCE, 0x79);
+
+    return reader;
+}
+
+static const std::vector<uint8_t> PIN = {0x31, 0x32, 0x33, 0x34};
+static const uint8_t PIN_CIPHERING_KIF = 0x30;
+static const uint8_t PIN_CIPHERING_KVC = 0x79;
+
+static std::shared_ptr<SoftwareSamReader> createSoftwareSamReader()
+{
+    return std::make_shared<SoftwareSamReader>("SOFTWARE_SAM_READER",
+                                               std::vector<uint8_t>({0x12, 0x34, 0x56, 0x78}));
+}
+
+/*
+ * The simulated readers are decorated with an UncountedReader, possibly over other decorators, so
+ * that the "allocs" counter reports the allocations of the library only.
+ */
+static std::shared_ptr<UncountedReader> uncounted(const std::shared_ptr<CardReader> reader)
+{
+    return std::make_shared<UncountedReader>(reader);
+}
+
+/* The SAM reader may be a decorator of the software SAM reader */
+static std::shared_ptr<CardSecuritySettingAdapter> createCardSecuritySetting(
+    const std::shared_ptr<CardReader> samReader,
+    const std::shared_ptr<SoftwareSamReader> softwareSamReader)
+{
+    std::shared_ptr<CardSelectionResponseApi> cardSelectionResponse;
+    {
+        const AllocationCountPause pause;
+        cardSelectionResponse = softwareSamReader->getCardSelectionResponse();
+    }
+
+    auto calypsoSam = std::make_shared<CalypsoSamAdapter>(cardSelectionResponse);
+
+    auto cardSecuritySetting = std::make_shared<CardSecuritySettingAdapter>();
+    cardSecuritySetting->setSamResource(samReader, calypsoSam);
+    cardSecuritySetting->setPinVerificationCipheringKey(PIN_CIPHERING_KIF, PIN_CIPHERING_KVC);
+
+    return cardSecuritySetting;
+}
+
+static std::shared_ptr<CalypsoCardAdapter> createCalypsoCard(
+    const std::shared_ptr<VirtualCardReader> reader)
+{
+    std::shared_ptr<ApduResponseApi> selectApplicationResponse;
+    {
+        const AllocationCountPause pause;
+        selectApplicationResponse = reader->getSelectApplicationResponse();
+    }
+
+    auto calypsoCard = std::make_shared<CalypsoCardAdapter>();
+    calypsoCard->initializeWithFci(selectApplicationResponse);
+
+    return calypsoCard;
+}
+
+static void BM_NonSecureTransaction(benchmark::State& state)
+{
+    const auto reader = createVirtualCardReader();
+    const auto calypsoCard = createCalypsoCard(reader);
+    auto cardTransaction =
+        std::make_shared<CardTransactionManagerAdapter>(uncounted(reader), calypsoCard);
+
+    const std::vector<uint8_t> event(29, 0x5A);
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        cardTransaction->prepareReadRecords(SFI_CONTRACTS, 1, 4, 29)
+                        .prepareAppendRecord(SFI_EVENT_LOG, event)
+                        .prepareIncreaseCounter(SFI_COUNTERS, 1, 1)
+                        .processCardCommands();
+    }
+
+    reportAllocations(state, allocationCount);
+    reportApdus(state, "card_apdus", reader->getApduCount());
+}
+BENCHMARK(BM_NonSecureTransaction);
+
+/*
+ * Validation of a transit ticket: reading of the last event and of the contracts, then secure
+ * session decreasing the trip counter and logging the new event.
+ */
+static void BM_ValidationScenario(benchmark::State& state)
+{
+    const auto reader = createVirtualCardReader();
+    const auto samReader = createSoftwareSamReader();
+    const auto calypsoCard = createCalypsoCard(reader);
+    auto cardTransaction =
+        std::make_shared<CardTransactionManagerAdapter>(
+            uncounted(reader),
+            calypsoCard,
+            createCardSecuritySetting(uncounted(samReader), samReader));
+
+    const std::vector<uint8_t> event(29, 0x5A);
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        cardTransaction->prepareReadRecords(SFI_EVENT_LOG, 1, 1, 29)
+                        .prepareReadRecords(SFI_CONTRACTS, 1, 4, 29)
+                        .processOpening(WriteAccessLevel::DEBIT)
+                        .prepareDecreaseCounter(SFI_COUNTERS, 1, 1)
+                        .prepareAppendRecord(SFI_EVENT_LOG, event)
+                        .processClosing();
+    }
+
+    reportAllocations(state, allocationCount);
+    reportApdus(state, "card_apdus", reader->getApduCount());
+    reportApdus(state, "sam_apdus", samReader->getApduCount());
+}
+BENCHMARK(BM_ValidationScenario);
+
+/* Secure session of a card presentation, run with a new transaction manager */
+static void runSvDebitScenario(const std::shared_ptr<CardReader> reader,
+                               const std::shared_ptr<CardReader> samReader,
+                               const std::shared_ptr<VirtualCardReader> virtualCardReader,
+                               const std::shared_ptr<SoftwareSamReader> softwareSamReader)
+{
+    const std::vector<uint8_t> event(29, 0x5A);
+
+    auto cardTransaction =
+        std::make_shared<CardTransactionManagerAdapter>(
+            reader,
+            createCalypsoCard(virtualCardReader),
+            createCardSecuritySetting(samReader, softwareSamReader));
+
+    cardTransaction->prepareReadRecords(SFI_CONTRACTS, 1, 4, 29)
+                    .prepareSvGet(SvOperation::DEBIT, SvAction::DO)
+                    .processOpening(WriteAccessLevel::DEBIT)
+                    .prepareAppendRecord(SFI_EVENT_LOG, event)
+                    .prepareSvDebit(1)
+                    .processClosing();
+}
+
+/* SV debit in a secure session, the card being presented again at each iteration */
+static void BM_SvDebitScenario(benchmark::State& state)
+{
+    const auto reader = createVirtualCardReader();
+    const auto samReader = createSoftwareSamReader();
+    const auto cardReader = uncounted(reader);
+    const auto samCardReader = uncounted(samReader);
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        runSvDebitScenario(cardReader, samCardReader, reader, samReader);
+    }
+
+    reportAllocations(state, allocationCount);
+    reportApdus(state, "card_apdus", reader->getApduCount());
+    reportApdus(state, "sam_apdus", samReader->getApduCount());
+}
+BENCHMARK(BM_SvDebitScenario);
+
+/*
+ * Update of the contracts and of 16 events, overflowing the 430-byte session buffer of the card:
+ * the transaction manager splits the writings into two secure sessions.
+ */
+static void BM_MultiSessionWriteScenario(benchmark::State& state)
+{
+    const auto reader = createVirtualCardReader();
+    const auto samReader = createSoftwareSamReader();
+    const auto calypsoCard = createCalypsoCard(reader);
+
+    auto cardSecuritySetting = createCardSecuritySetting(uncounted(samReader), samReader);
+    cardSecuritySetting->enableMultipleSession();
+
+    auto cardTransaction =
+        std::make_shared<CardTransactionManagerAdapter>(uncounted(reader),
+                                                        calypsoCard,
+                                                        cardSecuritySetting);
+
+    const std::vector<uint8_t> contract(29, 0x3C);
+    const std::vector<uint8_t> event(29, 0x5A);
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        cardTransaction->processOpening(WriteAccessLevel::LOAD);
+
+        for (int i = 1; i <= 4; i++) {
+            cardTransaction->prepareUpdateRecord(SFI_CONTRACTS, i, contract);
+        }
+
+        for (int i = 0; i < 16; i++) {
+            cardTransaction->prepareAppendRecord(SFI_EVENT_LOG, event);
+        }
+
+        cardTransaction->processClosing();
+    }
+
+    reportAllocations(state, allocationCount);
+    reportApdus(state, "card_apdus", reader->getApduCount());
+    reportApdus(state, "sam_apdus", samReader->getApduCount());
+}
+BENCHMARK(BM_MultiSessionWriteScenario);
+
+static void BM_CipheredPinVerification(benchmark::State& state)
+{
+    const auto reader = createVirtualCardReader();
+    const auto samReader = createSoftwareSamReader();
+    const auto calypsoCard = createCalypsoCard(reader);
+    auto cardTransaction =
+        std::make_shared<CardTransactionManagerAdapter>(
+            uncounted(reader),
+            calypsoCard,
+            createCardSecuritySetting(uncounted(samReader), samReader));
+
+    reader->setPin(PIN, PIN_CIPHERING_KIF, PIN_CIPHERING_KVC);
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        cardTransaction->processVerifyPin(PIN);
+    }
+
+    reportAllocations(state, allocationCount);
+    reportApdus(state, "card_apdus", reader->getApduCount());
+    reportApdus(state, "sam_apdus", samReader->getApduCount());
+}
+BENCHMARK(BM_CipheredPinVerification);
+
+static LatencyModel getLatencyModel(const char* variable, const LatencyModel& defaultModel)
+{
+    const char* path = std::getenv(variable);
+
+    return path != nullptr ? LatencyModel::fromFile(path) : defaultModel;
+}
+
+/*
+ * SV debit scenario, the card and SAM exchanges costing the time of a latency model on a virtual
+ * clock. The simulated latency (critical path of the exchanges) is reported in the "simulated_ms"
+ * counter, and the sum of the latencies of all the exchanges in the "serial_ms" counter.
+ */
+static void BM_SvDebitScenarioSimulatedLatency(benchmark::State& state)
+{
+    /* Models of the field by default, overridden by the files designated by the variables */
+    const LatencyModel cardModel =
+        getLatencyModel("KEYPLE_BENCH_CARD_LATENCY", LatencyModel::contactlessCard());
+    const LatencyModel samModel =
+        getLatencyModel("KEYPLE_BENCH_SAM_LATENCY", LatencyModel::contactSam());
+
+    const auto clock = std::make_shared<LatencyClock>(LatencyClock::Mode::VIRTUAL);
+
+    const auto virtualCardReader = createVirtualCardReader();
+    const auto softwareSamReader = createSoftwareSamReader();
+    const auto reader =
+        uncounted(std::make_shared<LatencyReader>(virtualCardReader, cardModel, clock, 1));
+    const auto samReader =
+        uncounted(std::make_shared<LatencyReader>(softwareSamReader, samModel, clock, 2));
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        runSvDebitScenario(reader, samReader, virtualCardReader, softwareSamReader);
+    }
+
+    reportAllocations(state, allocationCount);
+    reportApdus(state, "card_apdus", virtualCardReader->getApduCount());
+    reportApdus(state, "sam_apdus", softwareSamReader->getApduCount());
+    state.counters["simulated_ms"] =
+        benchmark::Counter(clock->getSpentLatency().count() / 1000.0,
+                           benchmark::Counter::kAvgIterations);
+    state.counters["serial_ms"] =
+        benchmark::Counter(clock->getTotalLatency().count() / 1000.0,
+                           benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SvDebitScenarioSimulatedLatency);
+
+/*
+ * SV debit scenario replayed from the APDU traces of its card and SAM channels, checked APDU by
+ * APDU. The size of the traces is reported in the "trace_bytes" counter.
+ */
+static void BM_SvDebitScenarioReplay(benchmark::State& state)
+{
+    const auto virtualCardReader = createVirtualCardReader();
+    const auto softwareSamReader = createSoftwareSamReader();
+
+    /* Recording of the card and SAM channels of a transaction */
+    const auto cardTrace = std::make_shared<std::stringstream>();
+    const auto samTrace = std::make_shared<std::stringstream>();
+
+    runSvDebitScenario(std::make_shared<RecordingReader>(virtualCardReader, cardTrace),
+                       std::make_shared<RecordingReader>(softwareSamReader, samTrace),
+                       virtualCardReader,
+                       softwareSamReader);
+
+    const auto reader = std::make_shared<ReplayReader>(*cardTrace);
+    const auto samReader = std::make_shared<ReplayReader>(*samTrace);
+    const auto cardReader = uncounted(reader);
+    const auto samCardReader = uncounted(samReader);
+
+    const long allocationCount = getAllocationCount();
+
+    for (auto _ : state) {
+        reader->rewind();
+        samReader->rewind();
+        runSvDebitScenario(cardReader, samCardReader, virtualCardReader, softwareSamReader);
+    }
+
+    reportAllocations(state, allocationCount);
+    state.counters["trace_bytes"] =
+        static_cast<double>(cardTrace->str().size() + samTrace->str().size());
+
+    if (reader->getRemainingEventCount() != 0 || samReader->getRemainingEventCount() != 0) {
+        state.SkipWithError("The transaction did not replay all the events of the traces.");
+    }
+}
+BENCHMARK(BM_SvDebitScenarioReplay);
@@ -0,0 +1,134 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "VirtualSignature.h"
+
+static const uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+static const uint64_t FNV_PRIME = 0x00000100000001B3ULL;
+
+/* Domains separating the session keys from the SV keys */
+static const uint8_t DOMAIN_SESSION = 0x01;
+static const uint8_t DOMAIN_SV = 0x02;
+
+/* Labels separating the signatures derived from a same digest */
+static const uint8_t LABEL_TERMINAL = 0x54;
+static const uint8_t LABEL_CARD = 0x43;
+static const uint8_t LABEL_SV_HI = 0x48;
+static const uint8_t LABEL_SV_LO = 0x4C;
+static const uint8_t LABEL_PIN = 0x50;
+
+VirtualSignature::VirtualSignature(const std::vector<uint8_t>& serialNumber,
+                                   const uint8_t kif,
+                                   const uint8_t kvc)
+: mState(initialState(serialNumber, DOMAIN_SESSION, kif, kvc)) {}
+
+void VirtualSignature::update(const std::vector<uint8_t>& data)
+{
+    mState = absorb(mState, data.data(), data.size());
+}
+
+const std::vector<uint8_t> VirtualSignature::getTerminalSignature(const int length) const
+{
+    return squeeze(mState, LABEL_TERMINAL, length);
+}
+
+const std::vector<uint8_t> VirtualSignature::getCardSignature(
+    const std::vector<uint8_t>& terminalSignature) const
+{
+    const uint64_t state = absorb(mState, terminalSignature.data(), terminalSignature.size());
+
+    return squeeze(state, LABEL_CARD, static_cast<int>(terminalSignature.size()));
+}
+
+const std::vector<uint8_t> VirtualSignature::computeSvSignatureHi(
+    const std::vector<uint8_t>& serialNumber,
+    const uint8_t kvc,
+    const std::vector<uint8_t>& svGetHeader,
+    const std::vector<uint8_t>& svGetResponse,
+    const std::vector<uint8_t>& svCommandData,
+    const std::vector<uint8_t>& samId,
+    const std::vector<uint8_t>& samTNum)
+{
+    uint64_t state = initialState(serialNumber, DOMAIN_SV, 0x00, kvc);
+    state = absorb(state, svGetHeader.data(), svGetHeader.size());
+    state = absorb(state, svGetResponse.data(), svGetResponse.size());
+    state = absorb(state, svCommandData.data(), svCommandData.size());
+    state = absorb(state, samId.data(), samId.size());
+    state = absorb(state, samTNum.data(), samTNum.size());
+
+    return squeeze(state, LABEL_SV_HI, 5);
+}
+
+const std::vector<uint8_t> VirtualSignature::computeSvSignatureLo(
+    const std::vector<uint8_t>& serialNumber,
+    const uint8_t kvc,
+    const std::vector<uint8_t>& signatureHi)
+{
+    uint64_t state = initialState(serialNumber, DOMAIN_SV, 0x00, kvc);
+    state = absorb(state, signatureHi.data(), signatureHi.size());
+
+    return squeeze(state, LABEL_SV_LO, 3);
+}
+
+const std::vector<uint8_t> VirtualSignature::computeCipheredPin(
+    const std::vector<uint8_t>& serialNumber,
+    const uint8_t kif,
+    const uint8_t kvc,
+    const std::vector<uint8_t>& cardChallenge,
+    const std::vector<uint8_t>& pin)
+{
+    uint64_t state = initialState(serialNumber, DOMAIN_SESSION, kif, kvc);
+    state = absorb(state, cardChallenge.data(), cardChallenge.size());
+    state = absorb(state, pin.data(), pin.size());
+
+    return squeeze(state, LABEL_PIN, 8);
+}
+
+uint64_t VirtualSignature::initialState(const std::vector<uint8_t>& serialNumber,
+                                        const uint8_t domain,
+                                        const uint8_t kif,
+                                        const uint8_t kvc)
+{
+    const uint8_t keyId[3] = {domain, kif, kvc};
+
+    uint64_t state = absorb(FNV_OFFSET_BASIS, keyId, sizeof(keyId));
+
+    return absorb(state, serialNumber.data(), serialNumber.size());
+}
+
+uint64_t VirtualSignature::absorb(uint64_t state, const uint8_t* data, const size_t length)
+{
+    /* The length prefix keeps the block boundaries in the digest */
+    state = (state ^ static_cast<uint8_t>(length)) * FNV_PRIME;
+    state = (state ^ static_cast<uint8_t>(length >> 8)) * FNV_PRIME;
+
+    for (size_t i = 0; i < length; i++) {
+        state = (state ^ data[i]) * FNV_PRIME;
+    }
+
+    return state;
+}
+
+const std::vector<uint8_t> VirtualSignature::squeeze(uint64_t state,
+                                                     const uint8_t label,
+                                                     const int length)
+{
+    std::vector<uint8_t> signature(length);
+
+    state = (state ^ label) * FNV_PRIME;
+    for (int i = 0; i < length; i++) {
+        state = (state ^ static_cast<uint8_t>(i)) * FNV_PRIME;
+        signature[i] = static_cast<uint8_t>(state >> 56);
+    }
+
+    return signature;
+}
@@ -0,0 +1,135 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Signatures shared by the virtual card and the software SAM (session, SV and PIN ciphering).
+ *
+ * <p>The session and SV signatures are computed with test keys diversified with the card serial
+ * number and the key identifiers (KIF/KVC). The primitive is a keyed 64-bit FNV-1a hash: it is
+ * NOT the Calypso cryptography and provides no security, it only lets both ends of a simulated
+ * transaction compute and check matching signatures.
+ */
+class VirtualSignature final {
+public:
+    /**
+     * Starts a secure session digest with the test key designated by the provided KIF/KVC.
+     *
+     * @param serialNumber The card serial number (diversifier).
+     * @param kif The KIF of the session key.
+     * @param kvc The KVC of the session key.
+     */
+    VirtualSignature(const std::vector<uint8_t>& serialNumber, const uint8_t kif, const uint8_t kvc);
+
+    /**
+     * Adds a block of data to the digest (open session response, command or response APDU).
+     *
+     * @param data The block.
+     */
+    void update(const std::vector<uint8_t>& data);
+
+    /**
+     * Computes the terminal signature of the data digested so far.
+     *
+     * @param length The signature length (4 or 8).
+     * @return A not empty array.
+     */
+    const std::vector<uint8_t> getTerminalSignature(const int length) const;
+
+    /**
+     * Computes the card signature of the data digested so far, terminal signature included.
+     *
+     * @param terminalSignature The terminal signature.
+     * @return An array having the same length as the terminal signature.
+     */
+    const std::vector<uint8_t> getCardSignature(const std::vector<uint8_t>& terminalSignature)
+        const;
+
+    /**
+     * Computes the signature provided by the SAM in an SV Reload/Debit/Undebit command.
+     *
+     * @param serialNumber The card serial number.
+     * @param kvc The KVC of the SV key (returned by SV Get).
+     * @param svGetHeader The SV Get command header (INS, P1, P2, Le).
+     * @param svGetResponse The SV Get response APDU (status word included).
+     * @param svCommandData The fixed part of the SV command: INS, Lc and the data in from byte #1
+     *        up to the SAM ID excluded.
+     * @param samId The SAM serial number (4 bytes).
+     * @param samTNum The SAM transaction number (3 bytes).
+     * @return A 5-byte array.
+     */
+    static const std::vector<uint8_t> computeSvSignatureHi(
+        const std::vector<uint8_t>& serialNumber,
+        const uint8_t kvc,
+        const std::vector<uint8_t>& svGetHeader,
+        const std::vector<uint8_t>& svGetResponse,
+        const std::vector<uint8_t>& svCommandData,
+        const std::vector<uint8_t>& samId,
+        const std::vector<uint8_t>& samTNum);
+
+    /**
+     * Computes the signature returned by the card to an SV Reload/Debit/Undebit command.
+     *
+     * @param serialNumber The card serial number.
+     * @param kvc The KVC of the SV key.
+     * @param signatureHi The signature provided by the SAM.
+     * @return A 3-byte array.
+     */
+    static const std::vector<uint8_t> computeSvSignatureLo(const std::vector<uint8_t>& serialNumber,
+                                                           const uint8_t kvc,
+                                                           const std::vector<uint8_t>& signatureHi);
+
+    /**
+     * Computes the ciphered PIN provided to a Verify PIN command.
+     *
+     * @param serialNumber The card serial number.
+     * @param kif The KIF of the ciphering key.
+     * @param kvc The KVC of the ciphering key.
+     * @param cardChallenge The challenge returned by the card Get Challenge command (8 bytes).
+     * @param pin The plain PIN (4 bytes).
+     * @return An 8-byte array.
+     */
+    static const std::vector<uint8_t> computeCipheredPin(const std::vector<uint8_t>& serialNumber,
+                                                         const uint8_t kif,
+                                                         const uint8_t kvc,
+                                                         const std::vector<uint8_t>& cardChallenge,
+                                                         const std::vector<uint8_t>& pin);
+
+private:
+    /**
+     *
+     */
+    uint64_t mState;
+
+    /**
+     * Computes the initial state of a digest keyed with a diversified test key.
+     */
+    static uint64_t initialState(const std::vector<uint8_t>& serialNumber,
+                                 const uint8_t domain,
+                                 const uint8_t kif,
+                                 const uint8_t kvc);
+
+    /**
+     * Absorbs a length-prefixed block.
+     */
+    static uint64_t absorb(uint64_t state, const uint8_t* data, const size_t length);
+
+    /**
+     * Derives a signature of the provided length from a digest state.
+     */
+    static const std::vector<uint8_t> squeeze(uint64_t state, const uint8_t label, const int length);
+};
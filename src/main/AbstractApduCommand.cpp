@@ -22,40 +22,52 @@ namespace card {
 namespace calypso {
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /* STATUS PROPERTIES ---------------------------------------------------------------------------- */
 
-StatusProperties::StatusProperties(const std::string& information)
-: mInformation(information), mSuccessful(true), mExceptionClass(typeid(nullptr)) {}
-
-StatusProperties::StatusProperties(
-  const std::string& information, const std::type_info& exceptionClass)
-: mInformation(information),
-  mSuccessful(exceptionClass == typeid(nullptr)),
-  mExceptionClass(exceptionClass) {}
-
-const std::string& StatusProperties::getInformation() const
+const char* StatusProperties::getInformation() const
 {
     return mInformation;
 }
 
 bool StatusProperties::isSuccessful() const
 {
-    return mSuccessful;
+    return mExceptionClass == nullptr;
 }
 
 const std::type_info& StatusProperties::getExceptionClass() const
 {
-    return mExceptionClass;
+    return mExceptionClass != nullptr ? mExceptionClass() : typeid(nullptr);
+}
+
+/* STATUS TABLE --------------------------------------------------------------------------------- */
+
+const StatusProperties* StatusTable::find(const int statusWord) const
+{
+    const StatusProperties* first = mBegin;
+    const StatusProperties* last = mEnd;
+
+    while (first < last) {
+        const StatusProperties* middle = first + (last - first) / 2;
+        if (middle->getStatusWord() < statusWord) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+
+    return first != mEnd && first->getStatusWord() == statusWord ? first : nullptr;
 }
 
 /* ABSTRACT APDU COMMAND ------------------------------------------------------------------------ */
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    AbstractApduCommand::STATUS_TABLE = {
-    {0x9000, std::make_shared<StatusProperties>("Success")},
+static constexpr StatusProperties STATUS_TABLE[] = {
+    {0x9000, "Success"},
 };
 
+static_assert(StatusTable::isSorted(STATUS_TABLE), "Status words must be sorted");
+
 AbstractApduCommand::AbstractApduCommand(const CardCommand& commandRef)
 : mCommandRef(commandRef), mName(commandRef.getName()) {}
 
@@ -99,10 +111,9 @@ const std::shared_ptr<ApduResponseApi> AbstractApduCommand::getApduResponse() co
     return mApduResponse;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    AbstractApduCommand::getStatusTable() const
+const StatusTable AbstractApduCommand::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 const CalypsoApduCommandException AbstractApduCommand::buildCommandException(
@@ -118,25 +129,21 @@ const CalypsoApduCommandException AbstractApduCommand::buildCommandException(
     return CardCommandUnknownStatusException(message, commandRef, sw);
 }
 
-const std::shared_ptr<StatusProperties> AbstractApduCommand::getStatusWordProperties() const
+const StatusProperties* AbstractApduCommand::getStatusWordProperties() const
 {
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& table = getStatusTable();
-
-    const auto it = getStatusTable().find(mApduResponse->getStatusWord());
-
-    return it != table.end() ? it->second : nullptr;
+    return getStatusTable().find(mApduResponse->getStatusWord());
 }
 
 bool AbstractApduCommand::isSuccessful() const
 {
-    const std::shared_ptr<StatusProperties> props = getStatusWordProperties();
+    const StatusProperties* props = getStatusWordProperties();
 
     return props != nullptr && props->isSuccessful();
 }
 
 void AbstractApduCommand::checkStatus()
 {
-    const std::shared_ptr<StatusProperties> props = getStatusWordProperties();
+    const StatusProperties* props = getStatusWordProperties();
     if (props != nullptr && props->isSuccessful()) {
         return;
     }
@@ -159,7 +166,7 @@ void AbstractApduCommand::checkStatus()
 
 const std::string AbstractApduCommand::getStatusInformation() const
 {
-    const std::shared_ptr<StatusProperties> props = getStatusWordProperties();
+    const StatusProperties* props = getStatusWordProperties();
 
     return props != nullptr ? props->getInformation() : "";
 }
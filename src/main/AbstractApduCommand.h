@@ -12,9 +12,11 @@
 
 #pragma once
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
+#include <typeinfo>
 
 /* Keyple Card Calypso */
 #include "ApduRequestAdapter.h"
@@ -30,6 +32,19 @@ namespace calypso {
 
 using namespace calypsonet::terminal::card;
 
+/**
+ * (package-private)<br>
+ * Exception class getter to be referenced from the status tables.
+ *
+ * @return The type info of the exception.
+ * @since 2.1.1
+ */
+template <typename E>
+const std::type_info& exceptionClassOf()
+{
+    return typeid(E);
+}
+
 /**
  * (package-private)<br>
  * Generic APDU command.
@@ -47,10 +62,20 @@ using namespace calypsonet::terminal::card;
  */
 class AbstractApduCommand {
 public:
+    /**
+     * (package-private)<br>
+     * Gets the exception class associated to a status word.
+     *
+     * @since 2.1.1
+     */
+    typedef const std::type_info& (*ExceptionClassGetter)();
+
     /**
      * (package-private)<br>
      * This internal class provides status word properties
      *
+     * <p>Instances are literal values so that the status tables are constant-initialized.
+     *
      * @since 2.0.1
      */
     class StatusProperties {
@@ -59,30 +84,47 @@ public:
          * (package-private)<br>
          * Creates a successful status.
          *
+         * @param statusWord the status word.
          * @param information the status information.
          * @since 2.0.1
          */
-        StatusProperties(const std::string& information);
+        constexpr StatusProperties(const int statusWord, const char* information)
+        : mStatusWord(statusWord), mInformation(information), mExceptionClass(nullptr) {}
 
         /**
          * (package-private)<br>
-         * Creates an error status.<br>
-         * If {@code exceptionClass} is null, then a successful status is created.
+         * Creates an error status.
          *
+         * @param statusWord the status word.
          * @param information the status information.
-         * @param exceptionClass the associated exception class.
+         * @param exceptionClass the getter of the associated exception class.
          * @since 2.0.1
          */
-        StatusProperties(const std::string& information, const std::type_info& exceptionClass);
+        constexpr StatusProperties(const int statusWord,
+                                   const char* information,
+                                   const ExceptionClassGetter exceptionClass)
+        : mStatusWord(statusWord), mInformation(information), mExceptionClass(exceptionClass) {}
+
+        /**
+         * (package-private)<br>
+         * Gets the status word
+         *
+         * @return A value
+         * @since 2.1.1
+         */
+        constexpr int getStatusWord() const
+        {
+            return mStatusWord;
+        }
 
         /**
          * (package-private)<br>
          * Gets information
          *
-         * @return A nullable reference
+         * @return A not null value
          * @since 2.0.1
          */
-        const std::string& getInformation() const;
+        const char* getInformation() const;
 
         /**
          * (package-private)<br>
@@ -97,7 +139,7 @@ public:
          * (package-private)<br>
          * Gets Exception Class
          *
-         * @return A nullable reference
+         * @return typeid(nullptr) if the status is successful.
          * @since 2.0.1
          */
         const std::type_info& getExceptionClass() const;
@@ -106,27 +148,79 @@ public:
         /**
          *
          */
-        const std::string mInformation;
+        const int mStatusWord;
 
         /**
          *
          */
-        const bool mSuccessful;
+        const char* const mInformation;
 
         /**
          *
          */
-        const std::type_info& mExceptionClass;
+        const ExceptionClassGetter mExceptionClass;
     };
 
     /**
      * (package-private)<br>
-     * This Map stores expected status that could be by default initialized with sw1=90 and sw2=00
-     * (Success)
+     * Read-only view on a status table, i.e. an array of status properties sorted by status word.
      *
-     * @since 2.0.1
+     * @since 2.1.1
      */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
+    class StatusTable {
+    public:
+        /**
+         * (package-private)<br>
+         * Creates a view on a status table.
+         *
+         * @param statusProperties the status properties, sorted by increasing status word.
+         * @since 2.1.1
+         */
+        template <std::size_t N>
+        constexpr StatusTable(const StatusProperties (&statusProperties)[N])
+        : mBegin(statusProperties), mEnd(statusProperties + N) {}
+
+        /**
+         * (package-private)<br>
+         * Looks up the properties of a status word (binary search).
+         *
+         * @param statusWord the status word.
+         * @return Null if the status word is not referenced.
+         * @since 2.1.1
+         */
+        const StatusProperties* find(const int statusWord) const;
+
+        /**
+         * (package-private)<br>
+         * Checks at compile time that status properties are sorted by strictly increasing status
+         * word, as required by find.
+         *
+         * @param statusProperties the status properties.
+         * @param index the index from which the order is checked.
+         * @return True if the status properties are sorted.
+         * @since 2.1.1
+         */
+        template <std::size_t N>
+        static constexpr bool isSorted(const StatusProperties (&statusProperties)[N],
+                                       const std::size_t index = 0)
+        {
+            return index + 1 >= N ||
+                   (statusProperties[index].getStatusWord() <
+                        statusProperties[index + 1].getStatusWord() &&
+                    isSorted(statusProperties, index + 1));
+        }
+
+    private:
+        /**
+         *
+         */
+        const StatusProperties* const mBegin;
+
+        /**
+         *
+         */
+        const StatusProperties* const mEnd;
+    };
 
     /**
      * (package-private)<br>
@@ -210,11 +304,10 @@ public:
      * (package-private)<br>
      * Returns the internal status table
      *
-     * @return A not null reference
+     * @return A not null value
      * @since 2.0.1
      */
-    virtual const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable()
-        const;
+    virtual const StatusTable getStatusTable() const;
 
     /**
      * (package-private)<br>
@@ -291,7 +384,7 @@ private:
      * @return The properties of the result.
      * @throws NullPointerException If the response is not set.
      */
-    virtual const std::shared_ptr<StatusProperties> getStatusWordProperties() const;
+    virtual const StatusProperties* getStatusWordProperties() const;
 };
 
 }
@@ -27,8 +27,14 @@ namespace keyple {
 namespace card {
 namespace calypso {
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    AbstractSamCommand::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 AbstractSamCommand::AbstractSamCommand(const CalypsoSamCommand& commandRef)
 : AbstractApduCommand(commandRef) {}
@@ -82,26 +88,9 @@ void AbstractSamCommand::checkStatus()
     }
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    AbstractSamCommand::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6D00,
-              std::make_shared<StatusProperties>("Instruction unknown.",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-    m.insert({0x6E00,
-              std::make_shared<StatusProperties>("Class not supported.",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    AbstractSamCommand::getStatusTable() const
+const StatusTable AbstractSamCommand::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
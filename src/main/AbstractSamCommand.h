@@ -24,6 +24,7 @@ namespace calypso {
 
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -33,21 +34,12 @@ using StatusProperties = AbstractApduCommand::StatusProperties;
  */
 class AbstractSamCommand : public AbstractApduCommand {
 public:
-    /**
-     * (package-private)<br>
-     * Default SAM product type.
-     *
-     * @since 2.0.1
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
     /**
      * {@inheritDoc}
      *
      * @since 2.0.1
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
     /**
      * (package-private)<br>
@@ -90,11 +82,6 @@ public:
      */
     void checkStatus() override;
 
-private:
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
@@ -12,13 +12,18 @@
 
 #include "ApduRequestAdapter.h"
 
+#include <algorithm>
+
 /* Keyple Core Utils */
+#include "IndexOutOfBoundsException.h"
 #include "KeypleStd.h"
 
 namespace keyple {
 namespace card {
 namespace calypso {
 
+using namespace keyple::core::util::cpp::exception;
+
 const int ApduRequestAdapter::DEFAULT_SUCCESSFUL_CODE = 0x9000;
 
 ApduRequestAdapter::ApduRequestAdapter(const std::vector<uint8_t>& apdu)
@@ -54,6 +59,18 @@ const std::vector<uint8_t>& ApduRequestAdapter::getApdu() const
     return mApdu;
 }
 
+ApduRequestAdapter& ApduRequestAdapter::patchApdu(const int offset,
+                                                  const std::vector<uint8_t>& data)
+{
+    if (offset < 0 || offset + data.size() > mApdu.size()) {
+        throw IndexOutOfBoundsException("The data does not fit in the APDU.");
+    }
+
+    std::copy(data.begin(), data.end(), mApdu.begin() + offset);
+
+    return *this;
+}
+
 
 std::ostream& operator<<(std::ostream& os, const std::shared_ptr<ApduRequestAdapter> ara)
 {
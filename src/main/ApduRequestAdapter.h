@@ -96,6 +96,18 @@ public:
      */
     const std::vector<uint8_t>& getApdu() const override;
 
+    /**
+     * (package-private)<br>
+     * Overwrites a part of the APDU with the provided bytes, the length of the APDU is unchanged.
+     *
+     * @param offset The index of the first byte to overwrite.
+     * @param data The new bytes.
+     * @return The object instance.
+     * @throw IndexOutOfBoundsException If the data does not fit in the APDU.
+     * @since 2.1.1
+     */
+    ApduRequestAdapter& patchApdu(const int offset, const std::vector<uint8_t>& data);
+
     /**
      *
      */
@@ -111,7 +123,7 @@ private:
     /**
      *
      */
-    const std::vector<uint8_t> mApdu;
+    std::vector<uint8_t> mApdu;
 
     /**
      *
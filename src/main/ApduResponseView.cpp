@@ -0,0 +1,65 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+
+#include "ApduResponseView.h"
+
+#include <string>
+
+/* Keyple Core Util */
+#include "IndexOutOfBoundsException.h"
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+using namespace keyple::core::util::cpp::exception;
+
+ApduResponseView::ApduResponseView(const ApduResponseApi& apduResponse)
+: mData(apduResponse.getApdu().data()),
+  mLength(apduResponse.getApdu().size() >= 2 ?
+          static_cast<int>(apduResponse.getApdu().size()) - 2 : 0) {}
+
+int ApduResponseView::getLength() const
+{
+    return mLength;
+}
+
+bool ApduResponseView::isEmpty() const
+{
+    return mLength == 0;
+}
+
+uint8_t ApduResponseView::operator[](const int index) const
+{
+    return mData[index];
+}
+
+std::vector<uint8_t> ApduResponseView::copyOfRange(const int from, const int to) const
+{
+    if (from < 0 || to > mLength || from > to) {
+        throw IndexOutOfBoundsException("Range [" + std::to_string(from) + ", " +
+                                        std::to_string(to) + "[ is out of the data out of length " +
+                                        std::to_string(mLength) + ".");
+    }
+
+    return std::vector<uint8_t>(mData + from, mData + to);
+}
+
+std::vector<uint8_t> ApduResponseView::toVector() const
+{
+    return std::vector<uint8_t>(mData, mData + mLength);
+}
+
+}
+}
+}
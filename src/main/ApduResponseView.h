@@ -0,0 +1,110 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/* Calypsonet Terminal Card */
+#include "ApduResponseApi.h"
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+using namespace calypsonet::terminal::card;
+
+/**
+ * (package-private)<br>
+ * Read-only view of the data out of an APDU response (status word excluded).
+ *
+ * <p>Unlike ApduResponseApi::getDataOut, no copy of the data is made: the view refers to the bytes
+ * of the response, it must therefore not outlive it.
+ *
+ * @since 2.1.1
+ */
+class ApduResponseView final {
+public:
+    /**
+     * (package-private)<br>
+     * Creates a view of the data out of the provided response.
+     *
+     * @param apduResponse The response.
+     * @since 2.1.1
+     */
+    explicit ApduResponseView(const ApduResponseApi& apduResponse);
+
+    /**
+     * (package-private)<br>
+     * Gets the length of the data out.
+     *
+     * @return A positive int.
+     * @since 2.1.1
+     */
+    int getLength() const;
+
+    /**
+     * (package-private)<br>
+     *
+     * @return True if the response contains only a status word.
+     * @since 2.1.1
+     */
+    bool isEmpty() const;
+
+    /**
+     * (package-private)<br>
+     * Gets a byte of the data out, the index is not checked.
+     *
+     * @param index The index of the byte in the range [0..length-1].
+     * @return The byte value.
+     * @since 2.1.1
+     */
+    uint8_t operator[](const int index) const;
+
+    /**
+     * (package-private)<br>
+     * Copies a range of the data out.
+     *
+     * @param from The index of the first byte (inclusive).
+     * @param to The index of the last byte (exclusive).
+     * @return A new array.
+     * @throw IndexOutOfBoundsException If the range is not included in the data out.
+     * @since 2.1.1
+     */
+    std::vector<uint8_t> copyOfRange(const int from, const int to) const;
+
+    /**
+     * (package-private)<br>
+     * Copies the whole data out.
+     *
+     * @return A new array.
+     * @since 2.1.1
+     */
+    std::vector<uint8_t> toVector() const;
+
+private:
+    /**
+     *
+     */
+    const uint8_t* const mData;
+
+    /**
+     *
+     */
+    const int mLength;
+};
+
+}
+}
+}
@@ -68,7 +68,11 @@ const std::vector<int> CalypsoCardAdapter::BUFFER_SIZE_INDICATOR_TO_BUFFER_SIZE
 CalypsoCardAdapter::CalypsoCardAdapter()
 : mCalypsoCardClass(CalypsoCardClass::UNKNOWN),
   mProductType(ProductType::UNKNOWN),
-  mIsModificationCounterInBytes(true) {}
+  mIsModificationCounterInBytes(true),
+  mFilesBackupSize(0),
+  mIsFilesBackupActive(false),
+  mCurrentSfi(0),
+  mCurrentLid(0) {}
 
 void CalypsoCardAdapter::initializeWithPowerOnData(const std::string& powerOnData)
 {
@@ -368,7 +372,7 @@ void CalypsoCardAdapter::setSvData(const uint8_t svKvc,
     mSvKvc = svKvc;
     mSvGetHeader = svGetHeader;
     mSvGetData = svGetData;
-    mSvBalance = std::make_shared<int>(svBalance);
+    mSvBalance = svBalance;
     mSvLastTNum = svLastTNum;
 
     /* Update logs, do not overwrite existing values (case of double reading) */
@@ -383,17 +387,17 @@ void CalypsoCardAdapter::setSvData(const uint8_t svKvc,
 
 int CalypsoCardAdapter::getSvBalance() const
 {
-    if (mSvBalance == nullptr) {
+    if (!mSvBalance.has_value()) {
         throw IllegalStateException("No SV Get command has been executed.");
     }
 
-    return *mSvBalance.get();
+    return *mSvBalance;
 }
 
 int CalypsoCardAdapter::getSvLastTNum() const
 {
-    if (mSvBalance == nullptr) {
-         new IllegalStateException("No SV Get command has been executed.");
+    if (!mSvBalance.has_value()) {
+        throw IllegalStateException("No SV Get command has been executed.");
     }
 
     return mSvLastTNum;
@@ -476,26 +480,22 @@ const std::shared_ptr<ElementaryFile> CalypsoCardAdapter::getFileBySfi(const uin
         return nullptr;
     }
 
-    for (const auto& ef : mFiles) {
-        if (ef->getSfi() == sfi) {
-            return ef;
-        }
+    const std::shared_ptr<ElementaryFileAdapter> ef = findFileBySfi(sfi);
+    if (ef == nullptr) {
+        mLogger->trace("EF with SFI % is not found\n", sfi);
     }
 
-    mLogger->warn("EF with SFI % is not found\n", sfi);
-
-    return nullptr;
+    return ef;
 }
 
 const std::shared_ptr<ElementaryFile> CalypsoCardAdapter::getFileByLid(const uint16_t lid) const
 {
-    for (const auto& ef : mFiles) {
-        if (ef->getHeader() != nullptr && ef->getHeader()->getLid() == lid) {
-            return ef;
-        }
+    const auto it = mFilesByLid.find(lid);
+    if (it != mFilesByLid.end()) {
+        return it->second;
     }
 
-    mLogger->warn("EF with LID % is not found\n", lid);
+    mLogger->trace("EF with LID % is not found\n", lid);
 
     return nullptr;
 }
@@ -536,27 +536,81 @@ const std::shared_ptr<ElementaryFileAdapter> CalypsoCardAdapter::getOrCreateFile
 {
     if (mCurrentSfi != 0) {
         /* Search by SFI */
-        for (const auto& ef : mFiles) {
-            if (ef->getSfi() == mCurrentSfi) {
-                return std::dynamic_pointer_cast<ElementaryFileAdapter>(ef);
-            }
+        const std::shared_ptr<ElementaryFileAdapter> ef = findFileBySfi(mCurrentSfi);
+        if (ef != nullptr) {
+            return ef;
         }
     } else if (mCurrentLid != 0) {
         /* Search by LID */
-        for (const auto& ef : mFiles) {
-            if (ef->getHeader() != nullptr && ef->getHeader()->getLid() == mCurrentLid) {
-                return std::dynamic_pointer_cast<ElementaryFileAdapter>(ef);
-            }
+        const auto it = mFilesByLid.find(mCurrentLid);
+        if (it != mFilesByLid.end()) {
+            return it->second;
         }
     }
 
     /* Create a new EF with the provided SFI */
     const auto ef = std::make_shared<ElementaryFileAdapter>(mCurrentSfi);
     mFiles.push_back(ef);
+    indexFile(ef);
+
+    /* Nothing to copy, the EF will be dropped if the backup is restored */
+    if (mIsFilesBackupActive) {
+        mFilesBackup.insert({ef.get(), nullptr});
+    }
 
     return ef;
 }
 
+const std::shared_ptr<ElementaryFileAdapter> CalypsoCardAdapter::getOrCreateFileForUpdate()
+{
+    const std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFile();
+
+    if (mIsFilesBackupActive && mFilesBackup.find(ef.get()) == mFilesBackup.end()) {
+        mFilesBackup.insert({ef.get(), std::make_shared<ElementaryFileAdapter>(ef)});
+    }
+
+    return ef;
+}
+
+const std::shared_ptr<ElementaryFileAdapter> CalypsoCardAdapter::findFileBySfi(
+    const uint8_t sfi) const
+{
+    if (sfi < SFI_INDEX_SIZE) {
+        return mFilesBySfi[sfi];
+    }
+
+    /* Out of the range allowed by the Calypso specification, not indexed */
+    for (const auto& ef : mFiles) {
+        if (ef->getSfi() == sfi) {
+            return std::dynamic_pointer_cast<ElementaryFileAdapter>(ef);
+        }
+    }
+
+    return nullptr;
+}
+
+void CalypsoCardAdapter::indexFile(const std::shared_ptr<ElementaryFileAdapter> ef)
+{
+    const uint8_t sfi = ef->getSfi();
+    if (sfi != 0 && sfi < SFI_INDEX_SIZE && mFilesBySfi[sfi] == nullptr) {
+        mFilesBySfi[sfi] = ef;
+    }
+
+    if (ef->getHeader() != nullptr) {
+        mFilesByLid.insert({ef->getHeader()->getLid(), ef});
+    }
+}
+
+void CalypsoCardAdapter::reindexFiles()
+{
+    mFilesBySfi.fill(nullptr);
+    mFilesByLid.clear();
+
+    for (const auto& ef : mFiles) {
+        indexFile(std::dynamic_pointer_cast<ElementaryFileAdapter>(ef));
+    }
+}
+
 bool CalypsoCardAdapter::isPinBlocked() const
 {
     return getPinAttemptRemaining() == 0;
@@ -564,16 +618,16 @@ bool CalypsoCardAdapter::isPinBlocked() const
 
 int CalypsoCardAdapter::getPinAttemptRemaining() const
 {
-    if (mPinAttemptCounter == nullptr) {
+    if (!mPinAttemptCounter.has_value()) {
         throw IllegalStateException("PIN status has not been checked.");
     }
 
-    return *mPinAttemptCounter.get();
+    return *mPinAttemptCounter;
 }
 
 void CalypsoCardAdapter::setPinAttemptRemaining(const int pinAttemptCounter)
 {
-    mPinAttemptCounter = std::make_shared<int>(pinAttemptCounter);
+    mPinAttemptCounter = pinAttemptCounter;
 }
 
 void CalypsoCardAdapter::setFileHeader(const uint8_t sfi,
@@ -582,9 +636,10 @@ void CalypsoCardAdapter::setFileHeader(const uint8_t sfi,
     updateCurrentSfi(sfi);
     updateCurrentLid(header->getLid());
 
-    std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFile();
+    std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFileForUpdate();
     if (ef->getHeader() == nullptr) {
         ef->setHeader(header);
+        indexFile(ef);
     } else {
         std::dynamic_pointer_cast<FileHeaderAdapter>(ef->getHeader())
             ->updateMissingInfoFrom(header);
@@ -596,7 +651,7 @@ void CalypsoCardAdapter::setContent(const uint8_t sfi,
                                     const std::vector<uint8_t>& content)
 {
     updateCurrentSfi(sfi);
-    std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFile();
+    std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFileForUpdate();
     std::dynamic_pointer_cast<FileDataAdapter>(ef->getData())->setContent(numRecord, content);
 }
 
@@ -605,7 +660,7 @@ void CalypsoCardAdapter::setCounter(const uint8_t sfi,
                                     const std::vector<uint8_t>& content)
 {
     updateCurrentSfi(sfi);
-    std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFile();
+    std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFileForUpdate();
     std::dynamic_pointer_cast<FileDataAdapter>(ef->getData())->setCounter(numCounter, content);
 }
 
@@ -615,7 +670,7 @@ void CalypsoCardAdapter::setContent(const uint8_t sfi,
                                     const int offset)
 {
     updateCurrentSfi(sfi);
-    std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFile();
+    std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFileForUpdate();
     std::dynamic_pointer_cast<FileDataAdapter>(ef->getData())
         ->setContent(numRecord, content, offset);
 }
@@ -626,7 +681,7 @@ void CalypsoCardAdapter::fillContent(const uint8_t sfi,
                                      const int offset)
 {
     updateCurrentSfi(sfi);
-    std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFile();
+    std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFileForUpdate();
     std::dynamic_pointer_cast<FileDataAdapter>(ef->getData())
         ->fillContent(numRecord, content, offset);
 }
@@ -634,27 +689,51 @@ void CalypsoCardAdapter::fillContent(const uint8_t sfi,
 void CalypsoCardAdapter::addCyclicContent(const uint8_t sfi, const std::vector<uint8_t> content)
 {
     updateCurrentSfi(sfi);
-    std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFile();
+    std::shared_ptr<ElementaryFileAdapter> ef = getOrCreateFileForUpdate();
     std::dynamic_pointer_cast<FileDataAdapter>(ef->getData())->addCyclicContent(content);
 }
 
 void CalypsoCardAdapter::backupFiles()
 {
-    copyFiles(mFiles, mFilesBackup);
+    mFilesBackupSize = static_cast<int>(mFiles.size());
+    mFilesBackup.clear();
+    mIsFilesBackupActive = true;
 }
 
 void CalypsoCardAdapter::restoreFiles()
 {
-    copyFiles(mFilesBackup, mFiles);
+    if (!mIsFilesBackupActive) {
+        return;
+    }
+
+    mIsFilesBackupActive = false;
+
+    if (mFilesBackup.empty()) {
+        return;
+    }
+
+    mFiles.resize(mFilesBackupSize);
+
+    for (auto& ef : mFiles) {
+        const auto it = mFilesBackup.find(ef.get());
+        if (it != mFilesBackup.end()) {
+            ef = it->second;
+        }
+    }
+
+    mFilesBackup.clear();
+    reindexFiles();
 }
 
-void CalypsoCardAdapter::copyFiles(const std::vector<std::shared_ptr<ElementaryFile>>& src,
-                                   std::vector<std::shared_ptr<ElementaryFile>>& dest)
+void CalypsoCardAdapter::commitFiles()
 {
-    dest.clear();
-    for (const auto& file : src) {
-        dest.push_back(std::make_shared<ElementaryFileAdapter>(file));
-    }
+    mIsFilesBackupActive = false;
+    mFilesBackup.clear();
+}
+
+int CalypsoCardAdapter::getFilesBackupCount() const
+{
+    return static_cast<int>(mFilesBackup.size());
 }
 
 const std::string& CalypsoCardAdapter::getPowerOnData() const
@@ -740,12 +819,17 @@ std::ostream& operator<<(std::ostream& os, const CalypsoCardAdapter& cca)
        << "IS_MODIFICATION_COUNTER_IN_BYTES: " << cca.mIsModificationCounterInBytes << ", "
        << "DIRECTORY_HEADER: " << cca.mDirectoryHeader << ", "
        << "FILES: " << cca.mFiles << ", "
-       << "FILES_BACKUP: " << cca.mFilesBackup << ", "
+       << "FILES_BACKUP_SIZE: " << cca.mFilesBackupSize << ", "
+       << "IS_FILES_BACKUP_ACTIVE: " << cca.mIsFilesBackupActive << ", "
        << "CURRENT_SFI: " << cca.mCurrentSfi << ", "
        << "CURRENT_LID: " << cca.mCurrentLid << ", "
        << "ID_DF_RATIFIED: " << cca.mIsDfRatified << ", "
-       << "PIN_ATTEMPT_COUNTER: " << cca.mPinAttemptCounter << ", "
-       << "SV_BALANCE: " << cca.mSvBalance << ", "
+       << "PIN_ATTEMPT_COUNTER: "
+       << (cca.mPinAttemptCounter.has_value() ? std::to_string(*cca.mPinAttemptCounter) : "null")
+       << ", "
+       << "SV_BALANCE: "
+       << (cca.mSvBalance.has_value() ? std::to_string(*cca.mSvBalance) : "null")
+       << ", "
        << "SV_LAST_T_NUM: " << cca.mSvLastTNum << ", "
        << "SV_LOAD_LOG_RECORD: " << cca.mSvLoadLogRecord << ", "
        << "SV_DEBIT_LOG_RECORD: " << cca.mSvDebitLogRecord << ", "
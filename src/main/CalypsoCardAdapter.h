@@ -12,10 +12,13 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <ostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /* Calypsonet Terminal Calypso */
@@ -30,6 +33,7 @@
 /* Keyple Card Calypso */
 #include "CalypsoCardClass.h"
 #include "ElementaryFileAdapter.h"
+#include "Optional.h"
 
 /* Keyple Core Util */
 #include "LoggerFactory.h"
@@ -504,7 +508,10 @@ public:
     /**
      * (package-private)<br>
      * Make a backup of the Elementary Files.<br>
-     * This method should be used before starting a card secure session.
+     * This method should be used before starting a card secure session.<br>
+     * No file is copied here: each file is copied before its first update following the backup.
+     * The files are only copied while a backup is active, i.e. until restoreFiles() or
+     * commitFiles() is called.
      *
      * @since 2.0.0
      */
@@ -520,6 +527,24 @@ public:
      */
     void restoreFiles();
 
+    /**
+     * (package-private)<br>
+     * Drop the last backup of Elementary Files.<br>
+     * This method should be used when SW of the card close secure session command is successful.
+     *
+     * @since 2.1.1
+     */
+    void commitFiles();
+
+    /**
+     * (package-private)<br>
+     * Gets the number of files copied or created since the last backup.
+     *
+     * @return 0 if no backup is active.
+     * @since 2.1.1
+     */
+    int getFilesBackupCount() const;
+
     /**
      * {@inheritDoc}
      *
@@ -748,9 +773,37 @@ private:
     std::vector<std::shared_ptr<ElementaryFile>> mFiles;
 
     /**
-     *
+     * Number of files of mFiles when the last backup was made, the files added afterwards are
+     * dropped when restoring.
+     */
+    int mFilesBackupSize;
+
+    /**
+     * Copies of the files modified since the last backup, made before their first modification.
+     * A null copy identifies a file created since the last backup.
+     */
+    std::unordered_map<const ElementaryFile*, std::shared_ptr<ElementaryFile>> mFilesBackup;
+
+    /**
+     * True between backupFiles() and restoreFiles() or commitFiles(), the updated files are
+     * copied to mFilesBackup only in this interval.
+     */
+    bool mIsFilesBackupActive;
+
+    /**
+     * Size of the SFI index: SFI values range from 1 to 30, 0 means "no SFI".
+     */
+    static const int SFI_INDEX_SIZE = 31;
+
+    /**
+     * Direct index of the files of mFiles having a non-zero SFI.
      */
-    std::vector<std::shared_ptr<ElementaryFile>> mFilesBackup;
+    std::array<std::shared_ptr<ElementaryFileAdapter>, SFI_INDEX_SIZE> mFilesBySfi;
+
+    /**
+     * Index of the files of mFiles having a header, by LID.
+     */
+    std::unordered_map<uint16_t, std::shared_ptr<ElementaryFileAdapter>> mFilesByLid;
 
     /**
      *
@@ -770,12 +823,12 @@ private:
     /**
      *
      */
-    std::shared_ptr<int> mPinAttemptCounter;
+    Optional<int> mPinAttemptCounter;
 
     /**
      *
      */
-    std::shared_ptr<int> mSvBalance;
+    Optional<int> mSvBalance;
 
     /**
      *
@@ -877,15 +930,42 @@ private:
      */
     const std::shared_ptr<ElementaryFileAdapter> getOrCreateFile();
 
-     /**
+    /**
+     * (private)<br>
+     * Gets the EF having the provided non-zero SFI.
+     *
+     * @param sfi The SFI.
+     * @return Null if the EF is not found.
+     */
+    const std::shared_ptr<ElementaryFileAdapter> findFileBySfi(const uint8_t sfi) const;
+
+    /**
+     * (private)<br>
+     * Adds an EF of mFiles to the SFI and LID indexes.
+     *
+     * <p>The first file registered for a given SFI or LID is kept, as the former linear searches
+     * did.
+     *
+     * @param ef The EF.
+     */
+    void indexFile(const std::shared_ptr<ElementaryFileAdapter> ef);
+
+    /**
      * (private)<br>
-     * Copy a set of ElementaryFile to another one by cloning each element.
+     * Rebuilds the SFI and LID indexes from mFiles.
+     */
+    void reindexFiles();
+
+    /**
+     * (private)<br>
+     * Gets the EF targeted by the current SFI or LID (see getOrCreateFile()) before updating it.
      *
-     * @param src the source (should be not null).
-     * @param dest the destination (should be not null).
+     * <p>A copy of the EF is kept for restoreFiles() if a backup is active and it is the first
+     * update of the EF since this backup.
+     *
+     * @return a not null reference.
      */
-    static void copyFiles(const std::vector<std::shared_ptr<ElementaryFile>>& src,
-                          std::vector<std::shared_ptr<ElementaryFile>>& dest);
+    const std::shared_ptr<ElementaryFileAdapter> getOrCreateFileForUpdate();
 };
 
 }
@@ -16,44 +16,77 @@ namespace keyple {
 namespace card {
 namespace calypso {
 
-const CalypsoCardCommand CalypsoCardCommand::NONE("None", 0x00);
-const CalypsoCardCommand CalypsoCardCommand::GET_DATA("Get Data", 0xCA);
-const CalypsoCardCommand CalypsoCardCommand::OPEN_SESSION("Open Secure Session", 0x8A);
-const CalypsoCardCommand CalypsoCardCommand::CLOSE_SESSION("Close Secure Session", 0x8E);
-const CalypsoCardCommand CalypsoCardCommand::READ_RECORDS("Read Records", 0xB2);
-const CalypsoCardCommand CalypsoCardCommand::UPDATE_RECORD("Update Record", 0xDC);
-const CalypsoCardCommand CalypsoCardCommand::WRITE_RECORD("Write Record", 0xD2);
-const CalypsoCardCommand CalypsoCardCommand::APPEND_RECORD("Append Record", 0xE2);
-const CalypsoCardCommand CalypsoCardCommand::READ_BINARY("Read Binary", 0xB0);
-const CalypsoCardCommand CalypsoCardCommand::UPDATE_BINARY("Update Binary", 0xD6);
-const CalypsoCardCommand CalypsoCardCommand::WRITE_BINARY("Write Binary", 0xD0);
-const CalypsoCardCommand CalypsoCardCommand::SEARCH_RECORD_MULTIPLE("Search Record Multiple", 0xA2);
-const CalypsoCardCommand CalypsoCardCommand::READ_RECORD_MULTIPLE("Read Record Multiple", 0xB3);
-const CalypsoCardCommand CalypsoCardCommand::GET_CHALLENGE("Get Challenge", 0x84);
-const CalypsoCardCommand CalypsoCardCommand::INCREASE("Increase", 0x32);
-const CalypsoCardCommand CalypsoCardCommand::DECREASE("Decrease", 0x30);
-const CalypsoCardCommand CalypsoCardCommand::INCREASE_MULTIPLE("Increase Multiple", 0x3A);
-const CalypsoCardCommand CalypsoCardCommand::DECREASE_MULTIPLE("Decrease Multiple", 0x38);
-const CalypsoCardCommand CalypsoCardCommand::SELECT_FILE("Select File", 0xA4);
-const CalypsoCardCommand CalypsoCardCommand::CHANGE_KEY("Change Key", 0xD8);
-const CalypsoCardCommand CalypsoCardCommand::CHANGE_PIN("Change PIN", 0xD8);
-const CalypsoCardCommand CalypsoCardCommand::VERIFY_PIN("Verify PIN", 0x20);
-const CalypsoCardCommand CalypsoCardCommand::SV_GET("SV Get", 0x7C);
-const CalypsoCardCommand CalypsoCardCommand::SV_DEBIT("SV Debit", 0xBA);
-const CalypsoCardCommand CalypsoCardCommand::SV_RELOAD("SV Reload", 0xB8);
-const CalypsoCardCommand CalypsoCardCommand::SV_UNDEBIT("SV Undebit", 0xBC);
-const CalypsoCardCommand CalypsoCardCommand::INVALIDATE("Invalidate", 0x04);
-const CalypsoCardCommand CalypsoCardCommand::REHABILITATE("Invalidate", 0x44);
+/* The names of the commands, indexed by identifier */
+static constexpr const char* const NAMES[] = {
+    "None",
+    "Get Data",
+    "Open Secure Session",
+    "Close Secure Session",
+    "Read Records",
+    "Update Record",
+    "Write Record",
+    "Append Record",
+    "Read Binary",
+    "Update Binary",
+    "Write Binary",
+    "Search Record Multiple",
+    "Read Record Multiple",
+    "Get Challenge",
+    "Increase",
+    "Decrease",
+    "Increase Multiple",
+    "Decrease Multiple",
+    "Select File",
+    "Change Key",
+    "Change PIN",
+    "Verify PIN",
+    "SV Get",
+    "SV Debit",
+    "SV Reload",
+    "SV Undebit",
+    "Invalidate",
+    "Rehabilitate"};
 
-CalypsoCardCommand::CalypsoCardCommand(const std::string& name, const uint8_t instructionByte)
-: mName(name), mInstructionByte(instructionByte) {}
+static_assert(sizeof(NAMES) / sizeof(NAMES[0]) == CalypsoCardCommand::ID_COUNT,
+              "One name is expected per command identifier");
 
-CalypsoCardCommand::CalypsoCardCommand(const CalypsoCardCommand& o)
-: mName(o.mName), mInstructionByte(o.mInstructionByte) {}
+const CalypsoCardCommand CalypsoCardCommand::NONE(Id::NONE, 0x00);
+const CalypsoCardCommand CalypsoCardCommand::GET_DATA(Id::GET_DATA, 0xCA);
+const CalypsoCardCommand CalypsoCardCommand::OPEN_SESSION(Id::OPEN_SESSION, 0x8A);
+const CalypsoCardCommand CalypsoCardCommand::CLOSE_SESSION(Id::CLOSE_SESSION, 0x8E);
+const CalypsoCardCommand CalypsoCardCommand::READ_RECORDS(Id::READ_RECORDS, 0xB2);
+const CalypsoCardCommand CalypsoCardCommand::UPDATE_RECORD(Id::UPDATE_RECORD, 0xDC);
+const CalypsoCardCommand CalypsoCardCommand::WRITE_RECORD(Id::WRITE_RECORD, 0xD2);
+const CalypsoCardCommand CalypsoCardCommand::APPEND_RECORD(Id::APPEND_RECORD, 0xE2);
+const CalypsoCardCommand CalypsoCardCommand::READ_BINARY(Id::READ_BINARY, 0xB0);
+const CalypsoCardCommand CalypsoCardCommand::UPDATE_BINARY(Id::UPDATE_BINARY, 0xD6);
+const CalypsoCardCommand CalypsoCardCommand::WRITE_BINARY(Id::WRITE_BINARY, 0xD0);
+const CalypsoCardCommand CalypsoCardCommand::SEARCH_RECORD_MULTIPLE(Id::SEARCH_RECORD_MULTIPLE, 0xA2);
+const CalypsoCardCommand CalypsoCardCommand::READ_RECORD_MULTIPLE(Id::READ_RECORD_MULTIPLE, 0xB3);
+const CalypsoCardCommand CalypsoCardCommand::GET_CHALLENGE(Id::GET_CHALLENGE, 0x84);
+const CalypsoCardCommand CalypsoCardCommand::INCREASE(Id::INCREASE, 0x32);
+const CalypsoCardCommand CalypsoCardCommand::DECREASE(Id::DECREASE, 0x30);
+const CalypsoCardCommand CalypsoCardCommand::INCREASE_MULTIPLE(Id::INCREASE_MULTIPLE, 0x3A);
+const CalypsoCardCommand CalypsoCardCommand::DECREASE_MULTIPLE(Id::DECREASE_MULTIPLE, 0x38);
+const CalypsoCardCommand CalypsoCardCommand::SELECT_FILE(Id::SELECT_FILE, 0xA4);
+const CalypsoCardCommand CalypsoCardCommand::CHANGE_KEY(Id::CHANGE_KEY, 0xD8);
+const CalypsoCardCommand CalypsoCardCommand::CHANGE_PIN(Id::CHANGE_PIN, 0xD8);
+const CalypsoCardCommand CalypsoCardCommand::VERIFY_PIN(Id::VERIFY_PIN, 0x20);
+const CalypsoCardCommand CalypsoCardCommand::SV_GET(Id::SV_GET, 0x7C);
+const CalypsoCardCommand CalypsoCardCommand::SV_DEBIT(Id::SV_DEBIT, 0xBA);
+const CalypsoCardCommand CalypsoCardCommand::SV_RELOAD(Id::SV_RELOAD, 0xB8);
+const CalypsoCardCommand CalypsoCardCommand::SV_UNDEBIT(Id::SV_UNDEBIT, 0xBC);
+const CalypsoCardCommand CalypsoCardCommand::INVALIDATE(Id::INVALIDATE, 0x04);
+const CalypsoCardCommand CalypsoCardCommand::REHABILITATE(Id::REHABILITATE, 0x44);
 
-const std::string& CalypsoCardCommand::getName() const
+CalypsoCardCommand::Id CalypsoCardCommand::getId() const
 {
-    return mName;
+    return mId;
+}
+
+const char* CalypsoCardCommand::getName() const
+{
+    return NAMES[static_cast<std::size_t>(mId)];
 }
 
 uint8_t CalypsoCardCommand::getInstructionByte() const
@@ -63,8 +96,7 @@ uint8_t CalypsoCardCommand::getInstructionByte() const
 
 bool CalypsoCardCommand::operator==(const CalypsoCardCommand& o) const
 {
-    return mName == o.mName &&
-           mInstructionByte == o.mInstructionByte;
+    return mId == o.mId;
 }
 
 bool CalypsoCardCommand::operator!=(const CalypsoCardCommand& o) const
@@ -72,14 +104,6 @@ bool CalypsoCardCommand::operator!=(const CalypsoCardCommand& o) const
     return !(*this == o);
 }
 
-CalypsoCardCommand& CalypsoCardCommand::operator=(const CalypsoCardCommand& o)
-{
-    mName = o.mName;
-    mInstructionByte = o.mInstructionByte;
-
-    return *this;
-}
-
 }
 }
 }
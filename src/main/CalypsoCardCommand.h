@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
 
 /* Keyple Card Calypso */
@@ -30,6 +32,49 @@ namespace calypso {
  */
 class CalypsoCardCommand : public CardCommand {
 public:
+    /**
+     * Compact identifier of a command, used for equality, hashing and switch dispatch.
+     *
+     * @since 2.1.1
+     */
+    enum class Id : uint8_t {
+        NONE,
+        GET_DATA,
+        OPEN_SESSION,
+        CLOSE_SESSION,
+        READ_RECORDS,
+        UPDATE_RECORD,
+        WRITE_RECORD,
+        APPEND_RECORD,
+        READ_BINARY,
+        UPDATE_BINARY,
+        WRITE_BINARY,
+        SEARCH_RECORD_MULTIPLE,
+        READ_RECORD_MULTIPLE,
+        GET_CHALLENGE,
+        INCREASE,
+        DECREASE,
+        INCREASE_MULTIPLE,
+        DECREASE_MULTIPLE,
+        SELECT_FILE,
+        CHANGE_KEY,
+        CHANGE_PIN,
+        VERIFY_PIN,
+        SV_GET,
+        SV_DEBIT,
+        SV_RELOAD,
+        SV_UNDEBIT,
+        INVALIDATE,
+        REHABILITATE,
+    };
+
+    /**
+     * The number of identifiers, for the tables indexed by identifier.
+     *
+     * @since 2.1.1
+     */
+    static constexpr std::size_t ID_COUNT = static_cast<std::size_t>(Id::REHABILITATE) + 1;
+
     /** no command yet */
     static const CalypsoCardCommand NONE;
 
@@ -125,25 +170,34 @@ public:
     bool operator!=(const CalypsoCardCommand& o) const;
 
     /**
+     * Gets the identifier of the command.
      *
+     * @return An identifier.
+     * @since 2.1.1
      */
-    CalypsoCardCommand& operator=(const CalypsoCardCommand& o);
+    Id getId() const;
 
     /**
+     * Gets the name, for display purpose only.
      *
+     * @return A null-terminated string.
+     * @since 2.0.0
      */
-    CalypsoCardCommand(const CalypsoCardCommand& o);
+    const char* getName() const override;
 
-    /**default
+    /**
+     * Gets the instruction byte (INS).
+     *
+     * @return A byte
      * @since 2.0.0
      */
-    uint8_t getInstructionByte() const;
+    uint8_t getInstructionByte() const override;
 
 private:
     /**
-     * The command name
+     * The command identifier
      */
-    std::string mName;
+    Id mId;
 
     /**
      * The instruction byte
@@ -153,21 +207,32 @@ private:
     /**
      * The generic constructor of CalypsoCommands.
      *
-     * @param name the name.
-     * @param instructionByte the instruction byte.
-     * @since 2.0.0
-     */
-    CalypsoCardCommand(const std::string& name, const uint8_t instructionByte);
-
-    /**
-     * Gets the name.
+     * <p>Being constexpr, the static instances are constant-initialized and can safely be copied
+     * during the dynamic initialization of other translation units.
      *
-     * @return A String
+     * @param id the identifier.
+     * @param instructionByte the instruction byte.
      * @since 2.0.0
      */
-    const std::string& getName() const;
+    constexpr CalypsoCardCommand(const Id id, const uint8_t instructionByte)
+    : mId(id), mInstructionByte(instructionByte) {}
 };
 
 }
 }
 }
+
+namespace std {
+
+/**
+ * Hashes a CalypsoCardCommand on its identifier.
+ */
+template <>
+struct hash<keyple::card::calypso::CalypsoCardCommand> {
+    size_t operator()(const keyple::card::calypso::CalypsoCardCommand& command) const
+    {
+        return static_cast<size_t>(command.getId());
+    }
+};
+
+}
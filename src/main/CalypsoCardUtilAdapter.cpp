@@ -12,6 +12,9 @@
 
 #include "CalypsoCardUtilAdapter.h"
 
+#include <cstddef>
+#include <typeinfo>
+
 /* Keyple Card Calypso */
 #include "CalypsoCardCommand.h"
 #include "CalypsoCardConstant.h"
@@ -19,8 +22,13 @@
 #include "CardPinException.h"
 #include "CmdCardGetDataFci.h"
 #include "CmdCardGetDataFcp.h"
+#include "CmdCardInvalidate.h"
+#include "CmdCardRehabilitate.h"
 #include "CmdCardSearchRecordMultiple.h"
 #include "CmdCardSelectFile.h"
+#include "CmdCardSvDebit.h"
+#include "CmdCardSvReload.h"
+#include "CmdCardSvUndebit.h"
 #include "DirectoryHeaderAdapter.h"
 
 /* Keyple Core Util */
@@ -37,131 +45,156 @@ using namespace keyple::core::util::cpp::exception;
 
 CalypsoCardUtilAdapter::CalypsoCardUtilAdapter() {}
 
-void CalypsoCardUtilAdapter::updateCalypsoCard(
+template <typename C,
+          void (*Handler)(std::shared_ptr<CalypsoCardAdapter>,
+                          std::shared_ptr<C>,
+                          std::shared_ptr<ApduResponseApi>)>
+void CalypsoCardUtilAdapter::dispatchWithCard(
     std::shared_ptr<CalypsoCardAdapter> calypsoCard,
     const std::shared_ptr<AbstractCardCommand> command,
     const std::shared_ptr<ApduResponseApi> apduResponse,
     const bool isSessionOpen)
 {
-    if (command->getCommandRef() == CalypsoCardCommand::READ_RECORDS) {
-        updateCalypsoCardReadRecords(calypsoCard,
-                                     std::dynamic_pointer_cast<CmdCardReadRecords>(command),
-                                     apduResponse,
-                                     isSessionOpen);
-    } else if (command->getCommandRef() == CalypsoCardCommand::GET_DATA) {
-        if (std::dynamic_pointer_cast<CmdCardGetDataFci>(command)) {
-            calypsoCard->initializeWithFci(apduResponse);
-        } else if (std::dynamic_pointer_cast<CmdCardGetDataFcp>(command)) {
-            updateCalypsoCardWithFcp(calypsoCard, command, apduResponse);
-        } else if (std::dynamic_pointer_cast<CmdCardGetDataEfList>(command)) {
-            updateCalypsoCardWithEfList(calypsoCard,
-                                        std::dynamic_pointer_cast<CmdCardGetDataEfList>(command),
-                                        apduResponse);
-        } else if (std::dynamic_pointer_cast<CmdCardGetDataTraceabilityInformation>(command)) {
-            updateCalypsoCardWithTraceabilityInformation(
-                calypsoCard,
-                std::dynamic_pointer_cast<CmdCardGetDataTraceabilityInformation>(command),
-                apduResponse);
-        } else {
-            throw IllegalStateException("Unknown GET DATA command reference.");
-        }
-    } else if (command->getCommandRef() == CalypsoCardCommand::SEARCH_RECORD_MULTIPLE) {
-        updateCalypsoCardSearchRecordMultiple(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardSearchRecordMultiple>(command),
-            apduResponse,
-            isSessionOpen);
-    } else if (command->getCommandRef() == CalypsoCardCommand::READ_RECORD_MULTIPLE) {
-        updateCalypsoCardReadRecordMultiple(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardReadRecordMultiple>(command),
-            apduResponse,
-            isSessionOpen);
-    } else if (command->getCommandRef() == CalypsoCardCommand::SELECT_FILE) {
-        updateCalypsoCardWithFcp(calypsoCard, command, apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::UPDATE_RECORD) {
-        updateCalypsoCardUpdateRecord(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardUpdateRecord>(command),
-            apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::WRITE_RECORD) {
-        updateCalypsoCardWriteRecord(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardWriteRecord>(command),
-            apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::APPEND_RECORD) {
-        updateCalypsoCardAppendRecord(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardAppendRecord>(command),
-            apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::INCREASE ||
-               command->getCommandRef() == CalypsoCardCommand::DECREASE) {
-        updateCalypsoCardIncreaseOrDecrease(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardIncreaseOrDecrease>(command),
-            apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::INCREASE_MULTIPLE ||
-               command->getCommandRef() == CalypsoCardCommand::DECREASE_MULTIPLE) {
-        updateCalypsoCardIncreaseOrDecreaseMultiple(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardIncreaseOrDecreaseMultiple>(command),
-            apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::OPEN_SESSION) {
-        updateCalypsoCardOpenSession(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardOpenSession>(command),
-            apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::CLOSE_SESSION) {
-        updateCalypsoCardCloseSession(
-            std::dynamic_pointer_cast<CmdCardCloseSession>(command),
-            apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::READ_BINARY) {
-        updateCalypsoCardReadBinary(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardReadBinary>(command),
-            apduResponse,
-            isSessionOpen);
-    } else if (command->getCommandRef() == CalypsoCardCommand::UPDATE_BINARY) {
-        updateCalypsoCardUpdateBinary(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardUpdateOrWriteBinary>(command),
-            apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::WRITE_BINARY) {
-        updateCalypsoCardWriteBinary(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardUpdateOrWriteBinary>(command),
-            apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::GET_CHALLENGE) {
-        updateCalypsoCardGetChallenge(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardGetChallenge>(command),
-            apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::VERIFY_PIN) {
-        updateCalypsoVerifyPin(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardVerifyPin>(command),
-            apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::SV_GET) {
-        updateCalypsoCardSvGet(
-            calypsoCard,
-            std::dynamic_pointer_cast<CmdCardSvGet>(command),
-            apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::SV_RELOAD ||
-               command->getCommandRef() == CalypsoCardCommand::SV_DEBIT ||
-               command->getCommandRef() == CalypsoCardCommand::SV_UNDEBIT) {
-        updateCalypsoCardSvOperation(calypsoCard, command, apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::INVALIDATE ||
-               command->getCommandRef() == CalypsoCardCommand::REHABILITATE) {
-        updateCalypsoInvalidateRehabilitate(command, apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::CHANGE_PIN) {
-        updateCalypsoChangePin(std::dynamic_pointer_cast<CmdCardChangePin>(command), apduResponse);
-    } else if (command->getCommandRef() == CalypsoCardCommand::CHANGE_KEY) {
-        updateCalypsoChangeKey(std::dynamic_pointer_cast<CmdCardChangeKey>(command), apduResponse);
+    (void)isSessionOpen;
+
+    /* The command reference determines the type of the command */
+    Handler(calypsoCard, std::static_pointer_cast<C>(command), apduResponse);
+}
+
+template <typename C,
+          void (*Handler)(std::shared_ptr<CalypsoCardAdapter>,
+                          std::shared_ptr<C>,
+                          std::shared_ptr<ApduResponseApi>,
+                          bool)>
+void CalypsoCardUtilAdapter::dispatchWithSessionState(
+    std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+    const std::shared_ptr<AbstractCardCommand> command,
+    const std::shared_ptr<ApduResponseApi> apduResponse,
+    const bool isSessionOpen)
+{
+    Handler(calypsoCard, std::static_pointer_cast<C>(command), apduResponse, isSessionOpen);
+}
+
+template <typename C, void (*Handler)(std::shared_ptr<C>, std::shared_ptr<ApduResponseApi>)>
+void CalypsoCardUtilAdapter::dispatchWithoutCard(
+    std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+    const std::shared_ptr<AbstractCardCommand> command,
+    const std::shared_ptr<ApduResponseApi> apduResponse,
+    const bool isSessionOpen)
+{
+    (void)calypsoCard;
+    (void)isSessionOpen;
+
+    Handler(std::static_pointer_cast<C>(command), apduResponse);
+}
+
+void CalypsoCardUtilAdapter::dispatchGetData(
+    std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+    const std::shared_ptr<AbstractCardCommand> command,
+    const std::shared_ptr<ApduResponseApi> apduResponse,
+    const bool isSessionOpen)
+{
+    const std::type_info& type = typeid(*command);
+
+    if (type == typeid(CmdCardGetDataFci)) {
+        dispatchWithCard<CmdCardGetDataFci, updateCalypsoCardWithFci>(
+            calypsoCard, command, apduResponse, isSessionOpen);
+    } else if (type == typeid(CmdCardGetDataFcp)) {
+        dispatchWithCard<AbstractCardCommand, updateCalypsoCardWithFcp>(
+            calypsoCard, command, apduResponse, isSessionOpen);
+    } else if (type == typeid(CmdCardGetDataEfList)) {
+        dispatchWithCard<CmdCardGetDataEfList, updateCalypsoCardWithEfList>(
+            calypsoCard, command, apduResponse, isSessionOpen);
+    } else if (type == typeid(CmdCardGetDataTraceabilityInformation)) {
+        dispatchWithCard<CmdCardGetDataTraceabilityInformation,
+                         updateCalypsoCardWithTraceabilityInformation>(
+            calypsoCard, command, apduResponse, isSessionOpen);
     } else {
         throw IllegalStateException("Unknown command reference.");
     }
 }
 
+/* In the order of CalypsoCardCommand::Id */
+const CalypsoCardUtilAdapter::ResponseHandler CalypsoCardUtilAdapter::RESPONSE_HANDLERS[] = {
+    /* NONE */
+    nullptr,
+    /* GET_DATA */
+    &dispatchGetData,
+    /* OPEN_SESSION */
+    &dispatchWithCard<CmdCardOpenSession, updateCalypsoCardOpenSession>,
+    /* CLOSE_SESSION */
+    &dispatchWithoutCard<CmdCardCloseSession, updateCalypsoCardCloseSession>,
+    /* READ_RECORDS */
+    &dispatchWithSessionState<CmdCardReadRecords, updateCalypsoCardReadRecords>,
+    /* UPDATE_RECORD */
+    &dispatchWithCard<CmdCardUpdateRecord, updateCalypsoCardUpdateRecord>,
+    /* WRITE_RECORD */
+    &dispatchWithCard<CmdCardWriteRecord, updateCalypsoCardWriteRecord>,
+    /* APPEND_RECORD */
+    &dispatchWithCard<CmdCardAppendRecord, updateCalypsoCardAppendRecord>,
+    /* READ_BINARY */
+    &dispatchWithSessionState<CmdCardReadBinary, updateCalypsoCardReadBinary>,
+    /* UPDATE_BINARY */
+    &dispatchWithCard<CmdCardUpdateOrWriteBinary, updateCalypsoCardUpdateOrWriteBinary>,
+    /* WRITE_BINARY */
+    &dispatchWithCard<CmdCardUpdateOrWriteBinary, updateCalypsoCardUpdateOrWriteBinary>,
+    /* SEARCH_RECORD_MULTIPLE */
+    &dispatchWithSessionState<CmdCardSearchRecordMultiple, updateCalypsoCardSearchRecordMultiple>,
+    /* READ_RECORD_MULTIPLE */
+    &dispatchWithSessionState<CmdCardReadRecordMultiple, updateCalypsoCardReadRecordMultiple>,
+    /* GET_CHALLENGE */
+    &dispatchWithCard<CmdCardGetChallenge, updateCalypsoCardGetChallenge>,
+    /* INCREASE */
+    &dispatchWithCard<CmdCardIncreaseOrDecrease, updateCalypsoCardIncreaseOrDecrease>,
+    /* DECREASE */
+    &dispatchWithCard<CmdCardIncreaseOrDecrease, updateCalypsoCardIncreaseOrDecrease>,
+    /* INCREASE_MULTIPLE */
+    &dispatchWithCard<CmdCardIncreaseOrDecreaseMultiple,
+                      updateCalypsoCardIncreaseOrDecreaseMultiple>,
+    /* DECREASE_MULTIPLE */
+    &dispatchWithCard<CmdCardIncreaseOrDecreaseMultiple,
+                      updateCalypsoCardIncreaseOrDecreaseMultiple>,
+    /* SELECT_FILE */
+    &dispatchWithCard<AbstractCardCommand, updateCalypsoCardWithFcp>,
+    /* CHANGE_KEY */
+    &dispatchWithoutCard<CmdCardChangeKey, updateCalypsoChangeKey>,
+    /* CHANGE_PIN */
+    &dispatchWithoutCard<CmdCardChangePin, updateCalypsoChangePin>,
+    /* VERIFY_PIN */
+    &dispatchWithCard<CmdCardVerifyPin, updateCalypsoVerifyPin>,
+    /* SV_GET */
+    &dispatchWithCard<CmdCardSvGet, updateCalypsoCardSvGet>,
+    /* SV_DEBIT */
+    &dispatchWithCard<AbstractCardCommand, updateCalypsoCardSvOperation>,
+    /* SV_RELOAD */
+    &dispatchWithCard<AbstractCardCommand, updateCalypsoCardSvOperation>,
+    /* SV_UNDEBIT */
+    &dispatchWithCard<AbstractCardCommand, updateCalypsoCardSvOperation>,
+    /* INVALIDATE */
+    &dispatchWithoutCard<AbstractCardCommand, updateCalypsoInvalidateRehabilitate>,
+    /* REHABILITATE */
+    &dispatchWithoutCard<AbstractCardCommand, updateCalypsoInvalidateRehabilitate>,
+};
+
+void CalypsoCardUtilAdapter::updateCalypsoCard(
+    std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+    const std::shared_ptr<AbstractCardCommand> command,
+    const std::shared_ptr<ApduResponseApi> apduResponse,
+    const bool isSessionOpen)
+{
+    static_assert(sizeof(RESPONSE_HANDLERS) / sizeof(RESPONSE_HANDLERS[0]) ==
+                      CalypsoCardCommand::ID_COUNT,
+                  "One response handler is expected per command identifier");
+
+    const ResponseHandler handler =
+        RESPONSE_HANDLERS[static_cast<std::size_t>(command->getCommandRef().getId())];
+    if (handler == nullptr) {
+        throw IllegalStateException("Unknown command reference.");
+    }
+
+    handler(calypsoCard, command, apduResponse, isSessionOpen);
+}
+
 void CalypsoCardUtilAdapter::updateCalypsoCard(
     std::shared_ptr<CalypsoCardAdapter> calypsoCard,
     const std::vector<std::shared_ptr<AbstractCardCommand>>& commands,
@@ -178,6 +211,28 @@ void CalypsoCardUtilAdapter::updateCalypsoCard(
     }
 }
 
+void CalypsoCardUtilAdapter::updateCalypsoCardWithFci(
+    std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+    std::shared_ptr<CmdCardGetDataFci> cmdCardGetDataFci,
+    const std::shared_ptr<ApduResponseApi> apduResponse)
+{
+    (void)cmdCardGetDataFci;
+
+    calypsoCard->initializeWithFci(apduResponse);
+}
+
+void CalypsoCardUtilAdapter::updateCalypsoCardUpdateOrWriteBinary(
+    std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+    std::shared_ptr<CmdCardUpdateOrWriteBinary> cmdCardUpdateOrWriteBinary,
+    const std::shared_ptr<ApduResponseApi> apduResponse)
+{
+    if (cmdCardUpdateOrWriteBinary->getCommandRef() == CalypsoCardCommand::UPDATE_BINARY) {
+        updateCalypsoCardUpdateBinary(calypsoCard, cmdCardUpdateOrWriteBinary, apduResponse);
+    } else {
+        updateCalypsoCardWriteBinary(calypsoCard, cmdCardUpdateOrWriteBinary, apduResponse);
+    }
+}
+
 void CalypsoCardUtilAdapter::updateCalypsoCardOpenSession(
     std::shared_ptr<CalypsoCardAdapter> calypsoCard,
     std::shared_ptr<CmdCardOpenSession> cmdCardOpenSession,
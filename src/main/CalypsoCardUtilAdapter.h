@@ -26,6 +26,7 @@
 #include "CmdCardCloseSession.h"
 #include "CmdCardGetChallenge.h"
 #include "CmdCardGetDataEfList.h"
+#include "CmdCardGetDataFci.h"
 #include "CmdCardGetDataTraceabilityInformation.h"
 #include "CmdCardIncreaseOrDecrease.h"
 #include "CmdCardIncreaseOrDecreaseMultiple.h"
@@ -91,11 +92,104 @@ public:
         const bool isSessionOpen);
 
 private:
+    /**
+     * (private)<br>
+     * Common signature of the functions updating the card with the response to a command.
+     */
+    typedef void (*ResponseHandler)(std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+                                    const std::shared_ptr<AbstractCardCommand> command,
+                                    const std::shared_ptr<ApduResponseApi> apduResponse,
+                                    const bool isSessionOpen);
+
+    /**
+     * (private)<br>
+     * Response handlers indexed by the identifier of the command reference (see
+     * CalypsoCardCommand::Id), null for the identifiers without response handling.
+     */
+    static const ResponseHandler RESPONSE_HANDLERS[];
+
     /**
      * Private constructor
      */
     CalypsoCardUtilAdapter();
 
+    /**
+     * (private)<br>
+     * Dispatches the response to one of the "Get Data" commands, which share the same command
+     * reference, according to the type of the command.
+     */
+    static void dispatchGetData(std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+                                const std::shared_ptr<AbstractCardCommand> command,
+                                const std::shared_ptr<ApduResponseApi> apduResponse,
+                                const bool isSessionOpen);
+
+    /**
+     * (private)<br>
+     * Adapts a handler taking the card, the command and the response to the ResponseHandler
+     * signature.
+     */
+    template <typename C,
+              void (*Handler)(std::shared_ptr<CalypsoCardAdapter>,
+                              std::shared_ptr<C>,
+                              std::shared_ptr<ApduResponseApi>)>
+    static void dispatchWithCard(std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+                                 const std::shared_ptr<AbstractCardCommand> command,
+                                 const std::shared_ptr<ApduResponseApi> apduResponse,
+                                 const bool isSessionOpen);
+
+    /**
+     * (private)<br>
+     * Adapts a handler also taking the session state to the ResponseHandler signature.
+     */
+    template <typename C,
+              void (*Handler)(std::shared_ptr<CalypsoCardAdapter>,
+                              std::shared_ptr<C>,
+                              std::shared_ptr<ApduResponseApi>,
+                              bool)>
+    static void dispatchWithSessionState(std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+                                         const std::shared_ptr<AbstractCardCommand> command,
+                                         const std::shared_ptr<ApduResponseApi> apduResponse,
+                                         const bool isSessionOpen);
+
+    /**
+     * (private)<br>
+     * Adapts a handler taking only the command and the response to the ResponseHandler signature.
+     */
+    template <typename C,
+              void (*Handler)(std::shared_ptr<C>, std::shared_ptr<ApduResponseApi>)>
+    static void dispatchWithoutCard(std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+                                    const std::shared_ptr<AbstractCardCommand> command,
+                                    const std::shared_ptr<ApduResponseApi> apduResponse,
+                                    const bool isSessionOpen);
+
+    /**
+     * (private)<br>
+     * Updates the CalypsoCardAdapter object with the response to a "Get Data" command for
+     * GetDataTag::FCI_FOR_CURRENT_DF tag received from the card.
+     *
+     * @param calypsoCard The CalypsoCardAdapter object to update.
+     * @param cmdCardGetDataFci The command.
+     * @param apduResponse The response received.
+     */
+    static void updateCalypsoCardWithFci(std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+                                         std::shared_ptr<CmdCardGetDataFci> cmdCardGetDataFci,
+                                         const std::shared_ptr<ApduResponseApi> apduResponse);
+
+    /**
+     * (private)<br>
+     * Updates the CalypsoCardAdapter object with the response to an "Update Binary" or a
+     * "Write Binary" command received from the card.
+     *
+     * @param calypsoCard The CalypsoCardAdapter object to update.
+     * @param cmdCardUpdateOrWriteBinary The command.
+     * @param apduResponse The response received.
+     * @throw CardCommandException If a response from the card was unexpected.
+     */
+    static void updateCalypsoCardUpdateOrWriteBinary(
+        std::shared_ptr<CalypsoCardAdapter> calypsoCard,
+        std::shared_ptr<CmdCardUpdateOrWriteBinary> cmdCardUpdateOrWriteBinary,
+        const std::shared_ptr<ApduResponseApi> apduResponse);
+
     /**
      * (private)<br>
      * Updates the {@link CalypsoCardAdapter} object with the response to an Open Secure Session
@@ -20,6 +20,9 @@
 #include "Pattern.h"
 #include "System.h"
 
+/* Keyple Card Calypso */
+#include "LogArgs.h"
+
 namespace keyple {
 namespace card {
 namespace calypso {
@@ -77,16 +80,16 @@ CalypsoSamAdapter::CalypsoSamAdapter(
         mSoftwareRevision = atrSubElements[5];
         System::arraycopy(atrSubElements, 6, mSerialNumber, 0, 4);
 
-        std::stringstream ss;
-        ss << "SAM " << mSamProductType
-           << "PLATFORM = " << mPlatform << ", "
-           << "APPTYPE = " << mApplicationType << "h, "
-           << "APPSUBTYPE = " << mApplicationSubType << "h, "
-           << "SWISSUER = " << mSoftwareIssuer << "h, "
-           << "SWVERSION = " << mSoftwareVersion << "h, "
-           << "SWREVISION = " << mSoftwareRevision;
-        mLogger->trace("%\n", ss.str());
-        mLogger->trace("SAM SERIALNUMBER = %\n", ByteArrayUtil::toHex(mSerialNumber));
+        mLogger->trace("SAM %PLATFORM = %, APPTYPE = %h, APPSUBTYPE = %h, SWISSUER = %h, " \
+                       "SWVERSION = %h, SWREVISION = %\n",
+                       mSamProductType,
+                       mPlatform,
+                       mApplicationType,
+                       mApplicationSubType,
+                       mSoftwareIssuer,
+                       mSoftwareVersion,
+                       mSoftwareRevision);
+        mLogger->trace("SAM SERIALNUMBER = %\n", HexLogArg(mSerialNumber));
 
     } else {
         mSamProductType = ProductType::UNKNOWN;
@@ -97,6 +100,11 @@ CalypsoSamAdapter::CalypsoSamAdapter(
         mSoftwareVersion = 0;
         mSoftwareRevision = 0;
     }
+
+    /* The variants and versions of a product do not all implement Digest Update Multiple */
+    mDigestUpdateMultipleSupport = getMaxDigestDataLength() > 0 ?
+                                   DigestUpdateMultipleSupport::UNKNOWN :
+                                   DigestUpdateMultipleSupport::UNSUPPORTED;
 }
 
 uint8_t CalypsoSamAdapter::getClassByte(const CalypsoSam::ProductType type)
@@ -131,6 +139,17 @@ int CalypsoSamAdapter::getMaxDigestDataLength() const
     }
 }
 
+CalypsoSamAdapter::DigestUpdateMultipleSupport
+    CalypsoSamAdapter::getDigestUpdateMultipleSupport() const
+{
+    return mDigestUpdateMultipleSupport;
+}
+
+void CalypsoSamAdapter::setDigestUpdateMultipleSupport(const DigestUpdateMultipleSupport support)
+{
+    mDigestUpdateMultipleSupport = support;
+}
+
 const std::vector<uint8_t> CalypsoSamAdapter::getSelectApplicationResponse() const
 {
     return std::vector<uint8_t>(0);
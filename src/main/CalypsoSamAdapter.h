@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 /* Calypsonet Terminal Calypso */
@@ -41,6 +42,29 @@ using namespace keyple::core::util::cpp;
  */
 class CalypsoSamAdapter final : public CalypsoSam, public SmartCardSpi {
 public:
+    /**
+     * (package-private)<br>
+     * Support of the Digest Update Multiple command by the SAM.
+     *
+     * @since 2.1.1
+     */
+    enum class DigestUpdateMultipleSupport {
+        /**
+         * Not known yet, the first Digest Update Multiple command sent tells.
+         */
+        UNKNOWN,
+
+        /**
+         * The SAM has accepted a Digest Update Multiple command.
+         */
+        SUPPORTED,
+
+        /**
+         * The SAM does not know the command or the product type is unknown.
+         */
+        UNSUPPORTED
+    };
+
     /**
      * Constructor.
      *
@@ -78,6 +102,26 @@ public:
      */
     int getMaxDigestDataLength() const;
 
+    /**
+     * (package-private)<br>
+     * Tells whether the SAM supports the Digest Update Multiple command.
+     *
+     * <p>The value may be updated concurrently by the processors sharing the SAM.
+     *
+     * @return The current support status.
+     * @since 2.1.1
+     */
+    DigestUpdateMultipleSupport getDigestUpdateMultipleSupport() const;
+
+    /**
+     * (package-private)<br>
+     * Records the support of the Digest Update Multiple command, as learnt from the SAM response.
+     *
+     * @param support the new support status.
+     * @since 2.1.1
+     */
+    void setDigestUpdateMultipleSupport(const DigestUpdateMultipleSupport support);
+
     /**
      * {@inheritDoc}<br>
      * No select application for a SAM.
@@ -206,6 +250,11 @@ private:
      *
      */
     uint8_t mSoftwareRevision;
+
+    /**
+     * Unknown until the SAM has answered a first Digest Update Multiple command.
+     */
+    std::atomic<DigestUpdateMultipleSupport> mDigestUpdateMultipleSupport;
 };
 
 }
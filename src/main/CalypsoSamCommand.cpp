@@ -22,32 +22,59 @@ namespace keyple {
 namespace card {
 namespace calypso {
 
-const CalypsoSamCommand CalypsoSamCommand::SELECT_DIVERSIFIER("Select Diversifier", 0x14);
-const CalypsoSamCommand CalypsoSamCommand::GET_CHALLENGE("Get Challenge", 0x84);
-const CalypsoSamCommand CalypsoSamCommand::DIGEST_INIT("Digest Init", 0x8A);
-const CalypsoSamCommand CalypsoSamCommand::DIGEST_UPDATE("Digest Update", 0x8C);
-const CalypsoSamCommand CalypsoSamCommand::DIGEST_UPDATE_MULTIPLE("Digest Update Multiple", 0x8C);
-const CalypsoSamCommand CalypsoSamCommand::DIGEST_CLOSE("Digest Close", 0x8E);
-const CalypsoSamCommand CalypsoSamCommand::DIGEST_AUTHENTICATE("Digest Authenticate", 0x82);
-const CalypsoSamCommand CalypsoSamCommand::GIVE_RANDOM("Give Random", 0x86);
-const CalypsoSamCommand CalypsoSamCommand::CARD_GENERATE_KEY("Card Generate Key", 0x12);
-const CalypsoSamCommand CalypsoSamCommand::CARD_CIPHER_PIN("Card Cipher PIN", 0x12);
-const CalypsoSamCommand CalypsoSamCommand::UNLOCK("Unlock", 0x20);
-const CalypsoSamCommand CalypsoSamCommand::WRITE_KEY("Write Key", 0x1A);
-const CalypsoSamCommand CalypsoSamCommand::READ_KEY_PARAMETERS("Read Key Parameters", 0xBC);
-const CalypsoSamCommand CalypsoSamCommand::READ_EVENT_COUNTER("Read Event Counter", 0xBE);
-const CalypsoSamCommand CalypsoSamCommand::READ_CEILINGS("Read Ceilings", 0xBE);
-const CalypsoSamCommand CalypsoSamCommand::SV_CHECK("SV Check", 0x58);
-const CalypsoSamCommand CalypsoSamCommand::SV_PREPARE_DEBIT("SV Prepare Debit", 0x54);
-const CalypsoSamCommand CalypsoSamCommand::SV_PREPARE_LOAD("SV Prepare Load", 0x56);
-const CalypsoSamCommand CalypsoSamCommand::SV_PREPARE_UNDEBIT("SV Prepare Undebit", 0x5C);
-
-CalypsoSamCommand::CalypsoSamCommand(const std::string& name, const uint8_t instructionByte)
-: mName(name), mInstructionByte(instructionByte) {}
-
-const std::string& CalypsoSamCommand::getName() const
+/* The names of the commands, indexed by identifier */
+static constexpr const char* const NAMES[] = {
+    "Select Diversifier",
+    "Get Challenge",
+    "Digest Init",
+    "Digest Update",
+    "Digest Update Multiple",
+    "Digest Close",
+    "Digest Authenticate",
+    "Give Random",
+    "Card Generate Key",
+    "Card Cipher PIN",
+    "Unlock",
+    "Write Key",
+    "Read Key Parameters",
+    "Read Event Counter",
+    "Read Ceilings",
+    "SV Check",
+    "SV Prepare Debit",
+    "SV Prepare Load",
+    "SV Prepare Undebit"};
+
+static_assert(sizeof(NAMES) / sizeof(NAMES[0]) == CalypsoSamCommand::ID_COUNT,
+              "One name is expected per command identifier");
+
+const CalypsoSamCommand CalypsoSamCommand::SELECT_DIVERSIFIER(Id::SELECT_DIVERSIFIER, 0x14);
+const CalypsoSamCommand CalypsoSamCommand::GET_CHALLENGE(Id::GET_CHALLENGE, 0x84);
+const CalypsoSamCommand CalypsoSamCommand::DIGEST_INIT(Id::DIGEST_INIT, 0x8A);
+const CalypsoSamCommand CalypsoSamCommand::DIGEST_UPDATE(Id::DIGEST_UPDATE, 0x8C);
+const CalypsoSamCommand CalypsoSamCommand::DIGEST_UPDATE_MULTIPLE(Id::DIGEST_UPDATE_MULTIPLE, 0x8C);
+const CalypsoSamCommand CalypsoSamCommand::DIGEST_CLOSE(Id::DIGEST_CLOSE, 0x8E);
+const CalypsoSamCommand CalypsoSamCommand::DIGEST_AUTHENTICATE(Id::DIGEST_AUTHENTICATE, 0x82);
+const CalypsoSamCommand CalypsoSamCommand::GIVE_RANDOM(Id::GIVE_RANDOM, 0x86);
+const CalypsoSamCommand CalypsoSamCommand::CARD_GENERATE_KEY(Id::CARD_GENERATE_KEY, 0x12);
+const CalypsoSamCommand CalypsoSamCommand::CARD_CIPHER_PIN(Id::CARD_CIPHER_PIN, 0x12);
+const CalypsoSamCommand CalypsoSamCommand::UNLOCK(Id::UNLOCK, 0x20);
+const CalypsoSamCommand CalypsoSamCommand::WRITE_KEY(Id::WRITE_KEY, 0x1A);
+const CalypsoSamCommand CalypsoSamCommand::READ_KEY_PARAMETERS(Id::READ_KEY_PARAMETERS, 0xBC);
+const CalypsoSamCommand CalypsoSamCommand::READ_EVENT_COUNTER(Id::READ_EVENT_COUNTER, 0xBE);
+const CalypsoSamCommand CalypsoSamCommand::READ_CEILINGS(Id::READ_CEILINGS, 0xBE);
+const CalypsoSamCommand CalypsoSamCommand::SV_CHECK(Id::SV_CHECK, 0x58);
+const CalypsoSamCommand CalypsoSamCommand::SV_PREPARE_DEBIT(Id::SV_PREPARE_DEBIT, 0x54);
+const CalypsoSamCommand CalypsoSamCommand::SV_PREPARE_LOAD(Id::SV_PREPARE_LOAD, 0x56);
+const CalypsoSamCommand CalypsoSamCommand::SV_PREPARE_UNDEBIT(Id::SV_PREPARE_UNDEBIT, 0x5C);
+
+CalypsoSamCommand::Id CalypsoSamCommand::getId() const
+{
+    return mId;
+}
+
+const char* CalypsoSamCommand::getName() const
 {
-    return mName;
+    return NAMES[static_cast<std::size_t>(mId)];
 }
 
 uint8_t CalypsoSamCommand::getInstructionByte() const
@@ -55,6 +82,16 @@ uint8_t CalypsoSamCommand::getInstructionByte() const
     return mInstructionByte;
 }
 
+bool CalypsoSamCommand::operator==(const CalypsoSamCommand& o) const
+{
+    return mId == o.mId;
+}
+
+bool CalypsoSamCommand::operator!=(const CalypsoSamCommand& o) const
+{
+    return !(*this == o);
+}
+
 }
 }
 }
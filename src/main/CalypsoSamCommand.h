@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
 
 /* Keyple Card Calypso */
@@ -30,6 +32,40 @@ namespace calypso {
  */
 class CalypsoSamCommand : public CardCommand {
 public:
+    /**
+     * Compact identifier of a command, used for equality, hashing and switch dispatch.
+     *
+     * @since 2.1.1
+     */
+    enum class Id : uint8_t {
+        SELECT_DIVERSIFIER,
+        GET_CHALLENGE,
+        DIGEST_INIT,
+        DIGEST_UPDATE,
+        DIGEST_UPDATE_MULTIPLE,
+        DIGEST_CLOSE,
+        DIGEST_AUTHENTICATE,
+        GIVE_RANDOM,
+        CARD_GENERATE_KEY,
+        CARD_CIPHER_PIN,
+        UNLOCK,
+        WRITE_KEY,
+        READ_KEY_PARAMETERS,
+        READ_EVENT_COUNTER,
+        READ_CEILINGS,
+        SV_CHECK,
+        SV_PREPARE_DEBIT,
+        SV_PREPARE_LOAD,
+        SV_PREPARE_UNDEBIT,
+    };
+
+    /**
+     * The number of identifiers, for the tables indexed by identifier.
+     *
+     * @since 2.1.1
+     */
+    static constexpr std::size_t ID_COUNT = static_cast<std::size_t>(Id::SV_PREPARE_UNDEBIT) + 1;
+
     /** select diversifier. */
     static const CalypsoSamCommand SELECT_DIVERSIFIER;
 
@@ -88,12 +124,30 @@ public:
     static const CalypsoSamCommand SV_PREPARE_UNDEBIT;
 
     /**
-     * Gets the name.
      *
-     * @return A String
+     */
+    bool operator==(const CalypsoSamCommand& o) const;
+
+    /**
+     *
+     */
+    bool operator!=(const CalypsoSamCommand& o) const;
+
+    /**
+     * Gets the identifier of the command.
+     *
+     * @return An identifier.
+     * @since 2.1.1
+     */
+    Id getId() const;
+
+    /**
+     * Gets the name, for display purpose only.
+     *
+     * @return A null-terminated string.
      * @since 2.0.0
      */
-    const std::string& getName() const override;
+    const char* getName() const override;
 
     /**
      * Gets the instruction byte (INS).
@@ -105,9 +159,9 @@ public:
 
 private:
     /**
-     * The name
+     * The command identifier
      */
-    const std::string mName;
+    const Id mId;
 
     /**
      * The instruction byte
@@ -117,13 +171,29 @@ private:
     /**
      * The generic constructor of CalypsoCommands.
      *
-     * @param name the name.
+     * @param id the identifier.
      * @param instructionByte the instruction byte.
      * @since 2.0.0
      */
-    CalypsoSamCommand(const std::string& name, const uint8_t instructionByte);
+    constexpr CalypsoSamCommand(const Id id, const uint8_t instructionByte)
+    : mId(id), mInstructionByte(instructionByte) {}
 };
 
 }
 }
 }
+
+namespace std {
+
+/**
+ * Hashes a CalypsoSamCommand on its identifier.
+ */
+template <>
+struct hash<keyple::card::calypso::CalypsoSamCommand> {
+    size_t operator()(const keyple::card::calypso::CalypsoSamCommand& command) const
+    {
+        return static_cast<size_t>(command.getId());
+    }
+};
+
+}
@@ -27,10 +27,10 @@ public:
     /**
      * Gets command's name.
      *
-     * @return A String
+     * @return A null-terminated string.
      * @since 2.0.0
      */
-    virtual const std::string& getName() const = 0;
+    virtual const char* getName() const = 0;
 
     /**
      * Gets Instruction Byte (INS)
@@ -36,12 +36,13 @@ void CardCommandManager::addStoredValueCommand(const std::shared_ptr<AbstractCar
                                                const SvOperation svOperation)
 {
     /* Check the logic of the SV command sequencing */
-    const CalypsoCardCommand& cmd = command->getCommandRef();
-    if (cmd == CalypsoCardCommand::SV_GET) {
+    switch (command->getCommandRef().getId()) {
+    case CalypsoCardCommand::Id::SV_GET:
         mSvOperation = svOperation;
-    } else if (cmd == CalypsoCardCommand::SV_RELOAD ||
-               cmd == CalypsoCardCommand::SV_DEBIT ||
-               cmd == CalypsoCardCommand::SV_UNDEBIT) {
+        break;
+    case CalypsoCardCommand::Id::SV_RELOAD:
+    case CalypsoCardCommand::Id::SV_DEBIT:
+    case CalypsoCardCommand::Id::SV_UNDEBIT:
         /*
          * CL-SV-GETDEBIT.1
          * CL-SV-GETRLOAD.1
@@ -62,7 +63,8 @@ void CardCommandManager::addStoredValueCommand(const std::shared_ptr<AbstractCar
         }
 
         mSvOperationComplete = true;
-    } else {
+        break;
+    default:
         throw IllegalStateException("An SV command is expected.");
     }
 
@@ -76,6 +78,13 @@ void CardCommandManager::notifyCommandsProcessed()
     mCardCommands.clear();
 }
 
+void CardCommandManager::reset()
+{
+    mCardCommands.clear();
+    mSvLastCommand = CalypsoCardCommand::NONE;
+    mSvOperationComplete = false;
+}
+
 const std::vector<std::shared_ptr<AbstractCardCommand>>& CardCommandManager::getCardCommands() const
 {
     return mCardCommands;
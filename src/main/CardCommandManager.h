@@ -93,6 +93,16 @@ public:
      */
     void notifyCommandsProcessed();
 
+    /**
+     * (package-private)<br>
+     * Discards the prepared commands and the SV sequencing state.
+     *
+     * <p>The capacity of the command list is kept to be reused by the next transaction.
+     *
+     * @since 2.1.1
+     */
+    void reset();
+
     /**
      * (package-private)<br>
      *
@@ -27,7 +27,8 @@ using ProductType = CalypsoSam::ProductType;
 
 const std::string CardSecuritySettingAdapter::WRITE_ACCESS_LEVEL = "writeAccessLevel";
 
-CardSecuritySettingAdapter::CardSecuritySettingAdapter() {}
+CardSecuritySettingAdapter::CardSecuritySettingAdapter()
+: mIsDigestPipeliningEnabled(false), mIsSessionChallengePrefetchEnabled(false) {}
 
 CardSecuritySetting& CardSecuritySettingAdapter::setSamResource(
     const std::shared_ptr<CardReader> samReader, const std::shared_ptr<CalypsoSam> calypsoSam)
@@ -85,6 +86,31 @@ CardSecuritySettingAdapter& CardSecuritySettingAdapter::authorizeSvNegativeBalan
     return *this;
 }
 
+CardSecuritySettingAdapter& CardSecuritySettingAdapter::enableDigestPipelining()
+{
+    mIsDigestPipeliningEnabled = true;
+
+    return *this;
+}
+
+CardSecuritySettingAdapter& CardSecuritySettingAdapter::enableSessionChallengePrefetch()
+{
+    mIsSessionChallengePrefetchEnabled = true;
+
+    return *this;
+}
+
+CardSecuritySettingAdapter& CardSecuritySettingAdapter::setSamPool(
+    const std::shared_ptr<SamPool> samPool)
+{
+    Assert::getInstance().notNull(samPool, "samPool")
+                         .greaterOrEqual(samPool->getSize(), 1, "samPool size");
+
+    mSamPool = samPool;
+
+    return *this;
+}
+
 CardSecuritySettingAdapter& CardSecuritySettingAdapter::assignKif(
     const WriteAccessLevel writeAccessLevel, const uint8_t kvc, const uint8_t kif)
 {
@@ -129,8 +155,8 @@ CardSecuritySettingAdapter& CardSecuritySettingAdapter::addAuthorizedSvKey(const
 CardSecuritySettingAdapter& CardSecuritySettingAdapter::setPinVerificationCipheringKey(
     const uint8_t kif, const uint8_t kvc)
 {
-    mPinVerificationCipheringKif = std::make_shared<uint8_t>(kif);
-    mPinVerificationCipheringKvc = std::make_shared<uint8_t>(kvc);
+    mPinVerificationCipheringKif = Optional<uint8_t>(kif);
+    mPinVerificationCipheringKvc = Optional<uint8_t>(kvc);
 
     return *this;
 }
@@ -138,8 +164,8 @@ CardSecuritySettingAdapter& CardSecuritySettingAdapter::setPinVerificationCipher
 CardSecuritySettingAdapter& CardSecuritySettingAdapter::setPinModificationCipheringKey(
     const uint8_t kif, const uint8_t kvc)
 {
-    mPinModificationCipheringKif = std::make_shared<uint8_t>(kif);
-    mPinModificationCipheringKvc = std::make_shared<uint8_t>(kvc);
+    mPinModificationCipheringKif = Optional<uint8_t>(kif);
+    mPinModificationCipheringKvc = Optional<uint8_t>(kvc);
 
     return *this;
 }
@@ -154,6 +180,11 @@ std::shared_ptr<CalypsoSam> CardSecuritySettingAdapter::getCalypsoSam() const
     return mCalypsoSam;
 }
 
+std::shared_ptr<SamPool> CardSecuritySettingAdapter::getSamPool() const
+{
+    return mSamPool;
+}
+
 bool CardSecuritySettingAdapter::isMultipleSessionEnabled() const
 {
     return mIsMultipleSessionEnabled;
@@ -184,48 +215,58 @@ bool CardSecuritySettingAdapter::isSvNegativeBalanceAuthorized() const
     return mIsSvNegativeBalanceAuthorized;
 }
 
-const std::shared_ptr<uint8_t> CardSecuritySettingAdapter::getKif(
+bool CardSecuritySettingAdapter::isDigestPipeliningEnabled() const
+{
+    return mIsDigestPipeliningEnabled;
+}
+
+bool CardSecuritySettingAdapter::isSessionChallengePrefetchEnabled() const
+{
+    return mIsSessionChallengePrefetchEnabled;
+}
+
+const Optional<uint8_t> CardSecuritySettingAdapter::getKif(
     const WriteAccessLevel writeAccessLevel, const uint8_t kvc) const
 {
     const auto it = mKifMap.find(writeAccessLevel);
     if (it == mKifMap.end()) {
-        return nullptr;
+        return Optional<uint8_t>();
     } else {
         const auto itt = it->second.find(kvc);
         if (itt == it->second.end()) {
-            return nullptr;
+            return Optional<uint8_t>();
         } else {
-            return std::make_shared<uint8_t>(itt->second);
+            return Optional<uint8_t>(itt->second);
         }
     }
 }
 
-const std::shared_ptr<uint8_t> CardSecuritySettingAdapter::getDefaultKif(
+const Optional<uint8_t> CardSecuritySettingAdapter::getDefaultKif(
     const WriteAccessLevel writeAccessLevel) const
 {
     const auto it = mDefaultKifMap.find(writeAccessLevel);
     if (it == mDefaultKifMap.end()) {
-        return nullptr;
+        return Optional<uint8_t>();
     } else {
-        return std::make_shared<uint8_t>(it->second);
+        return Optional<uint8_t>(it->second);
     }
 }
 
-const std::shared_ptr<uint8_t> CardSecuritySettingAdapter::getDefaultKvc(
+const Optional<uint8_t> CardSecuritySettingAdapter::getDefaultKvc(
     const WriteAccessLevel writeAccessLevel) const
 {
     const auto it = mDefaultKvcMap.find(writeAccessLevel);
     if (it == mDefaultKvcMap.end()) {
-        return nullptr;
+        return Optional<uint8_t>();
     } else {
-        return std::make_shared<uint8_t>(it->second);
+        return Optional<uint8_t>(it->second);
     }
 }
 
-bool CardSecuritySettingAdapter::isSessionKeyAuthorized(const std::shared_ptr<uint8_t> kif,
-                                                        const std::shared_ptr<uint8_t> kvc) const
+bool CardSecuritySettingAdapter::isSessionKeyAuthorized(const Optional<uint8_t> kif,
+                                                        const Optional<uint8_t> kvc) const
 {
-    if (kif == nullptr || kvc == nullptr) {
+    if (!kif.has_value() || !kvc.has_value()) {
         return false;
     }
 
@@ -234,13 +275,13 @@ bool CardSecuritySettingAdapter::isSessionKeyAuthorized(const std::shared_ptr<ui
     }
 
     return Arrays::contains(mAuthorizedSessionKeys,
-                            ((*kif.get() << 8) & 0xff00) | (*kvc.get() & 0x00ff));
+                            ((*kif << 8) & 0xff00) | (*kvc & 0x00ff));
 }
 
-bool CardSecuritySettingAdapter::isSvKeyAuthorized(const std::shared_ptr<uint8_t> kif,
-                                                   const std::shared_ptr<uint8_t> kvc) const
+bool CardSecuritySettingAdapter::isSvKeyAuthorized(const Optional<uint8_t> kif,
+                                                   const Optional<uint8_t> kvc) const
 {
-    if (kif == nullptr || kvc == nullptr) {
+    if (!kif.has_value() || !kvc.has_value()) {
         return false;
     }
 
@@ -249,25 +290,25 @@ bool CardSecuritySettingAdapter::isSvKeyAuthorized(const std::shared_ptr<uint8_t
     }
 
     return Arrays::contains(mAuthorizedSvKeys,
-                            ((*kif.get() << 8) & 0xff00) | (*kvc.get() & 0x00ff));
+                            ((*kif << 8) & 0xff00) | (*kvc & 0x00ff));
 }
 
-const std::shared_ptr<uint8_t> CardSecuritySettingAdapter::getPinVerificationCipheringKif() const
+const Optional<uint8_t> CardSecuritySettingAdapter::getPinVerificationCipheringKif() const
 {
     return mPinVerificationCipheringKif;
 }
 
-const std::shared_ptr<uint8_t> CardSecuritySettingAdapter::getPinVerificationCipheringKvc() const
+const Optional<uint8_t> CardSecuritySettingAdapter::getPinVerificationCipheringKvc() const
 {
     return mPinVerificationCipheringKvc;
 }
 
-const std::shared_ptr<uint8_t> CardSecuritySettingAdapter::getPinModificationCipheringKif() const
+const Optional<uint8_t> CardSecuritySettingAdapter::getPinModificationCipheringKif() const
 {
     return mPinModificationCipheringKif;
 }
 
-const std::shared_ptr<uint8_t> CardSecuritySettingAdapter::getPinModificationCipheringKvc() const
+const Optional<uint8_t> CardSecuritySettingAdapter::getPinModificationCipheringKvc() const
 {
     return mPinModificationCipheringKvc;
 }
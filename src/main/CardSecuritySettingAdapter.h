@@ -24,6 +24,10 @@
 /* Calypsonet Terminal Reader */
 #include "CardReader.h"
 
+/* Keyple Card Calypso */
+#include "Optional.h"
+#include "SamPool.h"
+
 namespace keyple {
 namespace card {
 namespace calypso {
@@ -97,6 +101,53 @@ public:
      */
     CardSecuritySettingAdapter& authorizeSvNegativeBalance() override;
 
+    /**
+     * Enables the pipelining of the session digest computation.
+     *
+     * <p>When enabled, the Digest Init/Update commands are sent to the SAM in background as soon as
+     * the corresponding card exchanges are done, while the transaction goes on with the card. Only
+     * the Digest Close command remains to be executed when the session is closed.
+     *
+     * <p>The card reader and the SAM reader must be able to process requests concurrently.
+     *
+     * @return The current instance.
+     * @since 2.1.1
+     */
+    CardSecuritySettingAdapter& enableDigestPipelining();
+
+    /**
+     * Enables the prefetching of the SAM challenge.
+     *
+     * <p>When enabled, the terminal challenge of the next secure session is requested from the SAM
+     * in background right after a session is closed, without delaying the end of the session. The
+     * next session opening then waits for the SAM response and starts directly with the card
+     * Open Secure Session command, the SAM Select Diversifier command being sent along with the
+     * Digest Init command.
+     *
+     * <p>The challenge is held by the SAM, so the prefetching requires the SAM to be owned by the
+     * transaction manager between two sessions: the SAM resource must not be used by another
+     * transaction manager. It is ignored when a SAM pool is set, the SAM being given back to the
+     * pool at the end of each session.
+     *
+     * @return The current instance.
+     * @since 2.1.1
+     */
+    CardSecuritySettingAdapter& enableSessionChallengePrefetch();
+
+    /**
+     * Sets a pool of SAMs to use instead of the single SAM resource.
+     *
+     * <p>Each secure session is then processed by a SAM of the pool allocated exclusively to it,
+     * from the terminal challenge to the card signature authentication. The SAM resource set with
+     * setSamResource, if any, is ignored.
+     *
+     * @param samPool The SAM pool, possibly shared between several settings.
+     * @return The current instance.
+     * @throw IllegalArgumentException If the pool is null or empty.
+     * @since 2.1.1
+     */
+    CardSecuritySettingAdapter& setSamPool(const std::shared_ptr<SamPool> samPool);
+
     /**
      * {@inheritDoc}
      *
@@ -172,6 +223,15 @@ public:
      */
     std::shared_ptr<CalypsoSam> getCalypsoSam() const;
 
+    /**
+     * (package-private)<br>
+     * Gets the pool of SAMs used for secured operations.
+     *
+     * @return Null if no pool is set.
+     * @since 2.1.1
+     */
+    std::shared_ptr<SamPool> getSamPool() const;
+
     /**
      * (package-private)<br>
      * Indicates if the multiple session mode is enabled.
@@ -226,17 +286,35 @@ public:
      */
     bool isSvNegativeBalanceAuthorized() const;
 
+    /**
+     * (package-private)<br>
+     * Indicates if the pipelining of the session digest computation is enabled.
+     *
+     * @return True if the digest commands are sent to the SAM in background.
+     * @since 2.1.1
+     */
+    bool isDigestPipeliningEnabled() const;
+
+    /**
+     * (package-private)<br>
+     * Indicates if the prefetching of the SAM challenge is enabled.
+     *
+     * @return True if the challenge of the next session is requested after each session closing.
+     * @since 2.1.1
+     */
+    bool isSessionChallengePrefetchEnabled() const;
+
     /**
      * (package-private)<br>
      * Gets the KIF value to use for the provided write access level and KVC value.
      *
      * @param writeAccessLevel The write access level.
      * @param kvc The KVC value.
-     * @return Null if no KIF is available.
+     * @return Empty if no KIF is available.
      * @throws IllegalArgumentException If the provided writeAccessLevel is null.
      * @since 2.0.0
      */
-    const std::shared_ptr<uint8_t> getKif(const WriteAccessLevel writeAccessLevel,
+    const Optional<uint8_t> getKif(const WriteAccessLevel writeAccessLevel,
                                           const uint8_t kvc) const;
 
     /**
@@ -244,22 +322,22 @@ public:
      * Gets the default KIF value for the provided write access level.
      *
      * @param writeAccessLevel The write access level.
-     * @return Null if no KIF is available.
+     * @return Empty if no KIF is available.
      * @throws IllegalArgumentException If the provided argument is null.
      * @since 2.0.0
      */
-    const std::shared_ptr<uint8_t> getDefaultKif(const WriteAccessLevel writeAccessLevel) const;
+    const Optional<uint8_t> getDefaultKif(const WriteAccessLevel writeAccessLevel) const;
 
     /**
      * (package-private)<br>
      * Gets the default KVC value for the provided write access level.
      *
      * @param writeAccessLevel The write access level.
-     * @return Null if no KVC is available.
+     * @return Empty if no KVC is available.
      * @throws IllegalArgumentException If the provided argument is null.
      * @since 2.0.0
      */
-    const std::shared_ptr<uint8_t> getDefaultKvc(const WriteAccessLevel writeAccessLevel) const;
+    const Optional<uint8_t> getDefaultKvc(const WriteAccessLevel writeAccessLevel) const;
 
     /**
      * (package-private)<br>
@@ -267,11 +345,11 @@ public:
      *
      * @param kif The KIF value.
      * @param kvc The KVC value.
-     * @return False if KIF or KVC is null or unauthorized.
+     * @return False if KIF or KVC is empty or unauthorized.
      * @since 2.0.0
      */
-    bool isSessionKeyAuthorized(const std::shared_ptr<uint8_t> kif,
-                                const std::shared_ptr<uint8_t> kvc) const;
+    bool isSessionKeyAuthorized(const Optional<uint8_t> kif,
+                                const Optional<uint8_t> kvc) const;
 
     /**
      * (package-private)<br>
@@ -279,47 +357,47 @@ public:
      *
      * @param kif The KIF value.
      * @param kvc The KVC value.
-     * @return False if KIF or KVC is null or unauthorized.
+     * @return False if KIF or KVC is empty or unauthorized.
      * @since 2.0.0
      */
-    bool isSvKeyAuthorized(const std::shared_ptr<uint8_t> kif,
-                           const std::shared_ptr<uint8_t> kvc) const;
+    bool isSvKeyAuthorized(const Optional<uint8_t> kif,
+                           const Optional<uint8_t> kvc) const;
 
     /**
      * (package-private)<br>
      * Gets the KIF value of the PIN verification ciphering key.
      *
-     * @return Null if no KIF is available.
+     * @return Empty if no KIF is available.
      * @since 2.0.0
      */
-    const std::shared_ptr<uint8_t> getPinVerificationCipheringKif() const;
+    const Optional<uint8_t> getPinVerificationCipheringKif() const;
 
     /**
      * (package-private)<br>
      * Gets the KVC value of the PIN verification ciphering key.
      *
-     * @return Null if no KVC is available.
+     * @return Empty if no KVC is available.
      * @since 2.0.0
      */
-    const std::shared_ptr<uint8_t> getPinVerificationCipheringKvc() const;
+    const Optional<uint8_t> getPinVerificationCipheringKvc() const;
 
     /**
      * (package-private)<br>
      * Gets the KIF value of the PIN modification ciphering key.
      *
-     * @return Null if no KIF is available.
+     * @return Empty if no KIF is available.
      * @since 2.0.0
      */
-    const std::shared_ptr<uint8_t> getPinModificationCipheringKif() const;
+    const Optional<uint8_t> getPinModificationCipheringKif() const;
 
     /**
      * (package-private)<br>
      * Gets the KVC value of the PIN modification ciphering key.
      *
-     * @return Null if no KVC is available.
+     * @return Empty if no KVC is available.
      * @since 2.0.0
      */
-    const std::shared_ptr<uint8_t> getPinModificationCipheringKvc() const;
+    const Optional<uint8_t> getPinModificationCipheringKvc() const;
 
 private:
     /**
@@ -337,6 +415,11 @@ private:
      */
     std::shared_ptr<CalypsoSam> mCalypsoSam;
 
+    /**
+     *
+     */
+    std::shared_ptr<SamPool> mSamPool;
+
     /**
      *
      */
@@ -367,6 +450,16 @@ private:
      */
     bool mIsSvNegativeBalanceAuthorized;
 
+    /**
+     *
+     */
+    bool mIsDigestPipeliningEnabled;
+
+    /**
+     *
+     */
+    bool mIsSessionChallengePrefetchEnabled;
+
     /**
      *
      */
@@ -395,22 +488,22 @@ private:
     /**
      *
      */
-    std::shared_ptr<uint8_t> mPinVerificationCipheringKif;
+    Optional<uint8_t> mPinVerificationCipheringKif;
 
     /**
      *
      */
-    std::shared_ptr<uint8_t> mPinVerificationCipheringKvc;
+    Optional<uint8_t> mPinVerificationCipheringKvc;
 
     /**
      *
      */
-    std::shared_ptr<uint8_t> mPinModificationCipheringKif;
+    Optional<uint8_t> mPinModificationCipheringKif;
 
     /**
      *
      */
-    std::shared_ptr<uint8_t> mPinModificationCipheringKvc;
+    Optional<uint8_t> mPinModificationCipheringKvc;
 };
 
 }
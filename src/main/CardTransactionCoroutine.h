@@ -0,0 +1,522 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+/*
+ * C++20 coroutine interface of the card transactions.
+ *
+ * Only available when the library and its consumers are built with the KEYPLECARDCALYPSO_COROUTINES
+ * option (which defines the macro of the same name and selects C++20). C++11 consumers are not
+ * affected.
+ */
+#if defined(KEYPLECARDCALYPSO_COROUTINES)
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+/* Calypsonet Terminal Card */
+#include "CardRequestSpi.h"
+#include "CardResponseApi.h"
+#include "ChannelControl.h"
+#include "ProxyReaderApi.h"
+
+/* Keyple Card Calypso */
+#include "CardTransactionManagerAdapter.h"
+#include "TransactionExecutor.h"
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+using namespace calypsonet::terminal::card;
+using namespace calypsonet::terminal::card::spi;
+
+template <typename T>
+class CalypsoTask;
+
+/**
+ * (package-private)<br>
+ * State shared by the promises of all the CalypsoTask types.
+ *
+ * <p>A task is started when it is awaited; at its end, the awaiting coroutine is resumed.
+ *
+ * @since 2.1.1
+ */
+class CalypsoTaskPromiseBase {
+public:
+    /**
+     * Resumes the awaiting coroutine, if any, when the task ends.
+     */
+    class FinalAwaiter {
+    public:
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            const std::coroutine_handle<> continuation = handle.promise().mContinuation;
+
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception() noexcept
+    {
+        mException = std::current_exception();
+    }
+
+    /**
+     * The coroutine to resume at the end of the task.
+     */
+    std::coroutine_handle<> mContinuation;
+
+    /**
+     * The exception raised by the task, if any.
+     */
+    std::exception_ptr mException;
+};
+
+/**
+ * (package-private)<br>
+ * Promise of a CalypsoTask producing a value.
+ *
+ * @since 2.1.1
+ */
+template <typename T>
+class CalypsoTaskPromise : public CalypsoTaskPromiseBase {
+public:
+    CalypsoTask<T> get_return_object() noexcept;
+
+    void return_value(T value)
+    {
+        mValue = std::move(value);
+    }
+
+    T getResult()
+    {
+        if (mException) {
+            std::rethrow_exception(mException);
+        }
+
+        return std::move(*mValue);
+    }
+
+private:
+    std::optional<T> mValue;
+};
+
+/**
+ * (package-private)<br>
+ * Promise of a CalypsoTask producing no value.
+ *
+ * @since 2.1.1
+ */
+template <>
+class CalypsoTaskPromise<void> : public CalypsoTaskPromiseBase {
+public:
+    CalypsoTask<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void getResult()
+    {
+        if (mException) {
+            std::rethrow_exception(mException);
+        }
+    }
+};
+
+/**
+ * Coroutine type of the card transaction scripts.
+ *
+ * <p>A script is a coroutine returning a CalypsoTask and awaiting the operations of a transaction
+ * (see coProcessOpening, coProcessCardCommands, coProcessClosing, coProcessCancel and
+ * coTransmitCardRequest):
+ *
+ * <pre>
+ * CalypsoTask<void> validate(CardTransactionManagerAdapter& cardTransaction)
+ * {
+ *     cardTransaction.prepareReadRecord(SFI_CONTRACTS, 1);
+ *     co_await coProcessOpening(cardTransaction, WriteAccessLevel::DEBIT);
+ *     cardTransaction.prepareDecreaseCounter(SFI_COUNTERS, 1, 1);
+ *     co_await coProcessClosing(cardTransaction);
+ * }
+ * </pre>
+ *
+ * <p>The task is lazy: it starts when it is awaited by another script or when it is passed to
+ * startCalypsoTask.
+ *
+ * @since 2.1.1
+ */
+template <typename T = void>
+class CalypsoTask {
+public:
+    using promise_type = CalypsoTaskPromise<T>;
+
+    explicit CalypsoTask(const std::coroutine_handle<promise_type> handle) noexcept
+    : mHandle(handle) {}
+
+    CalypsoTask(CalypsoTask&& other) noexcept
+    : mHandle(std::exchange(other.mHandle, nullptr)) {}
+
+    CalypsoTask(const CalypsoTask&) = delete;
+
+    CalypsoTask& operator=(const CalypsoTask&) = delete;
+
+    ~CalypsoTask()
+    {
+        if (mHandle) {
+            mHandle.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(const std::coroutine_handle<> continuation) noexcept
+    {
+        mHandle.promise().mContinuation = continuation;
+
+        return mHandle;
+    }
+
+    T await_resume()
+    {
+        return mHandle.promise().getResult();
+    }
+
+private:
+    std::coroutine_handle<promise_type> mHandle;
+};
+
+template <typename T>
+CalypsoTask<T> CalypsoTaskPromise<T>::get_return_object() noexcept
+{
+    return CalypsoTask<T>(std::coroutine_handle<CalypsoTaskPromise<T>>::from_promise(*this));
+}
+
+inline CalypsoTask<void> CalypsoTaskPromise<void>::get_return_object() noexcept
+{
+    return CalypsoTask<void>(std::coroutine_handle<CalypsoTaskPromise<void>>::from_promise(*this));
+}
+
+/**
+ * (package-private)<br>
+ * Awaitable running a blocking operation on a TransactionExecutor.
+ *
+ * <p>The awaiting coroutine is suspended while the operation runs and is resumed by the executor
+ * thread. Without executor, the operation is run inline, without suspension.
+ *
+ * @since 2.1.1
+ */
+template <typename T>
+class TransactionAwaiter {
+public:
+    TransactionAwaiter(const std::shared_ptr<TransactionExecutor> executor,
+                       const std::function<T()> operation)
+    : mExecutor(executor), mOperation(operation) {}
+
+    bool await_ready() const noexcept
+    {
+        return mExecutor == nullptr;
+    }
+
+    void await_suspend(const std::coroutine_handle<> continuation)
+    {
+        mContinuation = continuation;
+        mExecutor->execute(std::bind(&TransactionAwaiter::run, this));
+    }
+
+    T await_resume()
+    {
+        if (mExecutor == nullptr) {
+            return mOperation();
+        }
+
+        if (mException) {
+            std::rethrow_exception(mException);
+        }
+
+        return getResult();
+    }
+
+private:
+    const std::shared_ptr<TransactionExecutor> mExecutor;
+    const std::function<T()> mOperation;
+    std::coroutine_handle<> mContinuation;
+    std::exception_ptr mException;
+    std::optional<T> mResult;
+
+    void run()
+    {
+        try {
+            mResult = mOperation();
+        } catch (...) {
+            mException = std::current_exception();
+        }
+
+        mContinuation.resume();
+    }
+
+    T getResult()
+    {
+        return std::move(*mResult);
+    }
+};
+
+/**
+ * (package-private)<br>
+ * Awaitable running a blocking operation producing no value on a TransactionExecutor.
+ *
+ * @since 2.1.1
+ */
+template <>
+class TransactionAwaiter<void> {
+public:
+    TransactionAwaiter(const std::shared_ptr<TransactionExecutor> executor,
+                       const std::function<void()> operation)
+    : mExecutor(executor), mOperation(operation) {}
+
+    bool await_ready() const noexcept
+    {
+        return mExecutor == nullptr;
+    }
+
+    void await_suspend(const std::coroutine_handle<> continuation)
+    {
+        mContinuation = continuation;
+        mExecutor->execute(std::bind(&TransactionAwaiter::run, this));
+    }
+
+    void await_resume()
+    {
+        if (mExecutor == nullptr) {
+            mOperation();
+            return;
+        }
+
+        if (mException) {
+            std::rethrow_exception(mException);
+        }
+    }
+
+private:
+    const std::shared_ptr<TransactionExecutor> mExecutor;
+    const std::function<void()> mOperation;
+    std::coroutine_handle<> mContinuation;
+    std::exception_ptr mException;
+
+    void run()
+    {
+        try {
+            mOperation();
+        } catch (...) {
+            mException = std::current_exception();
+        }
+
+        mContinuation.resume();
+    }
+};
+
+/**
+ * Awaitable variant of CardTransactionManagerAdapter::processOpening.
+ *
+ * <p>The operation runs on the executor of the transaction (see
+ * CardTransactionManagerAdapter::setExecutor).
+ *
+ * @param cardTransaction The card transaction.
+ * @param writeAccessLevel The write access level to be used.
+ * @return An awaitable.
+ * @since 2.1.1
+ */
+inline TransactionAwaiter<void> coProcessOpening(CardTransactionManagerAdapter& cardTransaction,
+                                                 const WriteAccessLevel writeAccessLevel)
+{
+    return TransactionAwaiter<void>(
+               cardTransaction.getExecutor(),
+               std::bind(&CardTransactionManagerAdapter::processOpening,
+                         &cardTransaction,
+                         writeAccessLevel));
+}
+
+/**
+ * Awaitable variant of CardTransactionManagerAdapter::processCardCommands.
+ *
+ * @param cardTransaction The card transaction.
+ * @return An awaitable.
+ * @since 2.1.1
+ */
+inline TransactionAwaiter<void> coProcessCardCommands(
+    CardTransactionManagerAdapter& cardTransaction)
+{
+    return TransactionAwaiter<void>(
+               cardTransaction.getExecutor(),
+               std::bind(&CardTransactionManagerAdapter::processCardCommands, &cardTransaction));
+}
+
+/**
+ * Awaitable variant of CardTransactionManagerAdapter::processClosing.
+ *
+ * @param cardTransaction The card transaction.
+ * @return An awaitable.
+ * @since 2.1.1
+ */
+inline TransactionAwaiter<void> coProcessClosing(CardTransactionManagerAdapter& cardTransaction)
+{
+    return TransactionAwaiter<void>(
+               cardTransaction.getExecutor(),
+               std::bind(&CardTransactionManagerAdapter::processClosing, &cardTransaction));
+}
+
+/**
+ * Awaitable variant of CardTransactionManagerAdapter::processCancel.
+ *
+ * @param cardTransaction The card transaction.
+ * @return An awaitable.
+ * @since 2.1.1
+ */
+inline TransactionAwaiter<void> coProcessCancel(CardTransactionManagerAdapter& cardTransaction)
+{
+    return TransactionAwaiter<void>(
+               cardTransaction.getExecutor(),
+               std::bind(&CardTransactionManagerAdapter::processCancel, &cardTransaction));
+}
+
+/**
+ * Awaitable transmission of a request to a card or a SAM reader.
+ *
+ * @param executor The executor running the transmission (null to transmit inline).
+ * @param reader The card or SAM reader.
+ * @param cardRequest The request to transmit.
+ * @param channelControl Policy for managing the physical channel after the request is processed.
+ * @return An awaitable providing the response of the card.
+ * @since 2.1.1
+ */
+inline TransactionAwaiter<std::shared_ptr<CardResponseApi>> coTransmitCardRequest(
+    const std::shared_ptr<TransactionExecutor> executor,
+    const std::shared_ptr<ProxyReaderApi> reader,
+    const std::shared_ptr<CardRequestSpi> cardRequest,
+    const ChannelControl channelControl)
+{
+    return TransactionAwaiter<std::shared_ptr<CardResponseApi>>(
+               executor,
+               std::bind(&ProxyReaderApi::transmitCardRequest,
+                         reader,
+                         cardRequest,
+                         channelControl));
+}
+
+/**
+ * (package-private)<br>
+ * Coroutine type starting immediately and destroying itself at its end.
+ *
+ * @since 2.1.1
+ */
+class DetachedCalypsoTask {
+public:
+    class promise_type {
+    public:
+        DetachedCalypsoTask get_return_object() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+/**
+ * (package-private)<br>
+ * Runs a task and forwards its outcome to the provided promise.
+ *
+ * @since 2.1.1
+ */
+template <typename T>
+DetachedCalypsoTask runCalypsoTask(CalypsoTask<T> task, std::promise<T> promise)
+{
+    try {
+        if constexpr (std::is_void<T>::value) {
+            co_await task;
+            promise.set_value();
+        } else {
+            promise.set_value(co_await task);
+        }
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+/**
+ * Starts a card transaction script from a non-coroutine context.
+ *
+ * <p>The script runs on the calling thread until its first suspension, then on the executor
+ * threads.
+ *
+ * @param task The script.
+ * @return A future providing the outcome of the script.
+ * @since 2.1.1
+ */
+template <typename T>
+std::future<T> startCalypsoTask(CalypsoTask<T> task)
+{
+    std::promise<T> promise;
+    std::future<T> result = promise.get_future();
+
+    runCalypsoTask(std::move(task), std::move(promise));
+
+    return result;
+}
+
+}
+}
+}
+
+#endif
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <sstream>
+#include <thread>
 
 /* Calypsonet Terminal Calypso */
 #include "AtomicTransactionException.h"
@@ -50,14 +51,17 @@
 #include "CmdCardReadRecords.h"
 #include "CmdCardRehabilitate.h"
 #include "CmdCardSelectFile.h"
+#include "FileDataAdapter.h"
+#include "LogArgs.h"
 
 /* Keyple Core Util */
 #include "Arrays.h"
 #include "ByteArrayUtil.h"
+#include "Exception.h"
+#include "IllegalArgumentException.h"
 #include "IllegalStateException.h"
 #include "KeypleAssert.h"
 #include "KeypleStd.h"
-#include "MapUtils.h"
 #include "UnsupportedOperationException.h"
 #include "CmdCardRatificationBuilder.h"
 
@@ -123,7 +127,8 @@ CardTransactionManagerAdapter::CardTransactionManagerAdapter(
   mSessionState(SessionState::SESSION_UNINITIALIZED),
   mModificationsCounter(mCalypsoCard->getModificationsCounter()),
   mCardCommandManager(std::make_shared<CardCommandManager>()),
-  mChannelControl(ChannelControl::KEEP_OPEN) {}
+  mChannelControl(ChannelControl::KEEP_OPEN),
+  mIsOperationInProgress(false) {}
 
 CardTransactionManagerAdapter::CardTransactionManagerAdapter(
   const std::shared_ptr<CardReader> cardReader,
@@ -146,6 +151,18 @@ const std::shared_ptr<CardSecuritySetting> CardTransactionManagerAdapter::getCar
     return mCardSecuritySettings;
 }
 
+int CardTransactionManagerAdapter::getChallengePrefetchHitCount() const
+{
+    return mSamCommandProcessor != nullptr ?
+           mSamCommandProcessor->getChallengePrefetchHitCount() : 0;
+}
+
+int CardTransactionManagerAdapter::getChallengePrefetchMissCount() const
+{
+    return mSamCommandProcessor != nullptr ?
+           mSamCommandProcessor->getChallengePrefetchMissCount() : 0;
+}
+
 const std::string CardTransactionManagerAdapter::getTransactionAuditData() const
 {
     return "";
@@ -247,26 +264,24 @@ void CardTransactionManagerAdapter::processAtomicOpening(
     const std::vector<uint8_t> sessionCardChallenge = cmdCardOpenSession->getCardChallenge();
 
     /* The card KIF */
-    const std::shared_ptr<uint8_t> cardKif = cmdCardOpenSession->getSelectedKif();
+    const Optional<uint8_t> cardKif = cmdCardOpenSession->getSelectedKif();
 
     /* The card KVC, may be null for card Rev 1.0 */
-    const std::shared_ptr<uint8_t> cardKvc = cmdCardOpenSession->getSelectedKvc();
+    const Optional<uint8_t> cardKvc = cmdCardOpenSession->getSelectedKvc();
 
-    const std::string logCardKif = cardKif != nullptr ? std::to_string(*cardKif) : "null";
-    const std::string logCardKvc = cardKvc != nullptr ? std::to_string(*cardKvc) : "null";
     mLogger->debug("processAtomicOpening => opening: CARDCHALLENGE = %, CARDKIF = %, CARDKVC = %\n",
-                   ByteArrayUtil::toHex(sessionCardChallenge),
-                   logCardKif,
-                   logCardKvc);
+                   HexLogArg(sessionCardChallenge),
+                   OptionalLogArg<uint8_t>(cardKif),
+                   OptionalLogArg<uint8_t>(cardKvc));
 
-    const std::shared_ptr<uint8_t> kvc = mSamCommandProcessor->computeKvc(writeAccessLevel, cardKvc);
-    const std::shared_ptr<uint8_t> kif =
+    const Optional<uint8_t> kvc = mSamCommandProcessor->computeKvc(writeAccessLevel, cardKvc);
+    const Optional<uint8_t> kif =
         mSamCommandProcessor->computeKif(writeAccessLevel, cardKif, kvc);
 
     if (!std::dynamic_pointer_cast<CardSecuritySettingAdapter>(mCardSecuritySettings)
              ->isSessionKeyAuthorized(kif, kvc)) {
-        const std::string logKif = kif != nullptr ? std::to_string(*kif) : "null";
-        const std::string logKvc = kvc != nullptr ? std::to_string(*kvc) : "null";
+        const std::string logKif = kif.has_value() ? std::to_string(*kif) : "null";
+        const std::string logKvc = kvc.has_value() ? std::to_string(*kvc) : "null";
         throw UnauthorizedKeyException("Unauthorized key error: KIF = " +
                                        logKif +
                                        ", KVC = " +
@@ -317,14 +332,15 @@ CardTransactionManager& CardTransactionManagerAdapter::prepareSetCounter(const u
                                                                          const int counterNumber,
                                                                          const int newValue)
 {
-    std::shared_ptr<int> oldValue;
+    Optional<int> oldValue;
 
     const std::shared_ptr<ElementaryFile> ef = mCalypsoCard->getFileBySfi(sfi);
     if (ef != nullptr) {
-        oldValue = ef->getData()->getContentAsCounterValue(counterNumber);
+        oldValue = std::dynamic_pointer_cast<FileDataAdapter>(ef->getData())
+                       ->getOptionalCounterValue(counterNumber);
     }
 
-    if (oldValue == nullptr) {
+    if (!oldValue) {
         throw IllegalStateException("The value for counter " + std::to_string(counterNumber) +
                                     " in file " + std::to_string(sfi) + " is not available");
     }
@@ -627,6 +643,20 @@ void CardTransactionManagerAdapter::processAtomicClosing(
     }
 
     mSessionState = SessionState::SESSION_CLOSED;
+
+    /*
+     * Get the challenge of the next session in background while the card is processed by the
+     * application, if the SAM is owned by this transaction manager. A SAM of a pool is given back
+     * at the end of each session.
+     */
+    const auto cardSecuritySetting =
+        std::dynamic_pointer_cast<CardSecuritySettingAdapter>(mCardSecuritySettings);
+    if (cardSecuritySetting->isSessionChallengePrefetchEnabled() &&
+        cardSecuritySetting->getSamPool() == nullptr) {
+        prefetchSessionTerminalChallenge();
+    } else {
+        mSamCommandProcessor->releaseSam();
+    }
 }
 
 void CardTransactionManagerAdapter::processAtomicClosing(
@@ -647,8 +677,10 @@ int CardTransactionManagerAdapter::getCounterValue(const int sfi, const int coun
 {
     const std::shared_ptr<ElementaryFile> ef = mCalypsoCard->getFileBySfi(sfi);
     if (ef != nullptr) {
-        const std::shared_ptr<int> counterValue = ef->getData()->getContentAsCounterValue(counter);
-        if (counterValue != nullptr) {
+        const Optional<int> counterValue =
+            std::dynamic_pointer_cast<FileDataAdapter>(ef->getData())
+                ->getOptionalCounterValue(counter);
+        if (counterValue) {
             return *counterValue;
         }
     }
@@ -661,22 +693,14 @@ int CardTransactionManagerAdapter::getCounterValue(const int sfi, const int coun
     throw IllegalStateException(ss.str());
 }
 
-const std::map<const int, const int> CardTransactionManagerAdapter::getCounterValues(
-    const int sfi, const std::vector<int>& counters)
+const std::vector<int> CardTransactionManagerAdapter::getCounterValues(const int sfi)
 {
     const std::shared_ptr<ElementaryFile> ef = mCalypsoCard->getFileBySfi(sfi);
-    if (ef != nullptr) {
-        const std::map<const int, const int> allCountersValue = ef->getData()->getAllCountersValue();
-
-        if (Arrays::containsAll(MapUtils::getKeySet(allCountersValue), counters)) {
-            return allCountersValue;
-        }
+    if (ef == nullptr) {
+        return std::vector<int>();
     }
 
-    std::stringstream ss;
-    ss << "Anticipated response. Unable to determine anticipated value of counters in EF sfi "
-       << sfi;
-    throw IllegalStateException(ss.str());
+    return std::dynamic_pointer_cast<FileDataAdapter>(ef->getData())->getAllCountersValueAsArray();
 }
 
 const std::shared_ptr<ApduResponseApi> CardTransactionManagerAdapter::createIncreaseDecreaseResponse(
@@ -699,7 +723,7 @@ const std::shared_ptr<ApduResponseApi> CardTransactionManagerAdapter::createIncr
 const std::shared_ptr<ApduResponseApi>
     CardTransactionManagerAdapter::createIncreaseDecreaseMultipleResponse(
         const bool isDecreaseCommand,
-        const std::map<const int, const int>& counterNumberToCurrentValueMap,
+        const std::vector<int>& currentCounterValues,
         const std::map<const int, const int>& counterNumberToIncDecValueMap)
 {
     /* Response = CCVVVVVV..CCVVVVVV9000 */
@@ -708,14 +732,9 @@ const std::shared_ptr<ApduResponseApi>
 
     for (const auto& entry : counterNumberToIncDecValueMap) {
         response[index] = static_cast<uint8_t>(entry.first);
-        int newCounterValue;
-        if (isDecreaseCommand) {
-            const auto it = counterNumberToCurrentValueMap.find(entry.first);
-            newCounterValue = it->second - entry.second;
-        } else {
-            const auto it = counterNumberToCurrentValueMap.find(entry.first);
-            newCounterValue = it->second + entry.second;
-        }
+        const int currentCounterValue = currentCounterValues[entry.first - 1];
+        const int newCounterValue = isDecreaseCommand ? currentCounterValue - entry.second :
+                                                        currentCounterValue + entry.second;
 
         response[index + 1] = static_cast<uint8_t>((newCounterValue & 0x00FF0000) >> 16);
         response[index + 2] = static_cast<uint8_t>((newCounterValue & 0x0000FF00) >> 8);
@@ -737,8 +756,9 @@ const std::vector<std::shared_ptr<ApduResponseApi>>
 
     if (!cardCommands.empty()) {
         for (const auto& command : cardCommands) {
-            if (command->getCommandRef() == CalypsoCardCommand::INCREASE ||
-                command->getCommandRef() == CalypsoCardCommand::DECREASE) {
+            switch (command->getCommandRef().getId()) {
+            case CalypsoCardCommand::Id::INCREASE:
+            case CalypsoCardCommand::Id::DECREASE: {
                 auto incdec = std::dynamic_pointer_cast<CmdCardIncreaseOrDecrease>(command);
                 const int sfi = incdec->getSfi();
                 const int counter = incdec->getCounterNumber();
@@ -748,27 +768,41 @@ const std::vector<std::shared_ptr<ApduResponseApi>>
                         command->getCommandRef() == CalypsoCardCommand::DECREASE,
                         getCounterValue(sfi, counter),
                         incdec->getIncDecValue()));
-
-            } else if (command->getCommandRef() == CalypsoCardCommand::INCREASE_MULTIPLE ||
-                       command->getCommandRef() == CalypsoCardCommand::DECREASE_MULTIPLE) {
+                break;
+            }
+            case CalypsoCardCommand::Id::INCREASE_MULTIPLE:
+            case CalypsoCardCommand::Id::DECREASE_MULTIPLE: {
                 auto incdec = std::dynamic_pointer_cast<CmdCardIncreaseOrDecreaseMultiple>(command);
                 const int sfi = incdec->getSfi();
                 const std::map<const int, const int> counterNumberToIncDecValueMap =
                     incdec->getCounterNumberToIncDecValueMap();
+                const std::vector<int> counterValues = getCounterValues(sfi);
+
+                /* Counter numbers are sorted, checking the last one is enough */
+                if (counterNumberToIncDecValueMap.empty() ||
+                    counterNumberToIncDecValueMap.begin()->first < 1 ||
+                    counterNumberToIncDecValueMap.rbegin()->first >
+                        static_cast<int>(counterValues.size())) {
+                    std::stringstream ss;
+                    ss << "Anticipated response. Unable to determine anticipated value of "
+                       << "counters in EF sfi "
+                       << sfi;
+                    throw IllegalStateException(ss.str());
+                }
 
                 apduResponses.push_back(
                     createIncreaseDecreaseMultipleResponse(
                         command->getCommandRef() == CalypsoCardCommand::DECREASE_MULTIPLE,
-                        getCounterValues(sfi,
-                                         MapUtils::getKeySet(counterNumberToIncDecValueMap)),
+                        counterValues,
                         counterNumberToIncDecValueMap));
-
-            } else if (command->getCommandRef() == CalypsoCardCommand::SV_RELOAD ||
-                       command->getCommandRef() == CalypsoCardCommand::SV_DEBIT ||
-                       command->getCommandRef() == CalypsoCardCommand::SV_UNDEBIT) {
+                break;
+            }
+            case CalypsoCardCommand::Id::SV_RELOAD:
+            case CalypsoCardCommand::Id::SV_DEBIT:
+            case CalypsoCardCommand::Id::SV_UNDEBIT:
                 apduResponses.push_back(RESPONSE_OK_POSTPONED);
-
-            } else {
+                break;
+            default:
                 /* Append/Update/Write Record: response = 9000 */
                 apduResponses.push_back(RESPONSE_OK);
             }
@@ -778,8 +812,7 @@ const std::vector<std::shared_ptr<ApduResponseApi>>
     return apduResponses;
 }
 
-CardTransactionManager& CardTransactionManagerAdapter::processOpening(
-    const WriteAccessLevel writeAccessLevel)
+void CardTransactionManagerAdapter::executeOpening(const WriteAccessLevel writeAccessLevel)
 {
     /* CL-KEY-INDEXPO.1 */
     mCurrentWriteAccessLevel = writeAccessLevel;
@@ -833,8 +866,6 @@ CardTransactionManager& CardTransactionManagerAdapter::processOpening(
 
     /* Sets the flag indicating that the commands have been executed */
     mCardCommandManager->notifyCommandsProcessed();
-
-    return *this;
 }
 
 void CardTransactionManagerAdapter::processCardCommandsOutOfSession(
@@ -931,18 +962,16 @@ void CardTransactionManagerAdapter::processCardCommandsInSession()
     mCardCommandManager->notifyCommandsProcessed();
 }
 
-CardTransactionManager& CardTransactionManagerAdapter::processCardCommands()
+void CardTransactionManagerAdapter::executeCardCommands()
 {
     if (mSessionState == SessionState::SESSION_OPEN) {
         processCardCommandsInSession();
     } else {
         processCardCommandsOutOfSession(mChannelControl);
     }
-
-    return *this;
 }
 
-CardTransactionManager& CardTransactionManagerAdapter::processClosing()
+void CardTransactionManagerAdapter::executeClosing()
 {
     checkSessionOpen();
 
@@ -1034,11 +1063,9 @@ CardTransactionManager& CardTransactionManagerAdapter::processClosing()
 
     /* Sets the flag indicating that the commands have been executed */
     mCardCommandManager->notifyCommandsProcessed();
-
-    return *this;
 }
 
-CardTransactionManager& CardTransactionManagerAdapter::processCancel()
+void CardTransactionManagerAdapter::executeCancel()
 {
     checkSessionOpen();
 
@@ -1075,9 +1102,180 @@ CardTransactionManager& CardTransactionManagerAdapter::processCancel()
      */
     mSessionState = SessionState::SESSION_CLOSED;
 
+    /* The SAM allocated to the aborted session, if any, is given back to the pool */
+    mSamCommandProcessor->releaseSam();
+}
+
+CardTransactionManagerAdapter& CardTransactionManagerAdapter::reset(
+    const std::shared_ptr<CalypsoCard> calypsoCard)
+{
+    const auto newCalypsoCard = std::dynamic_pointer_cast<CalypsoCardAdapter>(calypsoCard);
+    Assert::getInstance().notNull(newCalypsoCard, "calypsoCard");
+
+    checkSessionNotOpen();
+
+    if (mIsOperationInProgress) {
+        throw IllegalStateException("An operation is already in progress.");
+    }
+
+    if (mSamCommandProcessor != nullptr) {
+        mSamCommandProcessor->reset(newCalypsoCard);
+    }
+
+    mCalypsoCard = newCalypsoCard;
+    mSessionState = SessionState::SESSION_UNINITIALIZED;
+    mModificationsCounter = mCalypsoCard->getModificationsCounter();
+    mCardCommandManager->reset();
+    mChannelControl = ChannelControl::KEEP_OPEN;
+
+    return *this;
+}
+
+std::shared_ptr<CardTransactionScript> CardTransactionManagerAdapter::compileScript()
+{
+    auto script = std::make_shared<CardTransactionScript>(mCardCommandManager->getCardCommands(),
+                                                          mCalypsoCard);
+
+    mCardCommandManager->notifyCommandsProcessed();
+
+    return script;
+}
+
+CardTransactionManagerAdapter& CardTransactionManagerAdapter::prepareScript(
+    const std::shared_ptr<CardTransactionScript> script)
+{
+    Assert::getInstance().notNull(script, "script");
+
+    if (!script->isCompatibleWith(mCalypsoCard)) {
+        throw IllegalArgumentException("The script was compiled for another card profile.");
+    }
+
+    for (const auto& cardCommand : script->getCardCommands()) {
+        mCardCommandManager->addRegularCommand(cardCommand);
+    }
+
+    return *this;
+}
+
+CardTransactionManagerAdapter& CardTransactionManagerAdapter::setExecutor(
+    const std::shared_ptr<TransactionExecutor> executor)
+{
+    mExecutor = executor;
+
     return *this;
 }
 
+const std::shared_ptr<TransactionExecutor> CardTransactionManagerAdapter::getExecutor() const
+{
+    return mExecutor;
+}
+
+CardTransactionManager& CardTransactionManagerAdapter::processOpening(
+    const WriteAccessLevel writeAccessLevel)
+{
+    processOperation(
+        std::bind(&CardTransactionManagerAdapter::executeOpening, this, writeAccessLevel));
+
+    return *this;
+}
+
+CardTransactionManager& CardTransactionManagerAdapter::processCardCommands()
+{
+    processOperation(std::bind(&CardTransactionManagerAdapter::executeCardCommands, this));
+
+    return *this;
+}
+
+CardTransactionManager& CardTransactionManagerAdapter::processClosing()
+{
+    processOperation(std::bind(&CardTransactionManagerAdapter::executeClosing, this));
+
+    return *this;
+}
+
+CardTransactionManager& CardTransactionManagerAdapter::processCancel()
+{
+    processOperation(std::bind(&CardTransactionManagerAdapter::executeCancel, this));
+
+    return *this;
+}
+
+std::future<void> CardTransactionManagerAdapter::processOpeningAsync(
+    const WriteAccessLevel writeAccessLevel)
+{
+    return submitOperation(
+               std::bind(&CardTransactionManagerAdapter::executeOpening, this, writeAccessLevel));
+}
+
+std::future<void> CardTransactionManagerAdapter::processCardCommandsAsync()
+{
+    return submitOperation(std::bind(&CardTransactionManagerAdapter::executeCardCommands, this));
+}
+
+std::future<void> CardTransactionManagerAdapter::processClosingAsync()
+{
+    return submitOperation(std::bind(&CardTransactionManagerAdapter::executeClosing, this));
+}
+
+std::future<void> CardTransactionManagerAdapter::processCancelAsync()
+{
+    return submitOperation(std::bind(&CardTransactionManagerAdapter::executeCancel, this));
+}
+
+void CardTransactionManagerAdapter::beginOperation()
+{
+    bool isInProgress = false;
+    if (!mIsOperationInProgress.compare_exchange_strong(isInProgress, true)) {
+        throw IllegalStateException("An operation is already in progress.");
+    }
+}
+
+void CardTransactionManagerAdapter::processOperation(const std::function<void()>& operation)
+{
+    beginOperation();
+    runOperation(operation);
+}
+
+std::future<void> CardTransactionManagerAdapter::submitOperation(
+    const std::function<void()>& operation)
+{
+    beginOperation();
+
+    const auto task = std::make_shared<std::packaged_task<void()>>(
+                          std::bind(&CardTransactionManagerAdapter::runOperation, this, operation));
+    std::future<void> result = task->get_future();
+
+    try {
+        if (mExecutor == nullptr) {
+            /* Unlike the one of std::async, the future of a detached thread does not block */
+            std::thread([task]() { (*task)(); }).detach();
+        } else {
+            mExecutor->execute([task]() { (*task)(); });
+        }
+    } catch (const Exception& e) {
+        mIsOperationInProgress = false;
+        throw IllegalStateException("The executor rejected the operation: " + e.getMessage());
+    } catch (...) {
+        mIsOperationInProgress = false;
+        throw;
+    }
+
+    return result;
+}
+
+void CardTransactionManagerAdapter::runOperation(const std::function<void()> operation)
+{
+    try {
+        operation();
+    } catch (...) {
+        /* The exception is forwarded to the caller or to the future of the operation */
+        mIsOperationInProgress = false;
+        throw;
+    }
+
+    mIsOperationInProgress = false;
+}
+
 CardTransactionManager& CardTransactionManagerAdapter::processVerifyPin(
     const std::vector<uint8_t>& pin)
 {
@@ -1312,6 +1510,15 @@ const std::vector<uint8_t> CardTransactionManagerAdapter::getSessionTerminalChal
     return sessionTerminalChallenge;
 }
 
+void CardTransactionManagerAdapter::prefetchSessionTerminalChallenge()
+{
+    try {
+        mSamCommandProcessor->startSessionTerminalChallengePrefetch();
+    } catch (const Exception& e) {
+        mLogger->warn("Unable to prefetch the terminal challenge: %\n", e.getMessage());
+    }
+}
+
 const std::vector<uint8_t> CardTransactionManagerAdapter::getSessionTerminalSignature()
 {
     std::vector<uint8_t> sessionTerminalSignature;
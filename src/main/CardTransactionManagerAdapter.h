@@ -13,6 +13,8 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
+#include <future>
 #include <memory>
 #include <ostream>
 
@@ -31,7 +33,9 @@
 /* Keyple Card Calypso */
 #include "CalypsoCardAdapter.h"
 #include "CardCommandManager.h"
+#include "CardTransactionScript.h"
 #include "SamCommandProcessor.h"
+#include "TransactionExecutor.h"
 
 /* Keyple Core Util */
 #include "LoggerFactory.h"
@@ -71,6 +75,17 @@ using namespace keyple::core::util::cpp;
  *   <li>CL-CSS-INFOEND.1
  * </ul>
  *
+ * <p>Thread safety: an instance and its SamCommandProcessor own all the session state (digest
+ * data, diversification, pending commands). Transactions running on distinct card/SAM reader pairs
+ * can therefore be processed in parallel, one thread per pair, without external locking.
+ *
+ * <p>The asynchronous variants of the process methods (processOpeningAsync, ...) run the same
+ * operation as the blocking ones on the TransactionExecutor set with setExecutor (or on a new
+ * detached thread if none is set), which frees the calling thread. Each operation still runs the
+ * blocking exchanges with the readers on the executor thread, from start to end: ProxyReaderApi
+ * has no non-blocking transmission, so an executor of N threads drives at most N readers at a
+ * time. Only one operation, blocking or not, may be in progress at a time on a given instance.
+ *
  * @since 2.0.0
  */
 class CardTransactionManagerAdapter final : public CardTransactionManager {
@@ -474,6 +489,135 @@ public:
      */
     CardTransactionManager& prepareRehabilitate() final;
 
+    /**
+     * Sets the executor running the asynchronous operations of this transaction.
+     *
+     * <p>If no executor is set, each asynchronous operation is run on a new thread.
+     *
+     * @param executor The executor, possibly shared between several transactions (null to restore
+     *        the default behaviour).
+     * @return The current instance.
+     * @since 2.1.1
+     */
+    CardTransactionManagerAdapter& setExecutor(const std::shared_ptr<TransactionExecutor> executor);
+
+    /**
+     * Gets the executor running the asynchronous operations of this transaction.
+     *
+     * @return Null if no executor is set.
+     * @since 2.1.1
+     */
+    const std::shared_ptr<TransactionExecutor> getExecutor() const;
+
+    /**
+     * Non-blocking variant of processOpening.
+     *
+     * <p>The instance must not be used nor destroyed until the returned future is ready.
+     *
+     * @param writeAccessLevel The write access level to be used.
+     * @return A future becoming ready when the operation ends, providing the exception raised by
+     *         processOpening, if any.
+     * @throw IllegalStateException If another operation is in progress or if the executor does
+     *        not accept the operation.
+     * @since 2.1.1
+     */
+    std::future<void> processOpeningAsync(const WriteAccessLevel writeAccessLevel);
+
+    /**
+     * Non-blocking variant of processCardCommands.
+     *
+     * @return A future becoming ready when the operation ends.
+     * @throw IllegalStateException If another operation is in progress or if the executor does
+     *        not accept the operation.
+     * @see processOpeningAsync
+     * @since 2.1.1
+     */
+    std::future<void> processCardCommandsAsync();
+
+    /**
+     * Non-blocking variant of processClosing.
+     *
+     * @return A future becoming ready when the operation ends.
+     * @throw IllegalStateException If another operation is in progress or if the executor does
+     *        not accept the operation.
+     * @see processOpeningAsync
+     * @since 2.1.1
+     */
+    std::future<void> processClosingAsync();
+
+    /**
+     * Non-blocking variant of processCancel.
+     *
+     * @return A future becoming ready when the operation ends.
+     * @throw IllegalStateException If another operation is in progress or if the executor does
+     *        not accept the operation.
+     * @see processOpeningAsync
+     * @since 2.1.1
+     */
+    std::future<void> processCancelAsync();
+
+    /**
+     * Binds this transaction manager to a newly selected card, so that it can be reused from one
+     * card presentation to the next instead of creating a new one.
+     *
+     * <p>The prepared commands are discarded and the session state is reset. The security settings,
+     * the SAM binding, the prefetched SAM challenge, the executor and the capacity of the internal
+     * buffers are kept. The SAM diversification is kept only if the new card has the same serial
+     * number.
+     *
+     * <p>The card must be selected with the same card reader.
+     *
+     * @param calypsoCard The initial card data provided by the selection process.
+     * @return The object instance.
+     * @throw IllegalArgumentException If calypsoCard is null.
+     * @throw IllegalStateException If a secure session or an operation is in progress.
+     * @since 2.1.1
+     */
+    CardTransactionManagerAdapter& reset(const std::shared_ptr<CalypsoCard> calypsoCard);
+
+    /**
+     * Turns the commands prepared so far into a script that can be replayed for the next cards.
+     *
+     * <p>The prepared commands are moved to the script, so that they are no longer scheduled by
+     * this transaction manager.
+     *
+     * @return A not null reference.
+     * @throw IllegalArgumentException If no commands are prepared or if a prepared command can't be
+     *        part of a script.
+     * @see CardTransactionScript
+     * @since 2.1.1
+     */
+    std::shared_ptr<CardTransactionScript> compileScript();
+
+    /**
+     * Schedules the commands of a script, as if the corresponding "prepare" methods were called.
+     *
+     * @param script The script.
+     * @return The object instance.
+     * @throw IllegalArgumentException If script is null or was compiled for a card having another
+     *        card class, payload capacity or product type.
+     * @since 2.1.1
+     */
+    CardTransactionManagerAdapter& prepareScript(const std::shared_ptr<CardTransactionScript> script);
+
+    /**
+     * Gets the number of secure session openings that used a prefetched SAM challenge.
+     *
+     * @return A positive int.
+     * @see CardSecuritySettingAdapter::enableSessionChallengePrefetch
+     * @since 2.1.1
+     */
+    int getChallengePrefetchHitCount() const;
+
+    /**
+     * Gets the number of secure session openings that had to request the challenge from the SAM.
+     *
+     * @return A positive int.
+     * @see CardSecuritySettingAdapter::enableSessionChallengePrefetch
+     * @since 2.1.1
+     */
+    int getChallengePrefetchMissCount() const;
+
     /**
      *
      */
@@ -577,7 +721,7 @@ private:
     /**
      * The current CalypsoCard
      */
-    const std::shared_ptr<CalypsoCardAdapter> mCalypsoCard;
+    std::shared_ptr<CalypsoCardAdapter> mCalypsoCard;
 
     /**
      * The type of the notified event
@@ -609,12 +753,76 @@ private:
      */
     ChannelControl mChannelControl;
 
+    /**
+     * The executor of the asynchronous operations, null to use a new thread for each one
+     */
+    std::shared_ptr<TransactionExecutor> mExecutor;
+
+    /**
+     * Set while a process operation, blocking or asynchronous, is in progress
+     */
+    std::atomic<bool> mIsOperationInProgress;
+
     /**
      *
      */
     static const std::shared_ptr<ApduResponseApi> RESPONSE_OK;
     static const std::shared_ptr<ApduResponseApi> RESPONSE_OK_POSTPONED;
 
+    /**
+     * Marks an operation as in progress.
+     *
+     * @throw IllegalStateException If another operation is in progress.
+     */
+    void beginOperation();
+
+    /**
+     * Runs an operation on the calling thread.
+     *
+     * @param operation The operation.
+     * @throw IllegalStateException If another operation is in progress.
+     */
+    void processOperation(const std::function<void()>& operation);
+
+    /**
+     * Schedules an operation on the executor, or on a new detached thread if no executor is set.
+     *
+     * @param operation The operation.
+     * @return The future of the operation.
+     * @throw IllegalStateException If another operation is in progress or if the executor does not
+     *        accept the operation.
+     */
+    std::future<void> submitOperation(const std::function<void()>& operation);
+
+    /**
+     * Runs an operation and clears the operation in progress flag.
+     *
+     * @param operation The operation.
+     */
+    void runOperation(const std::function<void()> operation);
+
+    /**
+     * Body of processOpening and processOpeningAsync.
+     *
+     * @param writeAccessLevel The write access level to be used.
+     */
+    void executeOpening(const WriteAccessLevel writeAccessLevel);
+
+    /**
+     * Body of processCardCommands and processCardCommandsAsync.
+     */
+    void executeCardCommands();
+
+    /**
+     * Body of processClosing and processClosingAsync.
+     */
+    void executeClosing();
+
+    /**
+     * Body of processCancel and processCancelAsync.
+     */
+    void executeCancel();
+
     /**
      * Create an ApduRequestAdapter List from a AbstractCardCommand List.
      *
@@ -740,12 +948,9 @@ private:
      * <p>Gets the value of the all counters of the designated file
      *
      * @param sfi The SFI of the EF containing the counter.
-     * @param counters The list of expected counters.
-     * @return A map containing the counters.
-     * @throw IllegalStateException If one of the expected counter was found.
+     * @return The value of counter #n at index n - 1, an empty vector if the file is not found.
      */
-    const std::map<const int, const int> getCounterValues(const int sfi,
-                                                          const std::vector<int>& counters);
+    const std::vector<int> getCounterValues(const int sfi);
 
     /**
      * Create an anticipated response to an Increase/Decrease command
@@ -764,13 +969,14 @@ private:
      *
      * @param isDecreaseCommand True if it is a "Decrease Multiple" command, false if it is an
      *        "Increase Multiple" command.
-     * @param counterNumberToCurrentValueMap The values of the counters currently known in the file.
+     * @param currentCounterValues The values of the counters currently known in the file (counter
+     *        #n at index n - 1), containing all the counters to be decremented/incremented.
      * @param counterNumberToIncDecValueMap The values to be decremented/incremented.
      * @return An ApduResponseApi containing the expected bytes.
      */
     const std::shared_ptr<ApduResponseApi> createIncreaseDecreaseMultipleResponse(
         const bool isDecreaseCommand,
-        const std::map<const int, const int>& counterNumberToCurrentValueMap,
+        const std::vector<int>& currentCounterValues,
         const std::map<const int, const int>& counterNumberToIncDecValueMap);
 
     /**
@@ -830,6 +1036,15 @@ private:
      */
     const std::vector<uint8_t> getSessionTerminalChallenge();
 
+    /**
+     * Starts requesting from the SAM the challenge of the next secure session, without waiting for
+     * the SAM response.
+     *
+     * <p>The next session opening waits for the end of the request. A failure is only logged: the
+     * challenge will then be requested at the session opening.
+     */
+    void prefetchSessionTerminalChallenge();
+
     /**
      * Gets the terminal signature from the SAM, and raises exceptions if necessary.
      *
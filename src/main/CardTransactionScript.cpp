@@ -0,0 +1,147 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+
+#include "CardTransactionScript.h"
+
+/* Keyple Card Calypso */
+#include "CalypsoCardConstant.h"
+#include "CmdCardAppendRecord.h"
+#include "CmdCardIncreaseOrDecrease.h"
+#include "CmdCardUpdateRecord.h"
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+#include "KeypleAssert.h"
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+
+CardTransactionScript::CardTransactionScript(
+  const std::vector<std::shared_ptr<AbstractCardCommand>>& cardCommands,
+  const std::shared_ptr<CalypsoCardAdapter> calypsoCard)
+: mCardCommands(cardCommands),
+  mCardClass(calypsoCard->getCardClass()),
+  mPayloadCapacity(calypsoCard->getPayloadCapacity()),
+  mProductType(calypsoCard->getProductType())
+{
+    if (mCardCommands.empty()) {
+        throw IllegalArgumentException("No commands are prepared.");
+    }
+
+    for (const auto& cardCommand : mCardCommands) {
+        if (!isReplayable(cardCommand->getCommandRef())) {
+            throw IllegalArgumentException("The command " + cardCommand->getName() +
+                                           " can't be part of a transaction script.");
+        }
+    }
+}
+
+int CardTransactionScript::getCommandCount() const
+{
+    return static_cast<int>(mCardCommands.size());
+}
+
+CardTransactionScript& CardTransactionScript::setRecordData(const int commandIndex,
+                                                            const std::vector<uint8_t>& recordData)
+{
+    const std::shared_ptr<AbstractCardCommand> cardCommand = getCardCommand(commandIndex);
+
+    if (cardCommand->getCommandRef() == CalypsoCardCommand::APPEND_RECORD) {
+        std::dynamic_pointer_cast<CmdCardAppendRecord>(cardCommand)->setData(recordData);
+    } else if (cardCommand->getCommandRef() == CalypsoCardCommand::UPDATE_RECORD) {
+        std::dynamic_pointer_cast<CmdCardUpdateRecord>(cardCommand)->setData(recordData);
+    } else {
+        throw IllegalArgumentException("The command #" + std::to_string(commandIndex) +
+                                       " is not an Update Record or Append Record command.");
+    }
+
+    return *this;
+}
+
+CardTransactionScript& CardTransactionScript::setCounterValue(const int commandIndex,
+                                                              const int incDecValue)
+{
+    Assert::getInstance().isInRange(incDecValue,
+                                    CalypsoCardConstant::CNT_VALUE_MIN,
+                                    CalypsoCardConstant::CNT_VALUE_MAX,
+                                    "incDecValue");
+
+    const std::shared_ptr<AbstractCardCommand> cardCommand = getCardCommand(commandIndex);
+
+    if (cardCommand->getCommandRef() != CalypsoCardCommand::INCREASE &&
+        cardCommand->getCommandRef() != CalypsoCardCommand::DECREASE) {
+        throw IllegalArgumentException("The command #" + std::to_string(commandIndex) +
+                                       " is not an Increase or Decrease command.");
+    }
+
+    std::dynamic_pointer_cast<CmdCardIncreaseOrDecrease>(cardCommand)->setIncDecValue(incDecValue);
+
+    return *this;
+}
+
+bool CardTransactionScript::isCompatibleWith(
+    const std::shared_ptr<CalypsoCardAdapter> calypsoCard) const
+{
+    return calypsoCard->getCardClass() == mCardClass &&
+           calypsoCard->getPayloadCapacity() == mPayloadCapacity &&
+           calypsoCard->getProductType() == mProductType;
+}
+
+const std::vector<std::shared_ptr<AbstractCardCommand>>& CardTransactionScript::getCardCommands()
+    const
+{
+    return mCardCommands;
+}
+
+const std::shared_ptr<AbstractCardCommand> CardTransactionScript::getCardCommand(
+    const int commandIndex) const
+{
+    Assert::getInstance().isInRange(commandIndex, 0, getCommandCount() - 1, "commandIndex");
+
+    return mCardCommands[commandIndex];
+}
+
+bool CardTransactionScript::isReplayable(const CalypsoCardCommand& command)
+{
+    /*
+     * The other commands either depend on the session (challenge, SV, PIN, keys) or fill data
+     * owned by the application (Search Record Multiple).
+     */
+    switch (command.getId()) {
+    case CalypsoCardCommand::Id::SELECT_FILE:
+    case CalypsoCardCommand::Id::GET_DATA:
+    case CalypsoCardCommand::Id::READ_RECORDS:
+    case CalypsoCardCommand::Id::READ_RECORD_MULTIPLE:
+    case CalypsoCardCommand::Id::READ_BINARY:
+    case CalypsoCardCommand::Id::UPDATE_RECORD:
+    case CalypsoCardCommand::Id::WRITE_RECORD:
+    case CalypsoCardCommand::Id::APPEND_RECORD:
+    case CalypsoCardCommand::Id::UPDATE_BINARY:
+    case CalypsoCardCommand::Id::WRITE_BINARY:
+    case CalypsoCardCommand::Id::INCREASE:
+    case CalypsoCardCommand::Id::DECREASE:
+    case CalypsoCardCommand::Id::INCREASE_MULTIPLE:
+    case CalypsoCardCommand::Id::DECREASE_MULTIPLE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+}
+}
+}
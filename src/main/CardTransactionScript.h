@@ -0,0 +1,162 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/* Calypsonet Terminal Calypso */
+#include "CalypsoCard.h"
+
+/* Keyple Card Calypso */
+#include "AbstractCardCommand.h"
+#include "CalypsoCardAdapter.h"
+#include "CalypsoCardClass.h"
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+using namespace calypsonet::terminal::calypso::card;
+
+/**
+ * (package-private)<br>
+ * Sequence of card commands prepared once and replayed for each card presented.
+ *
+ * <p>The script is compiled by CardTransactionManagerAdapter::compileScript from the commands
+ * prepared with the usual "prepare" methods. The APDUs are built and checked only at this time,
+ * for the card profile (card class, payload capacity and product type) of the card the manager was
+ * bound to. CardTransactionManagerAdapter::prepareScript then schedules the same commands for
+ * any card having the same profile.
+ *
+ * <p>Only the variable fields of the commands (data of the Update/Append Record commands, value of
+ * the Increase/Decrease commands) can be changed between two replays, they are patched directly in
+ * the APDUs.
+ *
+ * <p>The commands are shared by all the replays: a script must be used by only one transaction
+ * manager at a time.
+ *
+ * @since 2.1.1
+ */
+class CardTransactionScript final {
+public:
+    /**
+     * (package-private)<br>
+     * Creates a script from prepared commands.
+     *
+     * @param cardCommands The prepared commands.
+     * @param calypsoCard The card for which the commands were prepared.
+     * @throw IllegalArgumentException If the list is empty or contains a command that can't be
+     *        replayed (Stored Value, PIN, key management, Search Record Multiple, ...).
+     * @since 2.1.1
+     */
+    CardTransactionScript(const std::vector<std::shared_ptr<AbstractCardCommand>>& cardCommands,
+                          const std::shared_ptr<CalypsoCardAdapter> calypsoCard);
+
+    /**
+     * (package-private)<br>
+     * Gets the number of commands of the script.
+     *
+     * <p>A "prepare" method may have produced several commands (e.g. a read of several records
+     * exceeding the payload capacity of the card).
+     *
+     * @return A positive int.
+     * @since 2.1.1
+     */
+    int getCommandCount() const;
+
+    /**
+     * (package-private)<br>
+     * Changes the data of an Update Record or Append Record command.
+     *
+     * @param commandIndex The index of the command in the script.
+     * @param recordData The new data, of the same length as the data provided at preparation.
+     * @return The object instance.
+     * @throw IllegalArgumentException If the index does not designate an Update Record or Append
+     *        Record command or if the length of the data differs.
+     * @since 2.1.1
+     */
+    CardTransactionScript& setRecordData(const int commandIndex,
+                                         const std::vector<uint8_t>& recordData);
+
+    /**
+     * (package-private)<br>
+     * Changes the value of an Increase or Decrease command.
+     *
+     * @param commandIndex The index of the command in the script.
+     * @param incDecValue The new value in the range [0..16777215].
+     * @return The object instance.
+     * @throw IllegalArgumentException If the index does not designate an Increase or Decrease
+     *        command or if the value is out of range.
+     * @since 2.1.1
+     */
+    CardTransactionScript& setCounterValue(const int commandIndex, const int incDecValue);
+
+    /**
+     * (package-private)<br>
+     * Indicates whether the script can be replayed for the provided card.
+     *
+     * @param calypsoCard The card.
+     * @return True if the card has the profile the script was compiled for.
+     * @since 2.1.1
+     */
+    bool isCompatibleWith(const std::shared_ptr<CalypsoCardAdapter> calypsoCard) const;
+
+    /**
+     * (package-private)<br>
+     * Gets the commands of the script.
+     *
+     * @return A not empty list.
+     * @since 2.1.1
+     */
+    const std::vector<std::shared_ptr<AbstractCardCommand>>& getCardCommands() const;
+
+private:
+    /**
+     *
+     */
+    const std::vector<std::shared_ptr<AbstractCardCommand>> mCardCommands;
+
+    /**
+     *
+     */
+    const CalypsoCardClass mCardClass;
+
+    /**
+     *
+     */
+    const int mPayloadCapacity;
+
+    /**
+     *
+     */
+    const CalypsoCard::ProductType mProductType;
+
+    /**
+     * Gets the command at the provided index.
+     *
+     * @throw IllegalArgumentException If the index is out of range.
+     */
+    const std::shared_ptr<AbstractCardCommand> getCardCommand(const int commandIndex) const;
+
+    /**
+     * Indicates whether a command can be sent again without being rebuilt.
+     */
+    static bool isReplayable(const CalypsoCardCommand& command);
+};
+
+}
+}
+}
@@ -24,6 +24,7 @@
 /* Keyple Core Util */
 #include "ApduUtil.h"
 #include "Arrays.h"
+#include "KeypleAssert.h"
 
 namespace keyple {
 namespace card {
@@ -33,8 +34,23 @@ using namespace keyple::core::util;
 using namespace keyple::core::util::cpp;
 
 const CalypsoCardCommand CmdCardAppendRecord::mCommand = CalypsoCardCommand::APPEND_RECORD;
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardAppendRecord::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6400, "Too many modifications in session.",
+             exceptionClassOf<CardSessionBufferOverflowException>},
+    {0x6700, "Lc value not supported.", exceptionClassOf<CardDataAccessException>},
+    {0x6981, "The current EF is not a Cyclic EF.", exceptionClassOf<CardDataAccessException>},
+    {0x6982, "Security conditions not fulfilled (no session, wrong key).",
+             exceptionClassOf<CardSecurityContextException>},
+    {0x6985, "Access forbidden (Never access mode, DF is invalidated, etc..).",
+             exceptionClassOf<CardAccessForbiddenException>},
+    {0x6986, "Command not allowed (no current EF).", exceptionClassOf<CardDataAccessException>},
+    {0x6A82, "File not found.", exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P1 or P2 value not supported.", exceptionClassOf<CardIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardAppendRecord::CmdCardAppendRecord(const CalypsoCardClass calypsoCardClass,
                                          const uint8_t sfi,
@@ -72,46 +88,18 @@ const std::vector<uint8_t>& CmdCardAppendRecord::getData() const
     return mData;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardAppendRecord::initStatusTable()
+void CmdCardAppendRecord::setData(const std::vector<uint8_t>& data)
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P1 or P2 value not supported.",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Lc value not supported.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6400,
-              std::make_shared<StatusProperties>("Too many modifications in session.",
-                                                 typeid(CardSessionBufferOverflowException))});
-    m.insert({0x6981,
-              std::make_shared<StatusProperties>("The current EF is not a Cyclic EF.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6982,
-              std::make_shared<StatusProperties>("Security conditions not fulfilled (no session, " \
-                                                 "wrong key).",
-                                                  typeid(CardSecurityContextException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Access forbidden (Never access mode, DF is " \
-                                                 "invalidated, etc..).",
-                                                 typeid(CardAccessForbiddenException))});
-    m.insert({0x6986,
-              std::make_shared<StatusProperties>("Command not allowed (no current EF).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A82,
-              std::make_shared<StatusProperties>("File not found.",
-                                                 typeid(CardDataAccessException))});
-
-    return m;
+    Assert::getInstance().isEqual(data.size(), mData.size(), "data length");
+
+    /* The data follows the header and Lc */
+    getApduRequest()->patchApdu(5, data);
+    mData = data;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardAppendRecord::getStatusTable() const
+const StatusTable CmdCardAppendRecord::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
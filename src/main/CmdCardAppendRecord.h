@@ -32,6 +32,7 @@ namespace calypso {
 using namespace keyple::core::util::cpp;
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -79,13 +80,22 @@ public:
      */
     const std::vector<uint8_t>& getData() const;
 
+    /**
+     * (package-private)<br>
+     * Replaces the data sent to the card, the APDU is patched in place.
+     *
+     * @param data The new data, of the same length as the current one.
+     * @throw IllegalArgumentException If the length of the data differs.
+     * @since 2.1.1
+     */
+    void setData(const std::vector<uint8_t>& data);
+
     /**
      * {@inheritDoc}
      *
      * @since 2.0.1
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
 private:
     /**
@@ -94,11 +104,6 @@ private:
     const std::unique_ptr<Logger> mLogger =
         LoggerFactory::getLogger(typeid(CmdCardAppendRecord));
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
     /**
      *
      */
@@ -112,12 +117,8 @@ private:
     /**
      *
      */
-    const std::vector<uint8_t> mData;
+    std::vector<uint8_t> mData;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
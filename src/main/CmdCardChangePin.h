@@ -40,6 +40,7 @@ using namespace calypsonet::terminal::calypso::transaction;
 using namespace keyple::core::util::cpp;
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -73,8 +74,7 @@ public:
      *
      * @since 2.0.1
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
 private:
     /**
@@ -82,15 +82,6 @@ private:
      */
     static const CalypsoCardCommand mCommand;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
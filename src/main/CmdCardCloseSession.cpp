@@ -16,11 +16,11 @@
 
 /* Keyple Core Util */
 #include "ApduUtil.h"
-#include "Arrays.h"
 #include "ByteArrayUtil.h"
 #include "IllegalArgumentException.h"
 
 /* Keyple Card Calypso */
+#include "ApduResponseView.h"
 #include "CalypsoCardAdapter.h"
 #include "CardAccessForbiddenException.h"
 #include "CardIllegalParameterException.h"
@@ -34,8 +34,19 @@ using namespace keyple::core::util;
 using namespace keyple::core::util::cpp;
 
 const CalypsoCardCommand CmdCardCloseSession::mCommand = CalypsoCardCommand::CLOSE_SESSION;
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardCloseSession::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6700, "Lc signatureLo not supported (e.g. Lc=4 with a Revision 3.2 mode for Open Secure " \
+             "Session).",
+             exceptionClassOf<CardIllegalParameterException>},
+    {0x6985, "No session was opened.", exceptionClassOf<CardAccessForbiddenException>},
+    {0x6988, "incorrect signatureLo.", exceptionClassOf<CardSecurityDataException>},
+    {0x6B00, "P1 or P2 signatureLo not supported.",
+             exceptionClassOf<CardIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardCloseSession::CmdCardCloseSession(const std::shared_ptr<CalypsoCard> calypsoCard,
                                          const bool ratificationAsked,
@@ -95,27 +106,27 @@ CmdCardCloseSession& CmdCardCloseSession::setApduResponse(
 {
     AbstractCardCommand::setApduResponse(apduResponse);
 
-    const std::vector<uint8_t> responseData = getApduResponse()->getDataOut();
+    const ApduResponseView responseData(*apduResponse);
 
     if (mCalypsoCard->isExtendedModeSupported()) {
         /* 8-byte signature */
-        if (responseData.size() == 8) {
+        if (responseData.getLength() == 8) {
             /* Signature only */
-            mSignatureLo = Arrays::copyOfRange(responseData, 0, 8);
+            mSignatureLo = responseData.copyOfRange(0, 8);
             mPostponedData = std::vector<uint8_t>(0);
-        } else if (responseData.size() == 12) {
+        } else if (responseData.getLength() == 12) {
             /* Signature + 3 postponed bytes (+1) */
-            mSignatureLo = Arrays::copyOfRange(responseData, 4, 12);
-            mPostponedData = Arrays::copyOfRange(responseData, 1, 4);
-        } else if (responseData.size() == 15) {
+            mSignatureLo = responseData.copyOfRange(4, 12);
+            mPostponedData = responseData.copyOfRange(1, 4);
+        } else if (responseData.getLength() == 15) {
             /* Signature + 6 postponed bytes (+1) */
-            mSignatureLo = Arrays::copyOfRange(responseData, 7, 15);
-            mPostponedData = Arrays::copyOfRange(responseData, 1, 7);
+            mSignatureLo = responseData.copyOfRange(7, 15);
+            mPostponedData = responseData.copyOfRange(1, 7);
         } else {
-            if (responseData.size() != 0) {
+            if (responseData.getLength() != 0) {
             throw IllegalArgumentException("Unexpected length in response to CloseSecureSession " \
                                            "command: " +
-                                           std::to_string(responseData.size()));
+                                           std::to_string(responseData.getLength()));
             }
 
             /* Session abort case */
@@ -124,23 +135,23 @@ CmdCardCloseSession& CmdCardCloseSession::setApduResponse(
         }
     } else {
         /* 4-byte signature */
-        if (responseData.size() == 4) {
+        if (responseData.getLength() == 4) {
             /* Signature only */
-            mSignatureLo = Arrays::copyOfRange(responseData, 0, 4);
+            mSignatureLo = responseData.copyOfRange(0, 4);
             mPostponedData = std::vector<uint8_t>(0);
-        } else if (responseData.size() == 8) {
+        } else if (responseData.getLength() == 8) {
             /* Signature + 3 postponed bytes (+1) */
-            mSignatureLo = Arrays::copyOfRange(responseData, 4, 8);
-            mPostponedData = Arrays::copyOfRange(responseData, 1, 4);
-        } else if (responseData.size() == 11) {
+            mSignatureLo = responseData.copyOfRange(4, 8);
+            mPostponedData = responseData.copyOfRange(1, 4);
+        } else if (responseData.getLength() == 11) {
             /* Signature + 6 postponed bytes (+1) */
-            mSignatureLo = Arrays::copyOfRange(responseData, 7, 11);
-            mPostponedData = Arrays::copyOfRange(responseData, 1, 7);
+            mSignatureLo = responseData.copyOfRange(7, 11);
+            mPostponedData = responseData.copyOfRange(1, 7);
         } else {
-            if (responseData.size() != 0) {
+            if (responseData.getLength() != 0) {
             throw IllegalArgumentException("Unexpected length in response to CloseSecureSession " \
                                            "command: " +
-                                           std::to_string(responseData.size()));
+                                           std::to_string(responseData.getLength()));
             }
 
             /* Session abort case */
@@ -162,33 +173,9 @@ const std::vector<uint8_t>& CmdCardCloseSession::getPostponedData() const
     return mPostponedData;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardCloseSession::initStatusTable()
+const StatusTable CmdCardCloseSession::getStatusTable() const
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Lc signatureLo not supported (e.g. Lc=4 with a " \
-                                                 "Revision 3.2 mode for Open Secure Session).",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P1 or P2 signatureLo not supported.",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6988,
-              std::make_shared<StatusProperties>("incorrect signatureLo.",
-                                                 typeid(CardSecurityDataException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("No session was opened.",
-                                                 typeid(CardAccessForbiddenException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardCloseSession::getStatusTable() const
-{
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
@@ -36,6 +36,7 @@ using namespace calypsonet::terminal::calypso::card;
 using namespace keyple::core::util::cpp;
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -112,8 +113,7 @@ public:
      *
      * @since 2.0.1
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
 private:
     /**
@@ -121,11 +121,6 @@ private:
      */
     static const CalypsoCardCommand mCommand;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
     /**
      *
      */
@@ -141,10 +136,6 @@ private:
      */
     std::vector<uint8_t> mPostponedData;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
@@ -36,8 +36,15 @@ const int CmdCardGetDataEfList::DESCRIPTOR_DATA_SFI_OFFSET = 2;
 const int CmdCardGetDataEfList::DESCRIPTOR_TAG_LENGTH = 8;
 const int CmdCardGetDataEfList::DESCRIPTOR_DATA_LENGTH = 6;
 const CalypsoCardCommand CmdCardGetDataEfList::mCommand = CalypsoCardCommand::GET_DATA;
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardGetDataEfList::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6A88, "Data object not found (optional mode not available).",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P1 or P2 value not supported.", exceptionClassOf<CardDataAccessException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardGetDataEfList::CmdCardGetDataEfList(const CalypsoCardClass calypsoCardClass)
 : AbstractCardCommand(mCommand)
@@ -56,27 +63,9 @@ bool CmdCardGetDataEfList::isSessionBufferUsed() const
     return false;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardGetDataEfList::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6A88,
-              std::make_shared<StatusProperties>("Data object not found (optional mode not " \
-                                                 "available).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P1 or P2 value not supported.",
-                                                 typeid(CardDataAccessException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardGetDataEfList::getStatusTable() const
+const StatusTable CmdCardGetDataEfList::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 const std::map<const std::shared_ptr<FileHeaderAdapter>, const uint8_t>
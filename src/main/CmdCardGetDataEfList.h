@@ -29,6 +29,7 @@ namespace card {
 namespace calypso {
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -63,8 +64,7 @@ public:
      *
      * @since 2.1.0
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
     /**
      * (package-private)<br>
@@ -81,11 +81,6 @@ private:
      */
     static const CalypsoCardCommand mCommand;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
     /**
      *
      */
@@ -105,10 +100,6 @@ private:
     const std::shared_ptr<FileHeaderAdapter> createFileHeader(
         const std::vector<uint8_t>& efDescriptorByteArray) const;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
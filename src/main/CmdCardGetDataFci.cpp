@@ -15,11 +15,11 @@
 /* Keyple Card Calypso */
 #include "ApduRequestAdapter.h"
 #include "CardDataAccessException.h"
+#include "LogArgs.h"
 
 /* Keyple Core Util */
 #include "ApduUtil.h"
 #include "BerTlvUtil.h"
-#include "ByteArrayUtil.h"
 
 namespace keyple {
 namespace card {
@@ -32,8 +32,16 @@ const int CmdCardGetDataFci::TAG_DF_NAME = 0x84;
 const int CmdCardGetDataFci::TAG_APPLICATION_SERIAL_NUMBER = 0xC7;
 const int CmdCardGetDataFci::TAG_DISCRETIONARY_DATA = 0x53;
 const CalypsoCardCommand CmdCardGetDataFci::mCommand = CalypsoCardCommand::GET_DATA;
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardGetDataFci::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6283, "Successful execution, FCI request and DF is invalidated."},
+    {0x6A88, "Data object not found (optional mode not available).",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P1 or P2 value not supported.", exceptionClassOf<CardDataAccessException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardGetDataFci::CmdCardGetDataFci(const CalypsoCardClass calypsoCardClass)
 : AbstractCardCommand(mCommand), mIsDfInvalidated(false), mIsValidCalypsoFCI(false)
@@ -98,7 +106,7 @@ CmdCardGetDataFci& CmdCardGetDataFci::setApduResponse(
             return *this;
         }
 
-        mLogger->debug("DF name = %\n", ByteArrayUtil::toHex(mDfName));
+        mLogger->debug("DF name = %\n", HexLogArg(mDfName));
 
         it = tags.find(TAG_APPLICATION_SERIAL_NUMBER);
         if (it == tags.end()) {
@@ -115,7 +123,7 @@ CmdCardGetDataFci& CmdCardGetDataFci::setApduResponse(
             return *this;
         }
 
-        mLogger->debug("Application Serial Number = %\n", ByteArrayUtil::toHex(mApplicationSN));
+        mLogger->debug("Application Serial Number = %\n", HexLogArg(mApplicationSN));
 
         it = tags.find(TAG_DISCRETIONARY_DATA);
         if (it == tags.end()) {
@@ -131,7 +139,7 @@ CmdCardGetDataFci& CmdCardGetDataFci::setApduResponse(
             return *this;
         }
 
-        mLogger->debug("Discretionary Data = %\n", ByteArrayUtil::toHex(mDiscretionaryData));
+        mLogger->debug("Discretionary Data = %\n", HexLogArg(mDiscretionaryData));
 
         /* All 3 main fields were retrieved */
         mIsValidCalypsoFCI = true;
@@ -169,31 +177,9 @@ bool CmdCardGetDataFci::isDfInvalidated() const
     return mIsDfInvalidated;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardGetDataFci::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6A88,
-              std::make_shared<StatusProperties>("Data object not found (optional mode not " \
-                                                 "available).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P1 or P2 value not supported.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6283,
-              std::make_shared<StatusProperties>("Successful execution, FCI request and DF is " \
-                                                 "invalidated.",
-                                                 typeid(nullptr))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardGetDataFci::getStatusTable() const
+const StatusTable CmdCardGetDataFci::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
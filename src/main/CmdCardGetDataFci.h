@@ -33,6 +33,7 @@ namespace calypso {
 using namespace keyple::core::util::cpp;
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -147,8 +148,7 @@ public:
      *
      * @since 2.0.1
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
 private:
     /**
@@ -161,11 +161,6 @@ private:
      */
     static const CalypsoCardCommand mCommand;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
     /**
      * BER-TLV tags definitions
      */
@@ -194,10 +189,6 @@ private:
      */
     std::vector<uint8_t> mDiscretionaryData;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
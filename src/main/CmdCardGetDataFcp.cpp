@@ -30,8 +30,16 @@ using namespace keyple::core::util::cpp::exception;
 
 const CalypsoCardCommand CmdCardGetDataFcp::mCommand = CalypsoCardCommand::GET_DATA;
 const int CmdCardGetDataFcp::TAG_PROPRIETARY_INFORMATION = 0x85;
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardGetDataFcp::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6A82, "File not found.", exceptionClassOf<CardDataAccessException>},
+    {0x6A88, "Data object not found (optional mode not available).",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P1 or P2 value not supported.", exceptionClassOf<CardDataAccessException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardGetDataFcp::CmdCardGetDataFcp(const CalypsoCardClass calypsoCardClass)
 : AbstractCardCommand(mCommand)
@@ -68,30 +76,9 @@ const std::vector<uint8_t>& CmdCardGetDataFcp::getProprietaryInformation()
     return mProprietaryInformation;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardGetDataFcp::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6A88,
-              std::make_shared<StatusProperties>("Data object not found (optional mode not " \
-                                                 "available).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A82,
-              std::make_shared<StatusProperties>("File not found.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P1 or P2 value not supported.",
-                                                 typeid(CardDataAccessException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardGetDataFcp::getStatusTable() const
+const StatusTable CmdCardGetDataFcp::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
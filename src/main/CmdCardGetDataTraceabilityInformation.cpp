@@ -26,8 +26,15 @@ using namespace keyple::core::util;
 
 const CalypsoCardCommand CmdCardGetDataTraceabilityInformation::mCommand =
     CalypsoCardCommand::GET_DATA;
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardGetDataTraceabilityInformation::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6A88, "Data object not found (optional mode not available).",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P1 or P2 value not supported.", exceptionClassOf<CardDataAccessException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardGetDataTraceabilityInformation::CmdCardGetDataTraceabilityInformation(
     const CalypsoCardClass calypsoCardClass)
@@ -48,27 +55,9 @@ bool CmdCardGetDataTraceabilityInformation::isSessionBufferUsed() const
     return false;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardGetDataTraceabilityInformation::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6A88,
-              std::make_shared<StatusProperties>("Data object not found (optional mode not " \
-                                                 "available).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P1 or P2 value not supported.",
-                                                 typeid(CardDataAccessException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardGetDataTraceabilityInformation::getStatusTable() const
+const StatusTable CmdCardGetDataTraceabilityInformation::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
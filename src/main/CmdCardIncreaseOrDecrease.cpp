@@ -33,8 +33,26 @@ namespace calypso {
 using namespace keyple::core::util;
 using namespace keyple::core::util::cpp;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardIncreaseOrDecrease::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6103, "Successful execution (possible only in ISO7816 T=0)."},
+    {0x6400, "Too many modifications in session.",
+             exceptionClassOf<CardSessionBufferOverflowException>},
+    {0x6700, "Lc value not supported.", exceptionClassOf<CardIllegalParameterException>},
+    {0x6981, "The current EF is not a Counters or Simulated Counter EF.",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6982, "Security conditions not fulfilled (no session, wrong key, encryption required).",
+             exceptionClassOf<CardSecurityContextException>},
+    {0x6985, "Access forbidden (Never access mode, DF is invalidated, etc.)",
+             exceptionClassOf<CardAccessForbiddenException>},
+    {0x6986, "Command not allowed (no current EF).", exceptionClassOf<CardDataAccessException>},
+    {0x6A80, "Overflow error.", exceptionClassOf<CardDataOutOfBoundsException>},
+    {0x6A82, "File not found.", exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P1 or P2 value not supported.", exceptionClassOf<CardDataAccessException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardIncreaseOrDecrease::CmdCardIncreaseOrDecrease(
   const bool isDecreaseCommand,
@@ -103,54 +121,20 @@ int CmdCardIncreaseOrDecrease::getIncDecValue() const
     return mIncDecValue;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardIncreaseOrDecrease::initStatusTable()
+void CmdCardIncreaseOrDecrease::setIncDecValue(const int incDecValue)
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        CmdCardIncreaseOrDecrease::STATUS_TABLE;
-
-    m.insert({0x6400,
-              std::make_shared<StatusProperties>("Too many modifications in session.",
-                                                 typeid(CardSessionBufferOverflowException))});
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Lc value not supported.",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6981,
-              std::make_shared<StatusProperties>("The current EF is not a Counters or Simulated " \
-                                                 "Counter EF.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6982,
-              std::make_shared<StatusProperties>("Security conditions not fulfilled (no session, " \
-                                                 "wrong key, encryption required).",
-                                                 typeid(CardSecurityContextException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Access forbidden (Never access mode, DF is " \
-                                                 "invalidated, etc.)",
-                                                 typeid(CardAccessForbiddenException))});
-    m.insert({0x6986,
-              std::make_shared<StatusProperties>("Command not allowed (no current EF).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A80,
-              std::make_shared<StatusProperties>("Overflow error.",
-                                                 typeid(CardDataOutOfBoundsException))});
-    m.insert({0x6A82,
-              std::make_shared<StatusProperties>("File not found.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P1 or P2 value not supported.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6103,
-              std::make_shared<StatusProperties>("Successful execution (possible only in ISO7816 " \
-                                                 "T=0).",
-                                                 typeid(nullptr))});
-
-    return m;
+    const std::vector<uint8_t> valueBuffer = {static_cast<uint8_t>((incDecValue >> 16) & 0xFF),
+                                              static_cast<uint8_t>((incDecValue >> 8) & 0xFF),
+                                              static_cast<uint8_t>(incDecValue & 0xFF)};
+
+    /* The value follows the header and Lc */
+    getApduRequest()->patchApdu(5, valueBuffer);
+    mIncDecValue = incDecValue;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardIncreaseOrDecrease::getStatusTable() const
+const StatusTable CmdCardIncreaseOrDecrease::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
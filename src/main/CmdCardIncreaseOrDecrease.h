@@ -32,6 +32,7 @@ namespace calypso {
 using namespace keyple::core::util::cpp;
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -94,14 +95,23 @@ public:
      */
     int getIncDecValue() const;
 
+    /**
+     * (package-private)<br>
+     * Replaces the decrement/increment value, the APDU is patched in place.
+     *
+     * <p>The name of the command keeps the value provided at construction.
+     *
+     * @param incDecValue The new value.
+     * @since 2.1.1
+     */
+    void setIncDecValue(const int incDecValue);
+
     /**
      * {@inheritDoc}
      *
      * @since 2.1.0
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
-
+    const StatusTable getStatusTable() const override;
 
 private:
     /**
@@ -110,11 +120,6 @@ private:
     const std::unique_ptr<Logger> mLogger =
         LoggerFactory::getLogger(typeid(CmdCardIncreaseOrDecrease));
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
     /**
      *
      */
@@ -128,12 +133,8 @@ private:
     /**
      *
      */
-    const int mIncDecValue;
+    int mIncDecValue;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
@@ -17,9 +17,9 @@
 
 /* Keyple Core Util */
 #include "ApduUtil.h"
-#include "Arrays.h"
 
 /* Keyple Card Calypso */
+#include "ApduResponseView.h"
 #include "CardAccessForbiddenException.h"
 #include "CardDataAccessException.h"
 #include "CardIllegalParameterException.h"
@@ -33,8 +33,28 @@ namespace calypso {
 using namespace keyple::core::util;
 using namespace keyple::core::util::cpp;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardIncreaseOrDecreaseMultiple::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6400, "Too many modifications in session.",
+             exceptionClassOf<CardSessionBufferOverflowException>},
+    {0x6700, "Lc value not supported.", exceptionClassOf<CardIllegalParameterException>},
+    {0x6981, "Incorrect EF type: not a Counters EF.", exceptionClassOf<CardDataAccessException>},
+    {0x6982, "Security conditions not fulfilled (no secure session, incorrect key, encryption " \
+             "required, PKI mode and not Always access mode).",
+             exceptionClassOf<CardSecurityContextException>},
+    {0x6985, "Access forbidden (Never access mode, DF is invalid, etc.).",
+             exceptionClassOf<CardAccessForbiddenException>},
+    {0x6986, "Incorrect file type: the Current File is not an EF. Supersedes 6981h.",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6A80, "Incorrect command data (Overflow error, Incorrect counter number, Counter number " \
+             "present more than once).",
+             exceptionClassOf<CardIllegalParameterException>},
+    {0x6A82, "File not found.", exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P1 or P2 value not supported.", exceptionClassOf<CardIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardIncreaseOrDecreaseMultiple::CmdCardIncreaseOrDecreaseMultiple(
   const bool isDecreaseCommand,
@@ -83,53 +103,9 @@ bool CmdCardIncreaseOrDecreaseMultiple::isSessionBufferUsed() const
     return true;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardIncreaseOrDecreaseMultiple::initStatusTable()
+const StatusTable CmdCardIncreaseOrDecreaseMultiple::getStatusTable() const
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6400,
-              std::make_shared<StatusProperties>("Too many modifications in session.",
-                                                 typeid(CardSessionBufferOverflowException))});
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Lc value not supported.",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6981,
-              std::make_shared<StatusProperties>("Incorrect EF type: not a Counters EF.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6982,
-              std::make_shared<StatusProperties>("Security conditions not fulfilled (no secure " \
-                                                 "session, incorrect key, encryption required, " \
-                                                 "PKI mode and not Always access mode).",
-                                                 typeid(CardSecurityContextException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Access forbidden (Never access mode, DF is " \
-                                                 "invalid, etc.).",
-                                                 typeid(CardAccessForbiddenException))});
-    m.insert({0x6986,
-              std::make_shared<StatusProperties>("Incorrect file type: the Current File is not " \
-                                                 "an EF. Supersedes 6981h.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A80,
-              std::make_shared<StatusProperties>("Incorrect command data (Overflow error, " \
-                                                 "Incorrect counter number, Counter number " \
-                                                 "present more than once).",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6A82,
-              std::make_shared<StatusProperties>("File not found.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P1 or P2 value not supported.",
-                                                 typeid(CardIllegalParameterException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardIncreaseOrDecreaseMultiple::getStatusTable() const
-{
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 CmdCardIncreaseOrDecreaseMultiple& CmdCardIncreaseOrDecreaseMultiple::setApduResponse(
@@ -137,12 +113,16 @@ CmdCardIncreaseOrDecreaseMultiple& CmdCardIncreaseOrDecreaseMultiple::setApduRes
 {
     AbstractCardCommand::setApduResponse(apduResponse);
 
-    if (apduResponse->getDataOut().size() > 0) {
-        const std::vector<uint8_t> dataOut = apduResponse->getDataOut();
-        const int nbCounters = dataOut.size() / 4;
+    /* The command may be replayed by a transaction script */
+    mNewCounterValues.clear();
+
+    const ApduResponseView dataOut(*apduResponse);
+
+    if (!dataOut.isEmpty()) {
+        const int nbCounters = dataOut.getLength() / 4;
         for (int i = 0; i < nbCounters; i++) {
             mNewCounterValues.insert({dataOut[i * 4] & 0xFF,
-                                     Arrays::copyOfRange(dataOut, (i * 4) + 1, (i * 4) + 4)});
+                                     dataOut.copyOfRange((i * 4) + 1, (i * 4) + 4)});
         }
     }
 
@@ -33,6 +33,7 @@ namespace calypso {
 using namespace keyple::core::util::cpp;
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -75,8 +76,7 @@ public:
      *
      * @since 2.1.0
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
     /**
      * {@inheritDoc}
@@ -117,11 +117,6 @@ private:
     const std::unique_ptr<Logger> mLogger =
         LoggerFactory::getLogger(typeid(CmdCardIncreaseOrDecreaseMultiple));
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
     /**
      *
      */
@@ -137,10 +132,6 @@ private:
      */
     std::map<const int, const std::vector<uint8_t>> mNewCounterValues;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
@@ -28,8 +28,19 @@ namespace calypso {
 using namespace keyple::core::util;
 
 const CalypsoCardCommand CmdCardInvalidate::mCommand = CalypsoCardCommand::INVALIDATE;
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardInvalidate::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6400, "Too many modifications in session.",
+             exceptionClassOf<CardSessionBufferOverflowException>},
+    {0x6700, "Lc value not supported.", exceptionClassOf<CardDataAccessException>},
+    {0x6982, "Security conditions not fulfilled (no session, wrong key).",
+             exceptionClassOf<CardSecurityContextException>},
+    {0x6985, "Access forbidden (DF context is invalid).",
+             exceptionClassOf<CardAccessForbiddenException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardInvalidate::CmdCardInvalidate(const CalypsoCardClass calypsoCardClass)
 : AbstractCardCommand(mCommand)
@@ -47,33 +58,9 @@ bool CmdCardInvalidate::isSessionBufferUsed() const
     return true;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardInvalidate::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6400,
-              std::make_shared<StatusProperties>("Too many modifications in session.",
-                                                 typeid(CardSessionBufferOverflowException))});
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Lc value not supported.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6982,
-              std::make_shared<StatusProperties>("Security conditions not fulfilled (no session, " \
-                                                 "wrong key).",
-                                                 typeid(CardSecurityContextException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Access forbidden (DF context is invalid).",
-                                                 typeid(CardAccessForbiddenException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardInvalidate::getStatusTable() const
+const StatusTable CmdCardInvalidate::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
@@ -16,7 +16,6 @@
 
 /* Keyple Core Util */
 #include "ApduUtil.h"
-#include "Arrays.h"
 #include "ByteArrayUtil.h"
 #include "IllegalArgumentException.h"
 #include "IllegalStateException.h"
@@ -44,8 +43,8 @@ CmdCardOpenSession::SecureSession::SecureSession(const std::vector<uint8_t>& cha
                              const std::vector<uint8_t>& challengeRandomNumber,
                              const bool previousSessionRatified,
                              const bool manageSecureSessionAuthorized,
-                             const std::shared_ptr<uint8_t> kif,
-                             const std::shared_ptr<uint8_t> kvc,
+                             const Optional<uint8_t> kif,
+                             const Optional<uint8_t> kvc,
                              const std::vector<uint8_t>& originalData,
                              const std::vector<uint8_t>& secureSessionData)
 : mChallengeTransactionCounter(challengeTransactionCounter),
@@ -78,12 +77,12 @@ bool CmdCardOpenSession::SecureSession::isManageSecureSessionAuthorized() const
     return mManageSecureSessionAuthorized;
 }
 
-const std::shared_ptr<uint8_t> CmdCardOpenSession::SecureSession::getKIF() const
+const Optional<uint8_t> CmdCardOpenSession::SecureSession::getKIF() const
 {
     return mKif;
 }
 
-const std::shared_ptr<uint8_t> CmdCardOpenSession::SecureSession::getKVC() const
+const Optional<uint8_t> CmdCardOpenSession::SecureSession::getKVC() const
 {
     return mKvc;
 }
@@ -100,8 +99,30 @@ const std::vector<uint8_t>& CmdCardOpenSession::SecureSession::getSecureSessionD
 
 /* CMD CARD OPEN SESSIO ------------------------------------------------------------------------- */
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardOpenSession::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x61FF, "Correct execution (ISO7816 T=0)."},
+    {0x6700, "Lc value not supported.", exceptionClassOf<CardIllegalParameterException>},
+    {0x6900, "Transaction Counter is 0", exceptionClassOf<CardTerminatedException>},
+    {0x6981, "Command forbidden (read requested and current EF is a Binary file).",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6982, "Security conditions not fulfilled (PIN code not presented, AES key forbidding the " \
+             "compatibility mode, encryption required).",
+             exceptionClassOf<CardSecurityContextException>},
+    {0x6985, "Access forbidden (Never access mode, Session already opened).",
+             exceptionClassOf<CardAccessForbiddenException>},
+    {0x6986, "Command not allowed (read requested and no current EF).",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6A81, "Wrong key index.", exceptionClassOf<CardIllegalParameterException>},
+    {0x6A82, "File not found.", exceptionClassOf<CardDataAccessException>},
+    {0x6A83, "Record not found (record index is above NumRec).",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P1 or P2 value not supported (key index incorrect, wrong P2).",
+             exceptionClassOf<CardIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardOpenSession::CmdCardOpenSession(const std::shared_ptr<CalypsoCard> calypsoCard,
                                        const uint8_t debitKeyIndex,
@@ -262,8 +283,8 @@ CmdCardOpenSession& CmdCardOpenSession::setApduResponse(
 {
     AbstractCardCommand::setApduResponse(apduResponse);
 
-    const std::vector<uint8_t> dataOut = getApduResponse()->getDataOut();
-    if (dataOut.size() > 0) {
+    const ApduResponseView dataOut(*apduResponse);
+    if (!dataOut.isEmpty()) {
         switch (mCalypsoCard->getProductType()) {
             case CalypsoCard::ProductType::PRIME_REVISION_1:
                 parseRev10(dataOut);
@@ -279,54 +300,60 @@ CmdCardOpenSession& CmdCardOpenSession::setApduResponse(
     return *this;
 }
 
-void CmdCardOpenSession::parseRev3(const std::vector<uint8_t>& apduResponseData)
+void CmdCardOpenSession::parseRev3(const ApduResponseView& apduResponseData)
 {
     bool previousSessionRatified;
     bool manageSecureSessionAuthorized;
-    int offset;
 
     /* CL-CSS-OSSRFU.1 */
-    if (!mCalypsoCard->isExtendedModeSupported()) {
-        offset = 0;
+    const int offset = mCalypsoCard->isExtendedModeSupported() ? 4 : 0;
+
+    /* Fixed part, then the record data */
+    if (apduResponseData.getLength() < 8 + offset ||
+        apduResponseData.getLength() < 8 + offset + apduResponseData[7 + offset]) {
+        throw IllegalStateException("Bad response length to Open Secure Session: " +
+                                    std::to_string(apduResponseData.getLength()));
+    }
+
+    if (offset == 0) {
         previousSessionRatified = apduResponseData[4] == 0x00;
         manageSecureSessionAuthorized = false;
     } else {
-        offset = 4;
         previousSessionRatified = (apduResponseData[8] & 0x01) == 0x00;
         manageSecureSessionAuthorized = (apduResponseData[8] & 0x02) == 0x02;
     }
 
-    const auto kif = std::make_shared<uint8_t>(apduResponseData[5 + offset]);
-    const auto kvc = std::make_shared<uint8_t>(apduResponseData[6 + offset]);
+    const Optional<uint8_t> kif(apduResponseData[5 + offset]);
+    const Optional<uint8_t> kvc(apduResponseData[6 + offset]);
     const int dataLength = apduResponseData[7 + offset];
     const std::vector<uint8_t> data =
-        Arrays::copyOfRange(apduResponseData, 8 + offset, 8 + offset + dataLength);
+        apduResponseData.copyOfRange(8 + offset, 8 + offset + dataLength);
 
     mSecureSession = std::shared_ptr<SecureSession>(
                          new SecureSession(
-                            Arrays::copyOfRange(apduResponseData, 0, 3),
-                            Arrays::copyOfRange(apduResponseData, 3, 4 + offset),
+                            apduResponseData.copyOfRange(0, 3),
+                            apduResponseData.copyOfRange(3, 4 + offset),
                             previousSessionRatified,
                             manageSecureSessionAuthorized,
                             kif,
                             kvc,
                             data,
-                            apduResponseData));
+                            apduResponseData.toVector()));
 }
 
-void CmdCardOpenSession::parseRev24(const std::vector<uint8_t>& apduResponseData)
+void CmdCardOpenSession::parseRev24(const ApduResponseView& apduResponseData)
 {
     bool previousSessionRatified;
     std::vector<uint8_t> data;
 
-    switch (apduResponseData.size()) {
+    switch (apduResponseData.getLength()) {
     case 5:
         previousSessionRatified = true;
         data = std::vector<uint8_t>(0);
         break;
     case 34:
         previousSessionRatified = true;
-        data = Arrays::copyOfRange(apduResponseData, 5, 34);
+        data = apduResponseData.copyOfRange(5, 34);
         break;
     case 7:
         previousSessionRatified = false;
@@ -334,40 +361,40 @@ void CmdCardOpenSession::parseRev24(const std::vector<uint8_t>& apduResponseData
         break;
     case 36:
         previousSessionRatified = false;
-        data = Arrays::copyOfRange(apduResponseData, 7, 36);
+        data = apduResponseData.copyOfRange(7, 36);
         break;
     default:
         throw IllegalStateException("Bad response length to Open Secure Session: " +
-                                    std::to_string(apduResponseData.size()));
+                                    std::to_string(apduResponseData.getLength()));
     }
 
-    const auto kvc = std::make_shared<uint8_t>(apduResponseData[0]);
+    const Optional<uint8_t> kvc(apduResponseData[0]);
 
     mSecureSession = std::shared_ptr<SecureSession>(
                          new SecureSession(
-                            Arrays::copyOfRange(apduResponseData, 1, 4),
-                            Arrays::copyOfRange(apduResponseData, 4, 5),
+                            apduResponseData.copyOfRange(1, 4),
+                            apduResponseData.copyOfRange(4, 5),
                             previousSessionRatified,
                             false,
-                            nullptr,
+                            Optional<uint8_t>(),
                             kvc,
                             data,
-                            apduResponseData));
+                            apduResponseData.toVector()));
 }
 
-void CmdCardOpenSession::parseRev10(const std::vector<uint8_t>& apduResponseData) {
+void CmdCardOpenSession::parseRev10(const ApduResponseView& apduResponseData) {
 
     bool previousSessionRatified;
     std::vector<uint8_t> data;
 
-    switch (apduResponseData.size()) {
+    switch (apduResponseData.getLength()) {
     case 4:
         previousSessionRatified = true;
         data = std::vector<uint8_t>(0);
         break;
     case 33:
         previousSessionRatified = true;
-        data = Arrays::copyOfRange(apduResponseData, 4, 33);
+        data = apduResponseData.copyOfRange(4, 33);
         break;
     case 6:
         previousSessionRatified = false;
@@ -375,24 +402,24 @@ void CmdCardOpenSession::parseRev10(const std::vector<uint8_t>& apduResponseData
         break;
     case 35:
         previousSessionRatified = false;
-        data = Arrays::copyOfRange(apduResponseData, 6, 35);
+        data = apduResponseData.copyOfRange(6, 35);
         break;
     default:
         throw IllegalStateException("Bad response length to Open Secure Session: " +
-                                    std::to_string(apduResponseData.size()));
+                                    std::to_string(apduResponseData.getLength()));
     }
 
     /* KVC doesn't exist and is set to null for this type of card */
     mSecureSession = std::shared_ptr<SecureSession>(
                          new SecureSession(
-                             Arrays::copyOfRange(apduResponseData, 0, 3),
-                             Arrays::copyOfRange(apduResponseData, 3, 4),
+                             apduResponseData.copyOfRange(0, 3),
+                             apduResponseData.copyOfRange(3, 4),
                              previousSessionRatified,
                              false,
-                             nullptr,
-                             nullptr,
+                             Optional<uint8_t>(),
+                             Optional<uint8_t>(),
                              data,
-                             apduResponseData));
+                             apduResponseData.toVector()));
 }
 
 const std::vector<uint8_t>& CmdCardOpenSession::getCardChallenge() const
@@ -415,12 +442,12 @@ bool CmdCardOpenSession::isManageSecureSessionAuthorized() const
     return mSecureSession->isManageSecureSessionAuthorized();
 }
 
-const std::shared_ptr<uint8_t> CmdCardOpenSession::getSelectedKif() const
+const Optional<uint8_t> CmdCardOpenSession::getSelectedKif() const
 {
     return mSecureSession->getKIF();
 }
 
-const std::shared_ptr<uint8_t> CmdCardOpenSession::getSelectedKvc() const
+const Optional<uint8_t> CmdCardOpenSession::getSelectedKvc() const
 {
     return mSecureSession->getKVC();
 }
@@ -430,59 +457,9 @@ const std::vector<uint8_t>& CmdCardOpenSession::getRecordDataRead() const
     return mSecureSession->getOriginalData();
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardOpenSession::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Lc value not supported.",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6900,
-              std::make_shared<StatusProperties>("Transaction Counter is 0",
-                                                 typeid(CardTerminatedException))});
-    m.insert({0x6981,
-              std::make_shared<StatusProperties>("Command forbidden (read requested and current " \
-                                                 "EF is a Binary file).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6982,
-              std::make_shared<StatusProperties>("Security conditions not fulfilled (PIN code " \
-                                                 "not presented, AES key forbidding the " \
-                                                 "compatibility mode, encryption required).",
-                                                 typeid(CardSecurityContextException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Access forbidden (Never access mode, Session " \
-                                                 "already opened).",
-                                                 typeid(CardAccessForbiddenException))});
-    m.insert({0x6986,
-              std::make_shared<StatusProperties>("Command not allowed (read requested and no " \
-                                                 "current EF).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A81,
-              std::make_shared<StatusProperties>("Wrong key index.",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6A82,
-              std::make_shared<StatusProperties>("File not found.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A83,
-              std::make_shared<StatusProperties>("Record not found (record index is above NumRec).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P1 or P2 value not supported (key index " \
-                                                 "incorrect, wrong P2).",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x61FF,
-              std::make_shared<StatusProperties>("Correct execution (ISO7816 T=0).",
-                                                 typeid(nullptr))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardOpenSession::getStatusTable() const
+const StatusTable CmdCardOpenSession::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
@@ -23,7 +23,9 @@
 /* Keyple Card Calypso */
 #include "AbstractApduCommand.h"
 #include "AbstractCardCommand.h"
+#include "ApduResponseView.h"
 #include "CalypsoCardClass.h"
+#include "Optional.h"
 
 /* Keyple Core Util */
 #include "LoggerFactory.h"
@@ -36,6 +38,7 @@ using namespace calypsonet::terminal::calypso::card;
 using namespace keyple::core::util::cpp;
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -153,6 +156,7 @@ public:
     /**
      * {@inheritDoc}
      *
+     * @throw IllegalStateException If the data out of the response is malformed.
      * @since 2.0.1
      */
     CmdCardOpenSession& setApduResponse(const std::shared_ptr<ApduResponseApi> apduResponse)
@@ -164,7 +168,7 @@ public:
      *
      * @param apduResponseData The response data.
      */
-    void parseRev3(const std::vector<uint8_t>& apduResponseData);
+    void parseRev3(const ApduResponseView& apduResponseData);
 
     /**
      * (private)<br>
@@ -194,7 +198,7 @@ public:
      *
      * @param apduResponseData The response data.
      */
-    void parseRev24(const std::vector<uint8_t>& apduResponseData);
+    void parseRev24(const ApduResponseView& apduResponseData);
 
     /**
      * (private)<br>
@@ -223,7 +227,7 @@ public:
      *
      * @param apduResponseData The response data.
      */
-    void parseRev10(const std::vector<uint8_t>& apduResponseData);
+    void parseRev10(const ApduResponseView& apduResponseData);
 
     /**
      * (package-private)<br>
@@ -263,7 +267,7 @@ public:
      * @return The current KIF.
      * @since 2.0.1
      */
-    const std::shared_ptr<uint8_t> getSelectedKif() const;
+    const Optional<uint8_t> getSelectedKif() const;
 
     /**
      * (package-private)<br>
@@ -271,7 +275,7 @@ public:
      * @return The current KVC.
      * @since 2.0.1
      */
-    const std::shared_ptr<uint8_t> getSelectedKvc() const;
+    const Optional<uint8_t> getSelectedKvc() const;
 
     /**
      * (package-private)<br>
@@ -286,8 +290,7 @@ public:
      *
      * @since 2.0.1
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
 private:
     /**
@@ -333,7 +336,7 @@ private:
          * @return A byte
          * @since 2.0.1
          */
-        const std::shared_ptr<uint8_t> getKIF() const;
+        const Optional<uint8_t> getKIF() const;
 
         /**
          * Gets the kvc.
@@ -341,7 +344,7 @@ private:
          * @return A byte
          * @since 2.0.1
          */
-        const std::shared_ptr<uint8_t> getKVC() const;
+        const Optional<uint8_t> getKVC() const;
 
         /**
          * Gets the original data.
@@ -381,14 +384,14 @@ private:
         const bool mManageSecureSessionAuthorized;
 
         /**
-         * The kif (it may be null if it doesn't exist in the considered card [rev 1.0])
+         * The kif (it may be empty if it doesn't exist in the considered card [rev 1.0])
          */
-        const std::shared_ptr<uint8_t> mKif;
+        const Optional<uint8_t> mKif;
 
         /**
-         * The kvc (it may be null if it doesn't exist in the considered card [rev 1.0])
+         * The kvc (it may be empty if it doesn't exist in the considered card [rev 1.0])
          */
-        const std::shared_ptr<uint8_t> mKvc;
+        const Optional<uint8_t> mKvc;
 
         /**
          * The original data
@@ -419,8 +422,8 @@ private:
                       const std::vector<uint8_t>& challengeRandomNumber,
                       const bool previousSessionRatified,
                       const bool manageSecureSessionAuthorized,
-                      const std::shared_ptr<uint8_t> kif,
-                      const std::shared_ptr<uint8_t> kvc,
+                      const Optional<uint8_t> kif,
+                      const Optional<uint8_t> kvc,
                       const std::vector<uint8_t>& originalData,
                       const std::vector<uint8_t>& secureSessionData);
     };
@@ -430,11 +433,6 @@ private:
      */
     const std::unique_ptr<Logger> mLogger = LoggerFactory::getLogger(typeid(CmdCardOpenSession));
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
     /**
      *
      */
@@ -455,10 +453,6 @@ private:
      */
     std::shared_ptr<SecureSession> mSecureSession;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
@@ -36,6 +36,7 @@ using namespace calypsonet::terminal::calypso::card;
 using namespace keyple::core::util::cpp;
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -89,8 +90,7 @@ public:
      *
      * @since 2.1.0
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
 private:
     /**
@@ -98,11 +98,6 @@ private:
      */
     const std::unique_ptr<Logger> mLogger = LoggerFactory::getLogger(typeid(CmdCardReadBinary));
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
     /**
      *
      */
@@ -113,10 +108,6 @@ private:
      */
     const int mOffset;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
@@ -16,9 +16,9 @@
 
 /* Keyple Core Util */
 #include "ApduUtil.h"
-#include "Arrays.h"
 
 /* Keyple Card Calypso */
+#include "ApduResponseView.h"
 #include "CardAccessForbiddenException.h"
 #include "CardDataAccessException.h"
 #include "CardIllegalParameterException.h"
@@ -32,8 +32,30 @@ namespace calypso {
 using namespace keyple::core::util;
 using namespace keyple::core::util::cpp;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardReadRecordMultiple::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6200, "Successful execution, partial read only: issue another Read Record Multiple from " \
+             "record (P1 + (Size of returned data) / (R. Length)) to continue reading."},
+    {0x6700, "Lc value not supported (<4).", exceptionClassOf<CardIllegalParameterException>},
+    {0x6981, "Incorrect EF type: Binary EF.", exceptionClassOf<CardDataAccessException>},
+    {0x6982, "Security conditions not fulfilled (PIN code not presented, encryption required).",
+             exceptionClassOf<CardSecurityContextException>},
+    {0x6985, "Access forbidden (Never access mode, Stored Value log file and a Stored Value " \
+             "operation was done during the current secure session).",
+             exceptionClassOf<CardAccessForbiddenException>},
+    {0x6986, "Incorrect file type: the Current File is not an EF. Supersedes 6981h.",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6A80, "Incorrect command data (incorrect Tag, incorrect Length, R. Length > RecSize, R. " \
+             "Offset + R. Length > RecSize, R. Length = 0).",
+             exceptionClassOf<CardIllegalParameterException>},
+    {0x6A82, "File not found.", exceptionClassOf<CardDataAccessException>},
+    {0x6A83, "Record not found (record index is 0, or above NumRec).",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P1 or P2 value not supported.", exceptionClassOf<CardIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardReadRecordMultiple::CmdCardReadRecordMultiple(
     const CalypsoCardClass calypsoCardClass,
@@ -73,59 +95,9 @@ bool CmdCardReadRecordMultiple::isSessionBufferUsed() const
     return false;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardReadRecordMultiple::initStatusTable()
+const StatusTable CmdCardReadRecordMultiple::getStatusTable() const
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Lc value not supported (<4).",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6981,
-              std::make_shared<StatusProperties>("Incorrect EF type: Binary EF.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6982,
-              std::make_shared<StatusProperties>("Security conditions not fulfilled (PIN code " \
-                                                 "not presented, encryption required).",
-                                                 typeid(CardSecurityContextException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Access forbidden (Never access mode, Stored " \
-                                                 "Value log file and a Stored Value operation was" \
-                                                 " done during the current secure session).",
-                                                 typeid(CardAccessForbiddenException))});
-    m.insert({0x6986,
-              std::make_shared<StatusProperties>("Incorrect file type: the Current File is not " \
-                                                 "an EF. Supersedes 6981h.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A80,
-              std::make_shared<StatusProperties>("Incorrect command data (incorrect Tag, " \
-                                                 "incorrect Length, R. Length > RecSize, R. " \
-                                                 "Offset + R. Length > RecSize, R. Length = 0).",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6A82,
-              std::make_shared<StatusProperties>("File not found.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A83,
-              std::make_shared<StatusProperties>("Record not found (record index is 0, or above " \
-                                                 "NumRec).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P1 or P2 value not supported.",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6200,
-              std::make_shared<StatusProperties>("Successful execution, partial read only: issue " \
-                                                 "another Read Record Multiple from record (P1 + " \
-                                                 "(Size of returned data) / (R. Length)) to " \
-                                                 "continue reading.")});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardReadRecordMultiple::getStatusTable() const
-{
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 CmdCardReadRecordMultiple& CmdCardReadRecordMultiple::setApduResponse(
@@ -133,12 +105,16 @@ CmdCardReadRecordMultiple& CmdCardReadRecordMultiple::setApduResponse(
 {
     AbstractCardCommand::setApduResponse(apduResponse);
 
-    if (apduResponse->getDataOut().size() > 0) {
-        const std::vector<uint8_t> dataOut = apduResponse->getDataOut();
-        const int nbRecords = dataOut.size() / mLength;
+    /* The command may be replayed by a transaction script */
+    mResults.clear();
+
+    const ApduResponseView dataOut(*apduResponse);
+
+    if (!dataOut.isEmpty()) {
+        const int nbRecords = dataOut.getLength() / mLength;
         for (int i = 0; i < nbRecords; i++) {
             mResults.insert({mRecordNumber + i,
-                             Arrays::copyOfRange(dataOut, i * mLength, (i + 1) * mLength)});
+                             dataOut.copyOfRange(i * mLength, (i + 1) * mLength)});
         }
     }
 
@@ -32,6 +32,7 @@ namespace calypso {
 using namespace keyple::core::util::cpp;
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -71,8 +72,7 @@ public:
      *
      * @since 2.1.0
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
     /**
      * {@inheritDoc}
@@ -114,11 +114,6 @@ private:
     const std::unique_ptr<Logger> mLogger =
         LoggerFactory::getLogger(typeid(CmdCardReadRecordMultiple));
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
     /**
      *
      */
@@ -144,10 +139,6 @@ private:
      */
     std::map<const int, const std::vector<uint8_t>> mResults;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
@@ -15,6 +15,7 @@
 #include <sstream>
 
 /* Keyple Card Calypso */
+#include "ApduResponseView.h"
 #include "CardAccessForbiddenException.h"
 #include "CardDataAccessException.h"
 #include "CardIllegalParameterException.h"
@@ -22,7 +23,7 @@
 
 /* Keyple Core Util */
 #include "ApduUtil.h"
-#include "Arrays.h"
+#include "IllegalStateException.h"
 
 namespace keyple {
 namespace card {
@@ -30,10 +31,26 @@ namespace calypso {
 
 using namespace keyple::core::util;
 using namespace keyple::core::util::cpp;
+using namespace keyple::core::util::cpp::exception;
 
 const CalypsoCardCommand CmdCardReadRecords::mCommand = CalypsoCardCommand::READ_RECORDS;
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardReadRecords::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6981, "Command forbidden on binary files", exceptionClassOf<CardDataAccessException>},
+    {0x6982, "Security conditions not fulfilled (PIN code not presented, encryption required).",
+             exceptionClassOf<CardSecurityContextException>},
+    {0x6985, "Access forbidden (Never access mode, stored value log file and a stored value " \
+             "operation was done during the current session).",
+             exceptionClassOf<CardAccessForbiddenException>},
+    {0x6986, "Command not allowed (no current EF)", exceptionClassOf<CardDataAccessException>},
+    {0x6A82, "File not found", exceptionClassOf<CardDataAccessException>},
+    {0x6A83, "Record not found (record index is 0, or above NumRec",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P2 value not supported", exceptionClassOf<CardIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardReadRecords::CmdCardReadRecords(const CalypsoCardClass calypsoCardClass,
                                        const int sfi,
@@ -71,45 +88,9 @@ bool CmdCardReadRecords::isSessionBufferUsed() const
     return false;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardReadRecords::initStatusTable()
+const StatusTable CmdCardReadRecords::getStatusTable() const
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6981,
-              std::make_shared<StatusProperties>("Command forbidden on binary files",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6982,
-              std::make_shared<StatusProperties>("Security conditions not fulfilled (PIN code " \
-                                                 "not presented, encryption required).",
-                                                 typeid(CardSecurityContextException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Access forbidden (Never access mode, stored " \
-                                                 "value log file and a stored value operation was" \
-                                                 " done during the current session).",
-                                                 typeid(CardAccessForbiddenException))});
-    m.insert({0x6986,
-              std::make_shared<StatusProperties>("Command not allowed (no current EF)",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A82,
-              std::make_shared<StatusProperties>("File not found",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A83,
-              std::make_shared<StatusProperties>("Record not found (record index is 0, or above " \
-                                                 "NumRec",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P2 value not supported",
-                                                 typeid(CardIllegalParameterException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardReadRecords::getStatusTable() const
-{
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 CmdCardReadRecords& CmdCardReadRecords::setApduResponse(
@@ -117,19 +98,28 @@ CmdCardReadRecords& CmdCardReadRecords::setApduResponse(
 {
     AbstractCardCommand::setApduResponse(apduResponse);
 
-    if (apduResponse->getDataOut().size() > 0) {
+    /* The command may be replayed by a transaction script */
+    mRecords.clear();
+
+    const ApduResponseView dataOut(*apduResponse);
+
+    if (!dataOut.isEmpty()) {
         if (mReadMode == CmdCardReadRecords::ReadMode::ONE_RECORD) {
-            mRecords.insert({mFirstRecordNumber, apduResponse->getDataOut()});
+            mRecords.insert({mFirstRecordNumber, dataOut.toVector()});
         } else {
-            const std::vector<uint8_t> mApdu = apduResponse->getDataOut();
-            int apduLen = mApdu.size();
+            const int apduLen = dataOut.getLength();
             int index = 0;
-            while (apduLen > 0) {
-                const uint8_t recordNb = mApdu[index++];
-                const uint8_t len = mApdu[index++];
-                mRecords.insert({recordNb, Arrays::copyOfRange(mApdu, index, index + len)});
+            while (index < apduLen) {
+                /* Record number and length, then the record data */
+                if (index + 2 > apduLen || index + 2 + dataOut[index + 1] > apduLen) {
+                    throw IllegalStateException("Bad response length to Read Records: " +
+                                                std::to_string(apduLen));
+                }
+
+                const uint8_t recordNb = dataOut[index++];
+                const uint8_t len = dataOut[index++];
+                mRecords.insert({recordNb, dataOut.copyOfRange(index, index + len)});
                 index = index + len;
-                apduLen -= (2 + len);
             }
         }
     }
@@ -33,6 +33,7 @@ namespace calypso {
 using namespace keyple::core::util::cpp;
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -93,12 +94,12 @@ public:
      *
      * @since 2.0.1
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
     /**
      * {@inheritDoc}
      *
+     * @throw IllegalStateException If the data out of the response is malformed.
      * @since 2.1.0
      */
     CmdCardReadRecords& setApduResponse(const std::shared_ptr<ApduResponseApi> apduResponse)
@@ -153,11 +154,6 @@ private:
      */
     static const CalypsoCardCommand mCommand;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
     /**
      * Construction arguments used for parsing
      */
@@ -178,11 +174,6 @@ private:
      */
     std::map<const int, const std::vector<uint8_t>> mRecords;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
-
 };
 
 }
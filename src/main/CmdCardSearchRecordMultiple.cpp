@@ -18,9 +18,11 @@
 #include "ApduUtil.h"
 #include "Arrays.h"
 #include "ByteArrayUtil.h"
+#include "IllegalStateException.h"
 #include "System.h"
 
 /* Keyple Card Calypso */
+#include "ApduResponseView.h"
 #include "CardAccessForbiddenException.h"
 #include "CardDataAccessException.h"
 #include "CardIllegalParameterException.h"
@@ -33,9 +35,32 @@ namespace calypso {
 
 using namespace keyple::core::util;
 using namespace keyple::core::util::cpp;
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardSearchRecordMultiple::STATUS_TABLE = initStatusTable();
+using namespace keyple::core::util::cpp::exception;
+
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6400, "Data Out overflow (outgoing data would be too long).",
+             exceptionClassOf<CardSessionBufferOverflowException>},
+    {0x6700, "Lc value not supported (<4).", exceptionClassOf<CardIllegalParameterException>},
+    {0x6981, "Incorrect EF type: Binary EF.", exceptionClassOf<CardDataAccessException>},
+    {0x6982, "Security conditions not fulfilled (PIN code not presented, encryption required).",
+             exceptionClassOf<CardSecurityContextException>},
+    {0x6985, "Access forbidden (Never access mode, Stored Value log file and a Stored Value " \
+             "operation wasdone during the current secure session).",
+             exceptionClassOf<CardAccessForbiddenException>},
+    {0x6986, "Incorrect file type: the Current File is not an EF. Supersedes 6981h.",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6A80, "Incorrect command data (S. Length incompatible with Lc, S. Length > RecSize, S. " \
+             "Offset + S. Length > RecSize, S. Mask bigger than S. Data).",
+             exceptionClassOf<CardIllegalParameterException>},
+    {0x6A82, "File not found.", exceptionClassOf<CardDataAccessException>},
+    {0x6A83, "Record not found (record index is 0, or above NumRec).",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P1 or P2 value not supported.", exceptionClassOf<CardIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardSearchRecordMultiple::CmdCardSearchRecordMultiple(
   const CalypsoCardClass calypsoCardClass,
@@ -107,58 +132,9 @@ bool CmdCardSearchRecordMultiple::isSessionBufferUsed() const
     return false;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardSearchRecordMultiple::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6400,
-              std::make_shared<StatusProperties>("Data Out overflow (outgoing data would be too" \
-                                                 " long).",
-                                                 typeid(CardSessionBufferOverflowException))});
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Lc value not supported (<4).",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6981,
-              std::make_shared<StatusProperties>("Incorrect EF type: Binary EF.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6982,
-              std::make_shared<StatusProperties>("Security conditions not fulfilled (PIN code " \
-                                                 "not presented, encryption required).",
-                                                 typeid(CardSecurityContextException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Access forbidden (Never access mode, Stored " \
-                                                 "Value log file and a Stored Value operation was" \
-                                                 "done during the current secure session).",
-                                                 typeid(CardAccessForbiddenException))});
-    m.insert({0x6986,
-              std::make_shared<StatusProperties>("Incorrect file type: the Current File is not " \
-                                                 "an EF. Supersedes 6981h.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A80,
-              std::make_shared<StatusProperties>("Incorrect command data (S. Length incompatible " \
-                                                 "with Lc, S. Length > RecSize, S. Offset + S. " \
-                                                 "Length > RecSize, S. Mask bigger than S. Data).",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6A82,
-              std::make_shared<StatusProperties>("File not found.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A83,
-              std::make_shared<StatusProperties>("Record not found (record index is 0, or above " \
-                                                 "NumRec).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P1 or P2 value not supported.",
-                                                 typeid(CardIllegalParameterException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardSearchRecordMultiple::getStatusTable() const
+const StatusTable CmdCardSearchRecordMultiple::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 CmdCardSearchRecordMultiple& CmdCardSearchRecordMultiple::setApduResponse(
@@ -166,17 +142,21 @@ CmdCardSearchRecordMultiple& CmdCardSearchRecordMultiple::setApduResponse(
 {
     AbstractCardCommand::setApduResponse(apduResponse);
 
-    if (apduResponse->getDataOut().size() > 0) {
-        const std::vector<uint8_t> dataOut = apduResponse->getDataOut();
+    const ApduResponseView dataOut(*apduResponse);
 
+    if (!dataOut.isEmpty()) {
         const int nbRecords = dataOut[0];
+        if (nbRecords + 1 > dataOut.getLength()) {
+            throw IllegalStateException("Bad response length to Search Record Multiple: " +
+                                        std::to_string(dataOut.getLength()));
+        }
+
         for (int i = 1; i <= nbRecords; i++) {
             mData->getMatchingRecordNumbers().push_back(dataOut[i]);
         }
 
         if (mData->isFetchFirstMatchingResult() && nbRecords > 0) {
-            mFirstMatchingRecordContent =
-                Arrays::copyOfRange(dataOut, nbRecords + 1, dataOut.size());
+            mFirstMatchingRecordContent = dataOut.copyOfRange(nbRecords + 1, dataOut.getLength());
         }
     }
 
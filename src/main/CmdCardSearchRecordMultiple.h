@@ -33,6 +33,7 @@ namespace calypso {
 using namespace keyple::core::util::cpp;
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -66,12 +67,12 @@ public:
      *
      * @since 2.1.0
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
     /**
      * {@inheritDoc}
      *
+     * @throw IllegalStateException If the data out of the response is malformed.
      * @since 2.1.0
      */
     CmdCardSearchRecordMultiple& setApduResponse(
@@ -101,11 +102,6 @@ private:
     const std::unique_ptr<Logger> mLogger =
         LoggerFactory::getLogger(typeid(CmdCardSearchRecordMultiple));
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
     /**
      *
      */
@@ -116,10 +112,6 @@ private:
      */
     std::vector<uint8_t> mFirstMatchingRecordContent;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
@@ -38,8 +38,20 @@ using namespace keyple::core::util::cpp::exception;
 
 const CalypsoCardCommand CmdCardSvReload::mCommand = CalypsoCardCommand::SV_RELOAD;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardSvReload::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6200, "Successful execution, response data postponed until session closing."},
+    {0x6400, "Too many modifications in session.",
+             exceptionClassOf<CardSessionBufferOverflowException>},
+    {0x6700, "Lc value not supported.", exceptionClassOf<CardIllegalParameterException>},
+    {0x6900, "Transaction counter is 0 or SV TNum is FFFEh or FFFFh.",
+             exceptionClassOf<CalypsoSamCounterOverflowException>},
+    {0x6985, "Preconditions not satisfied.", exceptionClassOf<CalypsoSamAccessForbiddenException>},
+    {0x6988, "Incorrect signatureHi.", exceptionClassOf<CardSecurityDataException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardSvReload::CmdCardSvReload(const std::shared_ptr<CalypsoCard> calypsoCard,
                                  const int amount,
@@ -154,40 +166,9 @@ const std::vector<uint8_t> CmdCardSvReload::getSignatureLo() const
     return getApduResponse()->getDataOut();
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardSvReload::initStatusTable()
+const StatusTable CmdCardSvReload::getStatusTable() const
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6400,
-              std::make_shared<StatusProperties>("Too many modifications in session.",
-                                                 typeid(CardSessionBufferOverflowException))});
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Lc value not supported.",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6900,
-              std::make_shared<StatusProperties>("Transaction counter is 0 or SV TNum is FFFEh or" \
-                                                 " FFFFh.",
-                                                 typeid(CalypsoSamCounterOverflowException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Preconditions not satisfied.",
-                                                 typeid(CalypsoSamAccessForbiddenException))});
-    m.insert({0x6988,
-              std::make_shared<StatusProperties>("Incorrect signatureHi.",
-                                                 typeid(CardSecurityDataException))});
-    m.insert({0x6200,
-              std::make_shared<StatusProperties>("Successful execution, response data postponed " \
-                                                 "until session closing.",
-                                                 typeid(nullptr))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardSvReload::getStatusTable() const
-{
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
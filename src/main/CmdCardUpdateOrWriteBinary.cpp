@@ -34,8 +34,27 @@ namespace calypso {
 using namespace keyple::core::util;
 using namespace keyple::core::util::cpp;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardUpdateOrWriteBinary::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6400, "Too many modifications in session",
+             exceptionClassOf<CardSessionBufferOverflowException>},
+    {0x6700, "Lc value not supported, or Offset+Lc > file size",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6981, "Incorrect EF type: not a Binary EF", exceptionClassOf<CardDataAccessException>},
+    {0x6982, "Security conditions not fulfilled (no secure session, incorrect key, encryption " \
+             "required, PKI mode and not Always access mode)",
+             exceptionClassOf<CardSecurityContextException>},
+    {0x6985, "Access forbidden (Never access mode, DF is invalidated, etc..)",
+             exceptionClassOf<CardAccessForbiddenException>},
+    {0x6986, "Incorrect file type: the Current File is not an EF. Supersedes 6981h",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6A82, "File not found", exceptionClassOf<CardDataAccessException>},
+    {0x6A83, "Offset not in the file (offset overflow)", exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P1 value not supported", exceptionClassOf<CardIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardUpdateOrWriteBinary::CmdCardUpdateOrWriteBinary(
   const bool isUpdateCommand,
@@ -95,51 +114,9 @@ const std::vector<uint8_t>& CmdCardUpdateOrWriteBinary::getData() const
     return mData;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardUpdateOrWriteBinary::initStatusTable()
+const StatusTable CmdCardUpdateOrWriteBinary::getStatusTable() const
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6400,
-              std::make_shared<StatusProperties>("Too many modifications in session",
-                                                 typeid(CardSessionBufferOverflowException))});
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Lc value not supported, or Offset+Lc > file size",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6981,
-              std::make_shared<StatusProperties>("Incorrect EF type: not a Binary EF",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6982,
-              std::make_shared<StatusProperties>("Security conditions not fulfilled (no secure " \
-                                                 "session, incorrect key, encryption required, " \
-                                                 "PKI mode and not Always access mode)",
-                                                 typeid(CardSecurityContextException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Access forbidden (Never access mode, DF is " \
-                                                 "invalidated, etc..)",
-                                                 typeid(CardAccessForbiddenException))});
-    m.insert({0x6986,
-              std::make_shared<StatusProperties>("Incorrect file type: the Current File is not " \
-                                                 "an EF. Supersedes 6981h",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A82,
-              std::make_shared<StatusProperties>("File not found",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A83,
-              std::make_shared<StatusProperties>("Offset not in the file (offset overflow)",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P1 value not supported",
-                                                 typeid(CardIllegalParameterException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardUpdateOrWriteBinary::getStatusTable() const
-{
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
@@ -16,6 +16,7 @@
 
 /* Keyple Core Util */
 #include "ApduUtil.h"
+#include "KeypleAssert.h"
 
 /* Keyple Card Calypso */
 #include "CardAccessForbiddenException.h"
@@ -31,8 +32,26 @@ namespace calypso {
 using namespace keyple::core::util;
 
 const CalypsoCardCommand CmdCardUpdateRecord::mCommand = CalypsoCardCommand::UPDATE_RECORD;
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardUpdateRecord::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6400, "Too many modifications in session.",
+             exceptionClassOf<CardSessionBufferOverflowException>},
+    {0x6700, "Lc value not supported.", exceptionClassOf<CardDataAccessException>},
+    {0x6981, "Command forbidden on cyclic files when the record exists and is not record 01h and " \
+             "on binary files.",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6982, "Security conditions not fulfilled (no session, wrong key, encryption required).",
+             exceptionClassOf<CardSecurityContextException>},
+    {0x6985, "Access forbidden (Never access mode, DF is invalidated, etc..).",
+             exceptionClassOf<CardAccessForbiddenException>},
+    {0x6986, "Command not allowed (no current EF).", exceptionClassOf<CardDataAccessException>},
+    {0x6A83, "Record is not found (record index is 0 or above NumRec).",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P2 value not supported.", exceptionClassOf<CardIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardUpdateRecord::CmdCardUpdateRecord(const CalypsoCardClass calypsoCardClass,
                                          const uint8_t sfi,
@@ -82,49 +101,18 @@ const std::vector<uint8_t>& CmdCardUpdateRecord::getData() const
     return mData;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardUpdateRecord::initStatusTable()
+void CmdCardUpdateRecord::setData(const std::vector<uint8_t>& data)
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6400,
-              std::make_shared<StatusProperties>("Too many modifications in session.",
-                                                 typeid(CardSessionBufferOverflowException))});
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Lc value not supported.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6981,
-              std::make_shared<StatusProperties>("Command forbidden on cyclic files when the " \
-                                                 "record exists and is not record 01h and on " \
-                                                 "binary files.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6982,
-              std::make_shared<StatusProperties>("Security conditions not fulfilled (no session, " \
-                                                 "wrong key, encryption required).",
-                                                 typeid(CardSecurityContextException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Access forbidden (Never access mode, DF is " \
-                                                 "invalidated, etc..).",
-                                                 typeid(CardAccessForbiddenException))});
-    m.insert({0x6986,
-              std::make_shared<StatusProperties>("Command not allowed (no current EF).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A83,
-              std::make_shared<StatusProperties>("Record is not found (record index is 0 or " \
-                                                 "above NumRec).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P2 value not supported.",
-                                                 typeid(CardIllegalParameterException))});
-
-    return m;
+    Assert::getInstance().isEqual(data.size(), mData.size(), "data length");
+
+    /* The data follows the header and Lc */
+    getApduRequest()->patchApdu(5, data);
+    mData = data;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardUpdateRecord::getStatusTable() const
+const StatusTable CmdCardUpdateRecord::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
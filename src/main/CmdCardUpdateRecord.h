@@ -33,6 +33,7 @@ namespace calypso {
 using namespace keyple::core::util::cpp;
 
 using StatusProperties = AbstractApduCommand::StatusProperties;
+using StatusTable = AbstractApduCommand::StatusTable;
 
 /**
  * (package-private)<br>
@@ -93,13 +94,22 @@ public:
      */
     const std::vector<uint8_t>& getData() const;
 
+    /**
+     * (package-private)<br>
+     * Replaces the data sent to the card, the APDU is patched in place.
+     *
+     * @param data The new data, of the same length as the current one.
+     * @throw IllegalArgumentException If the length of the data differs.
+     * @since 2.1.1
+     */
+    void setData(const std::vector<uint8_t>& data);
+
     /**
      * {@inheritDoc}
      *
      * @since 2.0.1
      */
-    const std::map<const int, const std::shared_ptr<StatusProperties>>& getStatusTable() const
-        override;
+    const StatusTable getStatusTable() const override;
 
 private:
     /**
@@ -108,12 +118,6 @@ private:
     const std::unique_ptr<Logger> mLogger =
         LoggerFactory::getLogger(typeid(CmdCardUpdateRecord));
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> STATUS_TABLE;
-
-
     /**
      * The command
      */
@@ -132,12 +136,8 @@ private:
     /**
      *
      */
-    const std::vector<uint8_t> mData;
+    std::vector<uint8_t> mData;
 
-    /**
-     *
-     */
-    static const std::map<const int, const std::shared_ptr<StatusProperties>> initStatusTable();
 };
 
 }
@@ -31,8 +31,26 @@ namespace calypso {
 using namespace keyple::core::util;
 
 const CalypsoCardCommand CmdCardWriteRecord::mCommand = CalypsoCardCommand::WRITE_RECORD;
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardWriteRecord::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6400, "Too many modifications in session.",
+             exceptionClassOf<CardSessionBufferOverflowException>},
+    {0x6700, "Lc value not supported.", exceptionClassOf<CardDataAccessException>},
+    {0x6981, "Wrong EF type (not a Linear EF, or Cyclic EF with Record Number 01h).",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6982, "Security conditions not fulfilled (no session, wrong key, encryption required).",
+             exceptionClassOf<CardSecurityContextException>},
+    {0x6985, "Access forbidden (Never access mode, DF is invalidated, etc..).",
+             exceptionClassOf<CardAccessForbiddenException>},
+    {0x6986, "Command not allowed (no current EF).", exceptionClassOf<CardDataAccessException>},
+    {0x6A82, "File not found.", exceptionClassOf<CardDataAccessException>},
+    {0x6A83, "Record is not found (record index is 0 or above NumRec).",
+             exceptionClassOf<CardDataAccessException>},
+    {0x6B00, "P2 value not supported.", exceptionClassOf<CardIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdCardWriteRecord::CmdCardWriteRecord(const CalypsoCardClass calypsoCardClass,
                                        const uint8_t sfi,
@@ -81,51 +99,9 @@ const std::vector<uint8_t>& CmdCardWriteRecord::getData() const
     return mData;
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdCardWriteRecord::initStatusTable()
+const StatusTable CmdCardWriteRecord::getStatusTable() const
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractApduCommand::STATUS_TABLE;
-
-    m.insert({0x6400,
-              std::make_shared<StatusProperties>("Too many modifications in session.",
-                                                 typeid(CardSessionBufferOverflowException))});
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Lc value not supported.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6981,
-              std::make_shared<StatusProperties>("Wrong EF type (not a Linear EF, or Cyclic EF " \
-                                                 "with Record Number 01h).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6982,
-              std::make_shared<StatusProperties>("Security conditions not fulfilled (no session, " \
-                                                 "wrong key, encryption required).",
-                                                 typeid(CardSecurityContextException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Access forbidden (Never access mode, DF is " \
-                                                 "invalidated, etc..).",
-                                                 typeid(CardAccessForbiddenException))});
-    m.insert({0x6986,
-              std::make_shared<StatusProperties>("Command not allowed (no current EF).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A82,
-              std::make_shared<StatusProperties>("File not found.",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6A83,
-              std::make_shared<StatusProperties>("Record is not found (record index is 0 or " \
-                                                 "above NumRec).",
-                                                 typeid(CardDataAccessException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("P2 value not supported.",
-                                                 typeid(CardIllegalParameterException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdCardWriteRecord::getStatusTable() const
-{
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
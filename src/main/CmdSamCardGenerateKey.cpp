@@ -32,8 +32,21 @@ using namespace keyple::core::util::cpp::exception;
 
 const CalypsoSamCommand CmdSamCardGenerateKey::mCommand = CalypsoSamCommand::CARD_GENERATE_KEY;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamCardGenerateKey::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6700, "Incorrect Lc.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6985, "Preconditions not satisfied.", exceptionClassOf<CalypsoSamAccessForbiddenException>},
+    {0x6A00, "Incorrect P1 or P2", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6A80, "Incorrect incoming data: unknown or incorrect format",
+             exceptionClassOf<CalypsoSamIncorrectInputDataException>},
+    {0x6A83, "Record not found: ciphering key or key to cipher not found",
+             exceptionClassOf<CalypsoSamDataAccessException>},
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdSamCardGenerateKey::CmdSamCardGenerateKey(const CalypsoSam::ProductType productType,
                                              const uint8_t cipheringKif,
@@ -79,37 +92,9 @@ const std::vector<uint8_t> CmdSamCardGenerateKey::getCipheredData() const
     return isSuccessful() ? getApduResponse()->getDataOut() : std::vector<uint8_t>();
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamCardGenerateKey::initStatusTable()
+const StatusTable CmdSamCardGenerateKey::getStatusTable() const
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractSamCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Incorrect Lc.",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Preconditions not satisfied.",
-                                                 typeid(CalypsoSamAccessForbiddenException))});
-    m.insert({0x6A00,
-              std::make_shared<StatusProperties>("Incorrect P1 or P2",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-    m.insert({0x6A80,
-              std::make_shared<StatusProperties>("Incorrect incoming data: unknown or incorrect " \
-                                                 "format",
-                                                 typeid(CalypsoSamIncorrectInputDataException))});
-    m.insert({0x6A83,
-              std::make_shared<StatusProperties>("Record not found: ciphering key or key to " \
-                                                 "cipher not found",
-                                                 typeid(CalypsoSamDataAccessException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdSamCardGenerateKey::getStatusTable() const
-{
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
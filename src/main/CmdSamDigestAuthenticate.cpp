@@ -31,8 +31,17 @@ using namespace keyple::core::util::cpp::exception;
 
 const CalypsoSamCommand CmdSamDigestAuthenticate::mCommand = CalypsoSamCommand::DIGEST_AUTHENTICATE;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamDigestAuthenticate::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6700, "Incorrect Lc.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6985, "Preconditions not satisfied.", exceptionClassOf<CalypsoSamAccessForbiddenException>},
+    {0x6988, "Incorrect signature.", exceptionClassOf<CalypsoSamSecurityDataException>},
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdSamDigestAuthenticate::CmdSamDigestAuthenticate(const CalypsoSam::ProductType productType,
                                                    const std::vector<uint8_t>& signature)
@@ -56,29 +65,9 @@ CmdSamDigestAuthenticate::CmdSamDigestAuthenticate(const CalypsoSam::ProductType
             ApduUtil::build(cla, mCommand.getInstructionByte(), p1, p2, signature)));
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamDigestAuthenticate::initStatusTable()
+const StatusTable CmdSamDigestAuthenticate::getStatusTable() const
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractSamCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Incorrect Lc.",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Preconditions not satisfied.",
-                                                 typeid(CalypsoSamAccessForbiddenException))});
-    m.insert({0x6988,
-              std::make_shared<StatusProperties>("Incorrect signature.",
-                                                 typeid(CalypsoSamSecurityDataException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdSamDigestAuthenticate::getStatusTable() const
-{
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
@@ -28,8 +28,15 @@ using namespace keyple::core::util;
 
 const CalypsoSamCommand CmdSamDigestClose::mCommand = CalypsoSamCommand::DIGEST_CLOSE;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamDigestClose::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6985, "Preconditions not satisfied.", exceptionClassOf<CalypsoSamAccessForbiddenException>},
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdSamDigestClose::CmdSamDigestClose(const CalypsoSam::ProductType productType,
                                      const uint8_t expectedResponseLength)
@@ -54,23 +61,9 @@ const std::vector<uint8_t> CmdSamDigestClose::getSignature() const
     return isSuccessful() ? getApduResponse()->getDataOut() : std::vector<uint8_t>();
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamDigestClose::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractSamCommand::STATUS_TABLE;
-
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Preconditions not satisfied.",
-                                                 typeid(CalypsoSamAccessForbiddenException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdSamDigestClose::getStatusTable() const
+const StatusTable CmdSamDigestClose::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
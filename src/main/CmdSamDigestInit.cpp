@@ -34,8 +34,21 @@ using namespace keyple::core::util::cpp::exception;
 
 const CalypsoSamCommand CmdSamDigestInit::mCommand = CalypsoSamCommand::DIGEST_INIT;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamDigestInit::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6700, "Incorrect Lc.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6900, "An event counter cannot be incremented.",
+             exceptionClassOf<CalypsoSamCounterOverflowException>},
+    {0x6985, "Preconditions not satisfied.", exceptionClassOf<CalypsoSamAccessForbiddenException>},
+    {0x6A00, "Incorrect P2.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6A83, "Record not found: signing key not found.",
+             exceptionClassOf<CalypsoSamDataAccessException>},
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdSamDigestInit::CmdSamDigestInit(
   const CalypsoSam::ProductType productType,
@@ -77,35 +90,9 @@ CmdSamDigestInit::CmdSamDigestInit(
             ApduUtil::build(cla, mCommand.getInstructionByte(), p1, p2, dataIn)));
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamDigestInit::initStatusTable()
+const StatusTable CmdSamDigestInit::getStatusTable() const
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractSamCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Incorrect Lc.",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-    m.insert({0x6900,
-              std::make_shared<StatusProperties>("An event counter cannot be incremented.",
-                                                 typeid(CalypsoSamCounterOverflowException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Preconditions not satisfied.",
-                                                 typeid(CalypsoSamAccessForbiddenException))});
-    m.insert({0x6A00,
-              std::make_shared<StatusProperties>("Incorrect P2.",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-    m.insert({0x6A83,
-              std::make_shared<StatusProperties>("Record not found: signing key not found.",
-                                                 typeid(CalypsoSamDataAccessException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdSamDigestInit::getStatusTable() const
-{
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
@@ -32,8 +32,22 @@ using namespace keyple::core::util::cpp::exception;
 
 const CalypsoSamCommand CmdSamDigestUpdate::mCommand = CalypsoSamCommand::DIGEST_UPDATE;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamDigestUpdate::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6700, "Incorrect Lc.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6985, "Preconditions not satisfied.", exceptionClassOf<CalypsoSamAccessForbiddenException>},
+    {0x6A80, "Incorrect value in the incoming data: session in Rev.3.2 mode with " \
+             "encryption/decryption active and not enough data (less than 5 bytes for and odd " \
+             "occurrence or less than 2 bytes CalypsoSamIllegalParameterException for an even " \
+             "occurrence).",
+             exceptionClassOf<CalypsoSamIncorrectInputDataException>},
+    {0x6B00, "Incorrect P1 or P2.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdSamDigestUpdate::CmdSamDigestUpdate(const CalypsoSam::ProductType productType,
                                        const bool encryptedSession,
@@ -53,37 +67,9 @@ CmdSamDigestUpdate::CmdSamDigestUpdate(const CalypsoSam::ProductType productType
             ApduUtil::build(cla, mCommand.getInstructionByte(), p1, p2, digestData)));
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamDigestUpdate::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractSamCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Incorrect Lc.",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Preconditions not satisfied.",
-                                                 typeid(CalypsoSamAccessForbiddenException))});
-    m.insert({0x6A80,
-              std::make_shared<StatusProperties>("Incorrect value in the incoming data: session " \
-                                                 "in Rev.3.2 mode with encryption/decryption " \
-                                                 "active and not enough data (less than 5 bytes " \
-                                                 "for and odd occurrence or less than 2 bytes " \
-                                                 "CalypsoSamIllegalParameterException for an even" \
-                                                 " occurrence).",
-                                                 typeid(CalypsoSamIncorrectInputDataException))});
-    m.insert({0x6B00,
-              std::make_shared<StatusProperties>("Incorrect P1 or P2.",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdSamDigestUpdate::getStatusTable() const
+const StatusTable CmdSamDigestUpdate::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
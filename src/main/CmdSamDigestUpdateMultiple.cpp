@@ -0,0 +1,92 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "CmdSamDigestUpdateMultiple.h"
+
+/* Keyple Card Calypso */
+#include "CalypsoSamAccessForbiddenException.h"
+#include "CalypsoSamIllegalParameterException.h"
+#include "CalypsoSamIncorrectInputDataException.h"
+#include "SamUtilAdapter.h"
+
+/* Keyple Core Util */
+#include "ApduUtil.h"
+#include "IllegalArgumentException.h"
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+
+const CalypsoSamCommand CmdSamDigestUpdateMultiple::mCommand =
+    CalypsoSamCommand::DIGEST_UPDATE_MULTIPLE;
+
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6700, "Incorrect Lc.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6985, "Preconditions not satisfied.", exceptionClassOf<CalypsoSamAccessForbiddenException>},
+    {0x6A80, "Incorrect value in the incoming data: incorrect structure.",
+             exceptionClassOf<CalypsoSamIncorrectInputDataException>},
+    {0x6B00, "Incorrect P1.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
+
+CmdSamDigestUpdateMultiple::CmdSamDigestUpdateMultiple(const CalypsoSam::ProductType productType,
+                                                       const std::vector<uint8_t>& digestData)
+: AbstractSamCommand(mCommand)
+{
+    const uint8_t cla = SamUtilAdapter::getClassByte(productType);
+    const uint8_t p1 = 0x80;
+    const uint8_t p2 = 0x00;
+
+    if (digestData.empty() || digestData.size() > 255) {
+        throw IllegalArgumentException("Digest data null or too long!");
+    }
+
+    setApduRequest(
+        std::make_shared<ApduRequestAdapter>(
+            ApduUtil::build(cla, mCommand.getInstructionByte(), p1, p2, digestData)));
+}
+
+const StatusTable CmdSamDigestUpdateMultiple::getStatusTable() const
+{
+    return StatusTable(STATUS_TABLE);
+}
+
+const std::vector<std::vector<uint8_t>> CmdSamDigestUpdateMultiple::getDigestDataBlocks() const
+{
+    const std::vector<uint8_t>& apdu = getApduRequest()->getApdu();
+
+    /* The data field follows the header and Lc, each block being prefixed by its length */
+    std::vector<std::vector<uint8_t>> blocks;
+    const size_t end = 5 + static_cast<size_t>(apdu[4]);
+    size_t offset = 5;
+
+    while (offset < end) {
+        const size_t length = apdu[offset];
+        blocks.push_back(std::vector<uint8_t>(apdu.begin() + offset + 1,
+                                              apdu.begin() + offset + 1 + length));
+        offset += 1 + length;
+    }
+
+    return blocks;
+}
+
+}
+}
+}
@@ -0,0 +1,85 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/* Calypsonet Terminal Calypso */
+#include "CalypsoSam.h"
+
+/* Keyple Card Calypso */
+#include "AbstractSamCommand.h"
+#include "CalypsoSamCommand.h"
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+using namespace calypsonet::terminal::calypso::sam;
+
+/**
+ * (package-private)<br>
+ * Builds the Digest Update Multiple APDU command.
+ *
+ * <p>This command allows to send several digest data blocks (commands sent to the card and
+ * answers received) in a single APDU. Each block is prefixed by its length.
+ *
+ * @since 2.1.1
+ */
+class CmdSamDigestUpdateMultiple final : public AbstractSamCommand {
+public:
+    /**
+     * (package-private)<br>
+     * Instantiates a new CmdSamDigestUpdateMultiple.
+     *
+     * @param productType of the SAM.
+     * @param digestData the concatenation of the digest data blocks, each one being prefixed by
+     *        its length.
+     * @throws IllegalArgumentException If the digest data is null or has a length &gt; 255
+     * @since 2.1.1
+     */
+    CmdSamDigestUpdateMultiple(const CalypsoSam::ProductType productType,
+                               const std::vector<uint8_t>& digestData);
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.1
+     */
+    const StatusTable getStatusTable() const override;
+
+    /**
+     * (package-private)<br>
+     * Gets the digest data blocks carried by the command, without their length prefix.
+     *
+     * <p>Used to send the blocks again with individual Digest Update commands when the SAM does
+     * not support this command.
+     *
+     * @return A not empty list.
+     * @since 2.1.1
+     */
+    const std::vector<std::vector<uint8_t>> getDigestDataBlocks() const;
+
+private:
+    /**
+     * The command
+     */
+    static const CalypsoSamCommand mCommand;
+
+};
+
+}
+}
+}
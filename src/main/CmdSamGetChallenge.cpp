@@ -31,8 +31,15 @@ using namespace keyple::core::util::cpp::exception;
 
 const CalypsoSamCommand CmdSamGetChallenge::mCommand = CalypsoSamCommand::GET_CHALLENGE;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamGetChallenge::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6700, "Incorrect Lc.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdSamGetChallenge::CmdSamGetChallenge(const CalypsoSam::ProductType productType,
                                        const uint8_t expectedResponseLength)
@@ -57,23 +64,9 @@ const std::vector<uint8_t> CmdSamGetChallenge::getChallenge() const
     return isSuccessful() ? getApduResponse()->getDataOut() : std::vector<uint8_t>();
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamGetChallenge::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractSamCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Incorrect Lc.",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdSamGetChallenge::getStatusTable() const
+const StatusTable CmdSamGetChallenge::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
@@ -29,8 +29,15 @@ using namespace keyple::core::util::cpp::exception;
 
 const CalypsoSamCommand CmdSamGiveRandom::mCommand = CalypsoSamCommand::GIVE_RANDOM;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamGiveRandom::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6700, "Incorrect Lc.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdSamGiveRandom::CmdSamGiveRandom(const CalypsoSam::ProductType productType,
                                    const std::vector<uint8_t>& random)
@@ -49,23 +56,9 @@ CmdSamGiveRandom::CmdSamGiveRandom(const CalypsoSam::ProductType productType,
             ApduUtil::build(cla, mCommand.getInstructionByte(), p1, p2, random)));
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamGiveRandom::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractSamCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Incorrect Lc.",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdSamGiveRandom::getStatusTable() const
+const StatusTable CmdSamGiveRandom::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
@@ -30,8 +30,17 @@ using namespace keyple::core::util::cpp::exception;
 
 const CalypsoSamCommand CmdSamSelectDiversifier::mCommand = CalypsoSamCommand::SELECT_DIVERSIFIER;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamSelectDiversifier::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6700, "Incorrect Lc.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6985, "Preconditions not satisfied: the SAM is locked.",
+             exceptionClassOf<CalypsoSamAccessForbiddenException>},
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdSamSelectDiversifier::CmdSamSelectDiversifier(const CalypsoSam::ProductType productType,
                                                  const std::vector<uint8_t>& diversifier)
@@ -50,26 +59,9 @@ CmdSamSelectDiversifier::CmdSamSelectDiversifier(const CalypsoSam::ProductType p
             ApduUtil::build(cla, mCommand.getInstructionByte(), p1, p2, diversifier)));
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamSelectDiversifier::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractSamCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Incorrect Lc.",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Preconditions not satisfied: the SAM is locked.",
-                                                 typeid(CalypsoSamAccessForbiddenException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdSamSelectDiversifier::getStatusTable() const
+const StatusTable CmdSamSelectDiversifier::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
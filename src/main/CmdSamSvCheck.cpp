@@ -36,8 +36,17 @@ using namespace keyple::core::util::cpp::exception;
 
 const CalypsoSamCommand CmdSamSvCheck::mCommand = CalypsoSamCommand::SV_CHECK;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamSvCheck::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6700, "Incorrect Lc.", exceptionClassOf<CardIllegalParameterException>},
+    {0x6985, "No active SV transaction.", exceptionClassOf<CalypsoSamAccessForbiddenException>},
+    {0x6988, "Incorrect SV signature.", exceptionClassOf<CalypsoSamSecurityDataException>},
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdSamSvCheck::CmdSamSvCheck(const CalypsoSam::ProductType productType,
                              const std::vector<uint8_t>& svCardSignature)
@@ -65,28 +74,9 @@ CmdSamSvCheck::CmdSamSvCheck(const CalypsoSam::ProductType productType,
     }
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>> CmdSamSvCheck::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractSamCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Incorrect Lc.",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("No active SV transaction.",
-                                                 typeid(CalypsoSamAccessForbiddenException))});
-    m.insert({0x6988,
-              std::make_shared<StatusProperties>("Incorrect SV signature.",
-                                                 typeid(CalypsoSamSecurityDataException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>& CmdSamSvCheck::getStatusTable()
-    const
+const StatusTable CmdSamSvCheck::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
@@ -39,8 +39,20 @@ using namespace keyple::core::util::cpp::exception;
 
 const CalypsoSamCommand CmdSamSvPrepareUndebit::mCommand = CalypsoSamCommand::SV_PREPARE_UNDEBIT;
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamSvPrepareUndebit::STATUS_TABLE = initStatusTable();
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6700, "Incorrect Lc.", exceptionClassOf<CardIllegalParameterException>},
+    {0x6985, "Preconditions not satisfied.", exceptionClassOf<CalypsoSamAccessForbiddenException>},
+    {0x6A00, "Incorrect P1 or P2", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6A80, "Incorrect incoming data.", exceptionClassOf<CalypsoSamIncorrectInputDataException>},
+    {0x6A83, "Record not found: ciphering key not found",
+             exceptionClassOf<CalypsoSamDataAccessException>},
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdSamSvPrepareUndebit::CmdSamSvPrepareUndebit(const CalypsoSam::ProductType productType,
                                                const std::vector<uint8_t>& svGetHeader,
@@ -66,35 +78,9 @@ CmdSamSvPrepareUndebit::CmdSamSvPrepareUndebit(const CalypsoSam::ProductType pro
             ApduUtil::build(cla, mCommand.getInstructionByte(), p1, p2, data)));
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamSvPrepareUndebit::initStatusTable()
-{
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractSamCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Incorrect Lc.",
-                                                 typeid(CardIllegalParameterException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Preconditions not satisfied.",
-                                                 typeid(CalypsoSamAccessForbiddenException))});
-    m.insert({0x6A00,
-              std::make_shared<StatusProperties>("Incorrect P1 or P2",
-                                                 typeid(CalypsoSamIllegalParameterException))});
-    m.insert({0x6A80,
-              std::make_shared<StatusProperties>("Incorrect incoming data.",
-                                                 typeid(CalypsoSamIncorrectInputDataException))});
-    m.insert({0x6A83,
-              std::make_shared<StatusProperties>("Record not found: ciphering key not found",
-                                                 typeid(CalypsoSamDataAccessException))});
-
-    return m;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>>&
-    CmdSamSvPrepareUndebit::getStatusTable() const
+const StatusTable CmdSamSvPrepareUndebit::getStatusTable() const
 {
-    return STATUS_TABLE;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
@@ -30,9 +30,18 @@ using namespace keyple::core::util;
 using namespace keyple::core::util::cpp::exception;
 
 const CalypsoSamCommand CmdSamUnlock::mCommand = CalypsoSamCommand::UNLOCK;
-const std::map<const int, const std::shared_ptr<StatusProperties>>
-    CmdSamUnlock::STATUS_TABLE = initStatusTable();
-
+static constexpr AbstractApduCommand::StatusProperties STATUS_TABLE[] = {
+    {0x6700, "Incorrect Lc.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6985, "Preconditions not satisfied (SAM not locked?).",
+             exceptionClassOf<CalypsoSamAccessForbiddenException>},
+    {0x6988, "Incorrect UnlockData.", exceptionClassOf<CalypsoSamSecurityDataException>},
+    {0x6D00, "Instruction unknown.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x6E00, "Class not supported.", exceptionClassOf<CalypsoSamIllegalParameterException>},
+    {0x9000, "Success"},
+};
+
+static_assert(AbstractApduCommand::StatusTable::isSorted(STATUS_TABLE),
+              "Status words must be sorted");
 
 CmdSamUnlock::CmdSamUnlock(const CalypsoSam::ProductType productType, const std::vector<uint8_t>& unlockData)
 : AbstractSamCommand(mCommand)
@@ -54,28 +63,9 @@ CmdSamUnlock::CmdSamUnlock(const CalypsoSam::ProductType productType, const std:
             ApduUtil::build(cla, mCommand.getInstructionByte(), p1, p2, unlockData)));
 }
 
-const std::map<const int, const std::shared_ptr<StatusProperties>>& CmdSamUnlock::getStatusTable()
-    const
-{
-    return STATUS_TABLE;
-}
-
-const std::map<const int, const std::shared_ptr<StatusProperties>> CmdSamUnlock::initStatusTable()
+const StatusTable CmdSamUnlock::getStatusTable() const
 {
-    std::map<const int, const std::shared_ptr<StatusProperties>> m =
-        AbstractSamCommand::STATUS_TABLE;
-
-    m.insert({0x6700,
-              std::make_shared<StatusProperties>("Incorrect Lc.",
-                                                typeid(CalypsoSamIllegalParameterException))});
-    m.insert({0x6985,
-              std::make_shared<StatusProperties>("Preconditions not satisfied (SAM not locked?).",
-                                                 typeid(CalypsoSamAccessForbiddenException))});
-    m.insert({0x6988,
-              std::make_shared<StatusProperties>("Incorrect UnlockData.",
-                                                 typeid(CalypsoSamSecurityDataException))});
-
-    return m;
+    return StatusTable(STATUS_TABLE);
 }
 
 }
@@ -29,6 +29,15 @@ ElementaryFile& ElementaryFileAdapter::setHeader(const std::shared_ptr<FileHeade
 {
     mHeader = header;
 
+    /* Records of fixed size files are held in a single buffer, a ring buffer for cyclic files */
+    const ElementaryFile::Type type = header->getEfType();
+    if (type == ElementaryFile::Type::LINEAR ||
+        type == ElementaryFile::Type::CYCLIC ||
+        type == ElementaryFile::Type::COUNTERS ||
+        type == ElementaryFile::Type::SIMULATED_COUNTERS) {
+        mData->useFlatStorage(header->getRecordsNumber(), header->getRecordSize());
+    }
+
     return *this;
 }
 
@@ -12,9 +12,9 @@
 
 #include "FileDataAdapter.h"
 
+#include <algorithm>
+
 /* Keyple Core Util */
-#include "Arrays.h"
-#include "ByteArrayUtil.h"
 #include "IndexOutOfBoundsException.h"
 #include "KeypleAssert.h"
 #include "KeypleStd.h"
@@ -28,19 +28,51 @@ using namespace keyple::core::util;
 using namespace keyple::core::util::cpp;
 using namespace keyple::core::util::cpp::exception;
 
-FileDataAdapter::FileDataAdapter() {}
+FileDataAdapter::FileDataAdapter()
+: mIsRecordsViewValid(true), mRecordSize(0), mFirstRecordIndex(0) {}
 
 FileDataAdapter::FileDataAdapter(const std::shared_ptr<FileData> source)
+: mIsRecordsViewValid(true), mRecordSize(0), mFirstRecordIndex(0)
 {
-    const std::map<int, std::vector<uint8_t>>& sourceContent = source->getAllRecordsContent();
-
-    for (const auto& entry : sourceContent) {
-        mRecords.insert({entry.first, entry.second});
+    const auto adapter = std::dynamic_pointer_cast<FileDataAdapter>(source);
+
+    if (adapter != nullptr && adapter->mRecordSize != 0) {
+        /* Copy the flat storage as is, the records view will be built on demand */
+        mIsRecordsViewValid = false;
+        mRecordSize = adapter->mRecordSize;
+        mFirstRecordIndex = adapter->mFirstRecordIndex;
+        mFlatRecords = adapter->mFlatRecords;
+        mFlatRecordLengths = adapter->mFlatRecordLengths;
+    } else {
+        mRecords = source->getAllRecordsContent();
     }
 }
 
 const std::map<int, std::vector<uint8_t>>& FileDataAdapter::getAllRecordsContent() const
 {
+    /* Concurrent readers must not build the view at the same time */
+    if (!mIsRecordsViewValid) {
+        std::lock_guard<std::mutex> lock(mRecordsViewMutex);
+        if (mIsRecordsViewValid) {
+            return mRecords;
+        }
+
+        mRecords.clear();
+
+        for (int numRecord = 1;
+             numRecord <= static_cast<int>(mFlatRecordLengths.size());
+             numRecord++) {
+            const int index = getRecordIndex(numRecord);
+            if (mFlatRecordLengths[index] != 0) {
+                const auto first = mFlatRecords.begin() + index * mRecordSize;
+                mRecords.insert({numRecord,
+                                 std::vector<uint8_t>(first, first + mFlatRecordLengths[index])});
+            }
+        }
+
+        mIsRecordsViewValid = true;
+    }
+
     return mRecords;
 }
 
@@ -51,12 +83,13 @@ const std::vector<uint8_t> FileDataAdapter::getContent() const
 
 const std::vector<uint8_t> FileDataAdapter::getContent(const int numRecord) const
 {
-    const auto it = mRecords.find(numRecord);
-    if (it == mRecords.end()) {
+    int length = 0;
+    const uint8_t* record = getRecord(numRecord, length);
+    if (record == nullptr) {
         mLogger->warn("Record #% is not set\n", numRecord);
         return std::vector<uint8_t>();
     } else {
-        return it->second;
+        return std::vector<uint8_t>(record, record + length);
     }
 }
 
@@ -67,80 +100,113 @@ const std::vector<uint8_t> FileDataAdapter::getContent(const int numRecord,
     Assert::getInstance().greaterOrEqual(dataOffset, 0, "dataOffset")
                          .greaterOrEqual(dataLength, 1, "dataLength");
 
-    const auto it = mRecords.find(numRecord);
-    if (it == mRecords.end()) {
+    int length = 0;
+    const uint8_t* record = getRecord(numRecord, length);
+    if (record == nullptr) {
         mLogger->warn("Record #% is not set\n", numRecord);
         return std::vector<uint8_t>();
     }
 
-    const std::vector<uint8_t>& content = it->second;
-    if (dataOffset >= static_cast<int>(content.size())) {
+    if (dataOffset >= length) {
         throw IndexOutOfBoundsException("Offset [" + std::to_string(dataOffset) + "] >= " +
-                                        "content length [" + std::to_string(content.size()) + "].");
+                                        "content length [" + std::to_string(length) + "].");
     }
 
     const int toIndex = dataOffset + dataLength;
-    if (toIndex > static_cast<int>(content.size())) {
+    if (toIndex > length) {
         throw IndexOutOfBoundsException("Offset [" + std::to_string(dataOffset) + "] + " +
                                         "Length [" + std::to_string(dataLength) + "] = " +
                                         "[" + std::to_string(toIndex) + "] > " +
-                                        "content length [" + std::to_string(content.size()) + "].");
+                                        "content length [" + std::to_string(length) + "].");
     }
 
-    return Arrays::copyOfRange(content, dataOffset, toIndex);
+    return std::vector<uint8_t>(record + dataOffset, record + toIndex);
 }
 
 const std::shared_ptr<int> FileDataAdapter::getContentAsCounterValue(const int numCounter) const
+{
+    const Optional<int> counterValue = getOptionalCounterValue(numCounter);
+
+    return counterValue ? std::make_shared<int>(*counterValue) : nullptr;
+}
+
+const Optional<int> FileDataAdapter::getOptionalCounterValue(const int numCounter) const
 {
     Assert::getInstance().greaterOrEqual(numCounter, 1, "numCounter");
 
-    const auto it = mRecords.find(1);
-    if (it == mRecords.end()) {
+    int length = 0;
+    const uint8_t* rec1 = getRecord(1, length);
+    if (rec1 == nullptr) {
         mLogger->warn("Record #1 is not set\n");
-        return nullptr;
+        return Optional<int>();
     }
 
-    const std::vector<uint8_t>& rec1 = it->second;
     const int counterIndex = (numCounter - 1) * 3;
-    if (counterIndex >= static_cast<int>(rec1.size())) {
+    if (counterIndex >= length) {
         mLogger->warn("Counter #% is not set (nb of actual counters = %)\n",
                         numCounter,
-                        rec1.size() / 3);
-        return nullptr;
+                        length / 3);
+        return Optional<int>();
     }
 
-    if (counterIndex + 3 > static_cast<int>(rec1.size())) {
+    if (counterIndex + 3 > length) {
         throw IndexOutOfBoundsException("Counter #" + std::to_string(numCounter) + " " +
                                         "has a truncated value (nb of actual counters = " +
-                                        std::to_string(rec1.size() / 3) + ").");
+                                        std::to_string(length / 3) + ").");
     }
 
-    return std::make_shared<int>(ByteArrayUtil::threeBytesToInt(rec1, counterIndex));
+    return Optional<int>((rec1[counterIndex] << 16) |
+                         (rec1[counterIndex + 1] << 8) |
+                          rec1[counterIndex + 2]);
 }
 
 const std::map<const int, const int> FileDataAdapter::getAllCountersValue() const
 {
     std::map<const int, const int> result;
 
-    const auto it = mRecords.find(1);
+    const std::vector<int> counters = getAllCountersValueAsArray();
+    for (int i = 0; i < static_cast<int>(counters.size()); i++) {
+        result.insert({i + 1, counters[i]});
+    }
 
-    if (it == mRecords.end()) {
+    return result;
+}
+
+const std::vector<int> FileDataAdapter::getAllCountersValueAsArray() const
+{
+    int length = 0;
+    const uint8_t* rec1 = getRecord(1, length);
+    if (rec1 == nullptr) {
         mLogger->warn("Record #1 is not set\n");
-        return result;
+        return std::vector<int>();
     }
 
-    const std::vector<uint8_t> rec1 = it->second;
-    const int length = rec1.size() - (rec1.size() % 3);
-    for (int i = 0, c = 1; i < length; i += 3, c++) {
-        result.insert({c, ByteArrayUtil::threeBytesToInt(rec1, i)});
+    /* Fixed stride and no branch: the loop is left to the compiler auto-vectorization */
+    std::vector<int> counters(length / 3);
+    int* values = counters.data();
+    const int countersNumber = static_cast<int>(counters.size());
+    for (int c = 0; c < countersNumber; c++) {
+        values[c] = (rec1[3 * c] << 16) | (rec1[3 * c + 1] << 8) | rec1[3 * c + 2];
     }
 
-    return result;
+    return counters;
 }
 
 void FileDataAdapter::setContent(const int numRecord, const std::vector<uint8_t>& content)
 {
-    mRecords.insert({numRecord, content});
+    if (mRecordSize != 0) {
+        if (fitsFlatStorage(numRecord, static_cast<int>(content.size()))) {
+            const int index = getRecordIndex(numRecord);
+            System::arraycopy(content, 0, mFlatRecords, index * mRecordSize, content.size());
+            mFlatRecordLengths[index] = static_cast<uint8_t>(content.size());
+            dropRecordsView();
+            return;
+        }
+
+        useMapStorage();
+    }
+
+    mRecords[numRecord] = content;
 }
 
 void FileDataAdapter::setCounter(const int numCounter, const std::vector<uint8_t>& content)
@@ -152,81 +218,210 @@ void FileDataAdapter::setContent(const int numRecord,
                                  const std::vector<uint8_t> content,
                                  const int offset)
 {
-    std::vector<uint8_t> newContent;
     const int newLength = offset + content.size();
 
-    const auto it = mRecords.find(numRecord);
-    if (it == mRecords.end()) {
-        newContent = std::vector<uint8_t>(newLength);
-    } else {
-        const std::vector<uint8_t> oldContent = it->second;
-        if (static_cast<int>(oldContent.size()) <= offset) {
-            newContent = std::vector<uint8_t>(newLength);
-            System::arraycopy(oldContent, 0, newContent, 0, oldContent.size());
-        } else if (static_cast<int>(oldContent.size()) < newLength) {
-            newContent = std::vector<uint8_t>(newLength);
-            System::arraycopy(oldContent, 0, newContent, 0, offset);
-        } else {
-            newContent = oldContent;
+    if (mRecordSize != 0) {
+        int length = 0;
+        getRecord(numRecord, length);
+
+        if (fitsFlatStorage(numRecord, std::max(length, newLength))) {
+            const int index = getRecordIndex(numRecord);
+            const int recordOffset = index * mRecordSize;
+
+            /* Missing data is padded with 0 */
+            if (length < offset) {
+                std::fill(mFlatRecords.begin() + recordOffset + length,
+                          mFlatRecords.begin() + recordOffset + offset,
+                          0);
+            }
+
+            System::arraycopy(content, 0, mFlatRecords, recordOffset + offset, content.size());
+            mFlatRecordLengths[index] = static_cast<uint8_t>(std::max(length, newLength));
+            dropRecordsView();
+            return;
         }
+
+        useMapStorage();
     }
 
-    System::arraycopy(content, 0, newContent, offset, content.size());
-    mRecords.insert({numRecord, newContent});
+    /* The record is created if needed and updated in-place */
+    std::vector<uint8_t>& record = mRecords[numRecord];
+    if (static_cast<int>(record.size()) < newLength) {
+        record.resize(newLength);
+    }
+
+    System::arraycopy(content, 0, record, offset, content.size());
 }
 
 void FileDataAdapter::fillContent(const int numRecord,
                                   const std::vector<uint8_t> content,
                                   const int offset)
 {
-    std::vector<uint8_t> contentLeftPadded = content;
+    const int newLength = offset + content.size();
 
-    if (offset != 0) {
-        contentLeftPadded = std::vector<uint8_t>(offset + content.size());
-        System::arraycopy(content, 0, contentLeftPadded, offset, content.size());
-    }
+    if (mRecordSize != 0) {
+        int length = 0;
+        getRecord(numRecord, length);
 
-    const auto it = mRecords.find(numRecord);
-    if (it == mRecords.end()) {
-        mRecords.insert({numRecord, contentLeftPadded});
-    } else {
-        /* Make sure it's a non-const reference as it is updated in-place in the 'else' section */
-        std::vector<uint8_t>& actualContent = it->second;
+        if (fitsFlatStorage(numRecord, std::max(length, newLength))) {
+            const int index = getRecordIndex(numRecord);
+            const int recordOffset = index * mRecordSize;
 
-        if (actualContent.size() < contentLeftPadded.size()) {
-            for (int i = 0; i < static_cast<int>(actualContent.size()); i++) {
-                contentLeftPadded[i] |= actualContent[i];
+            /* Missing data is padded with 0 before being completed by the provided content */
+            if (length < newLength) {
+                std::fill(mFlatRecords.begin() + recordOffset + length,
+                          mFlatRecords.begin() + recordOffset + newLength,
+                          0);
             }
 
-            mRecords.insert({numRecord, contentLeftPadded});
-        } else {
-            for (int i = 0; i < static_cast<int>(contentLeftPadded.size()); i++) {
-                actualContent[i] |= contentLeftPadded[i];
+            for (int i = 0; i < static_cast<int>(content.size()); i++) {
+                mFlatRecords[recordOffset + offset + i] |= content[i];
             }
+
+            mFlatRecordLengths[index] = static_cast<uint8_t>(std::max(length, newLength));
+            dropRecordsView();
+            return;
         }
+
+        useMapStorage();
+    }
+
+    /* The record is created if needed and updated in-place */
+    std::vector<uint8_t>& record = mRecords[numRecord];
+    if (static_cast<int>(record.size()) < newLength) {
+        record.resize(newLength);
+    }
+
+    for (int i = 0; i < static_cast<int>(content.size()); i++) {
+        record[offset + i] |= content[i];
     }
 }
 
 void FileDataAdapter::addCyclicContent(const std::vector<uint8_t>& content)
 {
-    std::vector<int> descendingKeys;
-    std::map<int, std::vector<uint8_t>>::iterator it;
+    if (mRecordSize != 0) {
+        if (!content.empty() && static_cast<int>(content.size()) <= mRecordSize) {
+            /* The oldest record is overwritten by the new record #1 */
+            const int recordsNumber = static_cast<int>(mFlatRecordLengths.size());
+            mFirstRecordIndex = (mFirstRecordIndex + recordsNumber - 1) % recordsNumber;
+            System::arraycopy(content,
+                              0,
+                              mFlatRecords,
+                              mFirstRecordIndex * mRecordSize,
+                              content.size());
+            mFlatRecordLengths[mFirstRecordIndex] = static_cast<uint8_t>(content.size());
+            dropRecordsView();
+            return;
+        }
+
+        useMapStorage();
+    }
+
+    std::map<int, std::vector<uint8_t>> records;
+    records.insert({1, content});
+
+    for (auto& entry : mRecords) {
+        records.insert({entry.first + 1, std::move(entry.second)});
+    }
+
+    mRecords.swap(records);
+}
+
+void FileDataAdapter::useFlatStorage(const int recordsNumber, const int recordSize)
+{
+    if (recordsNumber < 1 || recordsNumber > 255 || recordSize < 1 || recordSize > 255) {
+        return;
+    }
 
-    for (auto it = mRecords.rbegin(); it != mRecords.rend(); ++it) {
-        descendingKeys.push_back(it->first);
+    if (mRecordSize != 0) {
+        useMapStorage();
     }
 
-    for (const auto& i : descendingKeys) {
-        mRecords.insert({i + 1, mRecords[i]});
+    for (const auto& entry : mRecords) {
+        if (entry.first < 1 ||
+            entry.first > recordsNumber ||
+            entry.second.empty() ||
+            static_cast<int>(entry.second.size()) > recordSize) {
+            return;
+        }
+    }
+
+    mFlatRecords = std::vector<uint8_t>(recordsNumber * recordSize);
+    mFlatRecordLengths = std::vector<uint8_t>(recordsNumber);
+
+    for (const auto& entry : mRecords) {
+        System::arraycopy(entry.second,
+                          0,
+                          mFlatRecords,
+                          (entry.first - 1) * recordSize,
+                          entry.second.size());
+        mFlatRecordLengths[entry.first - 1] = static_cast<uint8_t>(entry.second.size());
     }
 
-    mRecords.insert({1, content});
+    mRecordSize = recordSize;
+    mFirstRecordIndex = 0;
+    dropRecordsView();
+}
+
+const uint8_t* FileDataAdapter::getRecord(const int numRecord, int& length) const
+{
+    if (mRecordSize != 0) {
+        if (numRecord < 1 ||
+            numRecord > static_cast<int>(mFlatRecordLengths.size()) ||
+            mFlatRecordLengths[getRecordIndex(numRecord)] == 0) {
+            return nullptr;
+        }
+
+        const int index = getRecordIndex(numRecord);
+        length = mFlatRecordLengths[index];
+        return &mFlatRecords[index * mRecordSize];
+    }
+
+    const auto it = mRecords.find(numRecord);
+    if (it == mRecords.end()) {
+        return nullptr;
+    }
+
+    length = static_cast<int>(it->second.size());
+    return it->second.data();
+}
+
+void FileDataAdapter::dropRecordsView()
+{
+    /* The view would be stale: its memory is released until the next getAllRecordsContent */
+    mRecords.clear();
+    mIsRecordsViewValid = false;
+}
+
+int FileDataAdapter::getRecordIndex(const int numRecord) const
+{
+    return (mFirstRecordIndex + numRecord - 1) % static_cast<int>(mFlatRecordLengths.size());
+}
+
+bool FileDataAdapter::fitsFlatStorage(const int numRecord, const int length) const
+{
+    return mRecordSize != 0 &&
+           numRecord >= 1 &&
+           numRecord <= static_cast<int>(mFlatRecordLengths.size()) &&
+           length >= 1 &&
+           length <= mRecordSize;
+}
+
+void FileDataAdapter::useMapStorage()
+{
+    /* Make sure the records view is up to date before releasing the flat storage */
+    getAllRecordsContent();
+
+    mRecordSize = 0;
+    mFirstRecordIndex = 0;
+    mFlatRecords = std::vector<uint8_t>();
+    mFlatRecordLengths = std::vector<uint8_t>();
 }
 
 std::ostream& operator<<(std::ostream& os, const FileDataAdapter& fda)
 {
     os << "FILE_DATA_ADAPTER: {"
-       << "RECORDS = " << fda.mRecords
+       << "RECORDS = " << fda.getAllRecordsContent()
        << "}";
 
     return os;
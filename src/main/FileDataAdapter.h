@@ -12,9 +12,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <vector>
 
@@ -24,6 +26,9 @@
 /* Calypsonet Terminal alypso */
 #include "FileData.h"
 
+/* Keyple Card Calypso */
+#include "Optional.h"
+
 namespace keyple {
 namespace card {
 namespace calypso {
@@ -93,6 +98,18 @@ public:
      */
     const std::shared_ptr<int> getContentAsCounterValue(const int numCounter) const override;
 
+    /**
+     * (package-private)<br>
+     * Same as getContentAsCounterValue, without heap allocation.
+     *
+     * @param numCounter The counter number (should be &gt;= 1).
+     * @return An empty value if record #1 or the counter is not set.
+     * @throw IllegalArgumentException If numCounter is out of range.
+     * @throw IndexOutOfBoundsException If the counter value is truncated.
+     * @since 2.1.1
+     */
+    const Optional<int> getOptionalCounterValue(const int numCounter) const;
+
     /**
      * {@inheritDoc}
      *
@@ -100,6 +117,16 @@ public:
      */
     const std::map<const int, const int> getAllCountersValue() const override;
 
+    /**
+     * (package-private)<br>
+     * Decodes in a single pass all the counters of record #1 (3-byte big-endian values).
+     *
+     * @return The value of counter #n at index n - 1, an empty vector if record #1 is not set. A
+     *         truncated last counter is ignored.
+     * @since 2.1.1
+     */
+    const std::vector<int> getAllCountersValueAsArray() const;
+
     /**
      * (package-private)<br>
      * Sets or replaces the entire content of the specified record #numRecord by the provided content.
@@ -153,13 +180,28 @@ public:
      * Adds cyclic content at record #1 by rolling previously all actual records contents (record #1
      * -> record #2, record #2 -> record #3,...).<br>
      * This is useful for cyclic files.<br>
-     * Note that records are infinitely shifted.
+     * When the flat storage is used, the records are held in a ring buffer and the oldest record is
+     * dropped. Otherwise, records are infinitely shifted.
      *
      * @param content the content (should be not empty).
      * @since 2.0.0
      */
     void addCyclicContent(const std::vector<uint8_t>& content);
 
+    /**
+     * (package-private)<br>
+     * Switches to a flat storage of the records: all records are held in a single buffer of
+     * recordsNumber * recordSize bytes.<br>
+     * The records already set are moved to the new storage. The call is ignored if one of them does
+     * not fit in the provided layout.<br>
+     * The storage falls back to a map of records as soon as a record does not fit in the layout.
+     *
+     * @param recordsNumber the number of records of the file (in range [1..255]).
+     * @param recordSize the size of the records of the file (in range [1..255]).
+     * @since 2.1.1
+     */
+    void useFlatStorage(const int recordsNumber, const int recordSize);
+
     /**
      *
      */
@@ -172,9 +214,84 @@ private:
     const std::unique_ptr<Logger> mLogger = LoggerFactory::getLogger(typeid(FileDataAdapter));
 
     /**
+     * Records content when the flat storage is not used, lazily built view of the flat storage
+     * otherwise.
+     */
+    mutable std::map<int, std::vector<uint8_t>> mRecords;
+
+    /**
+     * False when the records view of the flat storage has to be built again.
+     */
+    mutable std::atomic<bool> mIsRecordsViewValid;
+
+    /**
+     * Serializes the building of the records view by concurrent readers.
+     */
+    mutable std::mutex mRecordsViewMutex;
+
+    /**
+     * Size of the records of the flat storage, 0 if the flat storage is not used.
+     */
+    int mRecordSize;
+
+    /**
+     * Index in the flat storage of the record #1, moved backward by each cyclic content added.
+     */
+    int mFirstRecordIndex;
+
+    /**
+     * Content of all the records when the flat storage is used, record #n being at index
+     * (mFirstRecordIndex + n - 1) % number of records.
+     */
+    std::vector<uint8_t> mFlatRecords;
+
+    /**
+     * Actual length of each record of the flat storage, 0 if the record is not set.
+     */
+    std::vector<uint8_t> mFlatRecordLengths;
+
+    /**
+     * (private)<br>
+     * Gets the content of a record without copying it.
+     *
+     * @param numRecord The record number.
+     * @param length Set to the actual length of the record.
+     * @return A pointer to the first byte of the record or nullptr if the record is not set.
+     */
+    const uint8_t* getRecord(const int numRecord, int& length) const;
+
+    /**
+     * (private)<br>
+     * Gets the index of a record in the flat storage.
      *
+     * @param numRecord The record number (in range [1..number of records]).
+     * @return The index of the record.
+     */
+    int getRecordIndex(const int numRecord) const;
+
+    /**
+     * (private)<br>
+     * Discards the records view after a write to the flat storage.
+     *
+     * <p>Must not be called while the content is being read by other threads.
+     */
+    void dropRecordsView();
+
+    /**
+     * (private)<br>
+     * Indicates if a record of the provided length can be held by the flat storage.
+     *
+     * @param numRecord The record number.
+     * @param length The length of the record.
+     * @return True if the flat storage is used and the record fits in it.
+     */
+    bool fitsFlatStorage(const int numRecord, const int length) const;
+
+    /**
+     * (private)<br>
+     * Moves the records of the flat storage to the map of records.
      */
-    std::map<int, std::vector<uint8_t>> mRecords;
+    void useMapStorage();
 
 };
 
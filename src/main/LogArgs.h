@@ -0,0 +1,107 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* Keyple Core Util */
+#include "ByteArrayUtil.h"
+
+/* Keyple Card Calypso */
+#include "Optional.h"
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+using namespace keyple::core::util;
+
+/**
+ * (package-private)<br>
+ * Logger argument printing a byte array as a hex string.
+ *
+ * <p>The logger formats its arguments only if the level of the message is enabled: unlike a call
+ * to ByteArrayUtil::toHex made by the caller, no work is done when the level is disabled. The
+ * referenced bytes must outlive the logger call.
+ *
+ * @since 2.1.1
+ */
+class HexLogArg final {
+public:
+    /**
+     * (package-private)<br>
+     *
+     * @param bytes The bytes to print.
+     * @since 2.1.1
+     */
+    explicit HexLogArg(const std::vector<uint8_t>& bytes) : mBytes(bytes) {}
+
+    /**
+     *
+     */
+    friend std::ostream& operator<<(std::ostream& os, const HexLogArg& arg)
+    {
+        return os << ByteArrayUtil::toHex(arg.mBytes);
+    }
+
+private:
+    /**
+     *
+     */
+    const std::vector<uint8_t>& mBytes;
+};
+
+/**
+ * (package-private)<br>
+ * Logger argument printing an optional integral value in decimal, or "null" if the value is
+ * absent.
+ *
+ * @since 2.1.1
+ */
+template <typename T>
+class OptionalLogArg final {
+public:
+    /**
+     * (package-private)<br>
+     *
+     * @param value The value to print.
+     * @since 2.1.1
+     */
+    explicit OptionalLogArg(const Optional<T>& value) : mValue(value) {}
+
+    /**
+     *
+     */
+    friend std::ostream& operator<<(std::ostream& os, const OptionalLogArg& arg)
+    {
+        if (!arg.mValue.has_value()) {
+            return os << "null";
+        }
+
+        /* Promotion to int so that bytes are not printed as characters */
+        return os << +*arg.mValue;
+    }
+
+private:
+    /**
+     *
+     */
+    const Optional<T> mValue;
+};
+
+}
+}
+}
@@ -0,0 +1,141 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#if defined(KEYPLECARDCALYPSO_STD_OPTIONAL)
+#include <optional>
+#endif
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+#if defined(KEYPLECARDCALYPSO_STD_OPTIONAL)
+
+/**
+ * (package-private)<br>
+ * Value that may be absent, std::optional when the build defines KEYPLECARDCALYPSO_STD_OPTIONAL
+ * (C++17 or later, see src/main/CMakeLists.txt).
+ *
+ * @since 2.1.1
+ */
+template <typename T>
+using Optional = std::optional<T>;
+
+#else
+
+/**
+ * (package-private)<br>
+ * Value that may be absent, stored inline (no heap allocation).
+ *
+ * <p>Subset of the C++17 std::optional interface, used in place of it when the build does not
+ * define KEYPLECARDCALYPSO_STD_OPTIONAL.
+ *
+ * @since 2.1.1
+ */
+template <typename T>
+class Optional final {
+public:
+    /**
+     * (package-private)<br>
+     * Creates an empty value.
+     *
+     * @since 2.1.1
+     */
+    Optional() : mValue(), mHasValue(false) {}
+
+    /**
+     * (package-private)<br>
+     * Creates a value.
+     *
+     * @param value The value.
+     * @since 2.1.1
+     */
+    Optional(const T& value) : mValue(value), mHasValue(true) {}
+
+    /**
+     * (package-private)<br>
+     *
+     * @return True if a value is present.
+     * @since 2.1.1
+     */
+    bool has_value() const
+    {
+        return mHasValue;
+    }
+
+    /**
+     * (package-private)<br>
+     *
+     * @return True if a value is present.
+     * @since 2.1.1
+     */
+    explicit operator bool() const
+    {
+        return mHasValue;
+    }
+
+    /**
+     * (package-private)<br>
+     * Gets the value, its presence is not checked.
+     *
+     * @return The value.
+     * @since 2.1.1
+     */
+    const T& operator*() const
+    {
+        return mValue;
+    }
+
+    /**
+     * (package-private)<br>
+     * Gets the value or the provided default value if no value is present.
+     *
+     * @param defaultValue The default value.
+     * @return The value.
+     * @since 2.1.1
+     */
+    T value_or(const T& defaultValue) const
+    {
+        return mHasValue ? mValue : defaultValue;
+    }
+
+    /**
+     * (package-private)<br>
+     * Removes the value.
+     *
+     * @since 2.1.1
+     */
+    void reset()
+    {
+        mValue = T();
+        mHasValue = false;
+    }
+
+private:
+    /**
+     *
+     */
+    T mValue;
+
+    /**
+     *
+     */
+    bool mHasValue;
+};
+
+#endif
+
+}
+}
+}
@@ -12,22 +12,28 @@
 
 #include "SamCommandProcessor.h"
 
+#include <algorithm>
+#include <chrono>
+
 /* Calypsonet Terminal Calypso */
 #include "DesynchronizedExchangesException.h"
 
 /* Calypsonet Terminal Card */
+#include "CalypsoSamAdapter.h"
 #include "CardSecuritySettingAdapter.h"
 #include "ChannelControl.h"
 #include "UnexpectedStatusWordException.h"
 
 /* Keyple Card Calypso */
 #include "ApduRequestSpi.h"
+#include "CalypsoSamIllegalParameterException.h"
 #include "CmdSamCardCipherPin.h"
 #include "CmdSamCardGenerateKey.h"
 #include "CmdSamDigestAuthenticate.h"
 #include "CmdSamDigestClose.h"
 #include "CmdSamDigestInit.h"
 #include "CmdSamDigestUpdate.h"
+#include "CmdSamDigestUpdateMultiple.h"
 #include "CmdSamGetChallenge.h"
 #include "CmdSamGiveRandom.h"
 #include "CmdSamSelectDiversifier.h"
@@ -35,6 +41,7 @@
 #include "CmdSamSvPrepareDebit.h"
 #include "CmdSamSvPrepareLoad.h"
 #include "CmdSamSvPrepareUndebit.h"
+#include "LogArgs.h"
 
 /* Keyple Card Generic */
 #include "CardRequestAdapter.h"
@@ -42,7 +49,7 @@
 /* Keyple Core Util */
 #include "ApduUtil.h"
 #include "Arrays.h"
-#include "ByteArrayUtil.h"
+#include "Exception.h"
 #include "IllegalStateException.h"
 #include "KeypleAssert.h"
 #include "System.h"
@@ -65,28 +72,72 @@ const uint8_t SamCommandProcessor::CHALLENGE_LENGTH_REV32 = 0x08;
 const uint8_t SamCommandProcessor::SIGNATURE_LENGTH_REV_INF_32 = 0x04;
 const uint8_t SamCommandProcessor::SIGNATURE_LENGTH_REV32 = 0x08;
 const std::string SamCommandProcessor::UNEXPECTED_EXCEPTION = "An unexpected exception was raised.";
-std::vector<std::vector<uint8_t>> SamCommandProcessor::mCardDigestDataCache;
 
 SamCommandProcessor::SamCommandProcessor(
   const std::shared_ptr<CalypsoCard> calypsoCard,
   const std::shared_ptr<CardSecuritySetting> cardSecuritySetting)
 : mCardSecuritySettings(cardSecuritySetting),
+  mSamIndex(-1),
   mCalypsoCard(std::dynamic_pointer_cast<CalypsoCardAdapter>(calypsoCard)),
-  mIsDiversificationDone(false)
+  mSamProductType(CalypsoSam::ProductType::UNKNOWN),
+  mMaxDigestDataLength(0),
+  mSessionEncryption(false),
+  mVerificationMode(false),
+  mKif(0),
+  mKvc(0),
+  mIsDiversificationDone(false),
+  mIsDigestInitDone(false),
+  mIsDigesterInitialized(false),
+  mIsDigestPipeliningEnabled(false),
+  mChallengePrefetchHitCount(0),
+  mChallengePrefetchMissCount(0)
 {
     const auto stngs = std::dynamic_pointer_cast<CardSecuritySettingAdapter>(cardSecuritySetting);
-    Assert::getInstance().notNull(stngs, "securitySettings")
-                         .notNull(stngs->getSamReader(), "samReader")
-                         .notNull(stngs->getCalypsoSam(), "calypsoSam");
+    Assert::getInstance().notNull(stngs, "securitySettings");
 
-    const auto calypsoSam = stngs->getCalypsoSam();
-    mSamProductType = calypsoSam->getProductType();
-    mSamSerialNumber = calypsoSam->getSerialNumber();
-    mSamReader = std::dynamic_pointer_cast<ProxyReaderApi>(stngs->getSamReader());
+    mSamPool = stngs->getSamPool();
+    mIsDigestPipeliningEnabled = stngs->isDigestPipeliningEnabled();
+
+    /* With a pool, the SAM is allocated when the first SAM operation is needed */
+    if (mSamPool == nullptr) {
+        Assert::getInstance().notNull(stngs->getSamReader(), "samReader")
+                             .notNull(stngs->getCalypsoSam(), "calypsoSam");
+
+        bindSam(stngs->getSamReader(), stngs->getCalypsoSam());
+    }
+}
+
+SamCommandProcessor::~SamCommandProcessor()
+{
+    releaseSam();
 }
 
 const std::vector<uint8_t> SamCommandProcessor::getSessionTerminalChallenge()
 {
+    waitForBackgroundExchange();
+    acquireSam();
+
+    /* Build the SAM Get Challenge command */
+    const uint8_t challengeLength = mCalypsoCard->isExtendedModeSupported() ?
+                                    CHALLENGE_LENGTH_REV32 : CHALLENGE_LENGTH_REV_INF_32;
+
+    /*
+     * Use the prefetched challenge if any. The diversification, if needed, will be done along with
+     * the Digest Init command.
+     */
+    if (mPrefetchedChallenge.size() == challengeLength) {
+        const std::vector<uint8_t> sessionTerminalChallenge = mPrefetchedChallenge;
+        mPrefetchedChallenge.clear();
+        mChallengePrefetchHitCount++;
+        mLogger->debug("identification: TERMINALCHALLENGE = % (prefetched)\n",
+                       HexLogArg(sessionTerminalChallenge));
+
+        return sessionTerminalChallenge;
+    }
+
+    mPrefetchedChallenge.clear();
+    mChallengePrefetchMissCount++;
+
     std::vector<std::shared_ptr<ApduRequestSpi>> apduRequests;
 
     /* Diversify only if this has not already been done */
@@ -105,24 +156,13 @@ const std::vector<uint8_t> SamCommandProcessor::getSessionTerminalChallenge()
         mIsDiversificationDone = true;
     }
 
-    /* Build the SAM Get Challenge command */
-    const uint8_t challengeLength = mCalypsoCard->isExtendedModeSupported() ?
-                                    CHALLENGE_LENGTH_REV32 : CHALLENGE_LENGTH_REV_INF_32;
-
     auto samGetChallengeCmd = std::make_shared<CmdSamGetChallenge>(mSamProductType,challengeLength);
 
     apduRequests.push_back(samGetChallengeCmd->getApduRequest());
 
     /* Transmit the CardRequest to the SAM and get back the CardResponse (list of ApduResponseApi)*/
-    std::shared_ptr<CardResponseApi> samCardResponse;
-    try {
-        samCardResponse = mSamReader->transmitCardRequest(
-                              std::make_shared<CardRequestAdapter>(apduRequests, false),
-                              ChannelControl::KEEP_OPEN);
-    } catch (const UnexpectedStatusWordException& e) {
-        throw IllegalStateException(UNEXPECTED_EXCEPTION,
-                                    std::make_shared<UnexpectedStatusWordException>(e));
-    }
+    const std::shared_ptr<CardResponseApi> samCardResponse =
+        transmitSamRequest(std::make_shared<CardRequestAdapter>(apduRequests, false));
 
     const std::vector<std::shared_ptr<ApduResponseApi>>&
         samApduResponses = samCardResponse->getApduResponses();
@@ -133,7 +173,7 @@ const std::vector<uint8_t> SamCommandProcessor::getSessionTerminalChallenge()
         samGetChallengeCmd->setApduResponse(samApduResponses[numberOfSamCmd - 1]).checkStatus();
         sessionTerminalChallenge = samGetChallengeCmd->getChallenge();
         mLogger->debug("identification: TERMINALCHALLENGE = %\n",
-                       ByteArrayUtil::toHex(sessionTerminalChallenge));
+                       HexLogArg(sessionTerminalChallenge));
 
     } else {
         throw DesynchronizedExchangesException("The number of commands/responses does not match: " \
@@ -144,10 +184,112 @@ const std::vector<uint8_t> SamCommandProcessor::getSessionTerminalChallenge()
     return sessionTerminalChallenge;
 }
 
-const std::shared_ptr<uint8_t> SamCommandProcessor::computeKvc(
-    const WriteAccessLevel writeAccessLevel, const std::shared_ptr<uint8_t> kvc) const
+void SamCommandProcessor::prefetchSessionTerminalChallenge()
 {
-    if (kvc != nullptr) {
+    if (mSamPool != nullptr) {
+        throw IllegalStateException("The terminal challenge can't be prefetched on a SAM of a " \
+                                    "pool.");
+    }
+
+    waitForBackgroundExchange();
+    acquireSam();
+
+    transmitChallengePrefetch();
+}
+
+void SamCommandProcessor::startSessionTerminalChallengePrefetch()
+{
+    if (mSamPool != nullptr) {
+        throw IllegalStateException("The terminal challenge can't be prefetched on a SAM of a " \
+                                    "pool.");
+    }
+
+    waitForBackgroundExchange();
+    acquireSam();
+
+    mPendingBackgroundExchange = runInBackground([this]() {
+                                                     try {
+                                                         transmitChallengePrefetch();
+                                                     } catch (const Exception& e) {
+                                                         mLogger->warn("Unable to prefetch the " \
+                                                                       "terminal challenge: %\n",
+                                                                       e.getMessage());
+                                                     }
+                                                 });
+}
+
+void SamCommandProcessor::transmitChallengePrefetch()
+{
+    mPrefetchedChallenge.clear();
+
+    const uint8_t challengeLength = mCalypsoCard->isExtendedModeSupported() ?
+                                    CHALLENGE_LENGTH_REV32 : CHALLENGE_LENGTH_REV_INF_32;
+
+    const auto samGetChallengeCmd = std::make_shared<CmdSamGetChallenge>(mSamProductType,
+                                                                         challengeLength);
+
+    std::vector<std::shared_ptr<AbstractSamCommand>> samCommands;
+    samCommands.push_back(samGetChallengeCmd);
+
+    transmitSamCommands(samCommands);
+
+    mPrefetchedChallenge = samGetChallengeCmd->getChallenge();
+    mLogger->debug("prefetch: TERMINALCHALLENGE = %\n", HexLogArg(mPrefetchedChallenge));
+}
+
+void SamCommandProcessor::releaseSam()
+{
+    if (mSamPool == nullptr || mSamIndex == -1) {
+        return;
+    }
+
+    discardBackgroundExchange();
+
+    mLogger->debug("releaseSam: SAM #% released\n", mSamIndex);
+
+    mSamPool->release(mSamIndex);
+    mSamIndex = -1;
+    mSamReader = nullptr;
+
+    /* The challenge and the diversification were bound to the released SAM */
+    mPrefetchedChallenge.clear();
+    mIsDiversificationDone = false;
+}
+
+void SamCommandProcessor::reset(const std::shared_ptr<CalypsoCard> calypsoCard)
+{
+    const auto newCalypsoCard = std::dynamic_pointer_cast<CalypsoCardAdapter>(calypsoCard);
+    Assert::getInstance().notNull(newCalypsoCard, "calypsoCard");
+
+    discardBackgroundExchange();
+
+    if (newCalypsoCard->getCalypsoSerialNumberFull() !=
+        mCalypsoCard->getCalypsoSerialNumberFull()) {
+        mIsDiversificationDone = false;
+    }
+
+    mCalypsoCard = newCalypsoCard;
+
+    /* The capacity of the cache is kept for the next session */
+    mCardDigestDataCache.clear();
+    mIsDigestInitDone = false;
+    mIsDigesterInitialized = false;
+}
+
+int SamCommandProcessor::getChallengePrefetchHitCount() const
+{
+    return mChallengePrefetchHitCount;
+}
+
+int SamCommandProcessor::getChallengePrefetchMissCount() const
+{
+    return mChallengePrefetchMissCount;
+}
+
+const Optional<uint8_t> SamCommandProcessor::computeKvc(
+    const WriteAccessLevel writeAccessLevel, const Optional<uint8_t> kvc) const
+{
+    if (kvc.has_value()) {
         return kvc;
     }
 
@@ -155,20 +297,20 @@ const std::shared_ptr<uint8_t> SamCommandProcessor::computeKvc(
                ->getDefaultKvc(writeAccessLevel);
 }
 
-const std::shared_ptr<uint8_t> SamCommandProcessor::computeKif(
+const Optional<uint8_t> SamCommandProcessor::computeKif(
     const WriteAccessLevel writeAccessLevel,
-    const std::shared_ptr<uint8_t> kif,
-    const std::shared_ptr<uint8_t> kvc)
+    const Optional<uint8_t> kif,
+    const Optional<uint8_t> kvc)
 {
     /* CL-KEY-KIF.1 */
-    if ((kif != nullptr && *kif.get() != KIF_UNDEFINED) || (kvc == nullptr)) {
+    if ((kif.has_value() && *kif != KIF_UNDEFINED) || !kvc.has_value()) {
         return kif;
     }
 
     /* CL-KEY-KIFUNK.1 */
     const auto adptr = std::dynamic_pointer_cast<CardSecuritySettingAdapter>(mCardSecuritySettings);
-    std::shared_ptr<uint8_t> result = adptr->getKif(writeAccessLevel, *kvc.get());
-    if (result == nullptr) {
+    Optional<uint8_t> result = adptr->getKif(writeAccessLevel, *kvc);
+    if (!result.has_value()) {
         result = adptr->getDefaultKif(writeAccessLevel);
     }
 
@@ -198,7 +340,10 @@ void SamCommandProcessor::initializeDigester(const bool sessionEncryption,
     mLogger->debug("initialize: KIF = %, KVC %, DIGESTDATA = %\n",
                    kif,
                    kvc,
-                   ByteArrayUtil::toHex(digestData));
+                   HexLogArg(digestData));
+
+    /* Discard the outcome of a background transmission left by a previous aborted session */
+    discardBackgroundExchange();
 
     /* Clear data cache */
     mCardDigestDataCache.clear();
@@ -243,16 +388,19 @@ void SamCommandProcessor::pushCardExchangedData(
         /* Add requests and responses to the digest processor */
         pushCardExchangedData(requests[i], responses[i]);
     }
+
+    if (mIsDigestPipeliningEnabled && mIsDigesterInitialized) {
+        startDigestTransmission();
+    }
 }
 
 const std::vector<std::shared_ptr<AbstractSamCommand>> SamCommandProcessor::getPendingSamCommands(
     const bool addDigestClose)
 {
-    /* TODO optimization with the use of Digest Update Multiple whenever possible */
     std::vector<std::shared_ptr<AbstractSamCommand>> samCommands;
 
-    /* Sanity checks */
-    if (mCardDigestDataCache.empty()) {
+    /* Sanity checks (the cache may have been emptied by a pipelined transmission) */
+    if (mCardDigestDataCache.empty() && !mIsDigestInitDone) {
         mLogger->debug("getSamDigestRequest: no data in cache\n");
         throw IllegalStateException("Digest data cache is empty.");
     }
@@ -264,6 +412,17 @@ const std::vector<std::shared_ptr<AbstractSamCommand>> SamCommandProcessor::getP
         throw IllegalStateException("Digest data cache is inconsistent.");
     }
 
+    if (!mIsDigestInitDone && !mIsDiversificationDone) {
+        /*
+         * The diversification has been postponed (prefetched challenge)
+         * CL-SAM-CSN.1
+         */
+        samCommands.push_back(
+            std::make_shared<CmdSamSelectDiversifier>(mSamProductType,
+                                                      mCalypsoCard->getCalypsoSerialNumberFull()));
+        mIsDiversificationDone = true;
+    }
+
     if (!mIsDigestInitDone) {
         /*
          * Build and append Digest Init command as first ApduRequestAdapter of the digest
@@ -289,10 +448,7 @@ const std::vector<std::shared_ptr<AbstractSamCommand>> SamCommandProcessor::getP
      * Build and append Digest Update commands
      * CL-SAM-DUPDATE.1
      */
-    for (const auto& bytes : mCardDigestDataCache) {
-        samCommands.push_back(
-            std::make_shared<CmdSamDigestUpdate>(mSamProductType, mSessionEncryption, bytes));
-    }
+    addDigestUpdateCommands(samCommands);
 
     /* Clears cached commands once they have been processed */
     mCardDigestDataCache.clear();
@@ -312,28 +468,188 @@ const std::vector<std::shared_ptr<AbstractSamCommand>> SamCommandProcessor::getP
     return samCommands;
 }
 
+void SamCommandProcessor::addDigestUpdateCommands(
+    std::vector<std::shared_ptr<AbstractSamCommand>>& samCommands) const
+{
+    /*
+     * Digest Update Multiple is not usable in encrypted session (the SAM has to return each block
+     * of data), when the SAM capacity is unknown nor when the SAM has already rejected it.
+     */
+    if (mSessionEncryption ||
+        mMaxDigestDataLength <= 0 ||
+        (mCalypsoSamAdapter != nullptr &&
+         mCalypsoSamAdapter->getDigestUpdateMultipleSupport() ==
+             CalypsoSamAdapter::DigestUpdateMultipleSupport::UNSUPPORTED)) {
+        for (const auto& bytes : mCardDigestDataCache) {
+            samCommands.push_back(
+                std::make_shared<CmdSamDigestUpdate>(mSamProductType, mSessionEncryption, bytes));
+        }
+
+        return;
+    }
+
+    /* Group the packages (each one prefixed by its length) up to the SAM capacity */
+    size_t first = 0;
+    int packedLength = 0;
+
+    for (size_t i = 0; i < mCardDigestDataCache.size(); i++) {
+        const int blockLength = 1 + static_cast<int>(mCardDigestDataCache[i].size());
+        if (i > first && packedLength + blockLength > mMaxDigestDataLength) {
+            samCommands.push_back(buildDigestUpdateCommand(first, i));
+            first = i;
+            packedLength = 0;
+        }
+
+        packedLength += blockLength;
+    }
+
+    if (first < mCardDigestDataCache.size()) {
+        samCommands.push_back(buildDigestUpdateCommand(first, mCardDigestDataCache.size()));
+    }
+}
+
+const std::shared_ptr<AbstractSamCommand> SamCommandProcessor::buildDigestUpdateCommand(
+    const size_t from, const size_t to) const
+{
+    if (to - from == 1) {
+        return std::make_shared<CmdSamDigestUpdate>(mSamProductType,
+                                                    mSessionEncryption,
+                                                    mCardDigestDataCache[from]);
+    }
+
+    std::vector<uint8_t> digestData;
+    for (size_t i = from; i < to; i++) {
+        const std::vector<uint8_t>& bytes = mCardDigestDataCache[i];
+        digestData.push_back(static_cast<uint8_t>(bytes.size()));
+        digestData.insert(digestData.end(), bytes.begin(), bytes.end());
+    }
+
+    return std::make_shared<CmdSamDigestUpdateMultiple>(mSamProductType, digestData);
+}
+
 const std::vector<uint8_t> SamCommandProcessor::getTerminalSignature()
 {
+    /* Pipelined mode: the previous digest commands must have been processed by the SAM */
+    waitForBackgroundExchange();
+    acquireSam();
+
     /*
      * All remaining SAM digest operations will now run at once.
      * Get the SAM Digest request including Digest Close from the cache manager
      */
     std::vector<std::shared_ptr<AbstractSamCommand>> samCommands = getPendingSamCommands(true);
 
-    auto samCardRequest = std::make_shared<CardRequestAdapter>(getApduRequests(samCommands), false);
+    transmitSamCommands(samCommands);
 
-    /* Transmit CardRequest and get CardResponse */
-    std::shared_ptr<CardResponseApi> samCardResponse;
+    /* Get Terminal Signature from the latest response */
+    auto cmdSamDigestClose = std::dynamic_pointer_cast<CmdSamDigestClose>(samCommands.back());
+
+    const std::vector<uint8_t> sessionTerminalSignature = cmdSamDigestClose->getSignature();
+
+    mLogger->debug("SIGNATURE = %\n", HexLogArg(sessionTerminalSignature));
+
+    return sessionTerminalSignature;
+}
+
+void SamCommandProcessor::transmitSamCommands(
+    const std::vector<std::shared_ptr<AbstractSamCommand>> samCommands)
+{
+    const CalypsoSamAdapter::DigestUpdateMultipleSupport support =
+        mCalypsoSamAdapter != nullptr ?
+            mCalypsoSamAdapter->getDigestUpdateMultipleSupport() :
+            CalypsoSamAdapter::DigestUpdateMultipleSupport::SUPPORTED;
+
+    if (support == CalypsoSamAdapter::DigestUpdateMultipleSupport::UNSUPPORTED) {
+        /* The commands may have been built before another processor found out */
+        transmitSamCommandBatch(splitDigestUpdateMultipleCommands(samCommands));
+        return;
+    }
+
+    const auto firstMultiple =
+        std::find_if(samCommands.begin(),
+                     samCommands.end(),
+                     [](const std::shared_ptr<AbstractSamCommand>& samCommand) {
+                         return std::dynamic_pointer_cast<CmdSamDigestUpdateMultiple>(samCommand) !=
+                                nullptr;
+                     });
+
+    if (support == CalypsoSamAdapter::DigestUpdateMultipleSupport::SUPPORTED ||
+        firstMultiple == samCommands.end()) {
+        transmitSamCommandBatch(samCommands);
+        return;
+    }
+
+    /*
+     * The SAM processes all the commands of a request: nothing may follow the first Digest Update
+     * Multiple command as long as its support is unknown.
+     */
+    const std::vector<std::shared_ptr<AbstractSamCommand>> probeCommands(samCommands.begin(),
+                                                                         firstMultiple + 1);
+    std::vector<std::shared_ptr<AbstractSamCommand>> remainingCommands(firstMultiple + 1,
+                                                                       samCommands.end());
 
     try {
-        samCardResponse = mSamReader->transmitCardRequest(samCardRequest,
-                                                          ChannelControl::KEEP_OPEN);
-    } catch (const UnexpectedStatusWordException& e) {
-        throw IllegalStateException(UNEXPECTED_EXCEPTION,
-                                    std::make_shared<UnexpectedStatusWordException>(e));
+        transmitSamCommandBatch(probeCommands);
+        mCalypsoSamAdapter->setDigestUpdateMultipleSupport(
+            CalypsoSamAdapter::DigestUpdateMultipleSupport::SUPPORTED);
+
+    } catch (const CalypsoSamIllegalParameterException&) {
+        const std::shared_ptr<ApduResponseApi> response = (*firstMultiple)->getApduResponse();
+        if (response == nullptr ||
+            (response->getStatusWord() != 0x6D00 && response->getStatusWord() != 0x6B00)) {
+            throw;
+        }
+
+        mLogger->warn("transmitSamCommands: Digest Update Multiple rejected by the SAM (%), " \
+                      "falling back to Digest Update\n",
+                      HexLogArg(response->getApdu()));
+
+        mCalypsoSamAdapter->setDigestUpdateMultipleSupport(
+            CalypsoSamAdapter::DigestUpdateMultipleSupport::UNSUPPORTED);
+
+        /* The commands preceding the rejected one have been processed */
+        remainingCommands.insert(remainingCommands.begin(), *firstMultiple);
+        remainingCommands = splitDigestUpdateMultipleCommands(remainingCommands);
     }
 
-    std::vector<std::shared_ptr<ApduResponseApi>> samApduResponses =
+    if (!remainingCommands.empty()) {
+        transmitSamCommandBatch(remainingCommands);
+    }
+}
+
+const std::vector<std::shared_ptr<AbstractSamCommand>>
+    SamCommandProcessor::splitDigestUpdateMultipleCommands(
+        const std::vector<std::shared_ptr<AbstractSamCommand>>& samCommands) const
+{
+    std::vector<std::shared_ptr<AbstractSamCommand>> splitCommands;
+
+    for (const auto& samCommand : samCommands) {
+        const auto digestUpdateMultiple =
+            std::dynamic_pointer_cast<CmdSamDigestUpdateMultiple>(samCommand);
+        if (digestUpdateMultiple == nullptr) {
+            splitCommands.push_back(samCommand);
+            continue;
+        }
+
+        /* Digest Update Multiple is never used in encrypted session */
+        for (const auto& block : digestUpdateMultiple->getDigestDataBlocks()) {
+            splitCommands.push_back(
+                std::make_shared<CmdSamDigestUpdate>(mSamProductType, false, block));
+        }
+    }
+
+    return splitCommands;
+}
+
+void SamCommandProcessor::transmitSamCommandBatch(
+    const std::vector<std::shared_ptr<AbstractSamCommand>>& samCommands)
+{
+    auto samCardRequest = std::make_shared<CardRequestAdapter>(getApduRequests(samCommands), false);
+
+    /* Transmit CardRequest and get CardResponse */
+    const std::shared_ptr<CardResponseApi> samCardResponse = transmitSamRequest(samCardRequest);
+
+    const std::vector<std::shared_ptr<ApduResponseApi>>& samApduResponses =
         samCardResponse->getApduResponses();
 
     if (samApduResponses.size() != samCommands.size()) {
@@ -346,16 +662,135 @@ const std::vector<uint8_t> SamCommandProcessor::getTerminalSignature()
     for (int i = 0; i < static_cast<int>(samApduResponses.size()); i++) {
         samCommands[i]->setApduResponse(samApduResponses[i]).checkStatus();
     }
+}
 
-    /* Get Terminal Signature from the latest response */
-    auto cmdSamDigestClose = std::dynamic_pointer_cast<CmdSamDigestClose>(samCommands.back());
-    cmdSamDigestClose->setApduResponse(samApduResponses[samCommands.size() - 1]);
+const std::shared_ptr<CardResponseApi> SamCommandProcessor::transmitSamRequest(
+    const std::shared_ptr<CardRequestSpi> samCardRequest)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::shared_ptr<CardResponseApi> samCardResponse;
 
-    const std::vector<uint8_t> sessionTerminalSignature = cmdSamDigestClose->getSignature();
+    try {
+        samCardResponse = mSamReader->transmitCardRequest(samCardRequest,
+                                                          ChannelControl::KEEP_OPEN);
+    } catch (const UnexpectedStatusWordException& e) {
+        reportSamExchange(start, true);
+        throw IllegalStateException(UNEXPECTED_EXCEPTION,
+                                    std::make_shared<UnexpectedStatusWordException>(e));
+    } catch (const Exception&) {
+        /* The SAM reader or the SAM itself did not respond */
+        reportSamExchange(start, false);
+        throw;
+    }
 
-    mLogger->debug("SIGNATURE = %\n", ByteArrayUtil::toHex(sessionTerminalSignature));
+    reportSamExchange(start, true);
 
-    return sessionTerminalSignature;
+    return samCardResponse;
+}
+
+void SamCommandProcessor::reportSamExchange(const std::chrono::steady_clock::time_point start,
+                                            const bool isSuccessful)
+{
+    if (mSamPool == nullptr || mSamIndex == -1) {
+        return;
+    }
+
+    const int64_t latencyMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                                      std::chrono::steady_clock::now() - start).count();
+
+    mSamPool->reportExchange(mSamIndex, latencyMicros, isSuccessful);
+}
+
+void SamCommandProcessor::bindSam(const std::shared_ptr<CardReader> samReader,
+                                  const std::shared_ptr<CalypsoSam> calypsoSam)
+{
+    mSamProductType = calypsoSam->getProductType();
+    mSamSerialNumber = calypsoSam->getSerialNumber();
+
+    const auto calypsoSamAdapter = std::dynamic_pointer_cast<CalypsoSamAdapter>(calypsoSam);
+    mMaxDigestDataLength = calypsoSamAdapter != nullptr ?
+                           calypsoSamAdapter->getMaxDigestDataLength() : 0;
+    mCalypsoSamAdapter = calypsoSamAdapter;
+
+    mSamReader = std::dynamic_pointer_cast<ProxyReaderApi>(samReader);
+
+    /* A challenge prefetched from another SAM is not valid */
+    mPrefetchedChallenge.clear();
+}
+
+void SamCommandProcessor::acquireSam()
+{
+    if (mSamPool == nullptr || mSamIndex != -1) {
+        return;
+    }
+
+    mSamIndex = mSamPool->acquire();
+    bindSam(mSamPool->getSamReader(mSamIndex), mSamPool->getCalypsoSam(mSamIndex));
+
+    /* The new SAM has to be diversified with the card serial number */
+    mIsDiversificationDone = false;
+
+    mLogger->debug("acquireSam: SAM #% allocated\n", mSamIndex);
+}
+
+void SamCommandProcessor::startDigestTransmission()
+{
+    /* Only one transmission at a time to keep the SAM commands in order */
+    waitForBackgroundExchange();
+    acquireSam();
+
+    const std::vector<std::shared_ptr<AbstractSamCommand>> samCommands =
+        getPendingSamCommands(false);
+
+    if (samCommands.empty()) {
+        return;
+    }
+
+    mLogger->trace("startDigestTransmission: % digest command(s) sent in background\n",
+                   samCommands.size());
+
+    mPendingBackgroundExchange = runInBackground([this, samCommands]() {
+                                                     transmitSamCommands(samCommands);
+                                                 });
+}
+
+void SamCommandProcessor::waitForBackgroundExchange()
+{
+    if (mPendingBackgroundExchange.valid()) {
+        /* Rethrows the exception raised by the background transmission, if any */
+        mPendingBackgroundExchange.get();
+    }
+}
+
+void SamCommandProcessor::discardBackgroundExchange()
+{
+    if (mPendingBackgroundExchange.valid()) {
+        try {
+            mPendingBackgroundExchange.get();
+        } catch (const Exception& e) {
+            mLogger->debug("discardBackgroundExchange: digest transmission failed: %\n",
+                           e.getMessage());
+        }
+    }
+}
+
+std::future<void> SamCommandProcessor::runInBackground(const std::function<void()>& task)
+{
+    /* A thread per exchange would cost a thread creation on every card command */
+    if (mWorker == nullptr) {
+        mWorker = std::unique_ptr<ThreadPoolTransactionExecutor>(
+                      new ThreadPoolTransactionExecutor(1));
+    }
+
+    /* The executor takes copyable tasks */
+    const auto packagedTask = std::make_shared<std::packaged_task<void()>>(task);
+    std::future<void> future = packagedTask->get_future();
+
+    mWorker->execute([packagedTask]() {
+                         (*packagedTask)();
+                     });
+
+    return future;
 }
 
 const std::vector<std::shared_ptr<ApduRequestSpi>> SamCommandProcessor::getApduRequests(
@@ -374,6 +809,9 @@ const std::vector<std::shared_ptr<ApduRequestSpi>> SamCommandProcessor::getApduR
 
 void SamCommandProcessor::authenticateCardSignature(const std::vector<uint8_t>& cardSignatureLo)
 {
+    waitForBackgroundExchange();
+    acquireSam();
+
     /*
      * Check the card signature part with the SAM
      * Build and send SAM Digest Authenticate command
@@ -387,14 +825,7 @@ void SamCommandProcessor::authenticateCardSignature(const std::vector<uint8_t>&
     auto samCardRequest = std::dynamic_pointer_cast<CardRequestSpi>(
                               std::make_shared<CardRequestAdapter>(samApduRequests, false));
 
-    std::shared_ptr<CardResponseApi> samCardResponse;
-    try {
-        samCardResponse = mSamReader->transmitCardRequest(samCardRequest,
-                                                          ChannelControl::KEEP_OPEN);
-    } catch (const UnexpectedStatusWordException& e) {
-        throw IllegalStateException(UNEXPECTED_EXCEPTION,
-                                    std::make_shared<UnexpectedStatusWordException>(e));
-    }
+    const std::shared_ptr<CardResponseApi> samCardResponse = transmitSamRequest(samCardRequest);
 
     /* Get transaction result parsing the response */
     std::vector<std::shared_ptr<ApduResponseApi>> samApduResponses =
@@ -414,6 +845,12 @@ const std::vector<uint8_t> SamCommandProcessor::getEncryptedKey(
     const uint8_t sourceKif,
     const uint8_t sourceKvc)
 {
+    waitForBackgroundExchange();
+    acquireSam();
+
+    /* The SAM challenge may be altered by this operation */
+    mPrefetchedChallenge.clear();
+
     std::vector<std::shared_ptr<AbstractSamCommand>> samCommands;
 
     if (!mIsDiversificationDone) {
@@ -443,14 +880,7 @@ const std::vector<uint8_t> SamCommandProcessor::getEncryptedKey(
     auto samCardRequest = std::make_shared<CardRequestAdapter>(getApduRequests(samCommands), false);
 
     /* Execute the command */
-    std::shared_ptr<CardResponseApi> samCardResponse;
-    try {
-        samCardResponse = mSamReader->transmitCardRequest(samCardRequest,
-                                                          ChannelControl::KEEP_OPEN);
-    } catch (const UnexpectedStatusWordException& e) {
-        throw IllegalStateException(UNEXPECTED_EXCEPTION,
-                                    std::make_shared<UnexpectedStatusWordException>(e));
-    }
+    const std::shared_ptr<CardResponseApi> samCardResponse = transmitSamRequest(samCardRequest);
 
     std::shared_ptr<ApduResponseApi> cmdSamCardGenerateKeyResponse =
         samCardResponse->getApduResponses()[cardGenerateKeyCmdIndex];
@@ -466,6 +896,12 @@ const std::vector<uint8_t> SamCommandProcessor::getCipheredPinData(
     const std::vector<uint8_t>& currentPin,
     const std::vector<uint8_t>& newPin)
 {
+    waitForBackgroundExchange();
+    acquireSam();
+
+    /* The SAM challenge may be altered by this operation */
+    mPrefetchedChallenge.clear();
+
     std::vector<std::shared_ptr<AbstractSamCommand>> samCommands;
     uint8_t pinCipheringKif;
     uint8_t pinCipheringKvc;
@@ -481,8 +917,8 @@ const std::vector<uint8_t> SamCommandProcessor::getCipheredPinData(
         if (newPin.empty()) {
             /* PIN verification */
 
-            if (adapter->getPinVerificationCipheringKif() == nullptr ||
-                adapter->getPinVerificationCipheringKvc() == nullptr) {
+            if (!adapter->getPinVerificationCipheringKif().has_value() ||
+                !adapter->getPinVerificationCipheringKvc().has_value()) {
                 throw IllegalStateException("No KIF or KVC defined for the PIN verification " \
                                             "ciphering key");
             }
@@ -491,8 +927,8 @@ const std::vector<uint8_t> SamCommandProcessor::getCipheredPinData(
             pinCipheringKvc = *adapter->getPinVerificationCipheringKvc();
         } else {
             /* PIN modification */
-            if (adapter->getPinModificationCipheringKif() == nullptr ||
-                adapter->getPinModificationCipheringKvc() == nullptr) {
+            if (!adapter->getPinModificationCipheringKif().has_value() ||
+                !adapter->getPinModificationCipheringKvc().has_value()) {
                 throw IllegalStateException("No KIF or KVC defined for the PIN modification " \
                                             "ciphering key");
             }
@@ -536,14 +972,7 @@ const std::vector<uint8_t> SamCommandProcessor::getCipheredPinData(
     auto samCardRequest = std::make_shared<CardRequestAdapter>(getApduRequests(samCommands), false);
 
     /* Execute the command */
-    std::shared_ptr<CardResponseApi> samCardResponse;
-    try {
-        samCardResponse = mSamReader->transmitCardRequest(samCardRequest,
-                                                          ChannelControl::KEEP_OPEN);
-    } catch (const UnexpectedStatusWordException& e) {
-        throw IllegalStateException(UNEXPECTED_EXCEPTION,
-                                    std::make_shared<UnexpectedStatusWordException>(e));
-    }
+    const std::shared_ptr<CardResponseApi> samCardResponse = transmitSamRequest(samCardRequest);
 
     std::shared_ptr<ApduResponseApi> cardCipherPinResponse =
         samCardResponse->getApduResponses()[cardCipherPinCmdIndex];
@@ -557,6 +986,12 @@ const std::vector<uint8_t> SamCommandProcessor::getCipheredPinData(
 const std::vector<uint8_t> SamCommandProcessor::getSvComplementaryData(
     const std::shared_ptr<AbstractSamCommand> cmdSamSvPrepare)
 {
+    waitForBackgroundExchange();
+    acquireSam();
+
+    /* The SAM challenge may be altered by this operation */
+    mPrefetchedChallenge.clear();
+
     std::vector<std::shared_ptr<AbstractSamCommand>> samCommands;
 
     if (!mIsDiversificationDone) {
@@ -585,14 +1020,7 @@ const std::vector<uint8_t> SamCommandProcessor::getSvComplementaryData(
     auto samCardRequest = std::make_shared<CardRequestAdapter>(getApduRequests(samCommands), false);
 
     /* Execute the command */
-    std::shared_ptr<CardResponseApi> samCardResponse;
-    try {
-        samCardResponse = mSamReader->transmitCardRequest(samCardRequest,
-                                                          ChannelControl::KEEP_OPEN);
-    } catch (const UnexpectedStatusWordException& e) {
-        throw IllegalStateException(UNEXPECTED_EXCEPTION,
-                                    std::make_shared<UnexpectedStatusWordException>(e));
-    }
+    const std::shared_ptr<CardResponseApi> samCardResponse = transmitSamRequest(samCardRequest);
 
     const std::shared_ptr<ApduResponseApi> svPrepareResponse =
         samCardResponse->getApduResponses()[svPrepareOperationCmdIndex];
@@ -660,6 +1088,12 @@ const std::vector<uint8_t> SamCommandProcessor::getSvUndebitComplementaryData(
 
 void SamCommandProcessor::checkSvStatus(const std::vector<uint8_t>& svOperationResponseData)
 {
+    waitForBackgroundExchange();
+    acquireSam();
+
+    /* The SAM challenge may be altered by this operation */
+    mPrefetchedChallenge.clear();
+
     std::vector<std::shared_ptr<AbstractSamCommand>> samCommands;
     const auto cmdSamSvCheck = std::make_shared<CmdSamSvCheck>(mSamProductType,
                                                                svOperationResponseData);
@@ -671,14 +1105,7 @@ void SamCommandProcessor::checkSvStatus(const std::vector<uint8_t>& svOperationR
                                                                    false));
 
     /* Execute the command */
-    std::shared_ptr<CardResponseApi> samCardResponse;
-    try {
-        samCardResponse = mSamReader->transmitCardRequest(samCardRequest,
-                                                          ChannelControl::KEEP_OPEN);
-    } catch (const UnexpectedStatusWordException& e) {
-        throw IllegalStateException(UNEXPECTED_EXCEPTION,
-                                    std::make_shared<UnexpectedStatusWordException>(e));
-    }
+    const std::shared_ptr<CardResponseApi> samCardResponse = transmitSamRequest(samCardRequest);
 
     const std::shared_ptr<ApduResponseApi> svCheckResponse = samCardResponse->getApduResponses()[0];
 
@@ -12,7 +12,10 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -24,12 +27,19 @@
 /* Calypsonet Terminal Card */
 #include "ProxyReaderApi.h"
 
+/* Calypsonet Terminal Reader */
+#include "CardReader.h"
+
 /* Keyple Card Calypso */
 #include "AbstractSamCommand.h"
 #include "CalypsoCardAdapter.h"
+#include "CalypsoSamAdapter.h"
 #include "CmdCardSvDebit.h"
 #include "CmdCardSvUndebit.h"
 #include "CmdCardSvReload.h"
+#include "Optional.h"
+#include "SamPool.h"
+#include "ThreadPoolTransactionExecutor.h"
 
 /* Keyple Core Util */
 #include "LoggerFactory.h"
@@ -42,6 +52,7 @@ using namespace calypsonet::terminal::calypso;
 using namespace calypsonet::terminal::calypso::sam;
 using namespace calypsonet::terminal::calypso::transaction;
 using namespace calypsonet::terminal::card;
+using namespace calypsonet::terminal::card::spi;
 using namespace keyple::core::util::cpp;
 
 /**
@@ -54,6 +65,18 @@ using namespace keyple::core::util::cpp;
  * <p>It also will integrate the SAM commands used for Stored Value and PIN/key management. In
  * session, these commands need to be carefully synchronized with the digest calculation.
  *
+ * <p>All the digest state is held by the instance itself: processors bound to distinct card/SAM
+ * reader pairs can be used concurrently from different threads. A single instance is not
+ * thread-safe and must not be shared between threads.
+ *
+ * <p>When the digest pipelining is enabled in the security settings, the digest commands are
+ * transmitted to the SAM by a background task as soon as the card exchanges are pushed, so that the
+ * SAM processing overlaps with the card processing.
+ *
+ * <p>When the security settings reference a SamPool, a SAM of the pool is allocated at the first
+ * SAM operation and kept until releaseSam is called, so that a whole secure session is processed
+ * by the same SAM.
+ *
  * @since 2.0.0
  */
 class SamCommandProcessor {
@@ -68,6 +91,13 @@ public:
     SamCommandProcessor(const std::shared_ptr<CalypsoCard> calypsoCard,
                         const std::shared_ptr<CardSecuritySetting> cardSecuritySetting);
 
+    /**
+     * Releases the SAM allocated from the pool, if any.
+     *
+     * @since 2.1.1
+     */
+    ~SamCommandProcessor();
+
     /**
      * Gets the terminal challenge
      *
@@ -77,6 +107,9 @@ public:
      *
      * <p>If the key diversification is already done, the Select Diversifier command is omitted.
      *
+     * <p>If a challenge of the expected length has been prefetched, it is returned without any
+     * exchange with the SAM and the diversification is postponed to the Digest Init command.
+     *
      * <p>The length of the challenge varies from one card product type to another. This information
      * can be found in the CardResource class field.
      *
@@ -89,17 +122,98 @@ public:
      */
     const std::vector<uint8_t> getSessionTerminalChallenge();
 
+    /**
+     * (package-private)<br>
+     * Requests from the SAM the terminal challenge of the next secure session.
+     *
+     * <p>The challenge is kept until the next call to getSessionTerminalChallenge. It is discarded
+     * by any other SAM operation (PIN, key or SV commands) that could alter it, and when the SAM is
+     * released or replaced.
+     *
+     * <p>The challenge being held by the SAM, the prefetching is only possible with the SAM
+     * resource of the security settings, owned by the processor. A SAM of a pool is only owned for
+     * the duration of a session.
+     *
+     * <p>The length of the challenge is the one expected by the current card.
+     *
+     * @throw IllegalStateException if the security settings reference a SAM pool.
+     * @throw CalypsoSamCommandException if the SAM has responded with an error status
+     * @throw ReaderBrokenCommunicationException if the communication with the SAM reader has failed.
+     * @throw CardBrokenCommunicationException if the communication with the SAM has failed.
+     * @throw DesynchronizedExchangesException if the APDU SAM exchanges are out of sync
+     * @since 2.1.1
+     */
+    void prefetchSessionTerminalChallenge();
+
+    /**
+     * (package-private)<br>
+     * Same as prefetchSessionTerminalChallenge, but the challenge is requested on the worker
+     * thread of the processor and the method returns immediately.
+     *
+     * <p>The next SAM operation, getSessionTerminalChallenge included, waits for the end of the
+     * request. A failure is only logged: the challenge will then be requested at the session
+     * opening.
+     *
+     * @throw IllegalStateException if the security settings reference a SAM pool.
+     * @throw CalypsoSamCommandException if the SAM has responded with an error status to a
+     *        previous background digest transmission.
+     * @since 2.1.1
+     */
+    void startSessionTerminalChallengePrefetch();
+
+    /**
+     * (package-private)<br>
+     * Gives back to the pool the SAM allocated to the current session.
+     *
+     * <p>The prefetched challenge, if any, is discarded. The next SAM operation allocates a new
+     * SAM. Does nothing if no SAM pool is used or if no SAM is allocated.
+     *
+     * @since 2.1.1
+     */
+    void releaseSam();
+
+    /**
+     * (package-private)<br>
+     * Binds the processor to a newly selected card.
+     *
+     * <p>The SAM binding and the prefetched challenge are kept. The SAM diversification is kept
+     * only if the new card has the same serial number as the previous one.
+     *
+     * @param calypsoCard The initial card data provided by the selection process.
+     * @throw IllegalArgumentException If calypsoCard is null.
+     * @since 2.1.1
+     */
+    void reset(const std::shared_ptr<CalypsoCard> calypsoCard);
+
+    /**
+     * (package-private)<br>
+     * Gets the number of terminal challenges served from a prefetched challenge.
+     *
+     * @return A positive int.
+     * @since 2.1.1
+     */
+    int getChallengePrefetchHitCount() const;
+
+    /**
+     * (package-private)<br>
+     * Gets the number of terminal challenges that had to be requested from the SAM.
+     *
+     * @return A positive int.
+     * @since 2.1.1
+     */
+    int getChallengePrefetchMissCount() const;
+
     /**
      * (package-private)<br>
      * Gets the KVC to use according to the provided write access and the card's KVC.
      *
      * @param writeAccessLevel The write access level.
      * @param kvc The card KVC value.
-     * @return Null if the card did not provide a KVC value and if there's no default KVC value.
+     * @return Empty if the card did not provide a KVC value and if there's no default KVC value.
      * @since 2.0.0
      */
-    const std::shared_ptr<uint8_t> computeKvc(const WriteAccessLevel writeAccessLevel,
-                                              const std::shared_ptr<uint8_t> kvc) const;
+    const Optional<uint8_t> computeKvc(const WriteAccessLevel writeAccessLevel,
+                                       const Optional<uint8_t> kvc) const;
 
     /**
      * (package-private)<br>
@@ -108,12 +222,12 @@ public:
      * @param writeAccessLevel The write access level.
      * @param kif The card KIF value.
      * @param kvc The previously computed KVC value.
-     * @return Null if the card did not provide a KIF value and if there's no default KIF value.
+     * @return Empty if the card did not provide a KIF value and if there's no default KIF value.
      * @since 2.0.0
      */
-    const std::shared_ptr<uint8_t> computeKif(const WriteAccessLevel writeAccessLevel,
-                                              const std::shared_ptr<uint8_t> kif,
-                                              const std::shared_ptr<uint8_t> kvc);
+    const Optional<uint8_t> computeKif(const WriteAccessLevel writeAccessLevel,
+                                       const Optional<uint8_t> kif,
+                                       const Optional<uint8_t> kvc);
 
     /**
      * Initializes the digest computation process
@@ -327,14 +441,25 @@ private:
     const std::shared_ptr<CardSecuritySetting> mCardSecuritySettings;
 
     /**
-     *
+     * SAM pool referenced by the security settings, null if a single SAM is used.
      */
-    static std::vector<std::vector<uint8_t>> mCardDigestDataCache;
+    std::shared_ptr<SamPool> mSamPool;
+
+    /**
+     * Index in the pool of the SAM allocated to the current session, -1 if none.
+     */
+    int mSamIndex;
+
+    /**
+     * Digest data of the current secure session.<br>
+     * Owned by this processor instance so that independent transactions never share it.
+     */
+    std::vector<std::vector<uint8_t>> mCardDigestDataCache;
 
     /**
      *
      */
-    const std::shared_ptr<CalypsoCardAdapter> mCalypsoCard;
+    std::shared_ptr<CalypsoCardAdapter> mCalypsoCard;
 
     /**
      *
@@ -346,6 +471,17 @@ private:
      */
     CalypsoSam::ProductType mSamProductType;
 
+    /**
+     * Maximum length of the data of a digest command supported by the SAM, 0 if unknown.
+     */
+    int mMaxDigestDataLength;
+
+    /**
+     * The SAM image holding the Digest Update Multiple support, null if not provided by this
+     * extension.
+     */
+    std::shared_ptr<CalypsoSamAdapter> mCalypsoSamAdapter;
+
     /**
      *
      */
@@ -381,6 +517,39 @@ private:
      */
     bool mIsDigesterInitialized;
 
+    /**
+     * True when the digest commands are sent to the SAM as soon as the card data is available.
+     */
+    bool mIsDigestPipeliningEnabled;
+
+    /**
+     * Challenge prefetched for the next session, empty if none.
+     */
+    std::vector<uint8_t> mPrefetchedChallenge;
+
+    /**
+     *
+     */
+    int mChallengePrefetchHitCount;
+
+    /**
+     *
+     */
+    int mChallengePrefetchMissCount;
+
+    /**
+     * Completion of the exchange running with the SAM in background: digest commands (pipelined
+     * mode) or prefetch of the next challenge.
+     */
+    std::future<void> mPendingBackgroundExchange;
+
+    /**
+     * Long-lived thread running the background exchanges with the SAM, created on first use.<br>
+     * Declared last so that its destruction waits for the running exchange to end before the
+     * other members are released.
+     */
+    std::unique_ptr<ThreadPoolTransactionExecutor> mWorker;
+
      /**
      * Appends a full card exchange (request and response) to the digest data cache.
      *
@@ -398,8 +567,11 @@ private:
      * session
      *
      * <ul>
-     *   <li>Starts with a Digest Init command if not already done,
-     *   <li>Adds as many Digest Update commands as there are packages in the cache,
+     *   <li>Starts with a Select Diversifier command if it has been postponed (prefetched
+     *       challenge),
+     *   <li>Continues with a Digest Init command if not already done,
+     *   <li>Adds the Digest Update commands needed to send all the packages of the cache, packing
+     *       them into Digest Update Multiple commands whenever possible,
      *   <li>Appends a Digest Close command if the addDigestClose flag is set to true.
      * </ul>
      *
@@ -410,6 +582,170 @@ private:
     const std::vector<std::shared_ptr<AbstractSamCommand>> getPendingSamCommands(
         const bool addDigestClose);
 
+    /**
+     * Appends to the provided list the Digest Update commands for all the packages of the cache.
+     *
+     * <p>Outside encrypted sessions, consecutive packages are grouped into Digest Update Multiple
+     * commands filled up to the maximum digest data length of the SAM. The individual Digest Update
+     * command is used otherwise.
+     *
+     * @param samCommands the list of SAM commands to complete.
+     * @since 2.1.1
+     */
+    void addDigestUpdateCommands(std::vector<std::shared_ptr<AbstractSamCommand>>& samCommands)
+        const;
+
+    /**
+     * Builds a single digest command for the packages of the cache in the range [from, to[.
+     *
+     * @param from index of the first package.
+     * @param to index following the last package.
+     * @return A Digest Update command if the range contains a single package, a Digest Update
+     *         Multiple command otherwise.
+     * @since 2.1.1
+     */
+    const std::shared_ptr<AbstractSamCommand> buildDigestUpdateCommand(const size_t from,
+                                                                       const size_t to) const;
+
+    /**
+     * Transmits the provided SAM commands and checks the status of all of them.
+     *
+     * <p>As long as the support of Digest Update Multiple by the SAM is unknown, the commands
+     * following the first Digest Update Multiple command are sent in a second request. If the SAM
+     * rejects it (6D00h or 6B00h), the command is marked as unsupported for this SAM and its data
+     * blocks are sent again, like those of the following commands, with individual Digest Update
+     * commands.
+     *
+     * @param samCommands the SAM commands to transmit.
+     * @throw CalypsoSamCommandException if the SAM has responded with an error status
+     * @throw ReaderBrokenCommunicationException if the communication with the SAM reader has failed.
+     * @throw CardBrokenCommunicationException if the communication with the SAM has failed.
+     * @throw DesynchronizedExchangesException if the APDU SAM exchanges are out of sync
+     * @since 2.1.1
+     */
+    void transmitSamCommands(const std::vector<std::shared_ptr<AbstractSamCommand>> samCommands);
+
+    /**
+     * Transmits the provided SAM commands in a single request and checks the status of all of
+     * them.
+     *
+     * @param samCommands the SAM commands to transmit.
+     * @throw CalypsoSamCommandException if the SAM has responded with an error status
+     * @throw ReaderBrokenCommunicationException if the communication with the SAM reader has failed.
+     * @throw CardBrokenCommunicationException if the communication with the SAM has failed.
+     * @throw DesynchronizedExchangesException if the APDU SAM exchanges are out of sync
+     * @since 2.1.1
+     */
+    void transmitSamCommandBatch(
+        const std::vector<std::shared_ptr<AbstractSamCommand>>& samCommands);
+
+    /**
+     * Replaces the Digest Update Multiple commands of the provided list by individual Digest
+     * Update commands carrying the same data blocks.
+     *
+     * @param samCommands the SAM commands.
+     * @return A new list of SAM commands.
+     * @since 2.1.1
+     */
+    const std::vector<std::shared_ptr<AbstractSamCommand>> splitDigestUpdateMultipleCommands(
+        const std::vector<std::shared_ptr<AbstractSamCommand>>& samCommands) const;
+
+    /**
+     * Transmits a request to the SAM and records the exchange in the SAM pool statistics.
+     *
+     * @param samCardRequest the request to transmit.
+     * @return The SAM response.
+     * @throw IllegalStateException if the SAM has responded with an unexpected status word
+     * @throw ReaderBrokenCommunicationException if the communication with the SAM reader has failed.
+     * @throw CardBrokenCommunicationException if the communication with the SAM has failed.
+     * @since 2.1.1
+     */
+    const std::shared_ptr<CardResponseApi> transmitSamRequest(
+        const std::shared_ptr<CardRequestSpi> samCardRequest);
+
+    /**
+     * Records in the pool the duration and the outcome of an exchange with the allocated SAM.
+     *
+     * @param start the time at which the exchange started.
+     * @param isSuccessful false if the communication with the SAM failed.
+     * @since 2.1.1
+     */
+    void reportSamExchange(const std::chrono::steady_clock::time_point start,
+                           const bool isSuccessful);
+
+    /**
+     * Makes the provided SAM the one used by the next SAM operations.
+     *
+     * @param samReader the SAM reader.
+     * @param calypsoSam the SAM.
+     * @since 2.1.1
+     */
+    void bindSam(const std::shared_ptr<CardReader> samReader,
+                 const std::shared_ptr<CalypsoSam> calypsoSam);
+
+    /**
+     * Allocates a free SAM of the pool if a pool is used and no SAM is allocated yet.
+     *
+     * <p>Must be called before building any SAM command.
+     *
+     * @throw IllegalStateException if the pool is empty.
+     * @since 2.1.1
+     */
+    void acquireSam();
+
+    /**
+     * (pipelined mode)<br>
+     * Sends all the pending digest commands (without Digest Close) to the SAM in background.
+     *
+     * @since 2.1.1
+     */
+    void startDigestTransmission();
+
+    /**
+     * Waits for the end of the background exchange with the SAM, if any.
+     *
+     * <p>Must be called before any other exchange with the SAM to keep the commands in order. A
+     * failed challenge prefetch is not reported.
+     *
+     * @throw CalypsoSamCommandException if the SAM has responded with an error status
+     * @throw ReaderBrokenCommunicationException if the communication with the SAM reader has failed.
+     * @throw CardBrokenCommunicationException if the communication with the SAM has failed.
+     * @throw DesynchronizedExchangesException if the APDU SAM exchanges are out of sync
+     * @since 2.1.1
+     */
+    void waitForBackgroundExchange();
+
+    /**
+     * Waits for the end of the background exchange with the SAM, if any, ignoring its outcome.
+     *
+     * @since 2.1.1
+     */
+    void discardBackgroundExchange();
+
+    /**
+     * Runs the provided task on the worker thread of the processor, started if needed.
+     *
+     * <p>The tasks are run one at a time, in their order of submission.
+     *
+     * @param task The task to run.
+     * @return A future becoming ready when the task ends, providing the exception it raised.
+     * @since 2.1.1
+     */
+    std::future<void> runInBackground(const std::function<void()>& task);
+
+    /**
+     * Requests a challenge from the SAM and keeps it for the next session.
+     *
+     * <p>The caller must have waited for the previous background exchange.
+     *
+     * @throw CalypsoSamCommandException if the SAM has responded with an error status
+     * @throw ReaderBrokenCommunicationException if the communication with the SAM reader has failed.
+     * @throw CardBrokenCommunicationException if the communication with the SAM has failed.
+     * @throw DesynchronizedExchangesException if the APDU SAM exchanges are out of sync
+     * @since 2.1.1
+     */
+    void transmitChallengePrefetch();
+
     /**
      * Create an ApduRequestAdapter List from a AbstractSamCommand List.
      *
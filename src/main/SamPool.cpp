@@ -0,0 +1,301 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "SamPool.h"
+
+#include <string>
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+#include "IllegalStateException.h"
+#include "KeypleAssert.h"
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+
+using ProductType = CalypsoSam::ProductType;
+
+const int SamPool::MAX_CONSECUTIVE_FAILURES = 3;
+const std::chrono::milliseconds SamPool::DEFAULT_ACQUIRE_TIMEOUT(10000);
+const std::chrono::milliseconds SamPool::DEFAULT_UNHEALTHY_RETRY_DELAY(30000);
+
+SamPool::SamPool()
+: mAcquireTimeout(DEFAULT_ACQUIRE_TIMEOUT), mUnhealthyRetryDelay(DEFAULT_UNHEALTHY_RETRY_DELAY) {}
+
+SamPool& SamPool::setAcquireTimeout(const std::chrono::milliseconds timeout)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mAcquireTimeout = timeout;
+
+    return *this;
+}
+
+SamPool& SamPool::setUnhealthyRetryDelay(const std::chrono::milliseconds delay)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mUnhealthyRetryDelay = delay;
+
+    return *this;
+}
+
+SamPool& SamPool::addSam(const std::shared_ptr<CardReader> samReader,
+                         const std::shared_ptr<CalypsoSam> calypsoSam)
+{
+    Assert::getInstance().notNull(samReader, "samReader")
+                         .notNull(calypsoSam, "calypsoSam")
+                         .isTrue(calypsoSam->getProductType() != ProductType::UNKNOWN, "productType");
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mSamEntries.push_back({samReader,
+                           calypsoSam,
+                           0,
+                           0,
+                           0,
+                           0,
+                           std::chrono::steady_clock::time_point()});
+
+    /* A waiting allocation may take the new SAM */
+    mSamReleased.notify_one();
+
+    return *this;
+}
+
+bool SamPool::discoverSam(
+    const std::shared_ptr<CardReader> samReader,
+    const std::shared_ptr<CardResourceProfileExtension> samProfileExtension,
+    const std::shared_ptr<CardSelectionManager> samCardSelectionManager)
+{
+    Assert::getInstance().notNull(samReader, "samReader")
+                         .notNull(samProfileExtension, "samProfileExtension")
+                         .notNull(samCardSelectionManager, "samCardSelectionManager");
+
+    const auto calypsoSam = std::dynamic_pointer_cast<CalypsoSam>(
+                                samProfileExtension->matches(samReader, samCardSelectionManager));
+
+    if (calypsoSam == nullptr || calypsoSam->getProductType() == ProductType::UNKNOWN) {
+        mLogger->debug("discoverSam: no matching SAM found\n");
+        return false;
+    }
+
+    addSam(samReader, calypsoSam);
+
+    return true;
+}
+
+int SamPool::getSize() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    return static_cast<int>(mSamEntries.size());
+}
+
+int SamPool::acquire()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    if (mSamEntries.empty()) {
+        throw IllegalStateException("The SAM pool is empty.");
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + mAcquireTimeout;
+
+    int selectedIndex = selectFreeSam();
+    while (selectedIndex == -1) {
+        if (mSamReleased.wait_until(lock, deadline) == std::cv_status::timeout) {
+            selectedIndex = selectFreeSam();
+            if (selectedIndex == -1) {
+                throw IllegalStateException("No SAM of the pool has been released within " +
+                                            std::to_string(mAcquireTimeout.count()) + " ms.");
+            }
+            break;
+        }
+
+        selectedIndex = selectFreeSam();
+    }
+
+    SamEntry& selected = mSamEntries[selectedIndex];
+
+    if (!isHealthy(selected)) {
+        mLogger->warn("acquire: allocating the unhealthy SAM #%\n", selectedIndex);
+
+        /* Only one probe per retry delay */
+        selected.lastFailureTime = std::chrono::steady_clock::now();
+    }
+
+    selected.activeSessionCount = 1;
+
+    return selectedIndex;
+}
+
+void SamPool::release(const int samIndex)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        checkSamIndex(samIndex);
+
+        mSamEntries[samIndex].activeSessionCount = 0;
+    }
+
+    mSamReleased.notify_one();
+}
+
+void SamPool::reportExchange(const int samIndex,
+                             const int64_t latencyMicros,
+                             const bool isSuccessful)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    checkSamIndex(samIndex);
+
+    SamEntry& entry = mSamEntries[samIndex];
+    entry.exchangeCount++;
+    entry.totalLatencyMicros += latencyMicros;
+
+    if (isSuccessful) {
+        entry.consecutiveFailureCount = 0;
+        return;
+    }
+
+    entry.lastFailureTime = std::chrono::steady_clock::now();
+
+    if (++entry.consecutiveFailureCount == MAX_CONSECUTIVE_FAILURES) {
+        mLogger->warn("reportExchange: SAM #% is now considered unhealthy\n", samIndex);
+    }
+}
+
+std::shared_ptr<CardReader> SamPool::getSamReader(const int samIndex) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    checkSamIndex(samIndex);
+
+    return mSamEntries[samIndex].samReader;
+}
+
+std::shared_ptr<CalypsoSam> SamPool::getCalypsoSam(const int samIndex) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    checkSamIndex(samIndex);
+
+    return mSamEntries[samIndex].calypsoSam;
+}
+
+int SamPool::getActiveSessionCount(const int samIndex) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    checkSamIndex(samIndex);
+
+    return mSamEntries[samIndex].activeSessionCount;
+}
+
+int64_t SamPool::getExchangeCount(const int samIndex) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    checkSamIndex(samIndex);
+
+    return mSamEntries[samIndex].exchangeCount;
+}
+
+int64_t SamPool::getAverageLatencyMicros(const int samIndex) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    checkSamIndex(samIndex);
+
+    return getAverageLatencyMicros(mSamEntries[samIndex]);
+}
+
+bool SamPool::isHealthy(const int samIndex) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    checkSamIndex(samIndex);
+
+    return isHealthy(mSamEntries[samIndex]);
+}
+
+void SamPool::checkSamIndex(const int samIndex) const
+{
+    if (samIndex < 0 || samIndex >= static_cast<int>(mSamEntries.size())) {
+        throw IllegalArgumentException("Invalid SAM index: " + std::to_string(samIndex));
+    }
+}
+
+int SamPool::selectFreeSam() const
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    int selectedIndex = -1;
+    int unhealthyIndex = -1;
+    bool isHealthySamPresent = false;
+
+    for (int i = 0; i < static_cast<int>(mSamEntries.size()); i++) {
+        const SamEntry& entry = mSamEntries[i];
+        const bool isEntryHealthy = isHealthy(entry);
+
+        isHealthySamPresent = isHealthySamPresent || isEntryHealthy;
+
+        if (entry.activeSessionCount != 0) {
+            continue;
+        }
+
+        if (!isEntryHealthy) {
+            /* Probe of an unhealthy SAM whose retry delay has elapsed */
+            if (now - entry.lastFailureTime >= mUnhealthyRetryDelay) {
+                return i;
+            }
+
+            if (unhealthyIndex == -1) {
+                unhealthyIndex = i;
+            }
+
+            continue;
+        }
+
+        if (selectedIndex == -1 ||
+            getAverageLatencyMicros(entry) < getAverageLatencyMicros(mSamEntries[selectedIndex])) {
+            selectedIndex = i;
+        }
+    }
+
+    /* The unhealthy SAMs are only used if no healthy one remains */
+    if (selectedIndex == -1 && !isHealthySamPresent) {
+        return unhealthyIndex;
+    }
+
+    return selectedIndex;
+}
+
+bool SamPool::isHealthy(const SamEntry& entry)
+{
+    return entry.consecutiveFailureCount < MAX_CONSECUTIVE_FAILURES;
+}
+
+int64_t SamPool::getAverageLatencyMicros(const SamEntry& entry)
+{
+    return entry.exchangeCount == 0 ? 0 : entry.totalLatencyMicros / entry.exchangeCount;
+}
+
+}
+}
+}
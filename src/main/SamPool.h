@@ -0,0 +1,328 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/* Calypsonet Terminal Calypso */
+#include "CalypsoSam.h"
+
+/* Calypsonet Terminal Reader */
+#include "CardReader.h"
+#include "CardSelectionManager.h"
+
+/* Keyple Core Service */
+#include "CardResourceProfileExtension.h"
+
+/* Keyple Core Util */
+#include "LoggerFactory.h"
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+using namespace calypsonet::terminal::calypso::sam;
+using namespace calypsonet::terminal::reader;
+using namespace calypsonet::terminal::reader::selection;
+using namespace keyple::core::service::resource::spi;
+using namespace keyple::core::util::cpp;
+
+/**
+ * (package-private)<br>
+ * Set of SAMs shared by the transactions referencing it in their security settings.
+ *
+ * <p>A SAM is allocated exclusively to a transaction for a whole secure session, the digest state
+ * of the session being held by the SAM. Among the free SAMs, the one with the lowest average
+ * exchange latency is chosen. When all the SAMs are busy, the allocation waits for a release, up
+ * to a timeout.
+ *
+ * <p>The exchanges with each SAM are monitored: a SAM is considered unhealthy after
+ * MAX_CONSECUTIVE_FAILURES consecutive communication failures and is no longer allocated while a
+ * healthy SAM remains in the pool, except to probe it once its retry delay has elapsed since its
+ * last failure. A successful exchange restores its health.
+ *
+ * <p>This class is thread-safe.
+ *
+ * @since 2.1.1
+ */
+class SamPool final {
+public:
+    /**
+     * (package-private)<br>
+     * Number of consecutive communication failures after which a SAM is considered unhealthy.
+     *
+     * @since 2.1.1
+     */
+    static const int MAX_CONSECUTIVE_FAILURES;
+
+    /**
+     * (package-private)<br>
+     * Default maximum duration of an allocation waiting for a free SAM.
+     *
+     * @since 2.1.1
+     */
+    static const std::chrono::milliseconds DEFAULT_ACQUIRE_TIMEOUT;
+
+    /**
+     * (package-private)<br>
+     * Default delay after which an unhealthy SAM is allocated again to probe it.
+     *
+     * @since 2.1.1
+     */
+    static const std::chrono::milliseconds DEFAULT_UNHEALTHY_RETRY_DELAY;
+
+    /**
+     * (package-private)<br>
+     * Constructor.
+     *
+     * @since 2.1.1
+     */
+    SamPool();
+
+    /**
+     * (package-private)<br>
+     * Sets the maximum duration of an allocation waiting for a free SAM (DEFAULT_ACQUIRE_TIMEOUT
+     * by default).
+     *
+     * @param timeout The timeout.
+     * @return The current instance.
+     * @since 2.1.1
+     */
+    SamPool& setAcquireTimeout(const std::chrono::milliseconds timeout);
+
+    /**
+     * (package-private)<br>
+     * Sets the delay after which an unhealthy SAM is allocated again to probe it
+     * (DEFAULT_UNHEALTHY_RETRY_DELAY by default).
+     *
+     * @param delay The delay since the last failure of the SAM.
+     * @return The current instance.
+     * @since 2.1.1
+     */
+    SamPool& setUnhealthyRetryDelay(const std::chrono::milliseconds delay);
+
+    /**
+     * (package-private)<br>
+     * Adds a SAM to the pool.
+     *
+     * @param samReader The reader in which the SAM is inserted.
+     * @param calypsoSam The selected SAM.
+     * @return The current instance.
+     * @throw IllegalArgumentException If one of the arguments is null or if the SAM product type is
+     *        unknown.
+     * @since 2.1.1
+     */
+    SamPool& addSam(const std::shared_ptr<CardReader> samReader,
+                    const std::shared_ptr<CalypsoSam> calypsoSam);
+
+    /**
+     * (package-private)<br>
+     * Selects the SAM inserted in the provided reader using the provided resource profile
+     * extension (see CalypsoExtensionService::createSamResourceProfileExtension) and adds it to the
+     * pool if it matches.
+     *
+     * @param samReader The reader to inspect.
+     * @param samProfileExtension The SAM resource profile extension.
+     * @param samCardSelectionManager A new card selection manager.
+     * @return True if a SAM has been added to the pool.
+     * @throw IllegalArgumentException If one of the arguments is null.
+     * @since 2.1.1
+     */
+    bool discoverSam(const std::shared_ptr<CardReader> samReader,
+                     const std::shared_ptr<CardResourceProfileExtension> samProfileExtension,
+                     const std::shared_ptr<CardSelectionManager> samCardSelectionManager);
+
+    /**
+     * (package-private)<br>
+     * Gets the number of SAMs in the pool.
+     *
+     * @return A positive int.
+     * @since 2.1.1
+     */
+    int getSize() const;
+
+    /**
+     * (package-private)<br>
+     * Allocates a free SAM to a new secure session, waiting for a release if all the SAMs are
+     * busy.
+     *
+     * <p>An unhealthy SAM whose retry delay has elapsed is chosen first, to probe it. Otherwise,
+     * the healthy SAM with the lowest average latency is chosen. The unhealthy SAMs are only used if
+     * no healthy SAM remains in the pool.
+     *
+     * <p>The allocation must be ended by a call to release.
+     *
+     * @return The index of the allocated SAM.
+     * @throw IllegalStateException If the pool is empty or if no SAM has been released within the
+     *        acquire timeout.
+     * @since 2.1.1
+     */
+    int acquire();
+
+    /**
+     * (package-private)<br>
+     * Ends an allocation made with acquire.
+     *
+     * @param samIndex The index of the SAM.
+     * @since 2.1.1
+     */
+    void release(const int samIndex);
+
+    /**
+     * (package-private)<br>
+     * Records the outcome of an exchange with a SAM.
+     *
+     * @param samIndex The index of the SAM.
+     * @param latencyMicros The duration of the exchange in microseconds.
+     * @param isSuccessful False if the communication with the SAM failed.
+     * @since 2.1.1
+     */
+    void reportExchange(const int samIndex, const int64_t latencyMicros, const bool isSuccessful);
+
+    /**
+     * (package-private)<br>
+     * Gets the reader of a SAM.
+     *
+     * @param samIndex The index of the SAM.
+     * @return A not null reference.
+     * @since 2.1.1
+     */
+    std::shared_ptr<CardReader> getSamReader(const int samIndex) const;
+
+    /**
+     * (package-private)<br>
+     * Gets a SAM.
+     *
+     * @param samIndex The index of the SAM.
+     * @return A not null reference.
+     * @since 2.1.1
+     */
+    std::shared_ptr<CalypsoSam> getCalypsoSam(const int samIndex) const;
+
+    /**
+     * (package-private)<br>
+     * Gets the number of secure sessions currently served by a SAM.
+     *
+     * @param samIndex The index of the SAM.
+     * @return 1 if the SAM is allocated, 0 otherwise.
+     * @since 2.1.1
+     */
+    int getActiveSessionCount(const int samIndex) const;
+
+    /**
+     * (package-private)<br>
+     * Gets the number of exchanges made with a SAM.
+     *
+     * @param samIndex The index of the SAM.
+     * @return A positive value.
+     * @since 2.1.1
+     */
+    int64_t getExchangeCount(const int samIndex) const;
+
+    /**
+     * (package-private)<br>
+     * Gets the average duration of the exchanges made with a SAM.
+     *
+     * @param samIndex The index of the SAM.
+     * @return The latency in microseconds, 0 if no exchange has been made yet.
+     * @since 2.1.1
+     */
+    int64_t getAverageLatencyMicros(const int samIndex) const;
+
+    /**
+     * (package-private)<br>
+     * Indicates if a SAM is considered healthy.
+     *
+     * @param samIndex The index of the SAM.
+     * @return False if the last MAX_CONSECUTIVE_FAILURES exchanges with the SAM failed.
+     * @since 2.1.1
+     */
+    bool isHealthy(const int samIndex) const;
+
+private:
+    /**
+     * State of a SAM of the pool.
+     */
+    struct SamEntry {
+        std::shared_ptr<CardReader> samReader;
+        std::shared_ptr<CalypsoSam> calypsoSam;
+        int activeSessionCount;
+        int64_t exchangeCount;
+        int64_t totalLatencyMicros;
+        int consecutiveFailureCount;
+        std::chrono::steady_clock::time_point lastFailureTime;
+    };
+
+    /**
+     *
+     */
+    const std::unique_ptr<Logger> mLogger = LoggerFactory::getLogger(typeid(SamPool));
+
+    /**
+     *
+     */
+    mutable std::mutex mMutex;
+
+    /**
+     * Notified when a SAM is released.
+     */
+    std::condition_variable mSamReleased;
+
+    /**
+     *
+     */
+    std::chrono::milliseconds mAcquireTimeout;
+
+    /**
+     *
+     */
+    std::chrono::milliseconds mUnhealthyRetryDelay;
+
+    /**
+     *
+     */
+    std::vector<SamEntry> mSamEntries;
+
+    /**
+     * Checks the index of a SAM (the mutex must be held).
+     *
+     * @throw IllegalArgumentException If the index is out of range.
+     */
+    void checkSamIndex(const int samIndex) const;
+
+    /**
+     * Selects a free SAM according to the rules of acquire (the mutex must be held).
+     *
+     * @return The index of the SAM, -1 if none can be allocated now.
+     */
+    int selectFreeSam() const;
+
+    /**
+     * Health of an entry (the mutex must be held).
+     */
+    static bool isHealthy(const SamEntry& entry);
+
+    /**
+     * Average latency of an entry (the mutex must be held).
+     */
+    static int64_t getAverageLatencyMicros(const SamEntry& entry);
+};
+
+}
+}
+}
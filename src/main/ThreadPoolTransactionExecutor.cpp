@@ -0,0 +1,114 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "ThreadPoolTransactionExecutor.h"
+
+#include <exception>
+
+/* Keyple Core Util */
+#include "Exception.h"
+#include "IllegalStateException.h"
+#include "KeypleAssert.h"
+#include "LoggerFactory.h"
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp;
+using namespace keyple::core::util::cpp::exception;
+
+ThreadPoolTransactionExecutor::ThreadPoolTransactionExecutor(const int threadCount)
+: mQueue(std::make_shared<WorkQueue>())
+{
+    Assert::getInstance().greaterOrEqual(threadCount, 1, "threadCount");
+
+    for (int i = 0; i < threadCount; i++) {
+        mWorkers.push_back(std::thread(&ThreadPoolTransactionExecutor::work, mQueue));
+    }
+}
+
+ThreadPoolTransactionExecutor::~ThreadPoolTransactionExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mQueue->mutex);
+        mQueue->isShutdown = true;
+    }
+
+    mQueue->condition.notify_all();
+
+    for (auto& worker : mWorkers) {
+        if (worker.get_id() == std::this_thread::get_id()) {
+            /* Destroyed by one of its tasks: joining the calling thread would deadlock */
+            worker.detach();
+        } else {
+            worker.join();
+        }
+    }
+}
+
+void ThreadPoolTransactionExecutor::execute(const std::function<void()>& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mQueue->mutex);
+
+        if (mQueue->isShutdown) {
+            throw IllegalStateException("The executor is shut down.");
+        }
+
+        mQueue->tasks.push_back(task);
+    }
+
+    mQueue->condition.notify_one();
+}
+
+void ThreadPoolTransactionExecutor::work(const std::shared_ptr<WorkQueue> queue)
+{
+    /* Owned by the thread, the pool may be destroyed while it runs */
+    const std::unique_ptr<Logger> logger =
+        LoggerFactory::getLogger(typeid(ThreadPoolTransactionExecutor));
+
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(queue->mutex);
+
+            while (queue->tasks.empty() && !queue->isShutdown) {
+                queue->condition.wait(lock);
+            }
+
+            /* The pending tasks are run before stopping */
+            if (queue->tasks.empty()) {
+                return;
+            }
+
+            task = queue->tasks.front();
+            queue->tasks.pop_front();
+        }
+
+        try {
+            task();
+        } catch (const Exception& e) {
+            logger->error("An exception occurred while running a task: %\n", e.getMessage());
+        } catch (const std::exception& e) {
+            logger->error("An exception occurred while running a task: %\n", e.what());
+        } catch (...) {
+            logger->error("An unknown exception occurred while running a task\n");
+        }
+    }
+}
+
+}
+}
+}
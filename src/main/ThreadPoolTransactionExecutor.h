@@ -0,0 +1,101 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Keyple Card Calypso */
+#include "TransactionExecutor.h"
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+/**
+ * (package-private)<br>
+ * TransactionExecutor running the tasks on a fixed number of worker threads.
+ *
+ * <p>The tasks are run in their order of submission. The destructor waits for all the submitted
+ * tasks to be run. When it is called from one of the tasks, the worker thread running that task is
+ * detached instead of joined and ends once the queue is empty. An exception escaping from a task is
+ * logged and does not stop the worker thread.
+ *
+ * <p>A task occupies its worker thread until it ends: the number of threads bounds the number of
+ * transactions processed at the same time.
+ *
+ * @since 2.1.1
+ */
+class ThreadPoolTransactionExecutor final : public TransactionExecutor {
+public:
+    /**
+     * Creates the pool and starts its worker threads.
+     *
+     * @param threadCount The number of worker threads.
+     * @throw IllegalArgumentException If threadCount is lower than 1.
+     * @since 2.1.1
+     */
+    explicit ThreadPoolTransactionExecutor(const int threadCount);
+
+    /**
+     * Runs the pending tasks and stops the worker threads.
+     *
+     * @since 2.1.1
+     */
+    ~ThreadPoolTransactionExecutor();
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.1
+     */
+    void execute(const std::function<void()>& task) override;
+
+private:
+    /**
+     * State shared with the worker threads, which may outlive the pool when it is destroyed from
+     * one of its tasks.
+     */
+    struct WorkQueue {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<std::function<void()>> tasks;
+        bool isShutdown = false;
+    };
+
+    /**
+     *
+     */
+    const std::shared_ptr<WorkQueue> mQueue;
+
+    /**
+     *
+     */
+    std::vector<std::thread> mWorkers;
+
+    /**
+     * Body of the worker threads: runs the queued tasks until the pool is shut down.
+     *
+     * @param queue The queue of the pool.
+     */
+    static void work(const std::shared_ptr<WorkQueue> queue);
+};
+
+}
+}
+}
@@ -0,0 +1,49 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <functional>
+
+namespace keyple {
+namespace card {
+namespace calypso {
+
+/**
+ * (package-private)<br>
+ * Runs the asynchronous operations of the card transaction managers.
+ *
+ * <p>Implementations decide on which thread the tasks are run (thread pool, event loop, ...).
+ * Each task must be run exactly once.
+ *
+ * @since 2.1.1
+ */
+class TransactionExecutor {
+public:
+    /**
+     *
+     */
+    virtual ~TransactionExecutor() = default;
+
+    /**
+     * Schedules the execution of a task.
+     *
+     * @param task The task to run.
+     * @throw IllegalStateException If the executor no longer accepts tasks.
+     * @since 2.1.1
+     */
+    virtual void execute(const std::function<void()>& task) = 0;
+};
+
+}
+}
+}
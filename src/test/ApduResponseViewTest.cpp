@@ -0,0 +1,318 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Card Calypso */
+#include "ApduResponseView.h"
+#include "CalypsoCardAdapter.h"
+#include "CalypsoCardClass.h"
+#include "CmdCardCloseSession.h"
+#include "CmdCardOpenSession.h"
+#include "CmdCardReadRecords.h"
+#include "CmdCardSearchRecordMultiple.h"
+#include "SearchCommandDataAdapter.h"
+
+/* Keyple Core Util */
+#include "ByteArrayUtil.h"
+#include "IllegalArgumentException.h"
+#include "IllegalStateException.h"
+#include "IndexOutOfBoundsException.h"
+
+/* Mock */
+#include "ApduResponseAdapterMock.h"
+
+using namespace testing;
+
+using namespace keyple::card::calypso;
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+
+static const std::string SELECT_APPLICATION_RESPONSE_PRIME_REVISION_3 =
+    "6F238409315449432E49434131A516BF0C13C708000000001122334453070A3C20051410019000";
+static const std::string SAM_CHALLENGE = "C1C2C3C4";
+static const std::string SAM_SIGNATURE = "12345678";
+
+static std::shared_ptr<CalypsoCardAdapter> calypsoCard;
+
+static void setUp()
+{
+    calypsoCard = std::make_shared<CalypsoCardAdapter>();
+    calypsoCard->initializeWithFci(
+        std::make_shared<ApduResponseAdapterMock>(
+            ByteArrayUtil::fromHex(SELECT_APPLICATION_RESPONSE_PRIME_REVISION_3)));
+}
+
+static void tearDown()
+{
+    calypsoCard.reset();
+}
+
+static std::shared_ptr<ApduResponseAdapterMock> createApduResponse(const std::string& apdu)
+{
+    return std::make_shared<ApduResponseAdapterMock>(ByteArrayUtil::fromHex(apdu));
+}
+
+TEST(ApduResponseViewTest, getLength_shouldExcludeTheStatusWord)
+{
+    const ApduResponseView dataOut(*createApduResponse("1122339000"));
+
+    ASSERT_EQ(dataOut.getLength(), 3);
+    ASSERT_FALSE(dataOut.isEmpty());
+    ASSERT_EQ(dataOut[0], 0x11);
+    ASSERT_EQ(dataOut[2], 0x33);
+    ASSERT_EQ(dataOut.toVector(), ByteArrayUtil::fromHex("112233"));
+}
+
+TEST(ApduResponseViewTest, isEmpty_whenResponseIsOnlyAStatusWord_shouldReturnTrue)
+{
+    const ApduResponseView dataOut(*createApduResponse("9000"));
+
+    ASSERT_EQ(dataOut.getLength(), 0);
+    ASSERT_TRUE(dataOut.isEmpty());
+    ASSERT_TRUE(dataOut.toVector().empty());
+}
+
+TEST(ApduResponseViewTest, copyOfRange_shouldCopyTheRange)
+{
+    const ApduResponseView dataOut(*createApduResponse("112233449000"));
+
+    ASSERT_EQ(dataOut.copyOfRange(1, 3), ByteArrayUtil::fromHex("2233"));
+    ASSERT_TRUE(dataOut.copyOfRange(4, 4).empty());
+}
+
+TEST(ApduResponseViewTest, copyOfRange_whenRangeIncludesTheStatusWord_shouldThrowIOOBE)
+{
+    const ApduResponseView dataOut(*createApduResponse("112233449000"));
+
+    EXPECT_THROW(dataOut.copyOfRange(2, 5), IndexOutOfBoundsException);
+    EXPECT_THROW(dataOut.copyOfRange(-1, 2), IndexOutOfBoundsException);
+    EXPECT_THROW(dataOut.copyOfRange(3, 2), IndexOutOfBoundsException);
+}
+
+TEST(ApduResponseViewTest, readRecords_whenOneRecordIsRead_shouldProvideTheRecord)
+{
+    CmdCardReadRecords cmd(CalypsoCardClass::ISO,
+                           0x07,
+                           1,
+                           CmdCardReadRecords::ReadMode::ONE_RECORD,
+                           0);
+
+    cmd.setApduResponse(createApduResponse("1122339000"));
+
+    ASSERT_EQ(cmd.getRecords().size(), 1u);
+    ASSERT_EQ(cmd.getRecords().at(1), ByteArrayUtil::fromHex("112233"));
+}
+
+TEST(ApduResponseViewTest, readRecords_whenSeveralRecordsAreRead_shouldProvideEachRecord)
+{
+    CmdCardReadRecords cmd(CalypsoCardClass::ISO,
+                           0x07,
+                           1,
+                           CmdCardReadRecords::ReadMode::MULTIPLE_RECORD,
+                           0);
+
+    cmd.setApduResponse(createApduResponse("01021122" "0301AA" "0200" "9000"));
+
+    ASSERT_EQ(cmd.getRecords().size(), 3u);
+    ASSERT_EQ(cmd.getRecords().at(1), ByteArrayUtil::fromHex("1122"));
+    ASSERT_TRUE(cmd.getRecords().at(2).empty());
+    ASSERT_EQ(cmd.getRecords().at(3), ByteArrayUtil::fromHex("AA"));
+}
+
+TEST(ApduResponseViewTest, readRecords_whenResponseIsOnlyAStatusWord_shouldProvideNoRecord)
+{
+    CmdCardReadRecords cmd(CalypsoCardClass::ISO,
+                           0x07,
+                           1,
+                           CmdCardReadRecords::ReadMode::MULTIPLE_RECORD,
+                           0);
+
+    cmd.setApduResponse(createApduResponse("6A83"));
+
+    ASSERT_TRUE(cmd.getRecords().empty());
+}
+
+TEST(ApduResponseViewTest, readRecords_whenRecordHeaderIsTruncated_shouldThrowISE)
+{
+    CmdCardReadRecords cmd(CalypsoCardClass::ISO,
+                           0x07,
+                           1,
+                           CmdCardReadRecords::ReadMode::MULTIPLE_RECORD,
+                           0);
+
+    EXPECT_THROW(cmd.setApduResponse(createApduResponse("01021122" "03" "9000")),
+                 IllegalStateException);
+}
+
+TEST(ApduResponseViewTest, readRecords_whenRecordLengthExceedsTheResponse_shouldThrowISE)
+{
+    CmdCardReadRecords cmd(CalypsoCardClass::ISO,
+                           0x07,
+                           1,
+                           CmdCardReadRecords::ReadMode::MULTIPLE_RECORD,
+                           0);
+
+    EXPECT_THROW(cmd.setApduResponse(createApduResponse("01051122" "9000")),
+                 IllegalStateException);
+}
+
+TEST(ApduResponseViewTest, searchRecordMultiple_shouldProvideTheMatchingRecordNumbers)
+{
+    auto data = std::make_shared<SearchCommandDataAdapter>();
+    data->setSfi(0x07);
+    data->setSearchData(ByteArrayUtil::fromHex("11"));
+    CmdCardSearchRecordMultiple cmd(CalypsoCardClass::ISO, data);
+
+    cmd.setApduResponse(createApduResponse("020104" "9000"));
+
+    ASSERT_EQ(data->getMatchingRecordNumbers(), std::vector<int>({1, 4}));
+    ASSERT_TRUE(cmd.getFirstMatchingRecordContent().empty());
+}
+
+TEST(ApduResponseViewTest,
+     searchRecordMultiple_whenFirstMatchingResultIsFetched_shouldProvideItsContent)
+{
+    auto data = std::make_shared<SearchCommandDataAdapter>();
+    data->setSfi(0x07);
+    data->setSearchData(ByteArrayUtil::fromHex("11"));
+    data->fetchFirstMatchingResult();
+    CmdCardSearchRecordMultiple cmd(CalypsoCardClass::ISO, data);
+
+    cmd.setApduResponse(createApduResponse("0103" "112233" "9000"));
+
+    ASSERT_EQ(data->getMatchingRecordNumbers(), std::vector<int>({3}));
+    ASSERT_EQ(cmd.getFirstMatchingRecordContent(), ByteArrayUtil::fromHex("112233"));
+}
+
+TEST(ApduResponseViewTest, searchRecordMultiple_whenNoRecordMatches_shouldProvideNoRecordNumber)
+{
+    auto data = std::make_shared<SearchCommandDataAdapter>();
+    data->setSfi(0x07);
+    data->setSearchData(ByteArrayUtil::fromHex("11"));
+    data->fetchFirstMatchingResult();
+    CmdCardSearchRecordMultiple cmd(CalypsoCardClass::ISO, data);
+
+    cmd.setApduResponse(createApduResponse("00" "9000"));
+
+    ASSERT_TRUE(data->getMatchingRecordNumbers().empty());
+    ASSERT_TRUE(cmd.getFirstMatchingRecordContent().empty());
+}
+
+TEST(ApduResponseViewTest,
+     searchRecordMultiple_whenRecordNumbersExceedTheResponse_shouldThrowISE)
+{
+    auto data = std::make_shared<SearchCommandDataAdapter>();
+    data->setSfi(0x07);
+    data->setSearchData(ByteArrayUtil::fromHex("11"));
+    CmdCardSearchRecordMultiple cmd(CalypsoCardClass::ISO, data);
+
+    EXPECT_THROW(cmd.setApduResponse(createApduResponse("0301" "9000")), IllegalStateException);
+}
+
+TEST(ApduResponseViewTest, openSession_whenRev3_shouldParseTheSecureSessionData)
+{
+    setUp();
+
+    CmdCardOpenSession cmd(calypsoCard, 0x03, ByteArrayUtil::fromHex(SAM_CHALLENGE), 0x07, 1);
+
+    cmd.setApduResponse(createApduResponse("030490" "98" "00" "30" "79" "03" "112233" "9000"));
+
+    ASSERT_EQ(cmd.getCardChallenge(), ByteArrayUtil::fromHex("98"));
+    ASSERT_EQ(cmd.getTransactionCounterValue(), 0x030490);
+    ASSERT_TRUE(cmd.wasRatified());
+    ASSERT_EQ(*cmd.getSelectedKif(), 0x30);
+    ASSERT_EQ(*cmd.getSelectedKvc(), 0x79);
+    ASSERT_EQ(cmd.getRecordDataRead(), ByteArrayUtil::fromHex("112233"));
+
+    tearDown();
+}
+
+TEST(ApduResponseViewTest, openSession_whenRev3ResponseIsTooShort_shouldThrowISE)
+{
+    setUp();
+
+    CmdCardOpenSession cmd(calypsoCard, 0x03, ByteArrayUtil::fromHex(SAM_CHALLENGE), 0x07, 1);
+
+    EXPECT_THROW(cmd.setApduResponse(createApduResponse("030490" "98" "00" "9000")),
+                 IllegalStateException);
+
+    tearDown();
+}
+
+TEST(ApduResponseViewTest, openSession_whenRev3RecordDataIsTruncated_shouldThrowISE)
+{
+    setUp();
+
+    CmdCardOpenSession cmd(calypsoCard, 0x03, ByteArrayUtil::fromHex(SAM_CHALLENGE), 0x07, 1);
+
+    EXPECT_THROW(
+        cmd.setApduResponse(createApduResponse("030490" "98" "00" "30" "79" "1D" "1122" "9000")),
+        IllegalStateException);
+
+    tearDown();
+}
+
+TEST(ApduResponseViewTest, closeSession_shouldProvideTheCardSignature)
+{
+    setUp();
+
+    CmdCardCloseSession cmd(calypsoCard, true, ByteArrayUtil::fromHex(SAM_SIGNATURE));
+
+    cmd.setApduResponse(createApduResponse("9ABCDEF0" "9000"));
+
+    ASSERT_EQ(cmd.getSignatureLo(), ByteArrayUtil::fromHex("9ABCDEF0"));
+    ASSERT_TRUE(cmd.getPostponedData().empty());
+
+    tearDown();
+}
+
+TEST(ApduResponseViewTest, closeSession_whenPostponedDataArePresent_shouldProvideThem)
+{
+    setUp();
+
+    CmdCardCloseSession cmd(calypsoCard, true, ByteArrayUtil::fromHex(SAM_SIGNATURE));
+
+    cmd.setApduResponse(createApduResponse("04" "112233" "9ABCDEF0" "9000"));
+
+    ASSERT_EQ(cmd.getSignatureLo(), ByteArrayUtil::fromHex("9ABCDEF0"));
+    ASSERT_EQ(cmd.getPostponedData(), ByteArrayUtil::fromHex("112233"));
+
+    tearDown();
+}
+
+TEST(ApduResponseViewTest, closeSession_whenSessionIsAborted_shouldProvideNoSignature)
+{
+    setUp();
+
+    CmdCardCloseSession cmd(calypsoCard);
+
+    cmd.setApduResponse(createApduResponse("9000"));
+
+    ASSERT_TRUE(cmd.getSignatureLo().empty());
+    ASSERT_TRUE(cmd.getPostponedData().empty());
+
+    tearDown();
+}
+
+TEST(ApduResponseViewTest, closeSession_whenResponseLengthIsUnexpected_shouldThrowIAE)
+{
+    setUp();
+
+    CmdCardCloseSession cmd(calypsoCard, true, ByteArrayUtil::fromHex(SAM_SIGNATURE));
+
+    EXPECT_THROW(cmd.setApduResponse(createApduResponse("9ABCDE" "9000")),
+                 IllegalArgumentException);
+
+    tearDown();
+}
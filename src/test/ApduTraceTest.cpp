@@ -0,0 +1,183 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+/* Keyple Core Util */
+#include "ByteArrayUtil.h"
+#include "IllegalArgumentException.h"
+
+/* Benchmark */
+#include "ApduTrace.h"
+
+using namespace testing;
+
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+
+static const std::string READER_NAME = "CARD_READER";
+
+static ApduTrace::Event createExchange(const ApduTrace::Outcome outcome)
+{
+    ApduTrace::Event event;
+    event.type = ApduTrace::EventType::EXCHANGE;
+    event.startTime = 0x0102030405060708;
+    event.endTime = 0x0102030405060709;
+    event.isCloseAfter = true;
+    event.stopOnUnsuccessfulStatusWord = true;
+    event.outcome = outcome;
+    event.isLogicalChannelOpen = false;
+    event.requests.push_back(ByteArrayUtil::fromHex("00B2014400"));
+    event.requests.push_back(ByteArrayUtil::fromHex("00B2024400"));
+    event.responses.push_back(ByteArrayUtil::fromHex("11223344556677889000"));
+
+    return event;
+}
+
+static const std::string createTrace()
+{
+    std::ostringstream output;
+    ApduTrace::writeHeader(output, READER_NAME, true);
+    ApduTrace::writeEvent(output, createExchange(ApduTrace::Outcome::SUCCESS));
+
+    return output.str();
+}
+
+TEST(ApduTraceTest, readEvent_whenTraceIsWritten_shouldReturnTheWrittenEvents)
+{
+    const std::vector<ApduTrace::Outcome> outcomes = {
+        ApduTrace::Outcome::SUCCESS,
+        ApduTrace::Outcome::UNEXPECTED_STATUS_WORD,
+        ApduTrace::Outcome::CARD_BROKEN_COMMUNICATION,
+        ApduTrace::Outcome::READER_BROKEN_COMMUNICATION};
+
+    std::stringstream trace;
+    ApduTrace::writeHeader(trace, READER_NAME, true);
+    for (const auto outcome : outcomes) {
+        ApduTrace::writeEvent(trace, createExchange(outcome));
+    }
+
+    ApduTrace::Event release;
+    release.type = ApduTrace::EventType::RELEASE_CHANNEL;
+    release.startTime = 10;
+    release.endTime = 20;
+    ApduTrace::writeEvent(trace, release);
+
+    std::string readerName;
+    bool isContactless = false;
+    ApduTrace::readHeader(trace, readerName, isContactless);
+
+    ASSERT_EQ(readerName, READER_NAME);
+    ASSERT_TRUE(isContactless);
+
+    ApduTrace::Event event;
+    for (const auto outcome : outcomes) {
+        const ApduTrace::Event expected = createExchange(outcome);
+
+        ASSERT_TRUE(ApduTrace::readEvent(trace, event));
+        ASSERT_EQ(event.type, ApduTrace::EventType::EXCHANGE);
+        ASSERT_EQ(event.startTime, expected.startTime);
+        ASSERT_EQ(event.endTime, expected.endTime);
+        ASSERT_TRUE(event.isCloseAfter);
+        ASSERT_TRUE(event.stopOnUnsuccessfulStatusWord);
+        ASSERT_EQ(event.outcome, outcome);
+        ASSERT_FALSE(event.isLogicalChannelOpen);
+        ASSERT_EQ(event.requests, expected.requests);
+        ASSERT_EQ(event.responses, expected.responses);
+    }
+
+    ASSERT_TRUE(ApduTrace::readEvent(trace, event));
+    ASSERT_EQ(event.type, ApduTrace::EventType::RELEASE_CHANNEL);
+    ASSERT_EQ(event.startTime, 10ULL);
+    ASSERT_EQ(event.endTime, 20ULL);
+    ASSERT_TRUE(event.requests.empty());
+    ASSERT_TRUE(event.responses.empty());
+
+    ASSERT_FALSE(ApduTrace::readEvent(trace, event));
+}
+
+TEST(ApduTraceTest, readEvent_whenTraceIsTruncated_shouldThrowIAE)
+{
+    const std::string trace = createTrace();
+
+    /* Every cut inside the event, the event type excepted */
+    for (size_t length = trace.size() - 1; length > 8 + READER_NAME.size(); length--) {
+        std::istringstream input(trace.substr(0, length));
+
+        std::string readerName;
+        bool isContactless = false;
+        ApduTrace::readHeader(input, readerName, isContactless);
+
+        ApduTrace::Event event;
+        EXPECT_THROW(ApduTrace::readEvent(input, event), IllegalArgumentException);
+    }
+}
+
+TEST(ApduTraceTest, readHeader_whenHeaderIsTruncated_shouldThrowIAE)
+{
+    const std::string trace = createTrace();
+
+    for (size_t length = 0; length < 8 + READER_NAME.size(); length++) {
+        std::istringstream input(trace.substr(0, length));
+
+        std::string readerName;
+        bool isContactless = false;
+        EXPECT_THROW(ApduTrace::readHeader(input, readerName, isContactless),
+                     IllegalArgumentException);
+    }
+}
+
+TEST(ApduTraceTest, readHeader_whenMagicIsBad_shouldThrowIAE)
+{
+    std::string trace = createTrace();
+    trace[0] = 'X';
+
+    std::istringstream input(trace);
+    std::string readerName;
+    bool isContactless = false;
+
+    EXPECT_THROW(ApduTrace::readHeader(input, readerName, isContactless),
+                 IllegalArgumentException);
+}
+
+TEST(ApduTraceTest, readHeader_whenVersionIsUnsupported_shouldThrowIAE)
+{
+    std::string trace = createTrace();
+    trace[4] = 0x7F;
+
+    std::istringstream input(trace);
+    std::string readerName;
+    bool isContactless = false;
+
+    EXPECT_THROW(ApduTrace::readHeader(input, readerName, isContactless),
+                 IllegalArgumentException);
+}
+
+TEST(ApduTraceTest, readEvent_whenOutcomeIsUnknown_shouldThrowIAE)
+{
+    std::string trace = createTrace();
+
+    /* Header, then event type, start, end, channel control and stop flag */
+    trace[8 + READER_NAME.size() + 19] = 0x7F;
+
+    std::istringstream input(trace);
+    std::string readerName;
+    bool isContactless = false;
+    ApduTrace::readHeader(input, readerName, isContactless);
+
+    ApduTrace::Event event;
+    EXPECT_THROW(ApduTrace::readEvent(input, event), IllegalArgumentException);
+}
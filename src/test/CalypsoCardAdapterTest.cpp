@@ -15,6 +15,7 @@
 
 /* Keyple Card Calypso */
 #include "CalypsoCardAdapter.h"
+#include "FileHeaderAdapter.h"
 
 /* Keyple Core Service */
 #include "ApduResponseAdapter.h"
@@ -907,3 +908,213 @@ TEST(CalypsoCardAdapterTest, getSvBalance_whenNotSet_shouldThrowISE)
 
     tearDown();
 }
+
+TEST(CalypsoCardAdapterTest, getFileBySfi_whenFileIsNotFound_shouldReturnNull)
+{
+    setUp();
+
+    ASSERT_EQ(calypsoCardAdapter->getFileBySfi(0x07), nullptr);
+    ASSERT_EQ(calypsoCardAdapter->getFileByLid(0x2010), nullptr);
+
+    tearDown();
+}
+
+TEST(CalypsoCardAdapterTest, getFileByLid_whenHeaderIsSet_shouldReturnTheFileOfTheSfi)
+{
+    setUp();
+
+    const std::shared_ptr<FileHeaderAdapter> header =
+        FileHeaderAdapter::builder()->lid(0x2010)
+                                    .recordsNumber(1)
+                                    .recordSize(29)
+                                    .type(ElementaryFile::Type::LINEAR)
+                                    .build();
+
+    calypsoCardAdapter->setFileHeader(0x07, header);
+
+    ASSERT_NE(calypsoCardAdapter->getFileBySfi(0x07), nullptr);
+    ASSERT_EQ(calypsoCardAdapter->getFileByLid(0x2010), calypsoCardAdapter->getFileBySfi(0x07));
+    ASSERT_EQ(calypsoCardAdapter->getAllFiles().size(), 1);
+
+    tearDown();
+}
+
+TEST(CalypsoCardAdapterTest, restoreFiles_shouldRestoreTheFilesIndexes)
+{
+    setUp();
+
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("1122"));
+    calypsoCardAdapter->backupFiles();
+    calypsoCardAdapter->setContent(0x08, 1, ByteArrayUtil::fromHex("3344"));
+
+    ASSERT_EQ(calypsoCardAdapter->getAllFiles().size(), 2);
+
+    calypsoCardAdapter->restoreFiles();
+
+    ASSERT_NE(calypsoCardAdapter->getFileBySfi(0x07), nullptr);
+    ASSERT_EQ(calypsoCardAdapter->getFileBySfi(0x08), nullptr);
+    ASSERT_EQ(calypsoCardAdapter->getAllFiles().size(), 1);
+
+    tearDown();
+}
+
+TEST(CalypsoCardAdapterTest, setContent_whenHeaderIsSet_shouldReplaceTheRecordContent)
+{
+    setUp();
+
+    const std::shared_ptr<FileHeaderAdapter> header =
+        FileHeaderAdapter::builder()->lid(0x2010)
+                                    .recordsNumber(2)
+                                    .recordSize(4)
+                                    .type(ElementaryFile::Type::LINEAR)
+                                    .build();
+
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("1122"));
+    calypsoCardAdapter->setFileHeader(0x07, header);
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("33"), 3);
+    calypsoCardAdapter->setContent(0x07, 2, ByteArrayUtil::fromHex("44"));
+
+    const std::shared_ptr<FileData> data = calypsoCardAdapter->getFileBySfi(0x07)->getData();
+
+    ASSERT_EQ(data->getContent(1), ByteArrayUtil::fromHex("11220033"));
+    ASSERT_EQ(data->getContent(2), ByteArrayUtil::fromHex("44"));
+
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("55"));
+
+    ASSERT_EQ(data->getContent(1), ByteArrayUtil::fromHex("55"));
+    ASSERT_EQ(data->getAllRecordsContent().size(), 2);
+
+    tearDown();
+}
+
+TEST(CalypsoCardAdapterTest, setContent_whenRecordExceedsTheRecordSize_shouldKeepAllRecords)
+{
+    setUp();
+
+    const std::shared_ptr<FileHeaderAdapter> header =
+        FileHeaderAdapter::builder()->lid(0x2010)
+                                    .recordsNumber(1)
+                                    .recordSize(2)
+                                    .type(ElementaryFile::Type::LINEAR)
+                                    .build();
+
+    calypsoCardAdapter->setFileHeader(0x07, header);
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("1122"));
+    calypsoCardAdapter->setContent(0x07, 2, ByteArrayUtil::fromHex("334455"));
+
+    const std::shared_ptr<FileData> data = calypsoCardAdapter->getFileBySfi(0x07)->getData();
+
+    ASSERT_EQ(data->getContent(1), ByteArrayUtil::fromHex("1122"));
+    ASSERT_EQ(data->getContent(2), ByteArrayUtil::fromHex("334455"));
+
+    tearDown();
+}
+
+TEST(CalypsoCardAdapterTest, addCyclicContent_whenHeaderIsSet_shouldDropTheOldestRecord)
+{
+    setUp();
+
+    const std::shared_ptr<FileHeaderAdapter> header =
+        FileHeaderAdapter::builder()->lid(0x2010)
+                                    .recordsNumber(2)
+                                    .recordSize(2)
+                                    .type(ElementaryFile::Type::CYCLIC)
+                                    .build();
+
+    calypsoCardAdapter->setFileHeader(0x07, header);
+    calypsoCardAdapter->addCyclicContent(0x07, ByteArrayUtil::fromHex("1111"));
+    calypsoCardAdapter->addCyclicContent(0x07, ByteArrayUtil::fromHex("2222"));
+    calypsoCardAdapter->addCyclicContent(0x07, ByteArrayUtil::fromHex("3333"));
+
+    const std::shared_ptr<FileData> data = calypsoCardAdapter->getFileBySfi(0x07)->getData();
+
+    ASSERT_EQ(data->getContent(1), ByteArrayUtil::fromHex("3333"));
+    ASSERT_EQ(data->getContent(2), ByteArrayUtil::fromHex("2222"));
+    ASSERT_EQ(data->getAllRecordsContent().size(), 2);
+
+    tearDown();
+}
+
+TEST(CalypsoCardAdapterTest, restoreFiles_shouldRestoreTheContentOfTheUpdatedFiles)
+{
+    setUp();
+
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("1122"));
+    calypsoCardAdapter->setContent(0x08, 1, ByteArrayUtil::fromHex("3344"));
+    calypsoCardAdapter->backupFiles();
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("5566"));
+    calypsoCardAdapter->setContent(0x07, 2, ByteArrayUtil::fromHex("7788"));
+
+    calypsoCardAdapter->restoreFiles();
+
+    const std::shared_ptr<FileData> data = calypsoCardAdapter->getFileBySfi(0x07)->getData();
+
+    ASSERT_EQ(data->getContent(1), ByteArrayUtil::fromHex("1122"));
+    ASSERT_EQ(data->getAllRecordsContent().size(), 1);
+    ASSERT_EQ(calypsoCardAdapter->getFileBySfi(0x08)->getData()->getContent(1),
+              ByteArrayUtil::fromHex("3344"));
+
+    tearDown();
+}
+
+TEST(CalypsoCardAdapterTest, setContent_whenNoBackup_shouldNotCopyTheFiles)
+{
+    setUp();
+
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("1122"));
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("3344"));
+    calypsoCardAdapter->setContent(0x08, 1, ByteArrayUtil::fromHex("5566"));
+
+    ASSERT_EQ(calypsoCardAdapter->getFilesBackupCount(), 0);
+
+    calypsoCardAdapter->restoreFiles();
+
+    ASSERT_EQ(calypsoCardAdapter->getFileBySfi(0x07)->getData()->getContent(1),
+              ByteArrayUtil::fromHex("3344"));
+    ASSERT_NE(calypsoCardAdapter->getFileBySfi(0x08), nullptr);
+
+    tearDown();
+}
+
+TEST(CalypsoCardAdapterTest, commitFiles_shouldDropTheBackupAndStopCopyingTheFiles)
+{
+    setUp();
+
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("1122"));
+    calypsoCardAdapter->backupFiles();
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("3344"));
+    calypsoCardAdapter->setContent(0x08, 1, ByteArrayUtil::fromHex("5566"));
+
+    ASSERT_EQ(calypsoCardAdapter->getFilesBackupCount(), 2);
+
+    calypsoCardAdapter->commitFiles();
+
+    ASSERT_EQ(calypsoCardAdapter->getFilesBackupCount(), 0);
+
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("7788"));
+    calypsoCardAdapter->restoreFiles();
+
+    ASSERT_EQ(calypsoCardAdapter->getFilesBackupCount(), 0);
+    ASSERT_EQ(calypsoCardAdapter->getFileBySfi(0x07)->getData()->getContent(1),
+              ByteArrayUtil::fromHex("7788"));
+    ASSERT_NE(calypsoCardAdapter->getFileBySfi(0x08), nullptr);
+
+    tearDown();
+}
+
+TEST(CalypsoCardAdapterTest, restoreFiles_shouldEndTheBackup)
+{
+    setUp();
+
+    calypsoCardAdapter->backupFiles();
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("1122"));
+    calypsoCardAdapter->restoreFiles();
+
+    ASSERT_EQ(calypsoCardAdapter->getFileBySfi(0x07), nullptr);
+
+    calypsoCardAdapter->setContent(0x07, 1, ByteArrayUtil::fromHex("3344"));
+
+    ASSERT_EQ(calypsoCardAdapter->getFilesBackupCount(), 0);
+
+    tearDown();
+}
@@ -10,6 +10,10 @@
  * SPDX-License-Identifier: EPL-2.0                                                               *
  **************************************************************************************************/
 
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -26,9 +30,15 @@
 #include "CalypsoSamAdapter.h"
 #include "CardRequestAdapter.h"
 #include "CardResponseAdapter.h"
+#include "CardTransactionCoroutine.h"
+#include "CardTransactionManagerAdapter.h"
+#include "ThreadPoolTransactionExecutor.h"
 
 /* Keyple Core Util */
 #include "ByteArrayUtil.h"
+#include "IllegalArgumentException.h"
+#include "IllegalStateException.h"
+#include "IndexOutOfBoundsException.h"
 
 /* Mock */
 #include "ApduResponseAdapterMock.h"
@@ -42,6 +52,7 @@ using namespace calypsonet::terminal::calypso::transaction;
 using namespace calypsonet::terminal::card;
 using namespace keyple::card::calypso;
 using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
 
 
 class CardRequestMatcher : public CardRequestSpi /*: public ArgumentMatcher<CardRequestSpi> */{
@@ -547,6 +558,482 @@ TEST(CardTransactionManagerAdapterTest, getCardSecuritySetting_shouldReturnCardS
     tearDown();
 }
 
+/**
+ * Executor keeping the tasks until runAll is called.
+ */
+class DeferredTransactionExecutor final : public TransactionExecutor {
+public:
+    void execute(const std::function<void()>& task) override
+    {
+        mTasks.push_back(task);
+    }
+
+    void runAll()
+    {
+        for (const auto& task : mTasks) {
+            task();
+        }
+
+        mTasks.clear();
+    }
+
+private:
+    std::vector<std::function<void()>> mTasks;
+};
+
+TEST(CardTransactionManagerAdapterTest,
+     processCardCommandsAsync_whenExecutorIsSet_shouldProcessCommandsOnExecutor)
+{
+    setUp();
+
+    auto executor = std::make_shared<ThreadPoolTransactionExecutor>(2);
+    auto adapter = std::dynamic_pointer_cast<CardTransactionManagerAdapter>(cardTransactionManager);
+    adapter->setExecutor(executor);
+
+    EXPECT_CALL(*cardReader, transmitCardRequest(_, _))
+        .WillOnce(Return(createCardResponse({CARD_READ_REC_SFI7_REC1_RSP})));
+
+    adapter->prepareReadRecord(0x07, 1);
+    std::future<void> result = adapter->processCardCommandsAsync();
+    result.get();
+
+    ASSERT_EQ(calypsoCard->getFileBySfi(0x07)->getData()->getContent(1), FILE7_REC1_29B_BYTES);
+
+    tearDown();
+}
+
+TEST(CardTransactionManagerAdapterTest,
+     threadPoolTransactionExecutor_whenATaskThrows_shouldRunTheNextTasks)
+{
+    std::promise<void> lastTaskRun;
+
+    {
+        ThreadPoolTransactionExecutor executor(1);
+        executor.execute([]() { throw std::runtime_error("Task failure."); });
+        executor.execute([]() { throw 1; });
+        executor.execute([&lastTaskRun]() { lastTaskRun.set_value(); });
+    }
+
+    ASSERT_EQ(lastTaskRun.get_future().wait_for(std::chrono::seconds(0)),
+              std::future_status::ready);
+}
+
+TEST(CardTransactionManagerAdapterTest,
+     processCardCommandsAsync_whenAnOperationIsInProgress_shouldThrowISE)
+{
+    setUp();
+
+    auto executor = std::make_shared<DeferredTransactionExecutor>();
+    auto adapter = std::dynamic_pointer_cast<CardTransactionManagerAdapter>(cardTransactionManager);
+    adapter->setExecutor(executor);
+
+    EXPECT_CALL(*cardReader, transmitCardRequest(_, _))
+        .WillRepeatedly(Return(createCardResponse({})));
+
+    std::future<void> result = adapter->processCardCommandsAsync();
+
+    EXPECT_THROW(adapter->processCardCommandsAsync(), IllegalStateException);
+
+    /* Nothing was prepared: empty exchange with the card */
+    executor->runAll();
+    result.get();
+
+    /* The next operation is accepted */
+    std::future<void> next = adapter->processCardCommandsAsync();
+    executor->runAll();
+    next.get();
+
+    tearDown();
+}
+
+TEST(CardTransactionManagerAdapterTest,
+     threadPoolTransactionExecutor_whenDestroyedByItsTask_shouldNotDeadlock)
+{
+    std::promise<void> submitted;
+    std::promise<void> destroyed;
+    const std::shared_future<void> isSubmitted = submitted.get_future().share();
+
+    auto executor = new ThreadPoolTransactionExecutor(2);
+    executor->execute([executor, isSubmitted, &destroyed]() {
+                          isSubmitted.wait();
+                          delete executor;
+                          destroyed.set_value();
+                      });
+    submitted.set_value();
+
+    ASSERT_EQ(destroyed.get_future().wait_for(std::chrono::seconds(5)),
+              std::future_status::ready);
+}
+
+/**
+ * Executor refusing all the tasks with a standard exception.
+ */
+class FailingTransactionExecutor final : public TransactionExecutor {
+public:
+    void execute(const std::function<void()>& task) override
+    {
+        (void)task;
+        throw std::runtime_error("No thread available.");
+    }
+};
+
+TEST(CardTransactionManagerAdapterTest,
+     processCardCommandsAsync_whenExecutorThrowsAStandardException_shouldAcceptTheNextOperation)
+{
+    setUp();
+
+    auto adapter = std::dynamic_pointer_cast<CardTransactionManagerAdapter>(cardTransactionManager);
+    adapter->setExecutor(std::make_shared<FailingTransactionExecutor>());
+
+    EXPECT_CALL(*cardReader, transmitCardRequest(_, _))
+        .WillRepeatedly(Return(createCardResponse({})));
+
+    EXPECT_THROW(adapter->processCardCommandsAsync(), std::runtime_error);
+
+    /* Default behaviour: a new thread */
+    adapter->setExecutor(nullptr);
+    adapter->processCardCommandsAsync().get();
+
+    tearDown();
+}
+
+TEST(CardTransactionManagerAdapterTest,
+     processCardCommands_whenAnAsyncOperationIsInProgress_shouldThrowISE)
+{
+    setUp();
+
+    auto executor = std::make_shared<DeferredTransactionExecutor>();
+    auto adapter = std::dynamic_pointer_cast<CardTransactionManagerAdapter>(cardTransactionManager);
+    adapter->setExecutor(executor);
+
+    EXPECT_CALL(*cardReader, transmitCardRequest(_, _))
+        .WillRepeatedly(Return(createCardResponse({})));
+
+    std::future<void> result = adapter->processCardCommandsAsync();
+
+    EXPECT_THROW(adapter->processCardCommands(), IllegalStateException);
+
+    executor->runAll();
+    result.get();
+
+    /* Same code path once the asynchronous operation is over */
+    adapter->processCardCommands();
+
+    tearDown();
+}
+
+TEST(CardTransactionManagerAdapterTest,
+     processClosingAsync_whenNoSessionIsOpen_shouldProvideISEThroughFuture)
+{
+    setUp();
+
+    auto adapter = std::dynamic_pointer_cast<CardTransactionManagerAdapter>(cardTransactionManager);
+
+    std::future<void> result = adapter->processClosingAsync();
+
+    EXPECT_THROW(result.get(), IllegalStateException);
+
+    tearDown();
+}
+
+#if defined(KEYPLECARDCALYPSO_COROUTINES)
+
+static CalypsoTask<void> openAndCloseSession(CardTransactionManagerAdapter& cardTransaction)
+{
+    co_await coProcessOpening(cardTransaction, WriteAccessLevel::DEBIT);
+    co_await coProcessClosing(cardTransaction);
+}
+
+static CalypsoTask<void> closeSession(CardTransactionManagerAdapter& cardTransaction)
+{
+    co_await coProcessClosing(cardTransaction);
+}
+
+TEST(CardTransactionManagerAdapterTest,
+     coProcessOpeningAndClosing_whenExecutorIsSet_shouldRunTheSessionOnExecutor)
+{
+    setUp();
+
+    auto executor = std::make_shared<ThreadPoolTransactionExecutor>(1);
+    auto adapter = std::dynamic_pointer_cast<CardTransactionManagerAdapter>(cardTransactionManager);
+    adapter->setExecutor(executor);
+
+    EXPECT_CALL(*samReader, transmitCardRequest(_, _))
+        .WillOnce(Return(createCardResponse({SW1SW2_OK_RSP, SAM_GET_CHALLENGE_RSP})))
+        .WillOnce(Return(createCardResponse({SW1SW2_OK_RSP, SAM_DIGEST_CLOSE_RSP})))
+        .WillOnce(Return(createCardResponse({SW1SW2_OK_RSP})));
+    EXPECT_CALL(*cardReader, transmitCardRequest(_, _))
+        .WillOnce(Return(createCardResponse({CARD_OPEN_SECURE_SESSION_RSP})))
+        .WillOnce(Return(createCardResponse({CARD_CLOSE_SECURE_SESSION_RSP})));
+
+    std::future<void> result = startCalypsoTask(openAndCloseSession(*adapter));
+    result.get();
+
+    tearDown();
+}
+
+TEST(CardTransactionManagerAdapterTest,
+     coProcessClosing_whenNoSessionIsOpen_shouldProvideISEThroughFuture)
+{
+    setUp();
+
+    auto adapter = std::dynamic_pointer_cast<CardTransactionManagerAdapter>(cardTransactionManager);
+
+    std::future<void> result = startCalypsoTask(closeSession(*adapter));
+
+    EXPECT_THROW(result.get(), IllegalStateException);
+
+    tearDown();
+}
+
+#endif
+
+TEST(CardTransactionManagerAdapterTest, reset_whenCardIsNull_shouldThrowIAE)
+{
+    setUp();
+
+    auto adapter = std::dynamic_pointer_cast<CardTransactionManagerAdapter>(cardTransactionManager);
+
+    EXPECT_THROW(adapter->reset(nullptr), IllegalArgumentException);
+
+    tearDown();
+}
+
+TEST(CardTransactionManagerAdapterTest,
+     reset_shouldBindTheNewCardAndDiscardThePreparedCommands)
+{
+    setUp();
+
+    auto adapter = std::dynamic_pointer_cast<CardTransactionManagerAdapter>(cardTransactionManager);
+    adapter->prepareReadRecord(0x07, 1);
+
+    auto newCalypsoCard = std::make_shared<CalypsoCardAdapter>();
+    newCalypsoCard->initializeWithFci(
+        std::make_shared<ApduResponseAdapterMock>(
+            ByteArrayUtil::fromHex(SELECT_APPLICATION_RESPONSE_PRIME_REVISION_3)));
+
+    adapter->reset(newCalypsoCard);
+
+    ASSERT_EQ(adapter->getCalypsoCard(), newCalypsoCard);
+    ASSERT_EQ(adapter->getCardSecuritySetting(), cardSecuritySetting);
+
+    /* The read record prepared for the previous card is not sent */
+    EXPECT_CALL(*cardReader, transmitCardRequest(_, _))
+        .WillOnce(Return(createCardResponse({CARD_READ_REC_SFI7_REC1_RSP})));
+
+    adapter->prepareReadRecord(0x07, 1);
+    adapter->processCardCommands();
+
+    ASSERT_EQ(newCalypsoCard->getFileBySfi(0x07)->getData()->getContent(1), FILE7_REC1_29B_BYTES);
+    ASSERT_EQ(calypsoCard->getFileBySfi(0x07), nullptr);
+
+    tearDown();
+}
+
+TEST(CardTransactionManagerAdapterTest, prepareScript_whenCardProfileDiffers_shouldThrowIAE)
+{
+    setUp();
+
+    auto adapter = std::dynamic_pointer_cast<CardTransactionManagerAdapter>(cardTransactionManager);
+    adapter->prepareReadRecord(0x07, 1);
+    std::shared_ptr<CardTransactionScript> script = adapter->compileScript();
+
+    auto calypsoCardRev2 = std::make_shared<CalypsoCardAdapter>();
+    calypsoCardRev2->initializeWithFci(
+        std::make_shared<ApduResponseAdapterMock>(
+            ByteArrayUtil::fromHex(SELECT_APPLICATION_RESPONSE_PRIME_REVISION_2)));
+    adapter->reset(calypsoCardRev2);
+
+    EXPECT_THROW(adapter->prepareScript(script), IllegalArgumentException);
+
+    tearDown();
+}
+
+TEST(CardTransactionManagerAdapterTest, prepareScript_shouldSendThePatchedCommands)
+{
+    setUp();
+
+    auto adapter = std::dynamic_pointer_cast<CardTransactionManagerAdapter>(cardTransactionManager);
+    adapter->prepareDecreaseCounter(0x01, 1, 1);
+    std::shared_ptr<CardTransactionScript> script = adapter->compileScript();
+
+    ASSERT_EQ(script->getCommandCount(), 1);
+    EXPECT_THROW(script->setRecordData(0, {0x00}), IllegalArgumentException);
+
+    script->setCounterValue(0, 100);
+
+    std::shared_ptr<CardRequestSpi> cardRequest;
+    EXPECT_CALL(*cardReader, transmitCardRequest(_, _))
+        .WillOnce(DoAll(SaveArg<0>(&cardRequest),
+                        Return(createCardResponse({CARD_DECREASE_SFI10_CNT1_4286U_RSP}))));
+
+    adapter->prepareScript(script).processCardCommands();
+
+    ASSERT_EQ(cardRequest->getApduRequests()[0]->getApdu(),
+              ByteArrayUtil::fromHex(CARD_DECREASE_SFI10_CNT1_100U_CMD));
+
+    tearDown();
+}
+
+TEST(CardTransactionManagerAdapterTest, prepareSetCounter_whenCounterIsNotSet_shouldThrowISE)
+{
+    setUp();
+
+    calypsoCard->setContent(0x01, 1, ByteArrayUtil::fromHex("0000110022"));
+
+    EXPECT_THROW(cardTransactionManager->prepareSetCounter(0x01, 3, 0x10), IllegalStateException);
+    EXPECT_THROW(cardTransactionManager->prepareSetCounter(0x02, 1, 0x10), IllegalStateException);
+
+    tearDown();
+}
+
+TEST(CardTransactionManagerAdapterTest, prepareSetCounter_whenCounterIsTruncated_shouldThrowIOOBE)
+{
+    setUp();
+
+    calypsoCard->setContent(0x01, 1, ByteArrayUtil::fromHex("0000110022"));
+
+    EXPECT_THROW(cardTransactionManager->prepareSetCounter(0x01, 2, 0x10),
+                 IndexOutOfBoundsException);
+
+    tearDown();
+}
+
+/**
+ * Responds to each command of a SAM request (challenge, signature or 9000) and keeps the APDUs.
+ */
+static std::shared_ptr<CardResponseApi> createSamResponse(
+    const std::shared_ptr<CardRequestSpi> samCardRequest,
+    std::vector<std::vector<uint8_t>>& samApdus)
+{
+    std::vector<std::string> apduResponses;
+
+    for (const auto& apduRequest : samCardRequest->getApduRequests()) {
+        const std::vector<uint8_t> apdu = apduRequest->getApdu();
+        samApdus.push_back(apdu);
+
+        switch (apdu[1]) {
+        case 0x84:
+            apduResponses.push_back(SAM_GET_CHALLENGE_RSP);
+            break;
+        case 0x8E:
+            apduResponses.push_back(SAM_DIGEST_CLOSE_RSP);
+            break;
+        default:
+            apduResponses.push_back(SW1SW2_OK_RSP);
+            break;
+        }
+    }
+
+    return createCardResponse(apduResponses);
+}
+
+static bool containsData(const std::vector<std::vector<uint8_t>>& apdus,
+                         const std::vector<uint8_t>& data)
+{
+    for (const auto& apdu : apdus) {
+        if (std::search(apdu.begin(), apdu.end(), data.begin(), data.end()) != apdu.end()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+TEST(CardTransactionManagerAdapterTest,
+     processClosing_whenIncreaseMultipleIsPrepared_shouldDigestTheAnticipatedResponse)
+{
+    setUp();
+
+    calypsoCard->setContent(0x01, 1, ByteArrayUtil::fromHex("000010000020000030"));
+
+    std::vector<std::vector<uint8_t>> samApdus;
+    EXPECT_CALL(*samReader, transmitCardRequest(_, _))
+        .WillRepeatedly(Invoke([&samApdus](const std::shared_ptr<CardRequestSpi> request,
+                                           const ChannelControl) {
+            return createSamResponse(request, samApdus);
+        }));
+    EXPECT_CALL(*cardReader, transmitCardRequest(_, _))
+        .WillOnce(Return(createCardResponse({CARD_OPEN_SECURE_SESSION_RSP})))
+        .WillOnce(Return(createCardResponse({CARD_INCREASE_MULTIPLE_SFI1_C1_11_C2_22_C3_33_RSP,
+                                             CARD_CLOSE_SECURE_SESSION_RSP})));
+
+    const std::map<const int, const int> counterNumberToIncValueMap = {{1, 1}, {2, 2}, {3, 3}};
+
+    cardTransactionManager->processOpening(WriteAccessLevel::DEBIT)
+                           .prepareIncreaseCounters(0x01, counterNumberToIncValueMap)
+                           .processClosing();
+
+    ASSERT_TRUE(
+        containsData(samApdus,
+                     ByteArrayUtil::fromHex(CARD_INCREASE_MULTIPLE_SFI1_C1_11_C2_22_C3_33_RSP)));
+    ASSERT_EQ(calypsoCard->getFileBySfi(0x01)->getData()->getAllCountersValue().at(3), 0x33);
+
+    tearDown();
+}
+
+TEST(CardTransactionManagerAdapterTest,
+     processClosing_whenDecreaseMultipleIsPrepared_shouldDigestTheAnticipatedResponse)
+{
+    setUp();
+
+    calypsoCard->setContent(
+        0x01,
+        1,
+        ByteArrayUtil::fromHex("000122000244000000000000000000000000000000000910"));
+
+    std::vector<std::vector<uint8_t>> samApdus;
+    EXPECT_CALL(*samReader, transmitCardRequest(_, _))
+        .WillRepeatedly(Invoke([&samApdus](const std::shared_ptr<CardRequestSpi> request,
+                                           const ChannelControl) {
+            return createSamResponse(request, samApdus);
+        }));
+    EXPECT_CALL(*cardReader, transmitCardRequest(_, _))
+        .WillOnce(Return(createCardResponse({CARD_OPEN_SECURE_SESSION_RSP})))
+        .WillOnce(Return(createCardResponse({CARD_DECREASE_MULTIPLE_SFI1_C1_111_C2_222_C8_888_RSP,
+                                             CARD_CLOSE_SECURE_SESSION_RSP})));
+
+    const std::map<const int, const int> counterNumberToDecValueMap =
+        {{1, 0x11}, {2, 0x22}, {8, 0x88}};
+
+    cardTransactionManager->processOpening(WriteAccessLevel::DEBIT)
+                           .prepareDecreaseCounters(0x01, counterNumberToDecValueMap)
+                           .processClosing();
+
+    ASSERT_TRUE(
+        containsData(samApdus,
+                     ByteArrayUtil::fromHex(CARD_DECREASE_MULTIPLE_SFI1_C1_111_C2_222_C8_888_RSP)));
+    ASSERT_EQ(calypsoCard->getFileBySfi(0x01)->getData()->getAllCountersValue().at(8), 0x888);
+
+    tearDown();
+}
+
+TEST(CardTransactionManagerAdapterTest,
+     processClosing_whenIncreaseMultipleTargetsAnUnknownCounter_shouldThrowISE)
+{
+    setUp();
+
+    calypsoCard->setContent(0x01, 1, ByteArrayUtil::fromHex("000010000020"));
+
+    std::vector<std::vector<uint8_t>> samApdus;
+    EXPECT_CALL(*samReader, transmitCardRequest(_, _))
+        .WillRepeatedly(Invoke([&samApdus](const std::shared_ptr<CardRequestSpi> request,
+                                           const ChannelControl) {
+            return createSamResponse(request, samApdus);
+        }));
+    EXPECT_CALL(*cardReader, transmitCardRequest(_, _))
+        .WillOnce(Return(createCardResponse({CARD_OPEN_SECURE_SESSION_RSP})));
+
+    const std::map<const int, const int> counterNumberToIncValueMap = {{1, 1}, {3, 3}};
+
+    cardTransactionManager->processOpening(WriteAccessLevel::DEBIT)
+                           .prepareIncreaseCounters(0x01, counterNumberToIncValueMap);
+
+    EXPECT_THROW(cardTransactionManager->processClosing(), IllegalStateException);
+
+    tearDown();
+}
+
 TEST(CardTransactionManagerAdapterTest,
      processOpening_whenNoCommandsArePrepared_shouldExchangeApduWithCardAndSam)
 {
@@ -0,0 +1,53 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Card Calypso */
+#include "CalypsoCardClass.h"
+#include "CardCommandException.h"
+#include "CmdCardIncreaseOrDecrease.h"
+
+/* Keyple Core Util */
+#include "ByteArrayUtil.h"
+
+/* Mock */
+#include "ApduResponseAdapterMock.h"
+
+using namespace testing;
+
+using namespace keyple::card::calypso;
+using namespace keyple::core::util;
+
+TEST(CmdCardIncreaseOrDecreaseTest, checkStatus_whenStatusWordIs9000_shouldBeSuccessful)
+{
+    CmdCardIncreaseOrDecrease cmd(false, CalypsoCardClass::ISO, 0x07, 1, 10);
+
+    cmd.setApduResponse(
+        std::make_shared<ApduResponseAdapterMock>(ByteArrayUtil::fromHex("00006E9000")));
+
+    ASSERT_TRUE(cmd.isSuccessful());
+    ASSERT_EQ(cmd.getStatusInformation(), "Success");
+    EXPECT_NO_THROW(cmd.checkStatus());
+}
+
+TEST(CmdCardIncreaseOrDecreaseTest, checkStatus_whenStatusWordIs6A80_shouldThrowCCE)
+{
+    CmdCardIncreaseOrDecrease cmd(true, CalypsoCardClass::ISO, 0x07, 1, 10);
+
+    cmd.setApduResponse(std::make_shared<ApduResponseAdapterMock>(ByteArrayUtil::fromHex("6A80")));
+
+    ASSERT_FALSE(cmd.isSuccessful());
+    ASSERT_EQ(cmd.getStatusInformation(), "Overflow error.");
+    EXPECT_THROW(cmd.checkStatus(), CardCommandException);
+}
@@ -0,0 +1,137 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Card Calypso */
+#include "FileDataAdapter.h"
+
+/* Keyple Core Util */
+#include "ByteArrayUtil.h"
+#include "IndexOutOfBoundsException.h"
+
+using namespace testing;
+
+using namespace keyple::card::calypso;
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+
+TEST(FileDataAdapterTest, getAllCountersValueAsArray_whenRecord1IsNotSet_shouldReturnEmptyVector)
+{
+    FileDataAdapter data;
+
+    ASSERT_TRUE(data.getAllCountersValueAsArray().empty());
+}
+
+TEST(FileDataAdapterTest, getAllCountersValueAsArray_shouldDecodeAllCounters)
+{
+    FileDataAdapter data;
+    data.setContent(1, ByteArrayUtil::fromHex("000001FFFFFF123456"));
+
+    const std::vector<int> counters = data.getAllCountersValueAsArray();
+
+    ASSERT_EQ(counters.size(), 3);
+    ASSERT_EQ(counters[0], 1);
+    ASSERT_EQ(counters[1], 0xFFFFFF);
+    ASSERT_EQ(counters[2], 0x123456);
+}
+
+TEST(FileDataAdapterTest, getAllCountersValueAsArray_whenLastCounterIsTruncated_shouldIgnoreIt)
+{
+    FileDataAdapter data;
+    data.setContent(1, ByteArrayUtil::fromHex("0000110022"));
+
+    const std::vector<int> counters = data.getAllCountersValueAsArray();
+
+    ASSERT_EQ(counters.size(), 1);
+    ASSERT_EQ(counters[0], 0x11);
+}
+
+TEST(FileDataAdapterTest, getAllCountersValue_shouldMatchTheArray)
+{
+    FileDataAdapter data;
+    data.setContent(1, ByteArrayUtil::fromHex("000011000022"));
+
+    const std::map<const int, const int> counters = data.getAllCountersValue();
+
+    ASSERT_EQ(counters.size(), 2);
+    ASSERT_EQ(counters.at(1), 0x11);
+    ASSERT_EQ(counters.at(2), 0x22);
+}
+
+TEST(FileDataAdapterTest, getContentAsCounterValue_whenCounterIsTruncated_shouldThrowIOOBE)
+{
+    FileDataAdapter data;
+    data.setContent(1, ByteArrayUtil::fromHex("0000110022"));
+
+    ASSERT_EQ(*data.getContentAsCounterValue(1), 0x11);
+    EXPECT_THROW(data.getContentAsCounterValue(2), IndexOutOfBoundsException);
+    ASSERT_EQ(data.getContentAsCounterValue(3), nullptr);
+}
+
+TEST(FileDataAdapterTest, getOptionalCounterValue_whenCounterIsTruncated_shouldThrowIOOBE)
+{
+    FileDataAdapter data;
+    data.setContent(1, ByteArrayUtil::fromHex("0000110022"));
+
+    ASSERT_EQ(*data.getOptionalCounterValue(1), 0x11);
+    EXPECT_THROW(data.getOptionalCounterValue(2), IndexOutOfBoundsException);
+    ASSERT_FALSE(data.getOptionalCounterValue(3).has_value());
+}
+
+TEST(FileDataAdapterTest, getAllRecordsContent_whenReadConcurrently_shouldBuildASingleView)
+{
+    FileDataAdapter data;
+    data.useFlatStorage(10, 29);
+    for (int numRecord = 1; numRecord <= 10; numRecord++) {
+        data.setContent(numRecord, std::vector<uint8_t>(29, static_cast<uint8_t>(numRecord)));
+    }
+
+    std::atomic<int> failures(0);
+    std::vector<std::thread> readers;
+
+    for (int i = 0; i < 8; i++) {
+        readers.push_back(std::thread([&data, &failures]() {
+                                          const auto& records = data.getAllRecordsContent();
+                                          if (records.size() != 10 ||
+                                              records.at(10) != std::vector<uint8_t>(29, 10)) {
+                                              failures++;
+                                          }
+                                      }));
+    }
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    ASSERT_EQ(failures.load(), 0);
+}
+
+TEST(FileDataAdapterTest, getAllRecordsContent_whenFlatStorageIsWritten_shouldReflectTheWrite)
+{
+    FileDataAdapter data;
+    data.useFlatStorage(2, 4);
+    data.setContent(1, ByteArrayUtil::fromHex("11223344"));
+
+    ASSERT_EQ(data.getAllRecordsContent().size(), 1);
+
+    data.setContent(2, ByteArrayUtil::fromHex("55667788"));
+
+    const auto& records = data.getAllRecordsContent();
+    ASSERT_EQ(records.size(), 2);
+    ASSERT_EQ(records.at(2), ByteArrayUtil::fromHex("55667788"));
+}
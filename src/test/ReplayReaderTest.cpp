@@ -0,0 +1,305 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+/* Calypsonet Terminal Card */
+#include "CardBrokenCommunicationException.h"
+#include "ReaderBrokenCommunicationException.h"
+#include "UnexpectedStatusWordException.h"
+
+/* Keyple Card Calypso */
+#include "ApduRequestAdapter.h"
+#include "CardRequestAdapter.h"
+
+/* Keyple Core Util */
+#include "ByteArrayUtil.h"
+#include "IllegalStateException.h"
+
+/* Mock */
+#include "ApduResponseAdapterMock.h"
+#include "CardResponseAdapterMock.h"
+#include "ReaderMock.h"
+
+/* Benchmark */
+#include "RecordingReader.h"
+#include "ReplayReader.h"
+
+using namespace testing;
+
+using namespace calypsonet::terminal::card;
+using namespace keyple::card::calypso;
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+
+static const std::string READER_NAME = "CARD_READER";
+
+static const std::string APDU_READ_RECORD_1 = "00B2014400";
+static const std::string APDU_READ_RECORD_2 = "00B2024400";
+static const std::string RESPONSE_RECORD_1 = "11223344556677889000";
+
+static std::shared_ptr<ReaderMock> reader;
+static std::shared_ptr<std::stringstream> trace;
+static std::shared_ptr<RecordingReader> recordingReader;
+
+static void setUp()
+{
+    reader = std::make_shared<ReaderMock>();
+    EXPECT_CALL(*reader, getName()).WillRepeatedly(ReturnRef(READER_NAME));
+    EXPECT_CALL(*reader, isContactless()).WillRepeatedly(Return(true));
+
+    trace = std::make_shared<std::stringstream>();
+    recordingReader = std::make_shared<RecordingReader>(reader, trace);
+}
+
+static void tearDown()
+{
+    recordingReader.reset();
+    trace.reset();
+    reader.reset();
+}
+
+static std::shared_ptr<CardRequestSpi> createCardRequest(const std::vector<std::string>& apdus)
+{
+    std::vector<std::shared_ptr<ApduRequestSpi>> apduRequests;
+    for (const auto& apdu : apdus) {
+        apduRequests.push_back(std::make_shared<ApduRequestAdapter>(ByteArrayUtil::fromHex(apdu)));
+    }
+
+    return std::make_shared<CardRequestAdapter>(apduRequests, true);
+}
+
+static std::shared_ptr<CardResponseApi> createCardResponse(const std::vector<std::string>& apdus)
+{
+    std::vector<std::shared_ptr<ApduResponseApi>> apduResponses;
+    for (const auto& apdu : apdus) {
+        apduResponses.push_back(
+            std::make_shared<ApduResponseAdapterMock>(ByteArrayUtil::fromHex(apdu)));
+    }
+
+    return std::make_shared<CardResponseAdapterMock>(apduResponses, true);
+}
+
+/**
+ * Records a successful exchange of both read record commands followed by a channel release.
+ */
+static void recordSession()
+{
+    EXPECT_CALL(*reader, transmitCardRequest(_, ChannelControl::KEEP_OPEN))
+        .WillOnce(Return(createCardResponse({RESPONSE_RECORD_1, "9000"})));
+    EXPECT_CALL(*reader, releaseChannel()).Times(1);
+
+    recordingReader->transmitCardRequest(
+        createCardRequest({APDU_READ_RECORD_1, APDU_READ_RECORD_2}), ChannelControl::KEEP_OPEN);
+    recordingReader->releaseChannel();
+}
+
+TEST(ReplayReaderTest, transmitCardRequest_whenRequestIsRecorded_shouldReturnTheRecordedResponse)
+{
+    setUp();
+    recordSession();
+
+    ReplayReader replayReader(*trace, nullptr);
+
+    ASSERT_EQ(replayReader.getName(), READER_NAME);
+    ASSERT_TRUE(replayReader.isContactless());
+    ASSERT_EQ(replayReader.getRemainingEventCount(), 2U);
+
+    const auto cardResponse = replayReader.transmitCardRequest(
+        createCardRequest({APDU_READ_RECORD_1, APDU_READ_RECORD_2}), ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(cardResponse->getApduResponses().size(), 2U);
+    ASSERT_EQ(cardResponse->getApduResponses()[0]->getApdu(),
+              ByteArrayUtil::fromHex(RESPONSE_RECORD_1));
+    ASSERT_EQ(cardResponse->getApduResponses()[1]->getApdu(), ByteArrayUtil::fromHex("9000"));
+    ASSERT_TRUE(cardResponse->isLogicalChannelOpen());
+
+    replayReader.releaseChannel();
+    ASSERT_EQ(replayReader.getRemainingEventCount(), 0U);
+
+    tearDown();
+}
+
+TEST(ReplayReaderTest, transmitCardRequest_whenApduDiffers_shouldThrowISE)
+{
+    setUp();
+    recordSession();
+
+    ReplayReader replayReader(*trace, nullptr);
+
+    EXPECT_THROW(replayReader.transmitCardRequest(
+                     createCardRequest({APDU_READ_RECORD_1, "00B2034400"}),
+                     ChannelControl::KEEP_OPEN),
+                 IllegalStateException);
+
+    tearDown();
+}
+
+TEST(ReplayReaderTest, transmitCardRequest_whenApduCountDiffers_shouldThrowISE)
+{
+    setUp();
+    recordSession();
+
+    ReplayReader replayReader(*trace, nullptr);
+
+    EXPECT_THROW(replayReader.transmitCardRequest(createCardRequest({APDU_READ_RECORD_1}),
+                                                  ChannelControl::KEEP_OPEN),
+                 IllegalStateException);
+
+    tearDown();
+}
+
+TEST(ReplayReaderTest, transmitCardRequest_whenChannelControlDiffers_shouldThrowISE)
+{
+    setUp();
+    recordSession();
+
+    ReplayReader replayReader(*trace, nullptr);
+
+    EXPECT_THROW(replayReader.transmitCardRequest(
+                     createCardRequest({APDU_READ_RECORD_1, APDU_READ_RECORD_2}),
+                     ChannelControl::CLOSE_AFTER),
+                 IllegalStateException);
+
+    tearDown();
+}
+
+TEST(ReplayReaderTest, transmitCardRequest_whenAReleaseIsExpected_shouldThrowISE)
+{
+    setUp();
+    recordSession();
+
+    ReplayReader replayReader(*trace, nullptr);
+    replayReader.transmitCardRequest(createCardRequest({APDU_READ_RECORD_1, APDU_READ_RECORD_2}),
+                                     ChannelControl::KEEP_OPEN);
+
+    EXPECT_THROW(replayReader.transmitCardRequest(createCardRequest({APDU_READ_RECORD_1}),
+                                                  ChannelControl::KEEP_OPEN),
+                 IllegalStateException);
+
+    tearDown();
+}
+
+TEST(ReplayReaderTest, releaseChannel_whenACardRequestIsExpected_shouldThrowISE)
+{
+    setUp();
+    recordSession();
+
+    ReplayReader replayReader(*trace, nullptr);
+
+    EXPECT_THROW(replayReader.releaseChannel(), IllegalStateException);
+
+    tearDown();
+}
+
+TEST(ReplayReaderTest, releaseChannel_whenTraceIsOver_shouldThrowISE)
+{
+    setUp();
+    recordSession();
+
+    ReplayReader replayReader(*trace, nullptr);
+    replayReader.transmitCardRequest(createCardRequest({APDU_READ_RECORD_1, APDU_READ_RECORD_2}),
+                                     ChannelControl::KEEP_OPEN);
+    replayReader.releaseChannel();
+
+    EXPECT_THROW(replayReader.releaseChannel(), IllegalStateException);
+
+    tearDown();
+}
+
+TEST(ReplayReaderTest, transmitCardRequest_whenStatusWordWasUnexpected_shouldThrowUSWE)
+{
+    setUp();
+
+    EXPECT_CALL(*reader, transmitCardRequest(_, _))
+        .WillOnce(Throw(UnexpectedStatusWordException(
+                            "Unexpected status word.",
+                            createCardResponse({"6A83"}))));
+
+    EXPECT_THROW(recordingReader->transmitCardRequest(
+                     createCardRequest({APDU_READ_RECORD_1, APDU_READ_RECORD_2}),
+                     ChannelControl::KEEP_OPEN),
+                 UnexpectedStatusWordException);
+
+    ReplayReader replayReader(*trace, nullptr);
+
+    try {
+        replayReader.transmitCardRequest(
+            createCardRequest({APDU_READ_RECORD_1, APDU_READ_RECORD_2}),
+            ChannelControl::KEEP_OPEN);
+        FAIL();
+    } catch (const UnexpectedStatusWordException& e) {
+        ASSERT_EQ(e.getCardResponse()->getApduResponses().size(), 1U);
+        ASSERT_EQ(e.getCardResponse()->getApduResponses()[0]->getApdu(),
+                  ByteArrayUtil::fromHex("6A83"));
+    }
+
+    tearDown();
+}
+
+TEST(ReplayReaderTest, transmitCardRequest_whenCardCommunicationWasBroken_shouldThrowCBCE)
+{
+    setUp();
+
+    EXPECT_CALL(*reader, transmitCardRequest(_, _))
+        .WillOnce(Throw(CardBrokenCommunicationException(
+                            "Card communication lost.",
+                            createCardResponse({RESPONSE_RECORD_1}))));
+
+    EXPECT_THROW(recordingReader->transmitCardRequest(
+                     createCardRequest({APDU_READ_RECORD_1, APDU_READ_RECORD_2}),
+                     ChannelControl::KEEP_OPEN),
+                 CardBrokenCommunicationException);
+
+    ReplayReader replayReader(*trace, nullptr);
+
+    try {
+        replayReader.transmitCardRequest(
+            createCardRequest({APDU_READ_RECORD_1, APDU_READ_RECORD_2}),
+            ChannelControl::KEEP_OPEN);
+        FAIL();
+    } catch (const CardBrokenCommunicationException& e) {
+        ASSERT_EQ(e.getCardResponse()->getApduResponses().size(), 1U);
+        ASSERT_EQ(e.getCardResponse()->getApduResponses()[0]->getApdu(),
+                  ByteArrayUtil::fromHex(RESPONSE_RECORD_1));
+    }
+
+    tearDown();
+}
+
+TEST(ReplayReaderTest, transmitCardRequest_whenReaderCommunicationWasBroken_shouldThrowRBCE)
+{
+    setUp();
+
+    EXPECT_CALL(*reader, transmitCardRequest(_, _))
+        .WillOnce(Throw(ReaderBrokenCommunicationException(
+                            "Reader communication lost.",
+                            createCardResponse({}))));
+
+    EXPECT_THROW(recordingReader->transmitCardRequest(
+                     createCardRequest({APDU_READ_RECORD_1, APDU_READ_RECORD_2}),
+                     ChannelControl::KEEP_OPEN),
+                 ReaderBrokenCommunicationException);
+
+    ReplayReader replayReader(*trace, nullptr);
+
+    EXPECT_THROW(replayReader.transmitCardRequest(
+                     createCardRequest({APDU_READ_RECORD_1, APDU_READ_RECORD_2}),
+                     ChannelControl::KEEP_OPEN),
+                 ReaderBrokenCommunicationException);
+
+    tearDown();
+}
@@ -0,0 +1,516 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Card Calypso */
+#include "ApduRequestAdapter.h"
+#include "CalypsoCardAdapter.h"
+#include "CalypsoExtensionService.h"
+#include "CalypsoSamAdapter.h"
+#include "CardSecuritySettingAdapter.h"
+#include "SamCommandProcessor.h"
+#include "SamPool.h"
+
+/* Keyple Core Util */
+#include "ByteArrayUtil.h"
+#include "IllegalStateException.h"
+
+/* Mock */
+#include "ApduResponseAdapterMock.h"
+#include "CardResponseAdapterMock.h"
+#include "CardSelectionResponseApiMock.h"
+#include "ReaderMock.h"
+
+using namespace testing;
+
+using namespace calypsonet::terminal::calypso::transaction;
+using namespace calypsonet::terminal::card;
+using namespace keyple::card::calypso;
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+
+static const std::string SELECT_APPLICATION_RESPONSE_PRIME_REVISION_3 =
+    "6F238409315449432E49434131A516BF0C13C708000000001122334453070A3C20051410019000";
+static const std::string SAM_C1_POWER_ON_DATA = "3B3F9600805A4880C120501711223344829000";
+static const std::string SAM_CHALLENGE = "C1C2C3C4";
+static const std::string SAM_SIGNATURE = "12345678";
+static const std::string SW1SW2_OK = "9000";
+static const std::string SW1SW2_INS_NOT_SUPPORTED = "6D00";
+
+static const uint8_t KIF = 0x30;
+static const uint8_t KVC = 0x79;
+
+static const int THREAD_COUNT = 16;
+static const int SESSION_COUNT = 100;
+static const int EXCHANGE_COUNT = 4;
+
+static std::atomic<int> samRequestCount(0);
+
+/**
+ * Answers to any SAM request: the Get Challenge and Digest Close commands get the challenge and the
+ * signature, the Digest Update Multiple command gets 6D00h if rejected, all the other commands get
+ * a simple 9000h. Every received APDU is appended to the provided list.
+ */
+static std::shared_ptr<CardResponseApi> answerSamRequest(
+    const std::shared_ptr<CardRequestSpi> cardRequest,
+    std::vector<std::vector<uint8_t>>& receivedApdus,
+    const bool isDigestUpdateMultipleRejected)
+{
+    std::vector<std::shared_ptr<ApduResponseApi>> apduResponses;
+
+    samRequestCount++;
+
+    for (const auto& apduRequest : cardRequest->getApduRequests()) {
+        const std::vector<uint8_t>& apdu = apduRequest->getApdu();
+        receivedApdus.push_back(apdu);
+
+        std::string response = SW1SW2_OK;
+        if (apdu[1] == 0x84) {
+            response = SAM_CHALLENGE + SW1SW2_OK;
+        } else if (apdu[1] == 0x8E) {
+            response = SAM_SIGNATURE + SW1SW2_OK;
+        } else if (apdu[1] == 0x8C && apdu[2] == 0x80 && isDigestUpdateMultipleRejected) {
+            response = SW1SW2_INS_NOT_SUPPORTED;
+        }
+
+        apduResponses.push_back(
+            std::make_shared<ApduResponseAdapterMock>(ByteArrayUtil::fromHex(response)));
+    }
+
+    return std::make_shared<CardResponseAdapterMock>(apduResponses, true);
+}
+
+/**
+ * Extracts the digest data blocks carried by the Digest Update and Digest Update Multiple
+ * commands of the range [from, to[ of the provided APDUs.
+ */
+static std::vector<std::vector<uint8_t>> extractDigestBlocks(
+    const std::vector<std::vector<uint8_t>>& apdus, const size_t from, const size_t to)
+{
+    std::vector<std::vector<uint8_t>> blocks;
+
+    for (size_t i = from; i < to; i++) {
+        const std::vector<uint8_t>& apdu = apdus[i];
+        if (apdu[1] != 0x8C) {
+            continue;
+        }
+
+        if (apdu[2] == 0x80) {
+            /* Digest Update Multiple: blocks prefixed by their length */
+            size_t offset = 5;
+            while (offset < apdu.size()) {
+                const size_t length = apdu[offset];
+                blocks.push_back(std::vector<uint8_t>(apdu.begin() + offset + 1,
+                                                      apdu.begin() + offset + 1 + length));
+                offset += 1 + length;
+            }
+        } else {
+            blocks.push_back(std::vector<uint8_t>(apdu.begin() + 5, apdu.end()));
+        }
+    }
+
+    return blocks;
+}
+
+/**
+ * Creates a new card image.
+ */
+static std::shared_ptr<CalypsoCardAdapter> createCalypsoCard()
+{
+    auto calypsoCard = std::make_shared<CalypsoCardAdapter>();
+    calypsoCard->initializeWithFci(
+        std::make_shared<ApduResponseAdapterMock>(
+            ByteArrayUtil::fromHex(SELECT_APPLICATION_RESPONSE_PRIME_REVISION_3)));
+
+    return calypsoCard;
+}
+
+/**
+ * Creates a new C1 SAM image.
+ */
+static std::shared_ptr<CalypsoSamAdapter> createCalypsoSam()
+{
+    auto samCardSelectionResponse = std::make_shared<CardSelectionResponseApiMock>();
+    EXPECT_CALL(*samCardSelectionResponse, getPowerOnData())
+        .WillRepeatedly(ReturnRef(SAM_C1_POWER_ON_DATA));
+
+    return std::make_shared<CalypsoSamAdapter>(samCardSelectionResponse);
+}
+
+/**
+ * Creates a mocked SAM reader recording all the APDUs it receives in the provided list.
+ */
+static std::shared_ptr<ReaderMock> createSamReader(
+    std::vector<std::vector<uint8_t>>& receivedApdus,
+    const bool isDigestUpdateMultipleRejected = false)
+{
+    auto samReader = std::make_shared<ReaderMock>();
+    EXPECT_CALL(*samReader, transmitCardRequest(_, _))
+        .WillRepeatedly(Invoke([&receivedApdus, isDigestUpdateMultipleRejected](
+                                   const std::shared_ptr<CardRequestSpi> request,
+                                   const ChannelControl channelControl) {
+                                   (void)channelControl;
+                                   return answerSamRequest(request,
+                                                           receivedApdus,
+                                                           isDigestUpdateMultipleRejected);
+                               }));
+
+    return samReader;
+}
+
+/**
+ * Creates a processor bound to a new card image and a new mocked C1 SAM reader recording all the
+ * APDUs it receives in the provided list.
+ */
+static std::shared_ptr<SamCommandProcessor> createSamCommandProcessor(
+    std::vector<std::vector<uint8_t>>& receivedApdus, const bool isDigestPipeliningEnabled = false)
+{
+    auto cardSecuritySetting = CalypsoExtensionService::getInstance()->createCardSecuritySetting();
+    cardSecuritySetting->setSamResource(createSamReader(receivedApdus), createCalypsoSam());
+
+    if (isDigestPipeliningEnabled) {
+        std::dynamic_pointer_cast<CardSecuritySettingAdapter>(cardSecuritySetting)
+            ->enableDigestPipelining();
+    }
+
+    return std::make_shared<SamCommandProcessor>(createCalypsoCard(), cardSecuritySetting);
+}
+
+/**
+ * Pushes exchangeCount card exchanges tagged with the provided id to the processor.
+ */
+static void pushCardExchanges(const std::shared_ptr<SamCommandProcessor> samCommandProcessor,
+                              const uint8_t tag,
+                              const uint8_t session,
+                              const int exchangeCount)
+{
+    std::vector<std::shared_ptr<ApduRequestSpi>> requests;
+    std::vector<std::shared_ptr<ApduResponseApi>> responses;
+
+    for (int i = 0; i < exchangeCount; i++) {
+        requests.push_back(
+            std::make_shared<ApduRequestAdapter>(
+                std::vector<uint8_t>({0x00, 0xB2, 0x01, tag, 0x00})));
+        responses.push_back(
+            std::make_shared<ApduResponseAdapterMock>(
+                std::vector<uint8_t>({tag, session, 0x90, 0x00})));
+    }
+
+    samCommandProcessor->pushCardExchangedData(requests, responses, 0);
+}
+
+/**
+ * Runs SESSION_COUNT digest computations with data tagged by the thread id and checks that the
+ * SAM only received that data.
+ */
+static void runSessions(const uint8_t threadId, std::atomic<int>& failures)
+{
+    std::vector<std::vector<uint8_t>> receivedApdus;
+    std::shared_ptr<SamCommandProcessor> samCommandProcessor =
+        createSamCommandProcessor(receivedApdus);
+
+    for (int session = 0; session < SESSION_COUNT; session++) {
+        receivedApdus.clear();
+
+        const std::vector<uint8_t> openSessionData = {threadId, static_cast<uint8_t>(session)};
+        samCommandProcessor->initializeDigester(false, false, KIF, KVC, openSessionData);
+
+        pushCardExchanges(
+            samCommandProcessor, threadId, static_cast<uint8_t>(session), EXCHANGE_COUNT);
+        samCommandProcessor->getTerminalSignature();
+
+        /* Digest Init + digest update command(s) + Digest Close */
+        if (receivedApdus.size() < 3) {
+            failures++;
+            continue;
+        }
+
+        /* Digest Init data: KIF, KVC then the open session data of this thread only */
+        const std::vector<uint8_t>& digestInit = receivedApdus[0];
+        if (digestInit.size() != 9 ||
+            digestInit[7] != threadId ||
+            digestInit[8] != static_cast<uint8_t>(session)) {
+            failures++;
+        }
+
+        /* Digest Update data: alternately the request and the response of this thread */
+        const std::vector<std::vector<uint8_t>> digestBlocks =
+            extractDigestBlocks(receivedApdus, 1, receivedApdus.size() - 1);
+        if (static_cast<int>(digestBlocks.size()) != 2 * EXCHANGE_COUNT) {
+            failures++;
+            continue;
+        }
+
+        for (int i = 0; i < 2 * EXCHANGE_COUNT; i++) {
+            const bool isRequest = (i % 2) == 0;
+            const uint8_t tag = isRequest ? digestBlocks[i][3] : digestBlocks[i][0];
+            if (tag != threadId) {
+                failures++;
+            }
+        }
+    }
+}
+
+TEST(SamCommandProcessorTest,
+     getTerminalSignature_whenProcessorsRunInParallel_shouldNotMixDigestData)
+{
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        threads.push_back(
+            std::thread(runSessions, static_cast<uint8_t>(i + 1), std::ref(failures)));
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(failures.load(), 0);
+}
+
+TEST(SamCommandProcessorTest,
+     getTerminalSignature_whenSessionIsNotEncrypted_shouldPackDigestDataInDigestUpdateMultiple)
+{
+    std::vector<std::vector<uint8_t>> receivedApdus;
+    std::shared_ptr<SamCommandProcessor> samCommandProcessor =
+        createSamCommandProcessor(receivedApdus);
+
+    samCommandProcessor->initializeDigester(false, false, KIF, KVC, {0x01, 0x02});
+    pushCardExchanges(samCommandProcessor, 0x01, 0x00, 12);
+    samCommandProcessor->getTerminalSignature();
+
+    /* 24 blocks of 5 or 4 bytes fit in a single Digest Update Multiple for a C1 SAM */
+    ASSERT_EQ(receivedApdus.size(), 3u);
+    ASSERT_EQ(receivedApdus[1][1], 0x8C);
+    ASSERT_EQ(receivedApdus[1][2], 0x80);
+    ASSERT_EQ(extractDigestBlocks(receivedApdus, 1, 2).size(), 24u);
+}
+
+TEST(SamCommandProcessorTest,
+     getTerminalSignature_whenSamRejectsDigestUpdateMultiple_shouldFallBackToDigestUpdate)
+{
+    std::vector<std::vector<uint8_t>> receivedApdus;
+    auto calypsoSam = createCalypsoSam();
+    auto cardSecuritySetting = CalypsoExtensionService::getInstance()->createCardSecuritySetting();
+    cardSecuritySetting->setSamResource(createSamReader(receivedApdus, true), calypsoSam);
+    auto samCommandProcessor =
+        std::make_shared<SamCommandProcessor>(createCalypsoCard(), cardSecuritySetting);
+
+    samRequestCount = 0;
+
+    samCommandProcessor->initializeDigester(false, false, KIF, KVC, {0x01, 0x02});
+    pushCardExchanges(samCommandProcessor, 0x01, 0x00, 2);
+    const std::vector<uint8_t> signature = samCommandProcessor->getTerminalSignature();
+
+    /* Digest Init + rejected Digest Update Multiple, then 4 Digest Update + Digest Close */
+    ASSERT_EQ(samRequestCount.load(), 2);
+    ASSERT_EQ(receivedApdus.size(), 7u);
+    ASSERT_EQ(receivedApdus[1][2], 0x80);
+    for (size_t i = 2; i < 6; i++) {
+        ASSERT_EQ(receivedApdus[i][1], 0x8C);
+        ASSERT_EQ(receivedApdus[i][2], 0x00);
+    }
+    ASSERT_EQ(extractDigestBlocks(receivedApdus, 2, 6), extractDigestBlocks(receivedApdus, 1, 2));
+    ASSERT_EQ(signature, ByteArrayUtil::fromHex(SAM_SIGNATURE));
+    ASSERT_EQ(calypsoSam->getDigestUpdateMultipleSupport(),
+              CalypsoSamAdapter::DigestUpdateMultipleSupport::UNSUPPORTED);
+
+    /* The next session of the same SAM does not try again */
+    receivedApdus.clear();
+    samCommandProcessor->initializeDigester(false, false, KIF, KVC, {0x01, 0x02});
+    pushCardExchanges(samCommandProcessor, 0x01, 0x00, 2);
+    samCommandProcessor->getTerminalSignature();
+
+    ASSERT_EQ(receivedApdus.size(), 6u);
+    for (const auto& apdu : receivedApdus) {
+        ASSERT_NE(apdu[2], 0x80);
+    }
+}
+
+TEST(SamCommandProcessorTest,
+     getTerminalSignature_whenSessionIsEncrypted_shouldUseOneDigestUpdatePerBlock)
+{
+    std::vector<std::vector<uint8_t>> receivedApdus;
+    std::shared_ptr<SamCommandProcessor> samCommandProcessor =
+        createSamCommandProcessor(receivedApdus);
+
+    samCommandProcessor->initializeDigester(true, false, KIF, KVC, {0x01, 0x02});
+    pushCardExchanges(samCommandProcessor, 0x01, 0x00, 12);
+    samCommandProcessor->getTerminalSignature();
+
+    ASSERT_EQ(receivedApdus.size(), 26u);
+    for (size_t i = 1; i < 25; i++) {
+        ASSERT_EQ(receivedApdus[i][1], 0x8C);
+        ASSERT_EQ(receivedApdus[i][3], 0x80);
+    }
+}
+
+TEST(SamCommandProcessorTest,
+     getTerminalSignature_whenDigestPipeliningIsEnabled_shouldOnlySendDigestCloseAtClosing)
+{
+    std::vector<std::vector<uint8_t>> receivedApdus;
+    std::shared_ptr<SamCommandProcessor> samCommandProcessor =
+        createSamCommandProcessor(receivedApdus, true);
+
+    samRequestCount = 0;
+
+    samCommandProcessor->initializeDigester(false, false, KIF, KVC, {0x01, 0x02});
+    pushCardExchanges(samCommandProcessor, 0x01, 0x00, 2);
+    pushCardExchanges(samCommandProcessor, 0x02, 0x00, 2);
+    const std::vector<uint8_t> signature = samCommandProcessor->getTerminalSignature();
+
+    /* Digest Init + Update in background, Update in background, then Digest Close alone */
+    ASSERT_EQ(samRequestCount.load(), 3);
+    ASSERT_EQ(receivedApdus.size(), 4u);
+    ASSERT_EQ(receivedApdus[0][1], 0x8A);
+    ASSERT_EQ(receivedApdus[1][1], 0x8C);
+    ASSERT_EQ(receivedApdus[2][1], 0x8C);
+    ASSERT_EQ(receivedApdus[3][1], 0x8E);
+    ASSERT_EQ(signature, ByteArrayUtil::fromHex(SAM_SIGNATURE));
+}
+
+TEST(SamCommandProcessorTest,
+     getSessionTerminalChallenge_whenChallengeIsPrefetched_shouldNotExchangeWithSam)
+{
+    std::vector<std::vector<uint8_t>> receivedApdus;
+    std::shared_ptr<SamCommandProcessor> samCommandProcessor =
+        createSamCommandProcessor(receivedApdus);
+
+    samCommandProcessor->prefetchSessionTerminalChallenge();
+
+    samRequestCount = 0;
+    receivedApdus.clear();
+
+    ASSERT_EQ(samCommandProcessor->getSessionTerminalChallenge(),
+              ByteArrayUtil::fromHex(SAM_CHALLENGE));
+    ASSERT_EQ(samRequestCount.load(), 0);
+    ASSERT_EQ(samCommandProcessor->getChallengePrefetchHitCount(), 1);
+    ASSERT_EQ(samCommandProcessor->getChallengePrefetchMissCount(), 0);
+
+    /* The diversification is done along with the Digest Init command */
+    samCommandProcessor->initializeDigester(false, false, KIF, KVC, {0x01, 0x02});
+    pushCardExchanges(samCommandProcessor, 0x01, 0x00, 1);
+    samCommandProcessor->getTerminalSignature();
+
+    ASSERT_EQ(samRequestCount.load(), 1);
+    ASSERT_EQ(receivedApdus[0][1], 0x14);
+    ASSERT_EQ(receivedApdus[1][1], 0x8A);
+}
+
+TEST(SamCommandProcessorTest,
+     getSessionTerminalChallenge_whenPrefetchIsStarted_shouldWaitForThePrefetchedChallenge)
+{
+    std::vector<std::vector<uint8_t>> receivedApdus;
+    std::shared_ptr<SamCommandProcessor> samCommandProcessor =
+        createSamCommandProcessor(receivedApdus);
+
+    samRequestCount = 0;
+
+    samCommandProcessor->startSessionTerminalChallengePrefetch();
+
+    ASSERT_EQ(samCommandProcessor->getSessionTerminalChallenge(),
+              ByteArrayUtil::fromHex(SAM_CHALLENGE));
+    ASSERT_EQ(samRequestCount.load(), 1);
+    ASSERT_EQ(receivedApdus.size(), 1u);
+    ASSERT_EQ(receivedApdus[0][1], 0x84);
+    ASSERT_EQ(samCommandProcessor->getChallengePrefetchHitCount(), 1);
+    ASSERT_EQ(samCommandProcessor->getChallengePrefetchMissCount(), 0);
+}
+
+TEST(SamCommandProcessorTest,
+     getSessionTerminalChallenge_whenNoChallengeIsPrefetched_shouldCountAMiss)
+{
+    std::vector<std::vector<uint8_t>> receivedApdus;
+    std::shared_ptr<SamCommandProcessor> samCommandProcessor =
+        createSamCommandProcessor(receivedApdus);
+
+    ASSERT_EQ(samCommandProcessor->getSessionTerminalChallenge(),
+              ByteArrayUtil::fromHex(SAM_CHALLENGE));
+    ASSERT_EQ(samCommandProcessor->getChallengePrefetchHitCount(), 0);
+    ASSERT_EQ(samCommandProcessor->getChallengePrefetchMissCount(), 1);
+
+    /* Select Diversifier + Get Challenge */
+    ASSERT_EQ(receivedApdus.size(), 2u);
+    ASSERT_EQ(receivedApdus[0][1], 0x14);
+    ASSERT_EQ(receivedApdus[1][1], 0x84);
+}
+
+TEST(SamCommandProcessorTest,
+     getSessionTerminalChallenge_whenSamPoolIsUsed_shouldAllocateAFreeSam)
+{
+    std::vector<std::vector<uint8_t>> receivedApdus1;
+    std::vector<std::vector<uint8_t>> receivedApdus2;
+
+    auto samPool = std::make_shared<SamPool>();
+    samPool->addSam(createSamReader(receivedApdus1), createCalypsoSam())
+            .addSam(createSamReader(receivedApdus2), createCalypsoSam());
+
+    auto cardSecuritySetting = std::make_shared<CardSecuritySettingAdapter>();
+    cardSecuritySetting->setSamPool(samPool);
+
+    auto samCommandProcessor1 =
+        std::make_shared<SamCommandProcessor>(createCalypsoCard(), cardSecuritySetting);
+    auto samCommandProcessor2 =
+        std::make_shared<SamCommandProcessor>(createCalypsoCard(), cardSecuritySetting);
+
+    samCommandProcessor1->getSessionTerminalChallenge();
+    samCommandProcessor2->getSessionTerminalChallenge();
+
+    /* One session per SAM */
+    ASSERT_EQ(receivedApdus1.size(), 2u);
+    ASSERT_EQ(receivedApdus2.size(), 2u);
+    ASSERT_EQ(samPool->getActiveSessionCount(0), 1);
+    ASSERT_EQ(samPool->getActiveSessionCount(1), 1);
+    ASSERT_EQ(samPool->getExchangeCount(0), 1);
+    ASSERT_EQ(samPool->getExchangeCount(1), 1);
+
+    /* The whole session stays on the same SAM */
+    samCommandProcessor1->initializeDigester(false, false, KIF, KVC, {0x01, 0x02});
+    pushCardExchanges(samCommandProcessor1, 0x01, 0x00, 1);
+    samCommandProcessor1->getTerminalSignature();
+    samCommandProcessor1->authenticateCardSignature(ByteArrayUtil::fromHex(SAM_SIGNATURE));
+
+    ASSERT_EQ(receivedApdus1.size(), 6u);
+    ASSERT_EQ(receivedApdus2.size(), 2u);
+
+    samCommandProcessor1->releaseSam();
+    samCommandProcessor2.reset();
+
+    ASSERT_EQ(samPool->getActiveSessionCount(0), 0);
+    ASSERT_EQ(samPool->getActiveSessionCount(1), 0);
+}
+
+TEST(SamCommandProcessorTest,
+     prefetchSessionTerminalChallenge_whenSamPoolIsUsed_shouldThrowISE)
+{
+    std::vector<std::vector<uint8_t>> receivedApdus;
+
+    auto samPool = std::make_shared<SamPool>();
+    samPool->addSam(createSamReader(receivedApdus), createCalypsoSam());
+
+    auto cardSecuritySetting = std::make_shared<CardSecuritySettingAdapter>();
+    cardSecuritySetting->setSamPool(samPool);
+
+    auto samCommandProcessor =
+        std::make_shared<SamCommandProcessor>(createCalypsoCard(), cardSecuritySetting);
+
+    EXPECT_THROW(samCommandProcessor->prefetchSessionTerminalChallenge(), IllegalStateException);
+    ASSERT_TRUE(receivedApdus.empty());
+    ASSERT_EQ(samPool->getActiveSessionCount(0), 0);
+}
@@ -0,0 +1,169 @@
+/**************************************************************************************************
+ * Copyright (c) 2022 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <chrono>
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Card Calypso */
+#include "CalypsoSamAdapter.h"
+#include "SamPool.h"
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+#include "IllegalStateException.h"
+
+/* Mock */
+#include "CardSelectionResponseApiMock.h"
+#include "ReaderMock.h"
+
+using namespace testing;
+
+using namespace keyple::card::calypso;
+using namespace keyple::core::util::cpp::exception;
+
+static const std::string SAM_C1_POWER_ON_DATA = "3B3F9600805A4880C120501711223344829000";
+
+static std::shared_ptr<SamPool> createSamPool(const int samCount)
+{
+    auto samPool = std::make_shared<SamPool>();
+
+    for (int i = 0; i < samCount; i++) {
+        auto samCardSelectionResponse = std::make_shared<CardSelectionResponseApiMock>();
+        EXPECT_CALL(*samCardSelectionResponse, getPowerOnData())
+            .WillRepeatedly(ReturnRef(SAM_C1_POWER_ON_DATA));
+
+        samPool->addSam(std::make_shared<ReaderMock>(),
+                        std::make_shared<CalypsoSamAdapter>(samCardSelectionResponse));
+    }
+
+    return samPool;
+}
+
+TEST(SamPoolTest, addSam_whenSamIsNull_shouldThrowIAE)
+{
+    SamPool samPool;
+
+    EXPECT_THROW(samPool.addSam(std::make_shared<ReaderMock>(), nullptr),
+                 IllegalArgumentException);
+}
+
+TEST(SamPoolTest, acquire_whenPoolIsEmpty_shouldThrowISE)
+{
+    SamPool samPool;
+
+    EXPECT_THROW(samPool.acquire(), IllegalStateException);
+}
+
+TEST(SamPoolTest, acquire_shouldReturnAFreeSam)
+{
+    auto samPool = createSamPool(3);
+
+    ASSERT_EQ(samPool->acquire(), 0);
+    ASSERT_EQ(samPool->acquire(), 1);
+    ASSERT_EQ(samPool->acquire(), 2);
+
+    samPool->release(1);
+
+    ASSERT_EQ(samPool->acquire(), 1);
+    ASSERT_EQ(samPool->getActiveSessionCount(0), 1);
+    ASSERT_EQ(samPool->getActiveSessionCount(1), 1);
+}
+
+TEST(SamPoolTest, acquire_whenSeveralSamsAreFree_shouldPreferTheFastestSam)
+{
+    auto samPool = createSamPool(2);
+
+    samPool->reportExchange(0, 5000, true);
+    samPool->reportExchange(1, 1000, true);
+
+    ASSERT_EQ(samPool->acquire(), 1);
+    ASSERT_EQ(samPool->acquire(), 0);
+    ASSERT_EQ(samPool->getAverageLatencyMicros(0), 5000);
+    ASSERT_EQ(samPool->getAverageLatencyMicros(1), 1000);
+}
+
+TEST(SamPoolTest, acquire_whenAllSamsAreBusy_shouldWaitForARelease)
+{
+    auto samPool = createSamPool(1);
+
+    ASSERT_EQ(samPool->acquire(), 0);
+
+    std::thread releaser([samPool]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        samPool->release(0);
+    });
+
+    ASSERT_EQ(samPool->acquire(), 0);
+
+    releaser.join();
+}
+
+TEST(SamPoolTest, acquire_whenNoSamIsReleasedBeforeTheTimeout_shouldThrowISE)
+{
+    auto samPool = createSamPool(1);
+    samPool->setAcquireTimeout(std::chrono::milliseconds(10));
+
+    ASSERT_EQ(samPool->acquire(), 0);
+
+    EXPECT_THROW(samPool->acquire(), IllegalStateException);
+}
+
+TEST(SamPoolTest, acquire_whenSamIsUnhealthy_shouldSkipIt)
+{
+    auto samPool = createSamPool(2);
+
+    for (int i = 0; i < SamPool::MAX_CONSECUTIVE_FAILURES; i++) {
+        samPool->reportExchange(0, 1000, false);
+    }
+
+    ASSERT_FALSE(samPool->isHealthy(0));
+    ASSERT_EQ(samPool->acquire(), 1);
+
+    samPool->release(1);
+
+    ASSERT_EQ(samPool->acquire(), 1);
+
+    samPool->release(1);
+
+    /* A successful exchange restores the health */
+    samPool->reportExchange(0, 1000, true);
+
+    ASSERT_TRUE(samPool->isHealthy(0));
+    ASSERT_EQ(samPool->acquire(), 0);
+}
+
+TEST(SamPoolTest, acquire_whenRetryDelayOfUnhealthySamHasElapsed_shouldProbeIt)
+{
+    auto samPool = createSamPool(2);
+    samPool->setUnhealthyRetryDelay(std::chrono::milliseconds(0));
+
+    for (int i = 0; i < SamPool::MAX_CONSECUTIVE_FAILURES; i++) {
+        samPool->reportExchange(0, 1000, false);
+    }
+
+    ASSERT_EQ(samPool->acquire(), 0);
+    ASSERT_EQ(samPool->acquire(), 1);
+}
+
+TEST(SamPoolTest, acquire_whenNoHealthySamRemains_shouldUseAnUnhealthySam)
+{
+    auto samPool = createSamPool(1);
+
+    for (int i = 0; i < SamPool::MAX_CONSECUTIVE_FAILURES; i++) {
+        samPool->reportExchange(0, 1000, false);
+    }
+
+    ASSERT_EQ(samPool->acquire(), 0);
+}
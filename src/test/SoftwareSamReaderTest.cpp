@@ -0,0 +1,214 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Calypsonet Terminal Calypso */
+#include "SessionAuthenticationException.h"
+
+/* Keyple Card Calypso */
+#include "ApduRequestAdapter.h"
+#include "CalypsoCardAdapter.h"
+#include "CalypsoSamAdapter.h"
+#include "CardRequestAdapter.h"
+#include "CardSecuritySettingAdapter.h"
+#include "CardTransactionManagerAdapter.h"
+
+/* Keyple Core Util */
+#include "ByteArrayUtil.h"
+
+/* Mock */
+#include "ApduResponseAdapterMock.h"
+#include "CardResponseAdapterMock.h"
+
+/* Benchmark */
+#include "SoftwareSamReader.h"
+#include "VirtualCardReader.h"
+
+using namespace testing;
+
+using namespace calypsonet::terminal::calypso::transaction;
+using namespace calypsonet::terminal::card;
+using namespace keyple::card::calypso;
+using namespace keyple::core::util;
+
+static const uint8_t SFI_EVENT_LOG = 0x08;
+static const uint8_t SFI_CONTRACTS = 0x09;
+static const uint8_t SFI_COUNTERS = 0x19;
+
+static const uint8_t INS_CLOSE_SECURE_SESSION = 0x8E;
+
+static const std::string SW1SW2_CONDITIONS_NOT_SATISFIED = "6985";
+
+static const std::string SAM_DIGEST_AUTHENTICATE_CMD = "808200000411223344";
+
+/**
+ * (private)<br>
+ * Card reader decorator flipping the first byte of the card signature returned by the Close Secure
+ * Session command.
+ */
+class CorruptedCardSignatureReader final : public CardReader, public ProxyReaderApi {
+public:
+    CorruptedCardSignatureReader(const std::shared_ptr<VirtualCardReader> reader)
+    : mReader(reader) {}
+
+    const std::string& getName() const override
+    {
+        return mReader->getName();
+    }
+
+    bool isContactless() override
+    {
+        return mReader->isContactless();
+    }
+
+    bool isCardPresent() override
+    {
+        return mReader->isCardPresent();
+    }
+
+    const std::shared_ptr<CardResponseApi> transmitCardRequest(
+        const std::shared_ptr<CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override
+    {
+        const auto cardResponse = mReader->transmitCardRequest(cardRequest, channelControl);
+        const auto& apduRequests = cardRequest->getApduRequests();
+
+        std::vector<std::shared_ptr<ApduResponseApi>> apduResponses;
+        for (size_t i = 0; i < cardResponse->getApduResponses().size(); i++) {
+            std::vector<uint8_t> apdu = cardResponse->getApduResponses()[i]->getApdu();
+
+            /* The Abort Secure Session command carries no data */
+            const std::vector<uint8_t>& request = apduRequests[i]->getApdu();
+            if (request[1] == INS_CLOSE_SECURE_SESSION && request.size() > 5 && apdu.size() > 2) {
+                apdu[0] ^= 0xFF;
+            }
+
+            apduResponses.push_back(std::make_shared<ApduResponseAdapterMock>(apdu));
+        }
+
+        return std::make_shared<CardResponseAdapterMock>(apduResponses,
+                                                         cardResponse->isLogicalChannelOpen());
+    }
+
+    void releaseChannel() override
+    {
+        mReader->releaseChannel();
+    }
+
+private:
+    const std::shared_ptr<VirtualCardReader> mReader;
+};
+
+static std::shared_ptr<VirtualCardReader> cardReader;
+static std::shared_ptr<SoftwareSamReader> samReader;
+static std::shared_ptr<CalypsoCardAdapter> calypsoCard;
+static std::shared_ptr<CardSecuritySettingAdapter> cardSecuritySetting;
+
+static void setUp()
+{
+    /* Prime revision 3.1 card with a 430-byte session buffer */
+    cardReader = std::make_shared<VirtualCardReader>(
+                     "VIRTUAL_CARD_READER",
+                     std::vector<uint8_t>({0x31, 0x54, 0x49, 0x43, 0x2E, 0x49, 0x43, 0x41, 0x31}),
+                     std::vector<uint8_t>({0x00, 0x00, 0x00, 0x00, 0x11, 0x22, 0x33, 0x44}),
+                     std::vector<uint8_t>({0x0A, 0x3C, 0x23, 0x12, 0x14, 0x10, 0x01}));
+
+    cardReader->createFile(SFI_EVENT_LOG, 0x2010, ElementaryFile::Type::CYCLIC, 3, 29);
+    cardReader->createFile(SFI_CONTRACTS, 0x2020, ElementaryFile::Type::LINEAR, 4, 29);
+    cardReader->createFile(SFI_COUNTERS, 0x2069, ElementaryFile::Type::COUNTERS, 1, 9);
+    cardReader->setRecord(SFI_COUNTERS, 1, ByteArrayUtil::fromHex("000010000020000030"));
+
+    samReader = std::make_shared<SoftwareSamReader>("SOFTWARE_SAM_READER",
+                                                    std::vector<uint8_t>({0x12, 0x34, 0x56, 0x78}));
+
+    calypsoCard = std::make_shared<CalypsoCardAdapter>();
+    calypsoCard->initializeWithFci(cardReader->getSelectApplicationResponse());
+
+    cardSecuritySetting = std::make_shared<CardSecuritySettingAdapter>();
+    cardSecuritySetting->setSamResource(
+        samReader,
+        std::make_shared<CalypsoSamAdapter>(samReader->getCardSelectionResponse()));
+}
+
+static void tearDown()
+{
+    cardSecuritySetting.reset();
+    calypsoCard.reset();
+    samReader.reset();
+    cardReader.reset();
+}
+
+static const std::vector<uint8_t> transmitToSam(const std::string& apduHex)
+{
+    std::vector<std::shared_ptr<ApduRequestSpi>> apduRequests;
+    apduRequests.push_back(std::make_shared<ApduRequestAdapter>(ByteArrayUtil::fromHex(apduHex)));
+
+    return samReader->transmitCardRequest(std::make_shared<CardRequestAdapter>(apduRequests, false),
+                                          ChannelControl::KEEP_OPEN)
+               ->getApduResponses()[0]
+               ->getApdu();
+}
+
+TEST(SoftwareSamReaderTest, processClosing_shouldAuthenticateTheVirtualCard)
+{
+    setUp();
+
+    const std::vector<uint8_t> contract(29, 0x5A);
+
+    CardTransactionManagerAdapter cardTransaction(cardReader, calypsoCard, cardSecuritySetting);
+    cardTransaction.prepareReadRecords(SFI_CONTRACTS, 1, 1, 29)
+                   .processOpening(WriteAccessLevel::DEBIT)
+                   .prepareUpdateRecord(SFI_CONTRACTS, 1, contract)
+                   .prepareDecreaseCounter(SFI_COUNTERS, 1, 1);
+
+    /* The card signature is checked by Digest Authenticate */
+    ASSERT_NO_THROW(cardTransaction.processClosing());
+
+    ASSERT_EQ(cardReader->getRecord(SFI_CONTRACTS, 1), contract);
+    ASSERT_EQ(cardReader->getRecord(SFI_COUNTERS, 1),
+              ByteArrayUtil::fromHex("00000F000020000030"));
+    ASSERT_GT(samReader->getApduCount(), 0);
+
+    /* The SAM session is over */
+    ASSERT_EQ(transmitToSam(SAM_DIGEST_AUTHENTICATE_CMD),
+              ByteArrayUtil::fromHex(SW1SW2_CONDITIONS_NOT_SATISFIED));
+
+    tearDown();
+}
+
+TEST(SoftwareSamReaderTest, processClosing_whenCardSignatureIsCorrupted_shouldThrowSAE)
+{
+    setUp();
+
+    CardTransactionManagerAdapter cardTransaction(
+        std::make_shared<CorruptedCardSignatureReader>(cardReader),
+        calypsoCard,
+        cardSecuritySetting);
+    cardTransaction.processOpening(WriteAccessLevel::DEBIT)
+                   .prepareUpdateRecord(SFI_CONTRACTS, 1, std::vector<uint8_t>(29, 0x5A));
+
+    EXPECT_THROW(cardTransaction.processClosing(), SessionAuthenticationException);
+
+    tearDown();
+}
+
+TEST(SoftwareSamReaderTest, digestAuthenticate_whenNoSessionIsOpen_shouldReturn6985)
+{
+    setUp();
+
+    ASSERT_EQ(transmitToSam(SAM_DIGEST_AUTHENTICATE_CMD),
+              ByteArrayUtil::fromHex(SW1SW2_CONDITIONS_NOT_SATISFIED));
+
+    tearDown();
+}
@@ -0,0 +1,281 @@
+/**************************************************************************************************
+ * Copyright (c) 2023 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <algorithm>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Card Calypso */
+#include "ApduRequestAdapter.h"
+#include "CardRequestAdapter.h"
+
+/* Keyple Core Util */
+#include "ByteArrayUtil.h"
+
+/* Benchmark */
+#include "VirtualCardReader.h"
+#include "VirtualSignature.h"
+
+using namespace testing;
+
+using namespace keyple::card::calypso;
+using namespace keyple::core::util;
+
+static const uint8_t SFI_EVENT_LOG = 0x08;
+static const uint8_t SFI_CONTRACTS = 0x09;
+static const uint8_t SFI_COUNTERS = 0x19;
+
+static const std::vector<uint8_t> SERIAL_NUMBER = {0x00, 0x00, 0x00, 0x00, 0x11, 0x22, 0x33, 0x44};
+
+/* Debit key (key index 3) */
+static const uint8_t DEBIT_KIF = 0x30;
+static const uint8_t DEBIT_KVC = 0x79;
+
+static const std::string SW1SW2_OK = "9000";
+static const std::string SW1SW2_SESSION_BUFFER_OVERFLOW = "6400";
+static const std::string SW1SW2_INCORRECT_SIGNATURE = "6988";
+static const std::string SW1SW2_INCORRECT_DATA = "6A80";
+
+static const std::string CARD_OPEN_SECURE_SESSION_DEBIT_CMD = "008A030104C1C2C3C400";
+static const std::string CARD_ABORT_SECURE_SESSION_CMD = "008E000000";
+static const std::string CARD_UPDATE_REC_SFI9_REC1_29B_HEADER = "00DC014C1D";
+static const std::string CARD_APPEND_REC_SFI8_4B_CMD = "00E200400444444444";
+static const std::string CARD_INCREASE_MULTIPLE_SFI19_C1_1_C3_3_CMD = "003A00C8080100000103000003";
+static const std::string CARD_INCREASE_MULTIPLE_SFI19_C1_11_C3_33_RSP =
+    "0100001103000033" + SW1SW2_OK;
+static const std::string CARD_DECREASE_MULTIPLE_SFI19_C1_1_C2_21_CMD = "003800C8080100000102000021";
+static const std::string CARD_DECREASE_MULTIPLE_SFI19_C4_1_CMD = "003800C8040400000100";
+
+static std::shared_ptr<VirtualCardReader> reader;
+
+static void setUp()
+{
+    /* Prime revision 3.1 card with a 430-byte session buffer */
+    reader = std::make_shared<VirtualCardReader>(
+                 "VIRTUAL_CARD_READER",
+                 std::vector<uint8_t>({0x31, 0x54, 0x49, 0x43, 0x2E, 0x49, 0x43, 0x41, 0x31}),
+                 SERIAL_NUMBER,
+                 std::vector<uint8_t>({0x0A, 0x3C, 0x23, 0x12, 0x14, 0x10, 0x01}));
+
+    reader->createFile(SFI_EVENT_LOG, 0x2010, ElementaryFile::Type::CYCLIC, 3, 29);
+    reader->createFile(SFI_CONTRACTS, 0x2020, ElementaryFile::Type::LINEAR, 4, 29);
+    reader->createFile(SFI_COUNTERS, 0x2069, ElementaryFile::Type::COUNTERS, 1, 9);
+}
+
+static void tearDown()
+{
+    reader.reset();
+}
+
+static const std::vector<uint8_t> transmit(const std::vector<uint8_t>& apdu)
+{
+    std::vector<std::shared_ptr<ApduRequestSpi>> apduRequests;
+    apduRequests.push_back(std::make_shared<ApduRequestAdapter>(apdu));
+
+    return reader->transmitCardRequest(std::make_shared<CardRequestAdapter>(apduRequests, false),
+                                       ChannelControl::KEEP_OPEN)
+               ->getApduResponses()[0]
+               ->getApdu();
+}
+
+static const std::vector<uint8_t> transmit(const std::string& apduHex)
+{
+    return transmit(ByteArrayUtil::fromHex(apduHex));
+}
+
+static const std::vector<uint8_t> withoutStatusWord(const std::vector<uint8_t>& response)
+{
+    return std::vector<uint8_t>(response.begin(), response.end() - 2);
+}
+
+static const std::string updateRecordSfi9Rec1(const uint8_t value)
+{
+    return CARD_UPDATE_REC_SFI9_REC1_29B_HEADER +
+           ByteArrayUtil::toHex(std::vector<uint8_t>(29, value));
+}
+
+TEST(VirtualCardReaderTest, updateRecord_whenSessionBufferIsFull_shouldReturn6400)
+{
+    setUp();
+
+    ASSERT_EQ(withoutStatusWord(transmit(CARD_OPEN_SECURE_SESSION_DEBIT_CMD)).size(), 8);
+
+    /* Each 29-byte update costs 29 + 6 bytes: 12 updates fit in 430 bytes */
+    for (int i = 0; i < 12; i++) {
+        ASSERT_EQ(transmit(updateRecordSfi9Rec1(static_cast<uint8_t>(i))),
+                  ByteArrayUtil::fromHex(SW1SW2_OK));
+    }
+
+    ASSERT_EQ(transmit(updateRecordSfi9Rec1(0xFF)),
+              ByteArrayUtil::fromHex(SW1SW2_SESSION_BUFFER_OVERFLOW));
+    ASSERT_EQ(reader->getRecord(SFI_CONTRACTS, 1), std::vector<uint8_t>(29, 11));
+
+    tearDown();
+}
+
+TEST(VirtualCardReaderTest, updateRecord_whenNoSessionIsOpen_shouldNotLimitTheModifications)
+{
+    setUp();
+
+    for (int i = 0; i < 20; i++) {
+        ASSERT_EQ(transmit(updateRecordSfi9Rec1(static_cast<uint8_t>(i))),
+                  ByteArrayUtil::fromHex(SW1SW2_OK));
+    }
+
+    tearDown();
+}
+
+TEST(VirtualCardReaderTest, abortSession_shouldRollBackTheModifications)
+{
+    setUp();
+
+    reader->setRecord(SFI_CONTRACTS, 1, std::vector<uint8_t>(29, 0x11));
+    reader->setRecord(SFI_COUNTERS, 1, ByteArrayUtil::fromHex("000010000020000030"));
+
+    transmit(CARD_OPEN_SECURE_SESSION_DEBIT_CMD);
+    transmit(updateRecordSfi9Rec1(0x5A));
+    transmit(CARD_INCREASE_MULTIPLE_SFI19_C1_1_C3_3_CMD);
+
+    ASSERT_EQ(reader->getRecord(SFI_CONTRACTS, 1), std::vector<uint8_t>(29, 0x5A));
+
+    ASSERT_EQ(transmit(CARD_ABORT_SECURE_SESSION_CMD), ByteArrayUtil::fromHex(SW1SW2_OK));
+    ASSERT_EQ(reader->getRecord(SFI_CONTRACTS, 1), std::vector<uint8_t>(29, 0x11));
+    ASSERT_EQ(reader->getRecord(SFI_COUNTERS, 1), ByteArrayUtil::fromHex("000010000020000030"));
+
+    tearDown();
+}
+
+TEST(VirtualCardReaderTest, releaseChannel_whenSessionIsOpen_shouldRollBackTheModifications)
+{
+    setUp();
+
+    transmit(CARD_OPEN_SECURE_SESSION_DEBIT_CMD);
+    transmit(updateRecordSfi9Rec1(0x5A));
+
+    reader->releaseChannel();
+
+    ASSERT_EQ(reader->getRecord(SFI_CONTRACTS, 1), std::vector<uint8_t>(29, 0x00));
+
+    tearDown();
+}
+
+TEST(VirtualCardReaderTest, closeSession_whenSignatureIsValid_shouldKeepTheModifications)
+{
+    setUp();
+
+    const std::vector<uint8_t> openResponse = transmit(CARD_OPEN_SECURE_SESSION_DEBIT_CMD);
+
+    VirtualSignature digest(SERIAL_NUMBER, DEBIT_KIF, DEBIT_KVC);
+    digest.update(withoutStatusWord(openResponse));
+
+    const std::vector<uint8_t> update = ByteArrayUtil::fromHex(updateRecordSfi9Rec1(0x5A));
+    digest.update(update);
+    digest.update(transmit(update));
+
+    const std::vector<uint8_t> terminalSignature = digest.getTerminalSignature(4);
+    const std::vector<uint8_t> closeResponse =
+        transmit("008E800004" + ByteArrayUtil::toHex(terminalSignature) + "00");
+
+    ASSERT_EQ(withoutStatusWord(closeResponse), digest.getCardSignature(terminalSignature));
+    ASSERT_EQ(reader->getRecord(SFI_CONTRACTS, 1), std::vector<uint8_t>(29, 0x5A));
+
+    /* The session is closed: nothing to roll back */
+    reader->releaseChannel();
+
+    ASSERT_EQ(reader->getRecord(SFI_CONTRACTS, 1), std::vector<uint8_t>(29, 0x5A));
+
+    tearDown();
+}
+
+TEST(VirtualCardReaderTest, closeSession_whenSignatureIsWrong_shouldReturn6988AndRollBack)
+{
+    setUp();
+
+    transmit(CARD_OPEN_SECURE_SESSION_DEBIT_CMD);
+    transmit(updateRecordSfi9Rec1(0x5A));
+
+    ASSERT_EQ(transmit("008E8000041234567800"),
+              ByteArrayUtil::fromHex(SW1SW2_INCORRECT_SIGNATURE));
+    ASSERT_EQ(reader->getRecord(SFI_CONTRACTS, 1), std::vector<uint8_t>(29, 0x00));
+
+    tearDown();
+}
+
+TEST(VirtualCardReaderTest, appendRecord_shouldShiftTheRecordsAndDropTheOldestOne)
+{
+    setUp();
+
+    reader->setRecord(SFI_EVENT_LOG, 1, {0x11});
+    reader->setRecord(SFI_EVENT_LOG, 2, {0x22});
+    reader->setRecord(SFI_EVENT_LOG, 3, {0x33});
+
+    ASSERT_EQ(transmit(CARD_APPEND_REC_SFI8_4B_CMD), ByteArrayUtil::fromHex(SW1SW2_OK));
+
+    std::vector<uint8_t> expectedRecord1(29);
+    std::fill(expectedRecord1.begin(), expectedRecord1.begin() + 4, 0x44);
+    std::vector<uint8_t> expectedRecord2(29);
+    expectedRecord2[0] = 0x11;
+    std::vector<uint8_t> expectedRecord3(29);
+    expectedRecord3[0] = 0x22;
+
+    ASSERT_EQ(reader->getRecord(SFI_EVENT_LOG, 1), expectedRecord1);
+    ASSERT_EQ(reader->getRecord(SFI_EVENT_LOG, 2), expectedRecord2);
+    ASSERT_EQ(reader->getRecord(SFI_EVENT_LOG, 3), expectedRecord3);
+
+    tearDown();
+}
+
+TEST(VirtualCardReaderTest, appendRecord_whenFileIsNotCyclic_shouldReturn6981)
+{
+    setUp();
+
+    ASSERT_EQ(transmit("00E200480444444444"), ByteArrayUtil::fromHex("6981"));
+
+    tearDown();
+}
+
+TEST(VirtualCardReaderTest, increaseMultiple_shouldReturnTheNewValues)
+{
+    setUp();
+
+    reader->setRecord(SFI_COUNTERS, 1, ByteArrayUtil::fromHex("000010000020000030"));
+
+    ASSERT_EQ(transmit(CARD_INCREASE_MULTIPLE_SFI19_C1_1_C3_3_CMD),
+              ByteArrayUtil::fromHex(CARD_INCREASE_MULTIPLE_SFI19_C1_11_C3_33_RSP));
+    ASSERT_EQ(reader->getRecord(SFI_COUNTERS, 1), ByteArrayUtil::fromHex("000011000020000033"));
+
+    tearDown();
+}
+
+TEST(VirtualCardReaderTest, decreaseMultiple_whenACounterWouldBeNegative_shouldChangeNoCounter)
+{
+    setUp();
+
+    reader->setRecord(SFI_COUNTERS, 1, ByteArrayUtil::fromHex("000010000020000030"));
+
+    ASSERT_EQ(transmit(CARD_DECREASE_MULTIPLE_SFI19_C1_1_C2_21_CMD),
+              ByteArrayUtil::fromHex(SW1SW2_INCORRECT_DATA));
+    ASSERT_EQ(reader->getRecord(SFI_COUNTERS, 1), ByteArrayUtil::fromHex("000010000020000030"));
+
+    tearDown();
+}
+
+TEST(VirtualCardReaderTest, decreaseMultiple_whenCounterDoesNotExist_shouldReturn6A80)
+{
+    setUp();
+
+    ASSERT_EQ(transmit(CARD_DECREASE_MULTIPLE_SFI19_C4_1_CMD),
+              ByteArrayUtil::fromHex(SW1SW2_INCORRECT_DATA));
+
+    tearDown();
+}